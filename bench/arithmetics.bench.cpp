@@ -0,0 +1,968 @@
+/// \file arithmetics.bench.cpp
+/// \brief Measures the throughput and latency of the basic algorithms and of
+/// every operation of the double-word and pair arithmetic, and the throughput
+/// of the double-word elementary functions.
+/// \details Each operation is registered twice:
+/// - `throughput` applies the operation to independent operands.
+/// - `latency` chains the operations, so that each one depends on the result
+///   of the previous one, and additionally reports the seconds per operation
+///   (`latency`).
+///
+/// Both report the operations per second (`items_per_second`), the number of
+/// floating point operations per call that is listed in the README (`FP ops`)
+/// and the resulting floating point operations per second (`FLOPS`), so that
+/// the op counts can be compared against measured cycles. All rates are in SI
+/// units, e.g. 1e9 `items_per_second` are one operation per nanosecond.
+///
+/// The quad-word operations and the elementary functions are measured for
+/// single numbers (`scalar`) and for arrays (`batch`), and the operations on
+/// expansions with `N` components (`multiword`) for single numbers and for
+/// vectors of four numbers (`simd`). They only report the operations per
+/// second, like the evaluation of a polynomial of degree 11 with the
+/// double-word and the pair arithmetic. The matrix product `blas::gemm`,
+/// the matrix-vector product `blas::gemv` and `blas::axpy` report the
+/// multiply-adds per second, compared with plain loops over the same operations
+/// (`naive`). The sparse matrix-vector products `sparse::spmv` report the
+/// nonzeros per second for the 5-point Laplacian. The complex products
+/// `complex::mul` report the products per second of the fused product for
+/// single numbers (`fused`) and arrays (`batch`), compared with the product
+/// composed of `doubleword::mul` and `add` (`composed`). The Fourier transforms
+/// `fft::forward` report the points times stages per second (`n log2(n)`),
+/// compared with the same Stockham algorithm on `double` (`double`). The
+/// decimal conversions `from_chars` and `to_chars` report the numbers per
+/// second with 32 digits, compared with `std::from_chars` and `std::to_chars`
+/// of `double` with 17 digits (`std`). The compression `codec::encode` and
+/// `codec::decode` reports the uncompressed bytes per second on one thread and
+/// the compressed size relative to the uncompressed size (`ratio`), for random
+/// numbers whose low words have all their bits (`random`) and for exact
+/// products of numbers with few significant bits (`products`).
+
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/double-word-batch.hpp>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/arithmetics/multi-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/arithmetics/quad-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/quad-word-batch.hpp>
+#include <libtwofloat/blas.hpp>
+#include <libtwofloat/charconv.hpp>
+#include <libtwofloat/codec.hpp>
+#include <libtwofloat/complex.hpp>
+#include <libtwofloat/fft.hpp>
+#include <libtwofloat/poly.hpp>
+#include <libtwofloat/sparse.hpp>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace twofloat {
+namespace bench {
+
+/// \brief The number of operations per benchmark iteration. The operands fit
+/// into the L1 cache.
+constexpr std::size_t n = 1024;
+
+/// \brief Creates normalized double-word numbers in [1/√2, √2), so that long
+/// chains of multiplications and divisions neither overflow nor underflow.
+template <typename T>
+std::vector<two<T>> operands(unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> exponent(-0.5, 0.5);
+  std::uniform_real_distribution<T> low(-1, 1);
+
+  std::vector<two<T>> v(n);
+  for (two<T> &x : v) {
+    T h = std::exp2(exponent(gen));
+    T l = h * low(gen) * std::numeric_limits<T>::epsilon();
+    x = algorithms::FastTwoSum(h, l);
+  }
+  return v;
+}
+
+void setCounters(benchmark::State &state, int flops) {
+  double ops = static_cast<double>(n) * state.iterations();
+  state.SetItemsProcessed(static_cast<std::int64_t>(ops));
+  state.counters["FP ops"] = flops;
+  state.counters["FLOPS"] =
+      benchmark::Counter(flops * ops, benchmark::Counter::kIsRate);
+}
+
+template <typename T, typename Op>
+void throughput(benchmark::State &state, Op op, int flops) {
+  std::vector<two<T>> x = operands<T>(1);
+  std::vector<two<T>> y = operands<T>(2);
+  std::vector<two<T>> z(n);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) z[i] = op(x[i], y[i]);
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  setCounters(state, flops);
+}
+
+template <typename T, typename Op>
+void latency(benchmark::State &state, Op op, int flops) {
+  std::vector<two<T>> x = operands<T>(1);
+  std::vector<two<T>> y = operands<T>(2);
+
+  for (auto _ : state) {
+    two<T> acc = x[0];
+    for (std::size_t i = 0; i < n; ++i) acc = op(acc, y[i]);
+    benchmark::DoNotOptimize(acc);
+  }
+  setCounters(state, flops);
+  state.counters["latency"] = benchmark::Counter(
+      static_cast<double>(n) * state.iterations(),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+/// \brief Registers the throughput and latency benchmarks of an operation.
+/// \param op Takes two double-word numbers and returns a double-word number.
+/// Operations with floating point operands use the high word.
+/// \param flops The number of floating point operations listed in the README.
+template <typename T, typename Op>
+void registerOp(const std::string &name, int flops, Op op) {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  benchmark::RegisterBenchmark((name + "/" + type + "/throughput").c_str(),
+                               throughput<T, Op>, op, flops);
+  benchmark::RegisterBenchmark((name + "/" + type + "/latency").c_str(),
+                               latency<T, Op>, op, flops);
+}
+
+template <typename T>
+void registerAlgorithms() {
+  registerOp<T>("algorithms::FastTwoSum", 3, [](const auto &x, const auto &y) {
+    return algorithms::FastTwoSum(x.h, y.h);
+  });
+  registerOp<T>("algorithms::TwoSum", 6, [](const auto &x, const auto &y) {
+    return algorithms::TwoSum(x.h, y.h);
+  });
+  registerOp<T>("algorithms::Split", 6, [](const auto &x, const auto &) {
+    return algorithms::Split(x.h);
+  });
+  registerOp<T>("algorithms::TwoProd/noFMA", 21,
+                [](const auto &x, const auto &y) {
+                  return algorithms::TwoProd<T, false>(x.h, y.h);
+                });
+  registerOp<T>("algorithms::TwoProd/FMA", 3, [](const auto &x, const auto &y) {
+    return algorithms::TwoProd<T, true>(x.h, y.h);
+  });
+}
+
+template <typename T>
+void registerDoubleWord() {
+  using doubleword::Mode;
+
+  registerOp<T>("doubleword::add(DW,FP)", 10, [](const auto &x, const auto &y) {
+    return doubleword::add(x, y.h);
+  });
+  registerOp<T>("doubleword::add(DW,DW)/Sloppy", 11,
+                [](const auto &x, const auto &y) {
+                  return doubleword::add<Mode::Sloppy>(x, y);
+                });
+  registerOp<T>("doubleword::add(DW,DW)/Accurate", 20,
+                [](const auto &x, const auto &y) {
+                  return doubleword::add<Mode::Accurate>(x, y);
+                });
+  registerOp<T>("doubleword::sub(DW,FP)", 10, [](const auto &x, const auto &y) {
+    return doubleword::sub(x, y.h);
+  });
+  registerOp<T>("doubleword::sub(DW,DW)/Sloppy", 11,
+                [](const auto &x, const auto &y) {
+                  return doubleword::sub<Mode::Sloppy>(x, y);
+                });
+  registerOp<T>("doubleword::sub(DW,DW)/Accurate", 20,
+                [](const auto &x, const auto &y) {
+                  return doubleword::sub<Mode::Accurate>(x, y);
+                });
+
+  registerOp<T>("doubleword::mul(DW,FP)/Accurate/noFMA", 29,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Accurate, false>(x, y.h);
+                });
+  registerOp<T>("doubleword::mul(DW,FP)/Fast/noFMA", 23,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Fast, false>(x, y.h);
+                });
+  registerOp<T>("doubleword::mul(DW,FP)/Accurate/FMA", 7,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Accurate, true>(x, y.h);
+                });
+  registerOp<T>("doubleword::mul(DW,DW)/Fast/noFMA", 28,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Fast, false>(x, y);
+                });
+  registerOp<T>("doubleword::mul(DW,DW)/Fast/FMA", 9,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Fast, true>(x, y);
+                });
+  registerOp<T>("doubleword::mul(DW,DW)/Accurate/FMA", 10,
+                [](const auto &x, const auto &y) {
+                  return doubleword::mul<Mode::Accurate, true>(x, y);
+                });
+
+  registerOp<T>("doubleword::fma(DW,DW,DW)/Fast/Accurate/noFMA", 39,
+                [](const auto &x, const auto &y) {
+                  return doubleword::fma<Mode::Fast, Mode::Accurate, false>(
+                      x, y, x);
+                });
+  registerOp<T>("doubleword::fma(DW,DW,DW)/Fast/Sloppy/FMA", 16,
+                [](const auto &x, const auto &y) {
+                  return doubleword::fma<Mode::Fast, Mode::Sloppy, true>(x, y,
+                                                                         x);
+                });
+  registerOp<T>("doubleword::fma(DW,DW,DW)/Fast/Accurate/FMA", 19,
+                [](const auto &x, const auto &y) {
+                  return doubleword::fma<Mode::Fast, Mode::Accurate, true>(
+                      x, y, x);
+                });
+
+  registerOp<T>("doubleword::div(DW,FP)/noFMA", 29,
+                [](const auto &x, const auto &y) {
+                  return doubleword::div<false>(x, y.h);
+                });
+  registerOp<T>("doubleword::div(DW,FP)/FMA", 11,
+                [](const auto &x, const auto &y) {
+                  return doubleword::div<true>(x, y.h);
+                });
+  registerOp<T>("doubleword::div(DW,DW)/Fast/noFMA", 36,
+                [](const auto &x, const auto &y) {
+                  return doubleword::div<Mode::Fast, false>(x, y);
+                });
+  registerOp<T>("doubleword::div(DW,DW)/Fast/FMA", 14,
+                [](const auto &x, const auto &y) {
+                  return doubleword::div<Mode::Fast, true>(x, y);
+                });
+  registerOp<T>("doubleword::div(DW,DW)/Accurate/FMA", 34,
+                [](const auto &x, const auto &y) {
+                  return doubleword::div<Mode::Accurate, true>(x, y);
+                });
+}
+
+template <typename T>
+void registerPair() {
+  registerOp<T>("pair::add(DW,FP)", 7,
+                [](const auto &x, const auto &y) { return pair::add(x, y.h); });
+  registerOp<T>("pair::add(DW,DW)", 8,
+                [](const auto &x, const auto &y) { return pair::add(x, y); });
+  registerOp<T>("pair::sub(DW,FP)", 7,
+                [](const auto &x, const auto &y) { return pair::sub(x, y.h); });
+  registerOp<T>("pair::sub(DW,DW)", 8,
+                [](const auto &x, const auto &y) { return pair::sub(x, y); });
+  registerOp<T>("pair::mul(DW,FP)/noFMA", 23, [](const auto &x, const auto &y) {
+    return pair::mul<false>(x, y.h);
+  });
+  registerOp<T>("pair::mul(DW,FP)/FMA", 5, [](const auto &x, const auto &y) {
+    return pair::mul<true>(x, y.h);
+  });
+  registerOp<T>("pair::mul(DW,DW)/noFMA", 25, [](const auto &x, const auto &y) {
+    return pair::mul<false>(x, y);
+  });
+  registerOp<T>("pair::mul(DW,DW)/FMA", 7, [](const auto &x, const auto &y) {
+    return pair::mul<true>(x, y);
+  });
+  registerOp<T>("pair::div(DW,DW)/noFMA", 29, [](const auto &x, const auto &y) {
+    return pair::div<false>(x, y);
+  });
+  registerOp<T>("pair::div(DW,DW)/FMA", 11, [](const auto &x, const auto &y) {
+    return pair::div<true>(x, y);
+  });
+}
+
+/// \brief Creates normalized quad-word numbers in [1/√2, √2).
+template <typename T>
+std::vector<four<T>> quadOperands(unsigned seed) {
+  const std::vector<two<T>> high = operands<T>(seed);
+  const std::vector<two<T>> low = operands<T>(seed + 2);
+  const T scale = std::numeric_limits<T>::epsilon() *
+                  std::numeric_limits<T>::epsilon() / 4;
+  std::vector<four<T>> v(n);
+  for (std::size_t i = 0; i < n; ++i)
+    v[i] = quadword::add<quadword::Mode::Accurate>(
+        four<T>(high[i]), four<T>(two<T>(low[i].h * scale, low[i].l * scale)));
+  return v;
+}
+
+template <typename T, typename Op>
+void quadScalar(benchmark::State &state, Op op) {
+  const std::vector<four<T>> x = quadOperands<T>(1), y = quadOperands<T>(2);
+  std::vector<four<T>> z(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) z[i] = op(x[i], y[i]);
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+template <typename T, typename Op>
+void quadBatch(benchmark::State &state, Op op) {
+  const std::vector<four<T>> x = quadOperands<T>(1), y = quadOperands<T>(2);
+  std::vector<four<T>> z(n);
+  for (auto _ : state) {
+    op(span<const four<T>>(x), span<const four<T>>(y), span<four<T>>(z));
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+/// \brief Registers the scalar and batched benchmarks of a quad-word
+/// operation.
+template <typename T, typename Scalar, typename Batch>
+void registerQuadOp(const std::string &name, Scalar scalar, Batch batch) {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  benchmark::RegisterBenchmark((name + "/" + type + "/scalar").c_str(),
+                               quadScalar<T, Scalar>, scalar);
+  benchmark::RegisterBenchmark((name + "/" + type + "/batch").c_str(),
+                               quadBatch<T, Batch>, batch);
+}
+
+template <typename T>
+void registerQuadWord() {
+  using quadword::Mode;
+  registerQuadOp<T>(
+      "quadword::add/Sloppy",
+      [](const auto &x, const auto &y) {
+        return quadword::add<Mode::Sloppy>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::add<Mode::Sloppy>(x, y, z);
+      });
+  registerQuadOp<T>(
+      "quadword::add/Accurate",
+      [](const auto &x, const auto &y) {
+        return quadword::add<Mode::Accurate>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::add<Mode::Accurate>(x, y, z);
+      });
+  registerQuadOp<T>(
+      "quadword::mul/Sloppy/FMA",
+      [](const auto &x, const auto &y) {
+        return quadword::mul<Mode::Sloppy, true>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::mul<Mode::Sloppy, true>(x, y, z);
+      });
+  registerQuadOp<T>(
+      "quadword::mul/Accurate/FMA",
+      [](const auto &x, const auto &y) {
+        return quadword::mul<Mode::Accurate, true>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::mul<Mode::Accurate, true>(x, y, z);
+      });
+  registerQuadOp<T>(
+      "quadword::div/Sloppy/FMA",
+      [](const auto &x, const auto &y) {
+        return quadword::div<Mode::Sloppy, true>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::div<Mode::Sloppy, true>(x, y, z);
+      });
+  registerQuadOp<T>(
+      "quadword::div/Accurate/FMA",
+      [](const auto &x, const auto &y) {
+        return quadword::div<Mode::Accurate, true>(x, y);
+      },
+      [](auto x, auto y, auto z) {
+        quadword::batch::div<Mode::Accurate, true>(x, y, z);
+      });
+}
+
+/// \brief Runs `op` on expansions with `N` components that are truncated from
+/// the quad-word operands, on single numbers or on `simd<T, W>` if `W > 1`.
+template <typename T, std::size_t N, std::size_t W, typename Op>
+void multiWord(benchmark::State &state, Op op) {
+  using V = std::conditional_t<(W > 1), simd<T, W>, T>;
+  const std::vector<four<T>> a = quadOperands<T>(1), b = quadOperands<T>(2);
+  std::vector<expansion<V, N>> x(n / W), y(n / W), z(n / W);
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t k = 0; k < N; ++k) {
+      if constexpr (W > 1) {
+        x[i / W][k].v[i % W] = a[i][k];
+        y[i / W][k].v[i % W] = b[i][k];
+      } else {
+        x[i][k] = a[i][k];
+        y[i][k] = b[i][k];
+      }
+    }
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n / W; ++i) z[i] = op(x[i], y[i]);
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+template <typename T, std::size_t N, typename Op>
+void registerMultiWordOp(const std::string &name, Op op) {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  const std::string prefix = name + "/N=" + std::to_string(N) + "/" + type;
+  benchmark::RegisterBenchmark((prefix + "/scalar").c_str(),
+                               multiWord<T, N, 1, Op>, op);
+  benchmark::RegisterBenchmark((prefix + "/simd").c_str(),
+                               multiWord<T, N, 4, Op>, op);
+}
+
+template <typename T, std::size_t N>
+void registerMultiWord() {
+  registerMultiWordOp<T, N>("multiword::add", [](const auto &x, const auto &y) {
+    return multiword::add(x, y);
+  });
+  registerMultiWordOp<T, N>(
+      "multiword::mul/FMA",
+      [](const auto &x, const auto &y) { return multiword::mul<true>(x, y); });
+  registerMultiWordOp<T, N>(
+      "multiword::div/FMA",
+      [](const auto &x, const auto &y) { return multiword::div<true>(x, y); });
+}
+
+template <typename T, typename Op>
+void scalarFunction(benchmark::State &state, Op op) {
+  std::vector<two<T>> x = operands<T>(1);
+  std::vector<two<T>> z(n);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) z[i] = op(x[i]);
+    benchmark::DoNotOptimize(z.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+template <typename T, typename Op>
+void batchFunction(benchmark::State &state, Op op) {
+  soa_vector<T> x;
+  for (const two<T> &v : operands<T>(1)) x.push_back(v);
+  soa_vector<T> z(n);
+
+  for (auto _ : state) {
+    op(soa_span<const T>(x), soa_span<T>(z));
+    benchmark::DoNotOptimize(z.h_data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+/// \brief Registers the scalar and batched benchmarks of an elementary
+/// function with and without FMA.
+template <typename T, bool useFMA, typename Scalar, typename Batch>
+void registerFunction(const std::string &name, Scalar scalar, Batch batch) {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  const std::string prefix =
+      name + "/" + type + "/" + (useFMA ? "FMA" : "noFMA") + "/";
+  benchmark::RegisterBenchmark((prefix + "scalar").c_str(),
+                               scalarFunction<T, Scalar>, scalar);
+  benchmark::RegisterBenchmark((prefix + "batch").c_str(),
+                               batchFunction<T, Batch>, batch);
+}
+
+template <typename T, bool useFMA>
+void registerFunctions() {
+  registerFunction<T, useFMA>(
+      "doubleword::sqrt",
+      [](const auto &x) { return doubleword::sqrt<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::sqrt<useFMA>(x, z); });
+  registerFunction<T, useFMA>(
+      "doubleword::exp",
+      [](const auto &x) { return doubleword::exp<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::exp<useFMA>(x, z); });
+  registerFunction<T, useFMA>(
+      "doubleword::log",
+      [](const auto &x) { return doubleword::log<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::log<useFMA>(x, z); });
+  registerFunction<T, useFMA>(
+      "doubleword::sin",
+      [](const auto &x) { return doubleword::sin<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::sin<useFMA>(x, z); });
+  registerFunction<T, useFMA>(
+      "doubleword::cos",
+      [](const auto &x) { return doubleword::cos<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::cos<useFMA>(x, z); });
+  registerFunction<T, useFMA>(
+      "doubleword::tan",
+      [](const auto &x) { return doubleword::tan<useFMA>(x); },
+      [](auto x, auto z) { doubleword::batch::tan<useFMA>(x, z); });
+}
+
+/// \brief Registers the benchmarks of Horner's and Estrin's scheme for a
+/// policy.
+template <typename T, typename Policy>
+void registerPolynomial(const std::string &name) {
+  constexpr const auto &coeffs = doubleword::details::tables<T>::invFactorial;
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  auto horner = [](const auto &x) { return poly::horner<coeffs, Policy>(x); };
+  auto estrin = [](const auto &x) { return poly::estrin<coeffs, Policy>(x); };
+  benchmark::RegisterBenchmark(("poly::horner/" + name + "/" + type).c_str(),
+                               scalarFunction<T, decltype(horner)>, horner);
+  benchmark::RegisterBenchmark(("poly::estrin/" + name + "/" + type).c_str(),
+                               scalarFunction<T, decltype(estrin)>, estrin);
+}
+
+template <typename T>
+void registerPolynomials() {
+  registerPolynomial<T, policy::doubleword<false>>("doubleword/noFMA");
+  registerPolynomial<T, policy::doubleword<true>>("doubleword/FMA");
+  registerPolynomial<T, policy::pair<false>>("pair/noFMA");
+  registerPolynomial<T, policy::pair<true>>("pair/FMA");
+}
+
+/// \brief Multiplies two square matrices of size `state.range(0)` on one
+/// thread.
+template <typename T, typename Policy, bool naive>
+void gemm(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  std::vector<two<T>> a(size * size), b(size * size), c(size * size);
+  std::vector<two<T>> x = operands<T>(1), y = operands<T>(2);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = x[i % n];
+    b[i] = y[(i * 7) % n];
+  }
+
+  for (auto _ : state) {
+    if constexpr (naive) {
+      for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+          two<T> sum;
+          for (std::size_t k = 0; k < size; ++k)
+            sum = Policy::fma(a[i * size + k], b[k * size + j], sum);
+          c[i * size + j] = Policy::normalize(sum);
+        }
+      }
+    } else {
+      blas::gemm<Policy>(size, size, size, a.data(), size, b.data(), size,
+                         c.data(), size, 1);
+    }
+    benchmark::DoNotOptimize(c.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(size * size * size));
+}
+
+/// \brief Calculates `y = a x + y` for vectors of size `state.range(0)`.
+template <typename T, typename Policy, bool naive>
+void axpy(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  std::vector<two<T>> x(size), y(size);
+  std::vector<two<T>> ops = operands<T>(1);
+  for (std::size_t i = 0; i < size; ++i) x[i] = ops[i % n];
+  const two<T> a = ops[0];
+
+  for (auto _ : state) {
+    if constexpr (naive) {
+      for (std::size_t i = 0; i < size; ++i)
+        y[i] = Policy::normalize(Policy::fma(a, x[i], y[i]));
+    } else {
+      blas::axpy<Policy>(a, x, y);
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(size));
+}
+
+/// \brief Multiplies a square matrix of size `state.range(0)` with a vector
+/// on one thread.
+template <typename T, typename Policy, bool naive>
+void gemv(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  std::vector<two<T>> a(size * size), x(size), y(size);
+  std::vector<two<T>> ops = operands<T>(1);
+  for (std::size_t i = 0; i < a.size(); ++i) a[i] = ops[i % n];
+  for (std::size_t i = 0; i < size; ++i) x[i] = ops[(i * 7) % n];
+
+  for (auto _ : state) {
+    if constexpr (naive) {
+      for (std::size_t i = 0; i < size; ++i) {
+        two<T> sum;
+        for (std::size_t j = 0; j < size; ++j)
+          sum = Policy::fma(a[i * size + j], x[j], sum);
+        y[i] = Policy::normalize(sum);
+      }
+    } else {
+      blas::gemv<Policy>(a.data(), size, x, y, 1);
+    }
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(size * size));
+}
+
+template <typename T, typename Policy>
+void registerGemm(const std::string &name) {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  benchmark::RegisterBenchmark(("blas::gemm/" + name + "/" + type).c_str(),
+                               gemm<T, Policy, false>)
+      ->Arg(64)
+      ->Arg(256);
+  benchmark::RegisterBenchmark(
+      ("blas::gemm/" + name + "/" + type + "/naive").c_str(),
+      gemm<T, Policy, true>)
+      ->Arg(64)
+      ->Arg(256);
+  benchmark::RegisterBenchmark(("blas::gemv/" + name + "/" + type).c_str(),
+                               gemv<T, Policy, false>)
+      ->Arg(256);
+  benchmark::RegisterBenchmark(
+      ("blas::gemv/" + name + "/" + type + "/naive").c_str(),
+      gemv<T, Policy, true>)
+      ->Arg(256);
+  benchmark::RegisterBenchmark(("blas::axpy/" + name + "/" + type).c_str(),
+                               axpy<T, Policy, false>)
+      ->Arg(4096);
+  benchmark::RegisterBenchmark(
+      ("blas::axpy/" + name + "/" + type + "/naive").c_str(),
+      axpy<T, Policy, true>)
+      ->Arg(4096);
+}
+
+template <typename T>
+void registerGemms() {
+  registerGemm<T, policy::doubleword<false>>("doubleword/noFMA");
+  registerGemm<T, policy::doubleword<true>>("doubleword/FMA");
+  registerGemm<T, policy::pair<true>>("pair/FMA");
+}
+
+/// \brief Returns the 5-point Laplacian on a grid of `n` x `n` points.
+template <typename E>
+sparse::csr<E> laplacian(std::size_t n) {
+  sparse::csr<E> A;
+  A.rows = A.cols = n * n;
+  A.rowPtr.push_back(0);
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < n; ++j) {
+      auto add = [&](std::size_t col, double value) {
+        A.colIdx.push_back(static_cast<std::uint32_t>(col));
+        A.values.push_back(E(value));
+      };
+      if (i > 0) add((i - 1) * n + j, -1);
+      if (j > 0) add(i * n + j - 1, -1);
+      add(i * n + j, 4);
+      if (j + 1 < n) add(i * n + j + 1, -1);
+      if (i + 1 < n) add((i + 1) * n + j, -1);
+      A.rowPtr.push_back(A.values.size());
+    }
+  }
+  return A;
+}
+
+/// \brief Multiplies the Laplacian on a grid of 512 x 512 points with a vector
+/// on one thread.
+template <typename Matrix, typename E>
+void spmv(benchmark::State &state) {
+  using Policy = policy::doubleword<true>;
+  const Matrix A(laplacian<E>(512));
+  std::vector<two<double>> x(A.cols), y(A.rows);
+  std::vector<two<double>> ops = operands<double>(1);
+  for (std::size_t i = 0; i < x.size(); ++i) x[i] = ops[i % n];
+
+  for (auto _ : state) {
+    sparse::spmv<Policy>(A, x, y, 1);
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(5 * A.rows));
+}
+
+void registerSpmv() {
+  using DW = two<double>;
+  benchmark::RegisterBenchmark("sparse::spmv/csr/doubleword",
+                               spmv<sparse::csr<DW>, DW>);
+  benchmark::RegisterBenchmark("sparse::spmv/sell/doubleword",
+                               spmv<sparse::sell<DW>, DW>);
+  benchmark::RegisterBenchmark("sparse::spmv/csr/mixed",
+                               spmv<sparse::csr<double>, double>);
+  benchmark::RegisterBenchmark("sparse::spmv/sell/mixed",
+                               spmv<sparse::sell<double>, double>);
+}
+
+enum class ComplexMul { Composed, Fused, Batch };
+
+/// \brief Multiplies arrays of complex double-word numbers element-wise.
+template <typename T, ComplexMul variant>
+void complexMul(benchmark::State &state) {
+  using doubleword::Mode;
+  std::vector<two<T>> ops = operands<T>(1);
+  std::vector<complex<T>> x(n), y(n), z(n);
+  soa_vector<T> xRe(n), xIm(n), yRe(n), yIm(n), zRe(n), zIm(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = {ops[i], ops[(i * 3) % n]};
+    y[i] = {ops[(i * 5) % n], ops[(i * 7) % n]};
+    xRe[i] = x[i].re, xIm[i] = x[i].im, yRe[i] = y[i].re, yIm[i] = y[i].im;
+  }
+
+  for (auto _ : state) {
+    if constexpr (variant == ComplexMul::Batch) {
+      doubleword::batch::mul<true, T>(xRe, xIm, yRe, yIm, zRe, zIm);
+      benchmark::DoNotOptimize(zRe.h_data());
+    } else {
+      for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (variant == ComplexMul::Fused) {
+          z[i] = doubleword::mul<true>(x[i], y[i]);
+        } else {
+          const complex<T> &a = x[i], &b = y[i];
+          z[i] = {doubleword::sub<Mode::Accurate>(
+                      doubleword::mul<Mode::Fast, true>(a.re, b.re),
+                      doubleword::mul<Mode::Fast, true>(a.im, b.im)),
+                  doubleword::add<Mode::Accurate>(
+                      doubleword::mul<Mode::Fast, true>(a.re, b.im),
+                      doubleword::mul<Mode::Fast, true>(a.im, b.re))};
+        }
+      }
+      benchmark::DoNotOptimize(z.data());
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(n * state.iterations()));
+}
+
+template <typename T>
+void registerComplex() {
+  const std::string type = std::is_same_v<T, float> ? "float" : "double";
+  benchmark::RegisterBenchmark(("complex::mul/" + type + "/composed").c_str(),
+                               complexMul<T, ComplexMul::Composed>);
+  benchmark::RegisterBenchmark(("complex::mul/" + type + "/fused").c_str(),
+                               complexMul<T, ComplexMul::Fused>);
+  benchmark::RegisterBenchmark(("complex::mul/" + type + "/batch").c_str(),
+                               complexMul<T, ComplexMul::Batch>);
+}
+
+/// \brief The radix-2 Stockham transform of `double` complex vectors, the
+/// reference for the cost of the double-word transform.
+/// \details `c` and `sn` are the cosines and sines of `2 π k / size` for
+/// `k < size / 2`.
+void doubleFft(std::size_t size, const double *c, const double *sn,
+               double *re, double *im, double *bufRe, double *bufIm) {
+  for (std::size_t len = size, s = 1; len >= 2; len /= 2, s *= 2) {
+    const std::size_t m = len / 2;
+    for (std::size_t p = 0; p < m; ++p) {
+      const double wc = c[p * s], ws = sn[p * s];
+      for (std::size_t q = 0; q < s; ++q) {
+        const double ar = re[q + s * p], ai = im[q + s * p];
+        const double br = re[q + s * (p + m)], bi = im[q + s * (p + m)];
+        bufRe[q + s * 2 * p] = ar + br;
+        bufIm[q + s * 2 * p] = ai + bi;
+        const double dr = ar - br, di = ai - bi;
+        bufRe[q + s * (2 * p + 1)] = dr * wc + di * ws;
+        bufIm[q + s * (2 * p + 1)] = di * wc - dr * ws;
+      }
+    }
+    std::swap(re, bufRe);
+    std::swap(im, bufIm);
+  }
+}
+
+/// \brief Transforms a complex vector of size `state.range(0)` on one
+/// thread.
+template <typename T, bool reference>
+void fft(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  std::vector<two<T>> ops = operands<T>(1);
+  soa_vector<T> re(size), im(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    re[i] = ops[i % n];
+    im[i] = ops[(i * 7) % n];
+  }
+  std::vector<double> plain(4 * size), c(size / 2), sn(size / 2);
+  for (std::size_t i = 0; i < size; ++i) {
+    plain[i] = static_cast<double>(ops[i % n].h);
+    plain[size + i] = static_cast<double>(ops[(i * 7) % n].h);
+  }
+  for (std::size_t k = 0; k < size / 2; ++k) {
+    c[k] = std::cos(2 * 3.14159265358979323846 * k / size);
+    sn[k] = std::sin(2 * 3.14159265358979323846 * k / size);
+  }
+  const auto p = fft::plan<T>::get(size);
+
+  for (auto _ : state) {
+    if constexpr (reference) {
+      doubleFft(size, c.data(), sn.data(), plain.data(), plain.data() + size,
+                plain.data() + 2 * size, plain.data() + 3 * size);
+      benchmark::DoNotOptimize(plain.data());
+    } else {
+      p->template forward<policy::doubleword<true>>(re, im, 1);
+      benchmark::DoNotOptimize(re.h_data());
+    }
+    benchmark::ClobberMemory();
+  }
+  std::size_t stages = 0;
+  while ((std::size_t(1) << stages) < size) ++stages;
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(size * stages));
+}
+
+void registerFft() {
+  benchmark::RegisterBenchmark("fft::forward/doubleword/float",
+                               fft<float, false>)
+      ->Arg(1 << 10)
+      ->Arg(1 << 16);
+  benchmark::RegisterBenchmark("fft::forward/doubleword/double",
+                               fft<double, false>)
+      ->Arg(1 << 10)
+      ->Arg(1 << 16);
+  benchmark::RegisterBenchmark("fft::forward/double", fft<double, true>)
+      ->Arg(1 << 10)
+      ->Arg(1 << 16);
+}
+
+/// \brief Parses `n` numbers printed with 32 digits, or with 17 digits by
+/// `std::to_chars` for the reference.
+template <bool reference>
+void fromChars(benchmark::State &state) {
+  const std::vector<two<double>> ops = operands<double>(1);
+  std::vector<std::string> strings(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    char buffer[64];
+    const std::to_chars_result res =
+        reference ? std::to_chars(buffer, buffer + sizeof(buffer), ops[i].h,
+                                  std::chars_format::scientific, 16)
+                  : to_chars(buffer, buffer + sizeof(buffer), ops[i]);
+    strings[i].assign(buffer, res.ptr);
+  }
+  for (auto _ : state) {
+    for (const std::string &s : strings) {
+      if constexpr (reference) {
+        double x;
+        std::from_chars(s.data(), s.data() + s.size(), x);
+        benchmark::DoNotOptimize(x);
+      } else {
+        two<double> x;
+        from_chars(s.data(), s.data() + s.size(), x);
+        benchmark::DoNotOptimize(x);
+      }
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(n));
+}
+
+/// \brief Prints `n` numbers with 32 digits, or with 17 digits by
+/// `std::to_chars` for the reference.
+template <bool reference>
+void toChars(benchmark::State &state) {
+  const std::vector<two<double>> ops = operands<double>(1);
+  char buffer[64];
+  for (auto _ : state) {
+    for (const two<double> &x : ops) {
+      if constexpr (reference)
+        std::to_chars(buffer, buffer + sizeof(buffer), x.h,
+                      std::chars_format::scientific, 16);
+      else
+        to_chars(buffer, buffer + sizeof(buffer), x);
+      benchmark::DoNotOptimize(buffer);
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(n));
+}
+
+void registerCharconv() {
+  benchmark::RegisterBenchmark("from_chars/doubleword", fromChars<false>);
+  benchmark::RegisterBenchmark("from_chars/std", fromChars<true>);
+  benchmark::RegisterBenchmark("to_chars/doubleword", toChars<false>);
+  benchmark::RegisterBenchmark("to_chars/std", toChars<true>);
+}
+
+/// \brief Returns 2^20 random numbers, or products of numbers with few
+/// significant bits if `products` is set.
+soa_vector<double> codecOperands(bool products) {
+  const std::size_t size = std::size_t(1) << 20;
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  soa_vector<double> values(size);
+  for (std::size_t i = 0; i < size; ++i)
+    values[i] = products
+                    ? algorithms::TwoProd(1 + double(i) / double(size),
+                                          3 + double(i % 7) / 8)
+                    : algorithms::FastTwoSum(dist(gen), dist(gen) * 0x1p-52);
+  return values;
+}
+
+template <bool decode>
+void codec(benchmark::State &state) {
+  const soa_vector<double> values = codecOperands(state.range(0) != 0);
+  const soa_span<const double> all(values);
+  const std::vector<std::uint8_t> data = codec::encode(all, 1);
+  soa_vector<double> decoded;
+  for (auto _ : state) {
+    if constexpr (decode) {
+      codec::decode(span<const std::uint8_t>(data), decoded, 1);
+      benchmark::DoNotOptimize(decoded.h_data());
+    } else {
+      benchmark::DoNotOptimize(codec::encode(all, 1).data());
+    }
+    benchmark::ClobberMemory();
+  }
+  const std::size_t bytes = 2 * sizeof(double) * values.size();
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(bytes));
+  state.counters["ratio"] = double(data.size()) / double(bytes);
+}
+
+void registerCodec() {
+  for (const auto &[name, products] :
+       {std::pair<const char *, int>{"random", 0}, {"products", 1}}) {
+    benchmark::RegisterBenchmark(
+        (std::string("codec::encode/") + name).c_str(), codec<false>)
+        ->Arg(products);
+    benchmark::RegisterBenchmark(
+        (std::string("codec::decode/") + name).c_str(), codec<true>)
+        ->Arg(products);
+  }
+}
+
+}  // namespace bench
+}  // namespace twofloat
+
+int main(int argc, char **argv) {
+  using namespace twofloat::bench;
+  registerAlgorithms<float>();
+  registerAlgorithms<double>();
+  registerDoubleWord<float>();
+  registerDoubleWord<double>();
+  registerPair<float>();
+  registerPair<double>();
+  registerQuadWord<float>();
+  registerQuadWord<double>();
+  registerMultiWord<double, 2>();
+  registerMultiWord<double, 3>();
+  registerMultiWord<double, 4>();
+  registerFunctions<float, false>();
+  registerFunctions<float, true>();
+  registerFunctions<double, false>();
+  registerFunctions<double, true>();
+  registerPolynomials<float>();
+  registerPolynomials<double>();
+  registerGemms<float>();
+  registerGemms<double>();
+  registerSpmv();
+  registerComplex<float>();
+  registerComplex<double>();
+  registerFft();
+  registerCharconv();
+  registerCodec();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
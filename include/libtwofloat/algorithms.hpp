@@ -3,7 +3,9 @@
 /// \file algorithms.hpp
 /// \brief Implements commonly used algorithms of all arithmetics.
 
+#include <cmath>
 #include <libtwofloat/twofloat.hpp>
+#include <type_traits>
 
 namespace twofloat {
 
@@ -18,7 +20,7 @@ namespace algorithms {
 /// \param b The second summand.
 /// \return The sum of a and b and its error.
 template <typename T>
-inline two<T> FastTwoSum(T a, T b) {
+constexpr two<T> FastTwoSum(T a, T b) {
   two<T> res;
   res.h = a + b;
   T z = res.h - a;
@@ -33,7 +35,7 @@ inline two<T> FastTwoSum(T a, T b) {
 /// \param b The subtrahend.
 /// \return The difference of a and b and its error.
 template <typename T>
-inline two<T> FastTwoDiff(T a, T b) {
+constexpr two<T> FastTwoDiff(T a, T b) {
   two<T> res;
   res.h = a - b;
   T z = a - res.h;
@@ -49,7 +51,7 @@ inline two<T> FastTwoDiff(T a, T b) {
 /// \param b The second summand.
 /// \return The sum of a and b and its error .
 template <typename T>
-inline two<T> TwoSum(T a, T b) {
+constexpr two<T> TwoSum(T a, T b) {
   two<T> res;
   res.h = a + b;
   T a1 = res.h - b;
@@ -66,7 +68,7 @@ inline two<T> TwoSum(T a, T b) {
 /// \param b The subtrahend.
 /// \return The difference of a and b and its error .
 template <typename T>
-inline two<T> TwoDiff(T a, T b) {
+constexpr two<T> TwoDiff(T a, T b) {
   two<T> res;
   res.h = a - b;
   T a1 = res.h - a;
@@ -79,23 +81,45 @@ inline two<T> TwoDiff(T a, T b) {
 
 /// \brief Splits a floating point number into the sum of a large and a small
 /// floating point number (Veltkamp 1968). Taken from Boldo 2006.
+/// \details For vectors, both branches are evaluated and the lanes that need
+/// scaling are selected afterwards.
 template <typename T>
-inline two<T> Split(T x) {
-  if (abs(x) > constants<T>::SplitScaleThreshold) [[unlikely]] {
+constexpr two<T> Split(T x) {
+  using C = constants<scalar_type_t<T>>;
+  if constexpr (is_simd_v<T>) {
+    // Scaled down version to avoid overflows
+    T xs = x * C::SplitScaleDownFactor;
+    T ps = xs * C::SplitC;
+    T qs = xs - ps;
+    T x1s = ps + qs;
+    T x2s = xs - x1s;
+    x1s *= C::SplitScaleUpFactor;
+    x2s *= C::SplitScaleUpFactor;
+
+    // Unscaled version
+    T p = x * C::SplitC;
+    T q = x - p;
+    T x1 = p + q;
+    T x2 = x - x1;
+
+    const T threshold = C::SplitScaleThreshold;
+    return {select_gt(abs(x), threshold, x1s, x1),
+            select_gt(abs(x), threshold, x2s, x2)};
+  } else if (x > C::SplitScaleThreshold || x < -C::SplitScaleThreshold)
+      [[unlikely]] {
     // Scale down the number to avoid overflows
-    x *= constants<T>::SplitScaleDownFactor;
+    x *= C::SplitScaleDownFactor;
 
-    T p = x * constants<T>::SplitC;
+    T p = x * C::SplitC;
     T q = x - p;
     T x1 = p + q;
     T x2 = x - x1;
 
     // Scale the numbers back up
-    return {x1 * constants<T>::SplitScaleUpFactor,
-            x2 * constants<T>::SplitScaleUpFactor};
+    return {x1 * C::SplitScaleUpFactor, x2 * C::SplitScaleUpFactor};
   } else {
     // It is safe to split the number without scaling
-    T p = x * constants<T>::SplitC;
+    T p = x * C::SplitC;
     T q = x - p;
     T x1 = p + q;
     T x2 = x - x1;
@@ -103,16 +127,68 @@ inline two<T> Split(T x) {
   }
 }
 
+namespace details {
+/// \brief Returns whether the call is evaluated in a constant expression,
+/// like `std::is_constant_evaluated` in C++20.
+constexpr bool isConstantEvaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+  return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+  return __builtin_is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+
+/// \brief Calculates the product of two floating point numbers and its error
+/// without FMA (Dekker 1971), see `TwoProd`.
+template <typename T>
+constexpr two<T> dekkerProd(T a, T b) {
+  two<T> res;
+  res.h = a * b;
+
+  two<T> a1 = Split(a);
+  two<T> b1 = Split(b);
+
+  res.l = ((a1.h * b1.h - res.h) + a1.h * b1.l + a1.l * b1.h) + a1.l * b1.l;
+  return res;
+}
+
+/// \brief Calculates `a*b+c` in a constant expression, where `std::fma` is not
+/// available.
+/// \details The exact product is added to `c` with error-free
+/// transformations, and the exact sum `u.h + u.l + t.l` is rounded once more
+/// at the end. The result is exact if it is representable, in particular the
+/// error of a product in `Fast2Prod`. Otherwise, this double rounding can in
+/// rare cases give a different result than a correctly rounded FMA.
+template <typename T>
+constexpr T constantFma(T a, T b, T c) {
+  two<T> p = dekkerProd(a, b);
+  two<T> s = TwoSum(p.h, c);
+  two<T> t = TwoSum(s.l, p.l);
+  two<T> u = TwoSum(s.h, t.h);
+  return u.h + (u.l + t.l);
+}
+}  // namespace details
+
 /// \brief Calculates `a*b+c` with infinite precision of the intermediate
 /// result.
+/// \details In constant expressions, the result is calculated with
+/// `details::constantFma`.
 template <typename T>
-inline T fma(T a, T b, T c) {
+constexpr T fma(T a, T b, T c) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (details::isConstantEvaluated()) return details::constantFma(a, b, c);
+  }
+
   if constexpr (std::is_same_v<T, float>)
     return std::fmaf(a, b, c);
   else if constexpr (std::is_same_v<T, double>)
     return std::fma(a, b, c);
   else if constexpr (std::is_same_v<T, long double>)
     return std::fmal(a, b, c);
+  else if constexpr (is_simd_v<T>)
+    return twofloat::fma(a, b, c);
   else
     static_assert(sizeof(T) == 0, "fma not (yet?) implemented for this type");
 }
@@ -127,7 +203,7 @@ inline T fma(T a, T b, T c) {
 /// \param b The second factor.
 /// \return The product of a and b and its error.
 template <typename T>
-inline two<T> Fast2Prod(T a, T b) {
+constexpr two<T> Fast2Prod(T a, T b) {
   two<T> res;
   res.h = a * b;
   res.l = fma(a, b, -res.h);
@@ -141,17 +217,11 @@ inline two<T> Fast2Prod(T a, T b) {
 /// \param b The second factor.
 /// \return The product of a and b and its error.
 template <typename T, bool useFMA = false>
-inline two<T> TwoProd(T a, T b) {
-  if constexpr (useFMA) return Fast2Prod(a, b);
-
-  two<T> res;
-  res.h = a * b;
-
-  two<T> a1 = Split(a);
-  two<T> b1 = Split(b);
-
-  res.l = ((a1.h * b1.h - res.h) + a1.h * b1.l + a1.l * b1.h) + a1.l * b1.l;
-  return res;
+constexpr two<T> TwoProd(T a, T b) {
+  if constexpr (useFMA)
+    return Fast2Prod(a, b);
+  else
+    return details::dekkerProd(a, b);
 }
 }  // namespace algorithms
 }  // namespace twofloat
\ No newline at end of file
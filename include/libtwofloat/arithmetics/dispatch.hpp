@@ -0,0 +1,212 @@
+#pragma once
+
+/// \file dispatch.hpp
+/// \brief Implements versions of the operations that select the FMA or
+/// non-FMA algorithm at runtime.
+/// \details The operations of the double-word and pair arithmetic select the
+/// FMA or non-FMA algorithm with the template parameter `useFMA`. Choosing the
+/// FMA algorithm on a CPU without FMA instructions is slow, because `std::fma`
+/// is emulated in software. The overloads in this file omit `useFMA` and check
+/// once at runtime whether the CPU supports FMA instructions (see cpu.hpp).
+/// The FMA algorithms are compiled with FMA instructions even if the compiler
+/// flags do not enable them, so a single binary runs at full speed on CPUs
+/// with and without FMA.
+///
+/// The check costs a predictable branch per call. In hot loops, prefer the
+/// batched operations in double-word-batch.hpp, which check once per array.
+
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/cpu.hpp>
+
+namespace twofloat {
+namespace doubleword {
+namespace details {
+template <Mode p, typename T>
+TWOFLOAT_TARGET_FMA two<T> mulFMA(const two<T> &x, const two<T> &y) {
+  return mul<p, true>(x, y);
+}
+
+template <Mode p, typename T>
+TWOFLOAT_TARGET_FMA two<T> mulFMA(const two<T> &x, T y) {
+  return mul<p, true>(x, y);
+}
+
+template <Mode mode, typename T>
+TWOFLOAT_TARGET_FMA two<T> divFMA(const two<T> &x, const two<T> &y) {
+  return div<mode, true>(x, y);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> divFMA(const two<T> &x, T y) {
+  return div<true>(x, y);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> sqrtFMA(const two<T> &x) {
+  return sqrt<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> expFMA(const two<T> &x) {
+  return exp<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> logFMA(const two<T> &x) {
+  return log<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA void sincosFMA(const two<T> &x, two<T> &s, two<T> &c) {
+  sincos<true>(x, s, c);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> sinFMA(const two<T> &x) {
+  return sin<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> cosFMA(const two<T> &x) {
+  return cos<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> tanFMA(const two<T> &x) {
+  return tan<true>(x);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> atan2FMA(const two<T> &y, const two<T> &x) {
+  return atan2<true>(y, x);
+}
+}  // namespace details
+
+/// \brief Multiplies two double-word floating point numbers using the FMA
+/// algorithm if the CPU supports FMA instructions.
+/// \details Without FMA, the fast mode is used for both modes, because no
+/// accurate non-FMA algorithm is implemented.
+/// \tparam p The mode (fast or accurate) used when FMA is available.
+template <Mode p, typename T>
+inline two<T> mul(const two<T> &x, const two<T> &y) {
+  if (cpu::hasFMA()) return details::mulFMA<p>(x, y);
+  return mul<Mode::Fast, false>(x, y);
+}
+
+/// \brief Multiplies a double-word floating point number with a floating
+/// point number using the FMA algorithm if the CPU supports FMA instructions.
+/// \tparam p The mode (fast or accurate) used without FMA.
+template <Mode p, typename T>
+inline two<T> mul(const two<T> &x, T y) {
+  if (cpu::hasFMA()) return details::mulFMA<p>(x, y);
+  return mul<p, false>(x, y);
+}
+template <Mode p, typename T>
+inline two<T> mul(T x, const two<T> &y) {
+  return mul<p>(y, x);
+}
+
+/// \brief Divides two double-word floating point numbers using the FMA
+/// algorithm if the CPU supports FMA instructions.
+/// \details Without FMA, the fast mode is used for both modes, because the
+/// accurate algorithm requires FMA.
+/// \tparam mode The mode (fast or accurate) used when FMA is available.
+template <Mode mode, typename T>
+inline two<T> div(const two<T> &x, const two<T> &y) {
+  if (cpu::hasFMA()) return details::divFMA<mode>(x, y);
+  return div<Mode::Fast, false>(x, y);
+}
+
+/// \brief Divides a double-word floating point number by a floating point
+/// number using the FMA algorithm if the CPU supports FMA instructions.
+template <typename T>
+inline two<T> div(const two<T> &x, T y) {
+  if (cpu::hasFMA()) return details::divFMA(x, y);
+  return div<false>(x, y);
+}
+
+/// \brief Calculates the square root of a double-word floating point number
+/// using FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> sqrt(const two<T> &x) {
+  if (cpu::hasFMA()) return details::sqrtFMA(x);
+  return sqrt<false>(x);
+}
+
+/// \brief Calculates the exponential function of a double-word floating point
+/// number using FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> exp(const two<T> &x) {
+  if (cpu::hasFMA()) return details::expFMA(x);
+  return exp<false>(x);
+}
+
+/// \brief Calculates the natural logarithm of a double-word floating point
+/// number using FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> log(const two<T> &x) {
+  if (cpu::hasFMA()) return details::logFMA(x);
+  return log<false>(x);
+}
+
+/// \brief Calculates the sine and cosine of a double-word floating point
+/// number using FMA instructions if the CPU supports them.
+template <typename T>
+inline void sincos(const two<T> &x, two<T> &s, two<T> &c) {
+  if (cpu::hasFMA()) return details::sincosFMA(x, s, c);
+  sincos<false>(x, s, c);
+}
+
+/// \brief Calculates the sine of a double-word floating point number using
+/// FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> sin(const two<T> &x) {
+  if (cpu::hasFMA()) return details::sinFMA(x);
+  return sin<false>(x);
+}
+
+/// \brief Calculates the cosine of a double-word floating point number using
+/// FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> cos(const two<T> &x) {
+  if (cpu::hasFMA()) return details::cosFMA(x);
+  return cos<false>(x);
+}
+
+/// \brief Calculates the tangent of a double-word floating point number using
+/// FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> tan(const two<T> &x) {
+  if (cpu::hasFMA()) return details::tanFMA(x);
+  return tan<false>(x);
+}
+
+/// \brief Calculates the angle of the point (x, y) in double-word precision
+/// using FMA instructions if the CPU supports them.
+template <typename T>
+inline two<T> atan2(const two<T> &y, const two<T> &x) {
+  if (cpu::hasFMA()) return details::atan2FMA(y, x);
+  return atan2<false>(y, x);
+}
+}  // namespace doubleword
+
+namespace pair {
+namespace details {
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> mulFMA(const two<T> &x, const two<T> &y) {
+  return mul<true>(x, y);
+}
+}  // namespace details
+
+/// \brief Multiplies two pairwise floating point numbers using the FMA
+/// algorithm if the CPU supports FMA instructions.
+template <typename T>
+inline two<T> mul(const two<T> &x, const two<T> &y) {
+  if (cpu::hasFMA()) return details::mulFMA(x, y);
+  return mul<false>(x, y);
+}
+}  // namespace pair
+}  // namespace twofloat
@@ -0,0 +1,521 @@
+#pragma once
+
+/// \file double-word-batch.hpp
+/// \brief Implements batched versions of the double-word arithmetic and
+/// elementary functions that operate on whole arrays of double-word numbers.
+
+#include <cstddef>
+#include <cstring>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/details/x86-vectors.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <stdexcept>
+#include <type_traits>
+
+namespace twofloat {
+namespace details {
+#if defined(TWOFLOAT_HAS_AVX2)
+TWOFLOAT_BEGIN_TARGET_AVX2
+namespace avx2 {
+#include <libtwofloat/details/double-word-vector-inl.hpp>
+}  // namespace avx2
+TWOFLOAT_END_TARGET
+#endif
+
+#if defined(TWOFLOAT_HAS_AVX512)
+TWOFLOAT_BEGIN_TARGET_AVX512
+namespace avx512 {
+#include <libtwofloat/details/double-word-vector-inl.hpp>
+}  // namespace avx512
+TWOFLOAT_END_TARGET
+#endif
+
+/// \brief Whether batched operations on numbers of type T are vectorized.
+template <typename T>
+inline constexpr bool is_vectorized =
+    std::is_same_v<T, double> || std::is_same_v<T, float>;
+
+/// \brief Calls `kernel` with the batched kernels of the widest instruction
+/// set supported by the CPU and returns the number of processed elements.
+/// Returns 0 if no vectorized implementation is available.
+template <typename T, typename Kernel>
+inline std::size_t dispatchBatch(Kernel kernel) {
+  if constexpr (is_vectorized<T>) {
+    switch (cpu::instructionSet()) {
+#if defined(TWOFLOAT_HAS_AVX512)
+      case cpu::InstructionSet::AVX512:
+        return kernel(avx512::batch());
+#endif
+#if defined(TWOFLOAT_HAS_AVX2)
+      case cpu::InstructionSet::AVX2:
+        return kernel(avx2::batch());
+#endif
+      default:
+        break;
+    }
+  }
+  return 0;
+}
+
+/// \brief Throws `std::invalid_argument` unless the containers `x` and `y`
+/// have the same size.
+template <typename T>
+inline void checkSizes(const soa_vector<T> &x, const soa_vector<T> &y) {
+  if (x.size() != y.size())
+    throw std::invalid_argument(
+        "doubleword::batch: x and y have different sizes");
+}
+}  // namespace details
+
+namespace doubleword {
+
+/// \brief Batched versions of the double-word operations.
+/// \details Each operation applies the corresponding scalar operation of the
+/// `doubleword` namespace element-wise to arrays that are stored as structure
+/// of arrays (see `soa_vector`). If the CPU supports AVX2 (with FMA) or
+/// AVX-512, 4 / 8 (AVX2) or 8 / 16 (AVX-512) double / float numbers are
+/// processed at once. The instruction set is selected at runtime (see
+/// cpu.hpp), so the compiler flags do not need to enable it. The remaining
+/// elements are processed by the scalar operations. The vectorized algorithms
+/// perform exactly the same floating point operations as the scalar ones, so
+/// the results are bitwise identical to calling the scalar operation for each
+/// element.
+///
+/// All operations process `z.size()` elements, i.e. `x` and `y` must hold at
+/// least as many numbers as `z`. The output may alias the inputs. The table
+/// lookups of the elementary functions and the Payne-Hanek reduction of large
+/// arguments of the trigonometric functions are performed lane by lane, the
+/// remaining operations are vectorized.
+namespace batch {
+
+/// \brief Adds two arrays of double-word numbers element-wise.
+/// \details See `doubleword::add` for the supported modes.
+/// \param x The first summands.
+/// \param y The second summands.
+/// \param z The array receiving the sums.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void add(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template add<mode>(x.h_data(), x.l_data(), y.h_data(),
+                                      y.l_data(), z.h_data(), z.l_data(),
+                                      z.size());
+  });
+  for (; i < z.size(); ++i)
+    z[i] = doubleword::add<mode>(two<T>(x[i]), two<T>(y[i]));
+}
+
+/// \brief Subtracts two arrays of double-word numbers element-wise.
+/// \details See `doubleword::sub` for the supported modes.
+/// \param x The minuends.
+/// \param y The subtrahends.
+/// \param z The array receiving the differences.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void sub(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template sub<mode>(x.h_data(), x.l_data(), y.h_data(),
+                                      y.l_data(), z.h_data(), z.l_data(),
+                                      z.size());
+  });
+  for (; i < z.size(); ++i)
+    z[i] = doubleword::sub<mode>(two<T>(x[i]), two<T>(y[i]));
+}
+
+/// \brief Multiplies two arrays of double-word numbers element-wise.
+/// \details See `doubleword::mul` for the supported modes.
+/// \param x The first factors.
+/// \param y The second factors.
+/// \param z The array receiving the products.
+/// \tparam p The mode (fast or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode p, bool useFMA, typename T>
+inline void mul(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template mul<p, useFMA>(x.h_data(), x.l_data(), y.h_data(),
+                                           y.l_data(), z.h_data(), z.l_data(),
+                                           z.size());
+  });
+  for (; i < z.size(); ++i)
+    z[i] = doubleword::mul<p, useFMA>(two<T>(x[i]), two<T>(y[i]));
+}
+
+/// \brief Divides two arrays of double-word numbers element-wise.
+/// \details See `doubleword::div` for the supported modes.
+/// \param x The dividends.
+/// \param y The divisors.
+/// \param z The array receiving the quotients.
+/// \tparam mode The mode (fast or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode mode, bool useFMA, typename T>
+inline void div(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  static_assert(mode == Mode::Fast || useFMA,
+                "Only fast mode is supported without FMA");
+
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template div<mode, useFMA>(x.h_data(), x.l_data(),
+                                              y.h_data(), y.l_data(),
+                                              z.h_data(), z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i)
+    z[i] = doubleword::div<mode, useFMA>(two<T>(x[i]), two<T>(y[i]));
+}
+
+/// \brief Calculates the square roots of an array of double-word numbers.
+/// \details See `doubleword::sqrt`.
+/// \param x The radicands.
+/// \param z The array receiving the square roots.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void sqrt(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template sqrt<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                         z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::sqrt<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Calculates the exponential function of an array of double-word
+/// numbers.
+/// \details See `doubleword::exp`.
+/// \param x The arguments.
+/// \param z The array receiving the results.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void exp(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template exp<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                        z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::exp<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Calculates the natural logarithm of an array of double-word
+/// numbers.
+/// \details See `doubleword::log`.
+/// \param x The arguments.
+/// \param z The array receiving the results.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void log(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template log<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                        z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::log<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Calculates the sine of an array of double-word numbers.
+/// \details See `doubleword::sin`.
+/// \param x The arguments.
+/// \param z The array receiving the results.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void sin(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template sin<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                        z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::sin<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Calculates the cosine of an array of double-word numbers.
+/// \details See `doubleword::cos`.
+/// \param x The arguments.
+/// \param z The array receiving the results.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void cos(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template cos<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                        z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::cos<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Calculates the tangent of an array of double-word numbers.
+/// \details See `doubleword::tan`.
+/// \param x The arguments.
+/// \param z The array receiving the results.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void tan(soa_span<const T> x, soa_span<T> z) {
+  std::size_t i = twofloat::details::dispatchBatch<T>([&](auto kernels) {
+    return kernels.template tan<useFMA>(x.h_data(), x.l_data(), z.h_data(),
+                                        z.l_data(), z.size());
+  });
+  for (; i < z.size(); ++i) z[i] = doubleword::tan<useFMA>(two<T>(x[i]));
+}
+
+/// \brief Multiplies two arrays of double-word numbers element-wise and
+/// selects the FMA or non-FMA algorithm at runtime, depending on whether the
+/// CPU supports FMA instructions.
+/// \details Without FMA, the fast mode is used for both modes, because no
+/// accurate non-FMA algorithm is implemented.
+/// \param x The first factors.
+/// \param y The second factors.
+/// \param z The array receiving the products.
+/// \tparam p The mode (fast or accurate) used when FMA is available.
+template <Mode p, typename T>
+inline void mul(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  if (cpu::hasFMA())
+    mul<p, true, T>(x, y, z);
+  else
+    mul<Mode::Fast, false, T>(x, y, z);
+}
+
+/// \brief Divides two arrays of double-word numbers element-wise and selects
+/// the FMA or non-FMA algorithm at runtime, depending on whether the CPU
+/// supports FMA instructions.
+/// \details Without FMA, the fast mode is used for both modes, because the
+/// accurate algorithm requires FMA.
+/// \param x The dividends.
+/// \param y The divisors.
+/// \param z The array receiving the quotients.
+/// \tparam mode The mode (fast or accurate) used when FMA is available.
+template <Mode mode, typename T>
+inline void div(soa_span<const T> x, soa_span<const T> y, soa_span<T> z) {
+  if (cpu::hasFMA())
+    div<mode, true, T>(x, y, z);
+  else
+    div<Mode::Fast, false, T>(x, y, z);
+}
+
+/// \brief Calculates the square roots of an array of double-word numbers and
+/// selects the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void sqrt(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    sqrt<true, T>(x, z);
+  else
+    sqrt<false, T>(x, z);
+}
+
+/// \brief Calculates the exponential function of an array of double-word
+/// numbers and selects the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void exp(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    exp<true, T>(x, z);
+  else
+    exp<false, T>(x, z);
+}
+
+/// \brief Calculates the natural logarithm of an array of double-word
+/// numbers and selects the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void log(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    log<true, T>(x, z);
+  else
+    log<false, T>(x, z);
+}
+
+/// \brief Calculates the sine of an array of double-word numbers and selects
+/// the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void sin(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    sin<true, T>(x, z);
+  else
+    sin<false, T>(x, z);
+}
+
+/// \brief Calculates the cosine of an array of double-word numbers and selects
+/// the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void cos(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    cos<true, T>(x, z);
+  else
+    cos<false, T>(x, z);
+}
+
+/// \brief Calculates the tangent of an array of double-word numbers and selects
+/// the FMA or non-FMA algorithm at runtime.
+template <typename T>
+inline void tan(soa_span<const T> x, soa_span<T> z) {
+  if (cpu::hasFMA())
+    tan<true, T>(x, z);
+  else
+    tan<false, T>(x, z);
+}
+
+/// \brief Adds two containers of double-word numbers element-wise. `z` is
+/// resized to the size of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode mode, typename T>
+inline void add(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  add<mode, T>(soa_span<const T>(x), soa_span<const T>(y), soa_span<T>(z));
+}
+
+/// \brief Subtracts two containers of double-word numbers element-wise. `z`
+/// is resized to the size of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode mode, typename T>
+inline void sub(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  sub<mode, T>(soa_span<const T>(x), soa_span<const T>(y), soa_span<T>(z));
+}
+
+/// \brief Multiplies two containers of double-word numbers element-wise. `z`
+/// is resized to the size of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode p, bool useFMA, typename T>
+inline void mul(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  mul<p, useFMA, T>(soa_span<const T>(x), soa_span<const T>(y),
+                    soa_span<T>(z));
+}
+
+/// \brief Divides two containers of double-word numbers element-wise. `z` is
+/// resized to the size of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode mode, bool useFMA, typename T>
+inline void div(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  div<mode, useFMA, T>(soa_span<const T>(x), soa_span<const T>(y),
+                       soa_span<T>(z));
+}
+
+/// \brief Multiplies two containers of double-word numbers element-wise and
+/// selects the FMA or non-FMA algorithm at runtime. `z` is resized to the size
+/// of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode p, typename T>
+inline void mul(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  mul<p, T>(soa_span<const T>(x), soa_span<const T>(y), soa_span<T>(z));
+}
+
+/// \brief Divides two containers of double-word numbers element-wise and
+/// selects the FMA or non-FMA algorithm at runtime. `z` is resized to the size
+/// of `x`.
+/// \throws std::invalid_argument if `x` and `y` have different sizes.
+template <Mode mode, typename T>
+inline void div(const soa_vector<T> &x, const soa_vector<T> &y,
+                soa_vector<T> &z) {
+  twofloat::details::checkSizes(x, y);
+  z.resize(x.size());
+  div<mode, T>(soa_span<const T>(x), soa_span<const T>(y), soa_span<T>(z));
+}
+
+/// \brief Calculates the square roots of a container of double-word numbers.
+/// `z` is resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void sqrt(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  sqrt<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the exponential function of a container of double-word
+/// numbers. `z` is resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void exp(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  exp<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the natural logarithm of a container of double-word
+/// numbers. `z` is resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void log(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  log<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the sine of a container of double-word numbers. `z` is
+/// resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void sin(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  sin<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the cosine of a container of double-word numbers. `z` is
+/// resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void cos(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  cos<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the tangent of a container of double-word numbers. `z` is
+/// resized to the size of `x`.
+template <bool useFMA, typename T>
+inline void tan(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  tan<useFMA, T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the square roots of a container of double-word numbers
+/// and selects the FMA or non-FMA algorithm at runtime. `z` is resized to the
+/// size of `x`.
+template <typename T>
+inline void sqrt(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  sqrt<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the exponential function of a container of double-word
+/// numbers and selects the FMA or non-FMA algorithm at runtime. `z` is
+/// resized to the size of `x`.
+template <typename T>
+inline void exp(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  exp<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the natural logarithm of a container of double-word
+/// numbers and selects the FMA or non-FMA algorithm at runtime. `z` is
+/// resized to the size of `x`.
+template <typename T>
+inline void log(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  log<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the sine of a container of double-word numbers and
+/// selects the FMA or non-FMA algorithm at runtime. `z` is resized to the
+/// size of `x`.
+template <typename T>
+inline void sin(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  sin<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the cosine of a container of double-word numbers and
+/// selects the FMA or non-FMA algorithm at runtime. `z` is resized to the
+/// size of `x`.
+template <typename T>
+inline void cos(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  cos<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+/// \brief Calculates the tangent of a container of double-word numbers and
+/// selects the FMA or non-FMA algorithm at runtime. `z` is resized to the
+/// size of `x`.
+template <typename T>
+inline void tan(const soa_vector<T> &x, soa_vector<T> &z) {
+  z.resize(x.size());
+  tan<T>(soa_span<const T>(x), soa_span<T>(z));
+}
+
+}  // namespace batch
+}  // namespace doubleword
+}  // namespace twofloat
@@ -0,0 +1,228 @@
+#pragma once
+
+/// \file double-word-functions.hpp
+/// \brief Implements the exponential function and the natural logarithm of
+/// double-word floating point numbers.
+/// \details Both functions reduce the argument with a table of 64 double-word
+/// values, so that short polynomials suffice. They only use the double-word
+/// arithmetic and `twofloat::lanewise` for the table lookups and scaling, so
+/// they also work for vectors (`two<simd<T, N>>`).
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/details/double-word-tables.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <type_traits>
+
+namespace twofloat {
+namespace doubleword {
+namespace details {
+
+/// \brief The degree of the Taylor polynomial of exp(r), |r| <= log(2)/128.
+template <typename S>
+inline constexpr int expDegree = std::is_same_v<S, float> ? 5 : 10;
+
+/// \brief The degree from which the Taylor coefficients of exp are evaluated
+/// in working precision, because their terms are smaller than u.
+template <typename S>
+inline constexpr int expWorkingDegree = std::is_same_v<S, float> ? 3 : 6;
+
+/// \brief The arguments beyond which exp overflows or underflows. The
+/// reduction clamps the arguments to this range.
+template <typename S>
+inline constexpr S expBound = std::is_same_v<S, float> ? 110 : 750;
+
+/// \brief The degree in z² of the series of atanh(z)/z, |z| <= 1/178.
+template <typename S>
+inline constexpr int logDegree = std::is_same_v<S, float> ? 3 : 6;
+
+/// \brief The degree from which the coefficients of atanh(z)/z are evaluated
+/// in working precision.
+template <typename S>
+inline constexpr int logWorkingDegree = std::is_same_v<S, float> ? 2 : 4;
+
+template <typename T, typename S>
+inline two<T> constant(const S (&c)[2]) {
+  return two<T>(T(c[0]), T(c[1]));
+}
+
+/// \brief Multiplies two double-word numbers with the most accurate algorithm
+/// that is available with or without FMA.
+template <bool useFMA, typename T>
+inline two<T> mulDW(const two<T> &x, const two<T> &y) {
+  if constexpr (useFMA)
+    return mul<Mode::Accurate, true>(x, y);
+  else
+    return mul<Mode::Fast, false>(x, y);
+}
+
+/// \brief Evaluates the polynomial with the double-word coefficients `c` and
+/// degree `N` at `x` with Horner's scheme.
+/// \details The coefficients of degree `K` and higher only contribute below
+/// the working precision and are evaluated with floating point operations.
+/// The terms decrease quickly and do not cancel, so the sloppy addition is
+/// accurate and shortens the dependency chain.
+template <bool useFMA, int K, int N, typename T, typename S>
+inline two<T> horner(const two<T> &x, const S (*c)[2]) {
+  T p = c[N][0];
+  for (int k = N - 1; k >= K; --k) p = p * x.h + c[k][0];
+
+  two<T> res(p);
+  for (int k = K - 1; k >= 0; --k)
+    res = add<Mode::Sloppy>(mulDW<useFMA>(res, x), constant<T>(c[k]));
+  return res;
+}
+
+/// \brief Returns 2^e for exponents e in the range of normal numbers.
+template <typename S>
+inline S pow2(int e) {
+  using I = std::conditional_t<sizeof(S) == 8, std::uint64_t, std::uint32_t>;
+  constexpr int bias = std::numeric_limits<S>::max_exponent - 1;
+  constexpr int shift = std::numeric_limits<S>::digits - 1;
+  I bits = static_cast<I>(e + bias) << shift;
+  S res;
+  std::memcpy(&res, &bits, sizeof(S));
+  return res;
+}
+
+/// \brief Multiplies a double-word number by 2^e, where the lanes of `e` hold
+/// integers whose magnitude is less than twice the maximum exponent.
+/// \details Unlike `std::ldexp`, this only needs multiplications. The factor
+/// is split into two powers of two, so that neither overflows and results in
+/// the subnormal range are rounded only once.
+template <typename T>
+inline two<T> scale(const two<T> &x, const T &e) {
+  using S = scalar_type_t<T>;
+  T s1 = lanewise([](S e) { return pow2<S>(static_cast<int>(e) / 2); }, e);
+  T s2 = lanewise(
+      [](S e) {
+        int k = static_cast<int>(e);
+        return pow2<S>(k - k / 2);
+      },
+      e);
+  return {x.h * s1 * s2, x.l * s1 * s2};
+}
+
+/// \brief Looks up the double-word table entries `table[i - offset]`, where
+/// the lanes of `i` hold integers.
+template <typename T, int offset, typename S, std::size_t size>
+inline two<T> lookup(const S (&table)[size][2], const T &i) {
+  auto index = [](S i) { return static_cast<int>(i) - offset; };
+  return {lanewise([&](S i) { return table[index(i)][0]; }, i),
+          lanewise([&](S i) { return table[index(i)][1]; }, i)};
+}
+}  // namespace details
+
+/// \brief Calculates the exponential function of a double-word floating point
+/// number.
+/// \details The argument is reduced to `x = (64k + j) log(2)/64 + r` with
+/// |r| <= log(2)/128 (Tang 1989), where log(2)/64 is subtracted in parts so
+/// that the products with `64k + j` are exact (Cody and Waite 1980). Then
+/// `exp(x) = 2^k 2^(j/64) exp(r)`, where 2^(j/64) is taken from a table and
+/// exp(r) is evaluated with its Taylor polynomial. The relative error is a
+/// small multiple of u² plus the error caused by the condition number |x|.
+/// \param x The double-word floating point number.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> exp(const two<T> &x) {
+  using S = scalar_type_t<T>;
+  using C = details::tables<S>;
+  constexpr S bound = details::expBound<S>;
+
+  T n = lanewise(
+      [](S h) {
+        if (!(h > -bound)) return std::isnan(h) ? 0 : -bound * C::expInvL;
+        if (h > bound) h = bound;
+        return std::nearbyint(h * C::expInvL);
+      },
+      x.h);
+  two<T> r = x;
+  for (S part : C::expL) r = sub(r, n * part);
+
+  two<T> p = details::horner<useFMA, details::expWorkingDegree<S>,
+                             details::expDegree<S>>(r, C::invFactorial);
+  T j = lanewise([](S n) { return n - 64 * std::floor(n / 64); }, n);
+  two<T> res = details::mulDW<useFMA>(details::lookup<T, 0>(C::exp2, j), p);
+  res = details::scale(res, (n - j) * S(1.0 / 64));
+
+  // Overflow, underflow and NaN
+  res.h = lanewise(
+      [](S h, S xh) {
+        if (xh >= bound) return std::numeric_limits<S>::infinity();
+        return xh <= -bound ? S(0) : h;
+      },
+      res.h, x.h);
+  res.l = lanewise(
+      [](S l, S h) { return std::isfinite(h) && h != 0 ? l : S(0); }, res.l,
+      res.h);
+  return res;
+}
+
+/// \brief Calculates the natural logarithm of a double-word floating point
+/// number.
+/// \details The argument is reduced to `x = 2^e m` with m in [√½, √2) and
+/// m is divided by the nearest `c = j/64`, so that `log(x) = e log(2) +
+/// log(c) + 2 atanh(z)` with `z = (m - c)/(m + c)` and |z| <= 1/178 (Tang
+/// 1990).
+/// log(c) is taken from a table and atanh(z) is evaluated with its Taylor
+/// series. The relative error is a small multiple of u².
+/// \param x The double-word floating point number.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> log(const two<T> &x) {
+  using S = scalar_type_t<T>;
+  using C = details::tables<S>;
+  constexpr S inf = std::numeric_limits<S>::infinity();
+
+  T e = lanewise(
+      [](S h) {
+        if (!(h > 0) || h == inf) return S(0);
+        int e;
+        S m = std::frexp(h, &e);
+        return S(m < S(0.70710678118654752) ? e - 1 : e);
+      },
+      x.h);
+  two<T> m = details::scale(x, -e);
+
+  // The clamping keeps the table index valid for special arguments
+  T j = lanewise(
+      [](S m) {
+        S j = std::nearbyint(m * 64);
+        return j >= 45 && j <= 91 ? j : S(64);
+      },
+      m.h);
+  T c = j * S(1.0 / 64);
+
+  // m - c is exact, because m and c are close
+  two<T> num = algorithms::TwoSum(m.h - c, m.l);
+  two<T> den = add(m, c);
+  two<T> z = div<Mode::Fast, useFMA>(num, den);
+  two<T> s = details::horner<useFMA, details::logWorkingDegree<S>,
+                             details::logDegree<S>>(
+      details::mulDW<useFMA>(z, z), C::invOdd);
+  two<T> t = details::mulDW<useFMA>(z, s);
+  t = {T(2) * t.h, T(2) * t.l};
+
+  two<T> res = add<Mode::Accurate>(details::lookup<T, 45>(C::log, j), t);
+  res = add<Mode::Accurate>(
+      mul<Mode::Accurate, useFMA>(details::constant<T>(C::ln2), e), res);
+
+  // Negative numbers, NaN, 0 and infinity
+  res.h = lanewise(
+      [](S r, S xh) {
+        if (xh > 0 && xh < inf) return r;
+        if (xh == 0) return -inf;
+        return xh == inf ? inf : std::numeric_limits<S>::quiet_NaN();
+      },
+      res.h, x.h);
+  res.l = lanewise([](S l, S xh) { return xh > 0 && xh < inf ? l : S(0); },
+                   res.l, x.h);
+  return res;
+}
+
+}  // namespace doubleword
+}  // namespace twofloat
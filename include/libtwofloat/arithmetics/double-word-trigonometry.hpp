@@ -0,0 +1,322 @@
+#pragma once
+
+/// \file double-word-trigonometry.hpp
+/// \brief Implements the trigonometric functions of double-word floating point
+/// numbers.
+/// \details The argument is reduced to `x = k π/2 + r` with |r| <= π/4, with
+/// the Cody-Waite reduction for moderate arguments and the Payne-Hanek
+/// reduction for large ones (Muller 2016, Chapter 11). Then r is reduced
+/// further to `r = j/64 + t` with |t| <= 1/128, so that sin(r) and cos(r)
+/// follow from a table of sin(j/64) and cos(j/64) and short Taylor
+/// polynomials in t. Like in double-word-functions.hpp, the functions also
+/// work for vectors (`two<simd<T, N>>`).
+
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/details/double-word-trig-tables.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <type_traits>
+
+namespace twofloat {
+namespace doubleword {
+namespace details {
+
+/// \brief The largest quadrant number for which the Cody-Waite reduction is
+/// exact. Larger arguments use the Payne-Hanek reduction.
+template <typename S>
+inline constexpr S codyWaiteBound = std::is_same_v<S, float> ? 0x1p12f : 0x1p20;
+
+/// \brief The degrees in t² of the Taylor polynomials of sin(t)/t and cos(t),
+/// |t| <= 1/128, and the degrees from which they are evaluated in working
+/// precision.
+template <typename S>
+inline constexpr int sinDegree = std::is_same_v<S, float> ? 2 : 5;
+template <typename S>
+inline constexpr int sinWorkingDegree = std::is_same_v<S, float> ? 2 : 3;
+template <typename S>
+inline constexpr int cosDegree = std::is_same_v<S, float> ? 2 : 5;
+template <typename S>
+inline constexpr int cosWorkingDegree = std::is_same_v<S, float> ? 2 : 4;
+
+/// \brief The number of lanes of a floating point type or vector.
+template <typename T>
+inline constexpr std::size_t laneCount = 1;
+template <typename T, std::size_t N>
+inline constexpr std::size_t laneCount<simd<T, N>> = N;
+
+template <typename T>
+inline scalar_type_t<T> getLane(const T &x, std::size_t i) {
+  if constexpr (is_simd_v<T>)
+    return x.v[i];
+  else
+    return x;
+}
+
+template <typename T>
+inline void setLane(T &x, std::size_t i, scalar_type_t<T> value) {
+  if constexpr (is_simd_v<T>)
+    x.v[i] = value;
+  else
+    x = value;
+}
+
+/// \brief Returns `n mod 4` for integers n.
+template <typename S>
+inline S mod4(S n) {
+  return n - 4 * std::floor(n / 4);
+}
+
+/// \brief Returns `x - 4k` in [-2, 2] for the nearest integer k. The result is
+/// exact and numbers in (-2, 2) are returned unchanged.
+inline double remainder4(double x) { return x - 4 * std::nearbyint(x / 4); }
+
+/// \brief Reduces a large floating point number `a` to `a - k π/2` with the
+/// Payne-Hanek algorithm and returns the remainder and `k mod 4`.
+/// \details With `|a| = M 2^q` and the integer M < 2^53, `a 2/π` is the sum
+/// of the exact products of M with chunks of 24 bits of 2/π. Products that
+/// are multiples of 4 do not change the remainder and are skipped, and the
+/// others are reduced to [-2, 2] before they are accumulated in double-word
+/// precision.
+inline two<double> payneHanek(double a, double &quadrant) {
+  using C = trigTables<double>;
+  int e;
+  double m = std::frexp(std::abs(a), &e) * 0x1p53;
+  int q = e - 53;
+
+  // 10 chunks cover the 106 bits of the result with enough guard bits
+  int first = q < 2 ? 0 : (q - 2) / 24;
+  two<double> acc;
+  for (int i = first; i < first + 10; ++i) {
+    double factor = m * pow2<double>(q - 24 * (i + 1));
+    two<double> p = algorithms::TwoProd(factor, C::twoOverPiChunks[i]);
+    acc = add<Mode::Accurate>(
+        acc, algorithms::TwoSum(remainder4(p.h), remainder4(p.l)));
+    acc = algorithms::TwoSum(remainder4(acc.h), acc.l);
+  }
+
+  double k = std::nearbyint(acc.h);
+  two<double> r = mul<Mode::Fast, false>(
+      sub(acc, k), two<double>(C::halfPi[0], C::halfPi[1]));
+  if (a < 0) {
+    quadrant = mod4(-k);
+    return {-r.h, -r.l};
+  }
+  quadrant = mod4(k);
+  return r;
+}
+
+/// \brief Reduces a floating point number of any size to `a - k π/2` in
+/// double precision and returns the remainder and `k mod 4`.
+inline two<double> reduceDouble(double a, double &quadrant) {
+  using C = trigTables<double>;
+  if (std::abs(a) * C::invHalfPi > codyWaiteBound<double>)
+    return payneHanek(a, quadrant);
+
+  double n = std::nearbyint(a * C::invHalfPi);
+  two<double> r(a);
+  for (double part : C::halfPiParts) r = sub(r, n * part);
+  quadrant = mod4(n);
+  return r;
+}
+
+/// \brief Reduces a large double-word number to `x - k π/2`, where the
+/// remainder is at most slightly larger than π/4, and returns the remainder
+/// and `k mod 4`.
+/// \details Both words are reduced separately in double precision and the
+/// sum of their remainders is reduced once more.
+template <typename S>
+inline two<S> reduceLarge(const two<S> &x, S &quadrant) {
+  using C = trigTables<double>;
+  double k1, k2;
+  two<double> r = add<Mode::Accurate>(reduceDouble(x.h, k1),
+                                      reduceDouble(x.l, k2));
+  double n = std::nearbyint(r.h * C::invHalfPi);
+  for (double part : C::halfPiParts) r = sub(r, n * part);
+  quadrant = S(mod4(k1 + k2 + n));
+
+  if constexpr (std::is_same_v<S, double>) {
+    return r;
+  } else {
+    S h = S(r.h);
+    return {h, S((r.h - h) + r.l)};
+  }
+}
+
+/// \brief Reduces `x` to `x - k π/2` with a remainder of at most about π/4
+/// and returns the remainder and the lanes of `k mod 4`.
+template <typename T>
+inline two<T> reduceHalfPi(const two<T> &x, T &quadrant) {
+  using S = scalar_type_t<T>;
+  using C = trigTables<S>;
+  constexpr S bound = codyWaiteBound<S>;
+
+  // Lanes that are too large for the Cody-Waite reduction are replaced below
+  auto large = [](S h) { return std::abs(h) * C::invHalfPi > bound; };
+  T n = lanewise(
+      [&](S h) {
+        return large(h) || std::isnan(h) ? 0 : std::nearbyint(h * C::invHalfPi);
+      },
+      x.h);
+  two<T> r = x;
+  for (S part : C::halfPiParts) r = sub(r, n * part);
+  quadrant = lanewise([](S n) { return mod4(n); }, n);
+
+  for (std::size_t i = 0; i < laneCount<T>; ++i) {
+    S h = getLane(x.h, i);
+    if (!large(h) || std::isinf(h)) continue;
+    S q;
+    two<S> ri = reduceLarge(two<S>(h, getLane(x.l, i)), q);
+    setLane(r.h, i, ri.h);
+    setLane(r.l, i, ri.l);
+    setLane(quadrant, i, q);
+  }
+  return r;
+}
+
+/// \brief Calculates sin(r) and cos(r) for |r| <= π/4 + 1/128.
+template <bool useFMA, typename T>
+inline void sinCosReduced(const two<T> &r, two<T> &s, two<T> &c) {
+  using S = scalar_type_t<T>;
+  using C = trigTables<S>;
+
+  // Infinity and NaN use the first table entry
+  T j = lanewise(
+      [](S h) {
+        S j = std::nearbyint(h * 64);
+        return std::abs(j) <= 51 ? j : S(0);
+      },
+      r.h);
+
+  // r - j/64 is exact, because r and j/64 are close
+  two<T> t = algorithms::TwoSum(r.h - j * S(1.0 / 64), r.l);
+  two<T> z = mulDW<useFMA>(t, t);
+  two<T> st = mulDW<useFMA>(
+      t, horner<useFMA, sinWorkingDegree<S>, sinDegree<S>>(z, C::sinCoeff));
+  two<T> ct = horner<useFMA, cosWorkingDegree<S>, cosDegree<S>>(z, C::cosCoeff);
+
+  // sin is odd and cos is even
+  T absJ = lanewise([](S j) { return std::abs(j); }, j);
+  T sign = lanewise([](S j) { return j < 0 ? S(-1) : S(1); }, j);
+  two<T> sj = lookup<T, 0>(C::sin, absJ);
+  sj = {sj.h * sign, sj.l * sign};
+  two<T> cj = lookup<T, 0>(C::cos, absJ);
+
+  s = add<Mode::Accurate>(mulDW<useFMA>(sj, ct), mulDW<useFMA>(cj, st));
+  c = sub<Mode::Accurate>(mulDW<useFMA>(cj, ct), mulDW<useFMA>(sj, st));
+}
+
+/// \brief Returns `±s` or `±c` depending on the quadrant, i.e. sin(x) from
+/// sin(r) and cos(r) for `x = k π/2 + r`. The quadrant `k + 1` gives cos(x).
+/// Infinity and NaN give NaN.
+template <typename T>
+inline two<T> quadrantSelect(const T &quadrant, const two<T> &s,
+                             const two<T> &c, const T &x) {
+  using S = scalar_type_t<T>;
+  auto pick = [](S q, S s, S c, S x) {
+    if (!std::isfinite(x)) return std::numeric_limits<S>::quiet_NaN();
+    int k = static_cast<int>(q);
+    S v = k & 1 ? c : s;
+    return k & 2 ? -v : v;
+  };
+  two<T> res = {lanewise(pick, quadrant, s.h, c.h, x),
+                lanewise(pick, quadrant, s.l, c.l, x)};
+  res.l = lanewise([](S l, S x) { return std::isfinite(x) ? l : S(0); },
+                   res.l, x);
+  return res;
+}
+}  // namespace details
+
+/// \brief Calculates the sine and cosine of a double-word floating point
+/// number with a single argument reduction.
+/// \details The relative error is a small multiple of u², except close to the
+/// zeros, where the absolute error is a small multiple of u². Infinity and
+/// NaN give NaN.
+/// \param x The double-word floating point number.
+/// \param s Receives sin(x).
+/// \param c Receives cos(x).
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void sincos(const two<T> &x, two<T> &s, two<T> &c) {
+  T quadrant;
+  two<T> r = details::reduceHalfPi(x, quadrant);
+  two<T> sr, cr;
+  details::sinCosReduced<useFMA>(r, sr, cr);
+  s = details::quadrantSelect(quadrant, sr, cr, x.h);
+  c = details::quadrantSelect(quadrant + scalar_type_t<T>(1), sr, cr, x.h);
+}
+
+/// \brief Calculates the sine of a double-word floating point number.
+/// \details See `sincos`.
+/// \param x The double-word floating point number.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> sin(const two<T> &x) {
+  two<T> s, c;
+  sincos<useFMA>(x, s, c);
+  return s;
+}
+
+/// \brief Calculates the cosine of a double-word floating point number.
+/// \details See `sincos`.
+/// \param x The double-word floating point number.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> cos(const two<T> &x) {
+  two<T> s, c;
+  sincos<useFMA>(x, s, c);
+  return c;
+}
+
+/// \brief Calculates the tangent of a double-word floating point number as
+/// sin(x)/cos(x).
+/// \param x The double-word floating point number.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> tan(const two<T> &x) {
+  two<T> s, c;
+  sincos<useFMA>(x, s, c);
+  return div<Mode::Fast, useFMA>(s, c);
+}
+
+/// \brief Calculates the angle of the point (x, y), i.e. the arc tangent of
+/// y/x in the correct quadrant.
+/// \details The angle `a = atan2(y.h, x.h)` in working precision is corrected
+/// with one Newton step, `atan2(y, x) = a + (y cos(a) - x sin(a)) /
+/// (x cos(a) + y sin(a))`, which doubles the number of correct bits. The
+/// relative error is a small multiple of u². If y is zero and x is not
+/// negative, or if an argument is not finite, the result is
+/// `std::atan2(y.h, x.h)`.
+/// \param y The y coordinate.
+/// \param x The x coordinate.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline two<T> atan2(const two<T> &y, const two<T> &x) {
+  using S = scalar_type_t<T>;
+  T a = lanewise([](S y, S x) { return std::atan2(y, x); }, y.h, x.h);
+  two<T> s, c;
+  sincos<useFMA>(two<T>(a), s, c);
+
+  two<T> num = sub<Mode::Accurate>(details::mulDW<useFMA>(y, c),
+                                   details::mulDW<useFMA>(x, s));
+  two<T> den = add<Mode::Accurate>(details::mulDW<useFMA>(x, c),
+                                   details::mulDW<useFMA>(y, s));
+  two<T> res = add(div<Mode::Fast, useFMA>(num, den), a);
+
+  // The correction would be NaN or lose the sign of zero
+  auto regular = [](S y, S x) {
+    return std::isfinite(x) && std::isfinite(y) && (y != 0 || x < 0);
+  };
+  res.h = lanewise([&](S r, S a, S y, S x) { return regular(y, x) ? r : a; },
+                   res.h, a, y.h, x.h);
+  res.l = lanewise([&](S l, S y, S x) { return regular(y, x) ? l : S(0); },
+                   res.l, y.h, x.h);
+  return res;
+}
+
+}  // namespace doubleword
+}  // namespace twofloat
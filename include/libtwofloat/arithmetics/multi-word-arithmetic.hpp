@@ -0,0 +1,341 @@
+#pragma once
+
+/// \file multi-word-arithmetic.hpp
+/// \brief Implements the arithmetic of floating-point expansions with a
+/// fixed number of components (Priest 1991, Shewchuk 1997), with the
+/// renormalization and addition of Joldeş, Muller and Popescu (2016).
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace twofloat {
+namespace multiword {
+
+namespace details {
+template <typename F, std::size_t... I>
+constexpr void unroll(F &&f, std::index_sequence<I...>) {
+  (f(std::integral_constant<std::size_t, I>()), ...);
+}
+
+/// \brief Calls `f(i)` for `i = 0, ..., N - 1`, where `i` is a
+/// `std::integral_constant`, so that the loop is unrolled independently of
+/// the optimization level and `decltype(i)::value` is a constant expression.
+template <std::size_t N, typename F>
+constexpr void unroll(F &&f) {
+  unroll(f, std::make_index_sequence<N>());
+}
+
+/// \brief Returns `c != 0 ? x : y` for each lane.
+template <typename T>
+constexpr T selectNonzero(const T &c, const T &x, const T &y) {
+  if constexpr (is_simd_v<T>)
+    return select_gt(abs(c), T(0), x, y);
+  else
+    return c != 0 ? x : y;
+}
+
+/// \brief Orders `a` and `b` by decreasing magnitude.
+template <typename T>
+constexpr void compareExchange(T &a, T &b) {
+  if constexpr (is_simd_v<T>) {
+    const T hi = select_gt(abs(b), abs(a), b, a);
+    b = select_gt(abs(b), abs(a), a, b);
+    a = hi;
+  } else {
+    // Selections instead of a branch, which is mispredicted for random data
+    const bool swap = std::abs(b) > std::abs(a);
+    const T hi = swap ? b : a;
+    b = swap ? a : b;
+    a = hi;
+  }
+}
+
+/// \brief Renormalizes the sum of the `N` numbers `c` to an expansion with
+/// `M` components.
+/// \details The numbers are first summed up from the smallest to the largest
+/// one, which leaves the sum in the first number and the rounding errors in
+/// the others (`VecSum`). The second pass sums them up from the largest to
+/// the smallest one and emits a component whenever the rounding error is not
+/// zero (`VecSumErrBranch`), which are the two passes of `renorm` in Hida et
+/// al. (2001) and Algorithm 6 in Joldeş et al. (2016). The branches on zero
+/// errors are replaced by selections and the zeros are moved to the end by a
+/// network of conditional moves, so that vectors process all lanes with the
+/// same operations. The first pass uses `FastTwoSum`, which requires that
+/// the numbers are roughly ordered by decreasing magnitude, unless `robust`
+/// is set.
+/// \tparam M The number of components of the result.
+/// \tparam robust Whether the first pass uses `TwoSum`.
+template <std::size_t M, bool robust, typename T, std::size_t N>
+constexpr expansion<T, M> renormalize(const T (&c)[N]) {
+  static_assert(N >= M, "At least M numbers are renormalized");
+  T e[N] = {};
+  T s = c[N - 1];
+  unroll<N - 1>([&](auto j) {
+    const std::size_t i = N - 2 - j;
+    const two<T> t = robust ? algorithms::TwoSum(c[i], s)
+                            : algorithms::FastTwoSum(c[i], s);
+    s = t.h;
+    e[i + 1] = t.l;
+  });
+  e[0] = s;
+
+  // w[i] is zero if no component was emitted in step i
+  T w[N] = {};
+  unroll<N - 1>([&](auto j) {
+    const two<T> t = algorithms::FastTwoSum(s, e[j + 1]);
+    w[j] = selectNonzero(t.l, t.h, T(0));
+    s = selectNonzero(t.l, t.l, t.h);
+  });
+  w[N - 1] = s;
+  // Pass k moves the first nonzero number of w[k..] to w[k], and the
+  // numbers after w[M - 2] are summed up in the last component
+  unroll<M - 1>([&](auto k) {
+    unroll<N - 1 - decltype(k)::value>([&](auto j) {
+      const std::size_t i = N - 2 - j;
+      const T next = w[i + 1];
+      w[i + 1] = selectNonzero(w[i], next, T(0));
+      w[i] = selectNonzero(w[i], w[i], next);
+    });
+  });
+  expansion<T, M> r;
+  unroll<M - 1>([&](auto i) { r[i] = w[i]; });
+  r[M - 1] = w[N - 1];
+  unroll<N - M>([&](auto j) { r[M - 1] = w[N - 2 - j] + r[M - 1]; });
+
+  // Infinities leave NaNs in the errors
+  const T inf = std::numeric_limits<scalar_type_t<T>>::max();
+  if constexpr (is_simd_v<T>) {
+    r[0] = select_gt(abs(e[0]), inf, e[0], r[0]);
+    unroll<M - 1>([&](auto i) {
+      r[i + 1] = select_gt(abs(e[0]), inf, T(0), r[i + 1]);
+    });
+  } else if (std::abs(e[0]) > inf) {
+    return expansion<T, M>(e[0]);
+  }
+  return r;
+}
+
+/// \brief A compare-exchange of the numbers `a` and `b` of a network.
+struct comparator {
+  std::size_t a = 0, b = 0;
+};
+
+/// \brief Returns the number of comparators of `oddEvenMerge<P>`.
+constexpr std::size_t oddEvenMergeSize(std::size_t p) {
+  std::size_t n = 0;
+  for (std::size_t k = p; k >= 1; k /= 2)
+    for (std::size_t j = k % p; j + k < 2 * p; j += 2 * k)
+      n += k < 2 * p - j - k ? k : 2 * p - j - k;
+  return n;
+}
+
+/// \brief Returns Batcher's odd-even merge network of two sorted sequences
+/// of `P` numbers, where `P` is a power of two.
+template <std::size_t P>
+constexpr std::array<comparator, oddEvenMergeSize(P)> oddEvenMergeNetwork() {
+  std::array<comparator, oddEvenMergeSize(P)> network{};
+  std::size_t n = 0;
+  for (std::size_t k = P; k >= 1; k /= 2)
+    for (std::size_t j = k % P; j + k < 2 * P; j += 2 * k)
+      for (std::size_t i = 0; i < k && i + j + k < 2 * P; ++i)
+        network[n++] = {i + j, i + j + k};
+  return network;
+}
+
+template <std::size_t P, typename T, std::size_t... I>
+constexpr void oddEvenMerge(T (&c)[2 * P], std::index_sequence<I...>) {
+  constexpr auto network = oddEvenMergeNetwork<P>();
+  (compareExchange(c[network[I].a], c[network[I].b]), ...);
+}
+
+/// \brief Merges the sorted sequences `c[0..P)` and `c[P..2P)` by decreasing
+/// magnitude.
+template <std::size_t P, typename T>
+constexpr void oddEvenMerge(T (&c)[2 * P]) {
+  oddEvenMerge<P>(c, std::make_index_sequence<oddEvenMergeSize(P)>());
+}
+
+/// \brief Returns the smallest power of two that is not less than `n`.
+constexpr std::size_t ceilPow2(std::size_t n) {
+  std::size_t p = 1;
+  while (p < n) p *= 2;
+  return p;
+}
+
+/// \brief Accumulates the products of order `K` of `x` and `y`, i.e. the
+/// high words of `x_i y_j` with `i + j = K`, and the errors `carry` of the
+/// previous orders to `c[K]`, and passes the errors on to the next order.
+/// \details All operations up to order `N - 1` are exact, the terms of order
+/// `N` are added up with plain floating point operations and the terms of
+/// higher orders are ignored. There are `K²` errors of the previous orders.
+template <std::size_t K, bool useFMA, typename T, std::size_t N>
+constexpr void mulOrders(const expansion<T, N> &x, const expansion<T, N> &y,
+                         const std::array<T, K * K> &carry, T (&c)[N + 1]) {
+  if constexpr (K < N) {
+    two<T> p[K + 1];
+    unroll<K + 1>([&](auto i) {
+      p[i] = algorithms::TwoProd<T, useFMA>(x[i], y[K - i]);
+    });
+    std::array<T, (K + 1) * (K + 1)> next{};
+    T s = p[0].h;
+    unroll<K>([&](auto i) {
+      const two<T> t = algorithms::TwoSum(s, p[i + 1].h);
+      s = t.h;
+      next[i] = t.l;
+    });
+    unroll<K * K>([&](auto j) {
+      const two<T> t = algorithms::TwoSum(s, carry[j]);
+      s = t.h;
+      next[K + j] = t.l;
+    });
+    unroll<K + 1>([&](auto i) { next[K + K * K + i] = p[i].l; });
+    c[K] = s;
+    mulOrders<K + 1, useFMA>(x, y, next, c);
+  } else {
+    T s = carry[0];
+    unroll<K * K - 1>([&](auto j) { s += carry[j + 1]; });
+    unroll<N - 1>([&](auto i) { s += x[i + 1] * y[N - 1 - i]; });
+    c[N] = s;
+  }
+}
+
+template <typename T, std::size_t N>
+constexpr expansion<T, N> negate(const expansion<T, N> &x) {
+  expansion<T, N> r;
+  unroll<N>([&](auto i) { r[i] = -x[i]; });
+  return r;
+}
+}  // namespace details
+
+/// \brief Adds an expansion and a floating point number.
+/// \details The number is propagated through the components with `TwoSum`
+/// and the result is renormalized.
+template <typename T, std::size_t N>
+constexpr expansion<T, N> add(const expansion<T, N> &x, T y) {
+  T c[N + 1];
+  T e = y;
+  details::unroll<N>([&](auto i) {
+    const two<T> t = algorithms::TwoSum(x[i], e);
+    c[i] = t.h;
+    e = t.l;
+  });
+  c[N] = e;
+  return details::renormalize<N, false>(c);
+}
+template <typename T, std::size_t N>
+constexpr expansion<T, N> add(T x, const expansion<T, N> &y) {
+  return add(y, x);
+}
+
+/// \brief Subtracts a floating point number from an expansion.
+template <typename T, std::size_t N>
+constexpr expansion<T, N> sub(const expansion<T, N> &x, T y) {
+  return add(x, T(-y));
+}
+
+/// \brief Adds two expansions.
+/// \details The components of both numbers are merged by decreasing
+/// magnitude with Batcher's odd-even merge network and the `2 N` numbers are
+/// renormalized (Algorithm 4 in Joldeş et al. 2016), so that the relative
+/// error is bounded even if the components cancel. If `N` is not a power of
+/// two, the components are padded with zeros for the network.
+/// \param x The first expansion.
+/// \param y The second expansion.
+template <typename T, std::size_t N>
+constexpr expansion<T, N> add(const expansion<T, N> &x,
+                              const expansion<T, N> &y) {
+  constexpr std::size_t P = details::ceilPow2(N);
+  T c[2 * P] = {};
+  details::unroll<N>([&](auto i) {
+    c[i] = x[i];
+    c[P + i] = y[i];
+  });
+  details::oddEvenMerge<P>(c);
+  if constexpr (P == N) {
+    return details::renormalize<N, true>(c);
+  } else {
+    T d[2 * N];
+    details::unroll<2 * N>([&](auto i) { d[i] = c[i]; });
+    return details::renormalize<N, true>(d);
+  }
+}
+
+/// \brief Subtracts two expansions, see `add`.
+template <typename T, std::size_t N>
+constexpr expansion<T, N> sub(const expansion<T, N> &x,
+                              const expansion<T, N> &y) {
+  return add(x, details::negate(y));
+}
+
+/// \brief Multiplies an expansion with a floating point number.
+/// \details The products of the components are calculated exactly with
+/// `TwoProd` and renormalized in the order of their magnitude.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T, std::size_t N>
+constexpr expansion<T, N> mul(const expansion<T, N> &x, T y) {
+  two<T> p[N];
+  details::unroll<N>([&](auto i) {
+    p[i] = algorithms::TwoProd<T, useFMA>(x[i], y);
+  });
+  // The high word of x_i y and the low word of x_{i-1} y are of order i
+  T c[2 * N];
+  c[0] = p[0].h;
+  details::unroll<N - 1>([&](auto i) {
+    c[2 * i + 1] = p[i + 1].h;
+    c[2 * i + 2] = p[i].l;
+  });
+  c[2 * N - 1] = p[N - 1].l;
+  return details::renormalize<N, true>(c);
+}
+template <bool useFMA, typename T, std::size_t N>
+constexpr expansion<T, N> mul(T x, const expansion<T, N> &y) {
+  return mul<useFMA>(y, x);
+}
+
+/// \brief Multiplies two expansions.
+/// \details The products `x_i y_j` with `i + j < N` are calculated exactly
+/// with `TwoProd` and accumulated by order with `TwoSum`, which passes the
+/// rounding errors on to the next order, like the accurate multiplication of
+/// quad-word numbers (Hida et al. 2001). Only the terms of order `N` are
+/// rounded, so that the relative error is close to the unit roundoff
+/// `u^N`. The `N + 1` sums are renormalized.
+/// \param x The first expansion.
+/// \param y The second expansion.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T, std::size_t N>
+constexpr expansion<T, N> mul(const expansion<T, N> &x,
+                              const expansion<T, N> &y) {
+  T c[N + 1];
+  details::mulOrders<0, useFMA>(x, y, std::array<T, 0>(), c);
+  return details::renormalize<N, true>(c);
+}
+
+/// \brief Divides two expansions.
+/// \details Long division: each of the `N + 1` quotient components is the
+/// quotient of the high components of the remainder and of `y`, and the
+/// remainder is updated with `mul` and `sub` (Hida et al. 2001).
+/// \param x The dividend.
+/// \param y The divisor.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T, std::size_t N>
+constexpr expansion<T, N> div(const expansion<T, N> &x,
+                              const expansion<T, N> &y) {
+  T q[N + 1];
+  expansion<T, N> r = x;
+  details::unroll<N + 1>([&](auto i) {
+    q[i] = r[0] / y[0];
+    if constexpr (decltype(i)::value < N)
+      r = sub(r, mul<useFMA>(y, q[i]));
+  });
+  return details::renormalize<N, false>(q);
+}
+
+}  // namespace multiword
+}  // namespace twofloat
@@ -3,8 +3,10 @@
 /// \file pair-arithmetic.hpp
 /// \brief Implements the pairwise arithmetic proposed by Lange and Rump.
 
+#include <cstddef>
 #include <libtwofloat/algorithms.hpp>
 #include <libtwofloat/twofloat.hpp>
+#include <limits>
 
 namespace twofloat {
 /// \brief Implements the pairwise arithmetic proposed by Lange and Rump in
@@ -21,13 +23,22 @@ namespace twofloat {
 /// details.
 namespace pair {
 
+/// \brief A conservative number of operations for which the pair arithmetic
+/// stays faithful, `2^(⌊p/2⌋-3)` for the precision p of `T`, i.e. 2^23 for
+/// double and 2^9 for float.
+/// \details The bounds of Corollaries 6.1 - 6.5 grow like √(1/u) with the
+/// unit roundoff u, and this is a fraction of them.
+template <typename T>
+inline constexpr std::size_t faithfulOperations =
+    std::size_t(1) << (std::numeric_limits<T>::digits / 2 - 3);
+
 /// \brief Adds two pairwise floating point numbers using the pairwise
 /// arithmetic. This is algorithm `CPairSum` in chapter 3 of the paper.
 template <typename T>
-inline two<T> add(const two<T> &x, const two<T> &y) {
+constexpr two<T> add(const two<T> &x, const two<T> &y) {
   two<T> s = algorithms::TwoSum(x.h, y.h);
-  float v = x.l + y.l;
-  float w = s.l + v;
+  T v = x.l + y.l;
+  T w = s.l + v;
   return {s.h, w};
 }
 
@@ -35,13 +46,13 @@ inline two<T> add(const two<T> &x, const two<T> &y) {
 /// number using the pairwise arithmetic. This is derived from algorithm
 /// `CPairSum` in chapter 3 of the paper.
 template <typename T>
-inline two<T> add(const two<T> &x, T y) {
+constexpr two<T> add(const two<T> &x, T y) {
   two<T> s = algorithms::TwoSum(x.h, y);
-  float w = s.l + x.l;
+  T w = s.l + x.l;
   return {s.h, w};
 }
 template <typename T>
-inline two<T> add(T x, const two<T> &y) {
+constexpr two<T> add(T x, const two<T> &y) {
   return add(y, x);
 }
 
@@ -49,10 +60,10 @@ inline two<T> add(T x, const two<T> &y) {
 /// arithmetic. This is derived from algorithm `CPairDiff` in chapter 3 of the
 /// paper.
 template <typename T>
-inline two<T> sub(const two<T> &x, const two<T> &y) {
+constexpr two<T> sub(const two<T> &x, const two<T> &y) {
   two<T> s = algorithms::TwoDiff(x.h, y.h);
-  float v = x.l - y.l;
-  float w = s.l + v;
+  T v = x.l - y.l;
+  T w = s.l + v;
   return {s.h, w};
 }
 
@@ -60,20 +71,22 @@ inline two<T> sub(const two<T> &x, const two<T> &y) {
 /// point number using the pairwise arithmetic. This is derived from algorithm
 /// `CPairDiff` in chapter 3 of the paper.
 template <typename T>
-inline two<T> sub(const two<T> &x, T y) {
+constexpr two<T> sub(const two<T> &x, T y) {
   two<T> s = algorithms::TwoDiff(x.h, y);
-  float w = s.l + x.l;
+  T w = s.l + x.l;
   return {s.h, w};
 }
 template <typename T>
-inline two<T> sub(T x, const two<T> &y) {
-  return sub(y, x);
+constexpr two<T> sub(T x, const two<T> &y) {
+  two<T> s = algorithms::TwoDiff(x, y.h);
+  T w = s.l - y.l;
+  return {s.h, w};
 }
 
 /// \brief Multiplies two pairwise floating point numbers using the pairwise
 /// arithmetic. This is algorithm `CPairProd` in chapter 3 of the paper.
 template <bool useFMA, typename T>
-inline two<T> mul(const two<T> &x, const two<T> &y) {
+constexpr two<T> mul(const two<T> &x, const two<T> &y) {
   two<T> c = algorithms::TwoProd<T, useFMA>(x.h, y.h);
   T tl1 = x.h * y.l;
   T tl2 = x.l * y.h;
@@ -86,23 +99,28 @@ inline two<T> mul(const two<T> &x, const two<T> &y) {
 /// point number using the pairwise arithmetic. This is derived from algorithm
 /// `CPairProd` in chapter 3 of the paper.
 template <bool useFMA, typename T>
-inline two<T> mul(const two<T> &x, T y) {
-  two<T> c = algorithms::TwoProd<useFMA>(x.h, y);
+constexpr two<T> mul(const two<T> &x, T y) {
+  two<T> c = algorithms::TwoProd<T, useFMA>(x.h, y);
   T tl2 = x.l * y;
   T cl3 = c.l + tl2;
   return {c.h, cl3};
 }
-template <typename T>
-inline two<T> mul(T x, const two<T> &y) {
-  return mul(y, x);
+template <bool useFMA, typename T>
+constexpr two<T> mul(T x, const two<T> &y) {
+  return mul<useFMA>(y, x);
 }
 
 /// \brief Divides two pairwise floating point numbers using the pairwise
 /// arithmetic. This is algorithm `CPairDiv` in chapter 3 of the paper.
-template <typename T>
-inline two<T> div(const two<T> &x, const two<T> &y) {
+/// \details The remainder `x.h - c y.h` is computed with an error-free
+/// product, otherwise the rounding error of the product is as large as the
+/// low word of the quotient.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA = false, typename T>
+constexpr two<T> div(const two<T> &x, const two<T> &y) {
   T c = x.h / y.h;
-  T t = x.h - c * y.h;
+  two<T> cy = algorithms::TwoProd<T, useFMA>(c, y.h);
+  T t = (x.h - cy.h) - cy.l;
   T p = t + x.l;
   T q = c * y.l;
   T r = p - q;
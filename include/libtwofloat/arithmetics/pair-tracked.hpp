@@ -0,0 +1,124 @@
+#pragma once
+
+/// \file pair-tracked.hpp
+/// \brief Implements pairwise floating point numbers that track the number of
+/// operations since their last normalization.
+
+#include <cstddef>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/twofloat.hpp>
+
+namespace twofloat {
+namespace pair {
+
+/// \brief A pairwise floating point number together with the number of pair
+/// operations that contributed to it since the last normalization.
+/// \details The bounds of Lange and Rump (Corollaries 6.1 - 6.5) limit the
+/// number of operations in an expression for which the pair arithmetic is
+/// faithful. The operations below add the counts of their operands. When the
+/// count of a result would exceed `budget`, the operands are normalized with
+/// `FastTwoSum` first and the count starts again. The counts are the number of
+/// operations in the expression tree of the result, which is the quantity
+/// that the bounds limit. Operands that share a subexpression count it twice,
+/// which is conservative.
+/// \tparam T The underlying floating point type or vector.
+/// \tparam budget The maximum number of operations between normalizations.
+template <typename T,
+          std::size_t budget = faithfulOperations<scalar_type_t<T>>>
+struct tracked {
+  static_assert(budget > 0, "The budget must allow at least one operation");
+
+  /// \brief The pairwise floating point number.
+  two<T> value;
+
+  /// \brief The number of operations since the last normalization.
+  std::size_t operations;
+
+  /// \brief Default constructor, zero.
+  tracked() : value(), operations(0) {}
+
+  /// \brief Constructs an instance from a floating point number.
+  explicit tracked(T x) : value(x), operations(0) {}
+
+  /// \brief Constructs an instance from a pairwise floating point number,
+  /// which counts as normalized.
+  explicit tracked(const two<T> &x) : value(x), operations(0) {}
+
+  /// \brief Constructs an instance with the given number of operations.
+  tracked(const two<T> &x, std::size_t operations)
+      : value(x), operations(operations) {}
+
+  /// \brief Returns the normalized double-word number.
+  two<T> normalized() const {
+    return algorithms::FastTwoSum(value.h, value.l);
+  }
+};
+
+namespace details {
+/// \brief Normalizes both operands if the result of an operation on them
+/// would exceed the budget, and returns the count of the result.
+template <typename T, std::size_t budget>
+inline std::size_t prepare(tracked<T, budget> &x, tracked<T, budget> &y) {
+  if (x.operations + y.operations + 1 > budget) {
+    x = tracked<T, budget>(x.normalized());
+    y = tracked<T, budget>(y.normalized());
+  }
+  return x.operations + y.operations + 1;
+}
+
+template <typename T, std::size_t budget>
+inline std::size_t prepare(tracked<T, budget> &x) {
+  if (x.operations + 1 > budget) x = tracked<T, budget>(x.normalized());
+  return x.operations + 1;
+}
+}  // namespace details
+
+/// \brief Adds two tracked pairwise floating point numbers, see `add`.
+template <typename T, std::size_t budget>
+inline tracked<T, budget> add(tracked<T, budget> x, tracked<T, budget> y) {
+  std::size_t operations = details::prepare(x, y);
+  return {add(x.value, y.value), operations};
+}
+template <typename T, std::size_t budget>
+inline tracked<T, budget> add(tracked<T, budget> x, T y) {
+  std::size_t operations = details::prepare(x);
+  return {add(x.value, y), operations};
+}
+
+/// \brief Subtracts two tracked pairwise floating point numbers, see `sub`.
+template <typename T, std::size_t budget>
+inline tracked<T, budget> sub(tracked<T, budget> x, tracked<T, budget> y) {
+  std::size_t operations = details::prepare(x, y);
+  return {sub(x.value, y.value), operations};
+}
+template <typename T, std::size_t budget>
+inline tracked<T, budget> sub(tracked<T, budget> x, T y) {
+  std::size_t operations = details::prepare(x);
+  return {sub(x.value, y), operations};
+}
+
+/// \brief Multiplies two tracked pairwise floating point numbers, see `mul`.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T, std::size_t budget>
+inline tracked<T, budget> mul(tracked<T, budget> x, tracked<T, budget> y) {
+  std::size_t operations = details::prepare(x, y);
+  return {mul<useFMA>(x.value, y.value), operations};
+}
+template <bool useFMA, typename T, std::size_t budget>
+inline tracked<T, budget> mul(tracked<T, budget> x, T y) {
+  std::size_t operations = details::prepare(x);
+  return {mul<useFMA>(x.value, y), operations};
+}
+
+/// \brief Divides two tracked pairwise floating point numbers, see `div`.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T, std::size_t budget>
+inline tracked<T, budget> div(tracked<T, budget> x, tracked<T, budget> y) {
+  std::size_t operations = details::prepare(x, y);
+  return {div<useFMA>(x.value, y.value), operations};
+}
+
+}  // namespace pair
+}  // namespace twofloat
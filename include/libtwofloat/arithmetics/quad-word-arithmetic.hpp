@@ -0,0 +1,227 @@
+#pragma once
+
+/// \file quad-word-arithmetic.hpp
+/// \brief Implements the quad-word arithmetic proposed by Hida, Li and Bailey
+/// (2001), with an accurate addition based on Joldeş, Muller and Popescu
+/// (2016).
+
+#include <cstddef>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/multi-word-arithmetic.hpp>
+#include <libtwofloat/twofloat.hpp>
+
+namespace twofloat {
+namespace quadword {
+
+/// \brief The modes of the quad-word operations, see `add`, `mul` and `div`.
+using doubleword::Mode;
+
+namespace details {
+using multiword::details::negate;
+
+/// \brief Renormalizes the sum of the `N` numbers `c` to a quad-word number,
+/// see `multiword::details::renormalize`.
+/// \tparam robust Whether the first pass uses `TwoSum`.
+template <bool robust, typename T, std::size_t N>
+constexpr four<T> renormalize(const T (&c)[N]) {
+  return multiword::details::renormalize<4, robust>(c);
+}
+
+/// \brief Calculates the sum of `a`, `b` and `c`, which is returned in `a`,
+/// and the error in `b` and `c` (`three_sum` in Hida et al. 2001).
+template <typename T>
+constexpr void threeSum(T &a, T &b, T &c) {
+  const two<T> t = algorithms::TwoSum(a, b);
+  const two<T> u = algorithms::TwoSum(c, t.h);
+  const two<T> v = algorithms::TwoSum(t.l, u.l);
+  a = u.h;
+  b = v.h;
+  c = v.l;
+}
+
+/// \brief Like `threeSum`, but only returns the error in `b` as a single
+/// number (`three_sum2` in Hida et al. 2001).
+template <typename T>
+constexpr void threeSum2(T &a, T &b, T c) {
+  const two<T> t = algorithms::TwoSum(a, b);
+  const two<T> u = algorithms::TwoSum(c, t.h);
+  a = u.h;
+  b = t.l + u.l;
+}
+}  // namespace details
+
+/// \brief Adds a quad-word number and a floating point number.
+/// \details The number is propagated through the components with `TwoSum`
+/// and the result is renormalized (Hida et al. 2001).
+template <typename T>
+constexpr four<T> add(const four<T> &x, T y) {
+  return multiword::add(x, y);
+}
+template <typename T>
+constexpr four<T> add(T x, const four<T> &y) {
+  return add(y, x);
+}
+
+/// \brief Subtracts a floating point number from a quad-word number.
+template <typename T>
+constexpr four<T> sub(const four<T> &x, T y) {
+  return add(x, T(-y));
+}
+
+/// \brief Adds two quad-word numbers.
+/// \details The sloppy mode (`sloppy_add` in Hida et al. 2001) adds the
+/// components pairwise with `TwoSum` and accumulates the errors of the same
+/// order. Like the sloppy double-word addition, its relative error is only
+/// bounded if the components do not cancel, e.g. if `x` and `y` have the same
+/// sign. The accurate mode merges the components of both numbers by
+/// decreasing magnitude with a sorting network and renormalizes the eight
+/// numbers (Algorithm 7 in Joldeş et al. 2016), so that its relative error is
+/// always bounded, at about twice the cost. Both modes are free of branches.
+/// \param x The first quad-word number.
+/// \param y The second quad-word number.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+constexpr four<T> add(const four<T> &x, const four<T> &y) {
+  if constexpr (mode == Mode::Sloppy) {
+    two<T> s[4];
+    for (std::size_t i = 0; i < 4; ++i) s[i] = algorithms::TwoSum(x[i], y[i]);
+    // The errors of order i are added to the sums of order i + 1
+    T c[5] = {s[0].h, 0, s[2].h, s[3].h, 0};
+    two<T> t = algorithms::TwoSum(s[1].h, s[0].l);
+    c[1] = t.h;
+    T e0 = t.l, e1 = s[1].l;
+    details::threeSum(c[2], e0, e1);
+    T e2 = s[2].l;
+    details::threeSum2(c[3], e0, e2);
+    c[4] = e0 + e1 + s[3].l;
+    return details::renormalize<false>(c);
+  } else if constexpr (mode == Mode::Accurate) {
+    return multiword::add(x, y);
+  } else
+    static_assert(sizeof(T) == 0, "Sloppy and accurate modes are supported");
+}
+
+/// \brief Subtracts two quad-word numbers, see `add`.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+constexpr four<T> sub(const four<T> &x, const four<T> &y) {
+  return add<mode>(x, details::negate(y));
+}
+
+/// \brief Multiplies a quad-word number with a floating point number.
+/// \details `mul_qd_d` in Hida et al. (2001).
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+constexpr four<T> mul(const four<T> &x, T y) {
+  const two<T> p0 = algorithms::TwoProd<T, useFMA>(x[0], y);
+  const two<T> p1 = algorithms::TwoProd<T, useFMA>(x[1], y);
+  const two<T> p2 = algorithms::TwoProd<T, useFMA>(x[2], y);
+  const T p3 = x[3] * y;
+  const two<T> s1 = algorithms::TwoSum(p0.l, p1.h);
+  T s2 = s1.l, q1 = p1.l, r2 = p2.h;
+  details::threeSum(s2, q1, r2);
+  T q2 = p2.l;
+  details::threeSum2(q1, q2, p3);
+  T c[5] = {p0.h, s1.h, s2, q1, q2 + r2};
+  return details::renormalize<false>(c);
+}
+template <bool useFMA, typename T>
+constexpr four<T> mul(T x, const four<T> &y) {
+  return mul<useFMA>(y, x);
+}
+
+/// \brief Multiplies two quad-word numbers.
+/// \details The products of the components are calculated exactly with
+/// `TwoProd` up to the terms of order `u³` and accumulated by order (Hida et
+/// al. 2001). The sloppy mode (`sloppy_mul`) adds the terms of order `u³`
+/// and their errors without `TwoProd`, the accurate mode (`accurate_mul`)
+/// calculates them exactly and adds the terms of order `u⁴`, with a relative
+/// error close to the unit roundoff `u⁴`.
+/// \param x The first quad-word number.
+/// \param y The second quad-word number.
+/// \tparam mode The mode (sloppy or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode mode, bool useFMA, typename T>
+constexpr four<T> mul(const four<T> &x, const four<T> &y) {
+  static_assert(mode == Mode::Sloppy || mode == Mode::Accurate,
+                "Sloppy and accurate modes are supported");
+  two<T> p0 = algorithms::TwoProd<T, useFMA>(x[0], y[0]);
+  two<T> p1 = algorithms::TwoProd<T, useFMA>(x[0], y[1]);
+  two<T> p2 = algorithms::TwoProd<T, useFMA>(x[1], y[0]);
+  two<T> p3 = algorithms::TwoProd<T, useFMA>(x[0], y[2]);
+  two<T> p4 = algorithms::TwoProd<T, useFMA>(x[1], y[1]);
+  two<T> p5 = algorithms::TwoProd<T, useFMA>(x[2], y[0]);
+
+  // The terms of order u
+  T a1 = p1.h, a2 = p2.h, q0 = p0.l;
+  details::threeSum(a1, a2, q0);
+  // The terms of order u²: (a2, q1, q2) + (p3, p4, p5)
+  T q1 = p1.l, q2 = p2.l, b3 = p3.h, b4 = p4.h, b5 = p5.h;
+  details::threeSum(a2, q1, q2);
+  details::threeSum(b3, b4, b5);
+  const two<T> s0 = algorithms::TwoSum(a2, b3);
+  two<T> s1 = algorithms::TwoSum(q1, b4);
+  T s2 = q2 + b5;
+  const two<T> u = algorithms::TwoSum(s1.h, s0.l);
+  s2 += u.l + s1.l;
+
+  if constexpr (mode == Mode::Sloppy) {
+    const T r = u.h + (x[0] * y[3] + x[1] * y[2] + x[2] * y[1] +
+                       x[3] * y[0] + q0 + p3.l + p4.l + p5.l);
+    T c[5] = {p0.h, a1, s0.h, r, s2};
+    return details::renormalize<false>(c);
+  } else {
+    // The terms of order u³
+    const two<T> p6 = algorithms::TwoProd<T, useFMA>(x[0], y[3]);
+    const two<T> p7 = algorithms::TwoProd<T, useFMA>(x[1], y[2]);
+    const two<T> p8 = algorithms::TwoProd<T, useFMA>(x[2], y[1]);
+    const two<T> p9 = algorithms::TwoProd<T, useFMA>(x[3], y[0]);
+    // Sum of q0, u.h, p3.l, p4.l, p5.l, p6.h, p7.h, p8.h and p9.h
+    const two<T> t03 = algorithms::TwoSum(q0, p3.l);
+    const two<T> t45 = algorithms::TwoSum(p4.l, p5.l);
+    const two<T> t67 = algorithms::TwoSum(p6.h, p7.h);
+    const two<T> t89 = algorithms::TwoSum(p8.h, p9.h);
+    two<T> t = algorithms::TwoSum(t03.h, t45.h);
+    t.l += t03.l + t45.l;
+    two<T> r = algorithms::TwoSum(t67.h, t89.h);
+    r.l += t67.l + t89.l;
+    two<T> v = algorithms::TwoSum(t.h, r.h);
+    v.l += t.l + r.l;
+    two<T> w = algorithms::TwoSum(v.h, u.h);
+    w.l += v.l;
+    // The terms of order u⁴
+    w.l += x[1] * y[3] + x[2] * y[2] + x[3] * y[1] + p6.l + p7.l + p8.l +
+           p9.l + s2;
+    T c[5] = {p0.h, a1, s0.h, w.h, w.l};
+    return details::renormalize<false>(c);
+  }
+}
+
+/// \brief Divides two quad-word numbers.
+/// \details Long division: each quotient component is the quotient of the
+/// high components of the remainder and of `y`, and the remainder is updated
+/// with `mul` and `sub` (Hida et al. 2001). The sloppy mode (`sloppy_div`)
+/// calculates four components with sloppy subtractions, the accurate mode
+/// (`accurate_div`) calculates five components with accurate subtractions.
+/// \param x The dividend.
+/// \param y The divisor.
+/// \tparam mode The mode (sloppy or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode mode, bool useFMA, typename T>
+constexpr four<T> div(const four<T> &x, const four<T> &y) {
+  static_assert(mode == Mode::Sloppy || mode == Mode::Accurate,
+                "Sloppy and accurate modes are supported");
+  constexpr std::size_t terms = mode == Mode::Sloppy ? 4 : 5;
+  T q[terms] = {};
+  four<T> r = x;
+  multiword::details::unroll<terms>([&](auto i) {
+    q[i] = r[0] / y[0];
+    if constexpr (decltype(i)::value + 1 < terms)
+      r = sub<mode>(r, mul<useFMA>(y, q[i]));
+  });
+  return details::renormalize<false>(q);
+}
+
+}  // namespace quadword
+}  // namespace twofloat
@@ -0,0 +1,134 @@
+#pragma once
+
+/// \file quad-word-batch.hpp
+/// \brief Implements batched versions of the quad-word arithmetic that
+/// operate on whole arrays of quad-word numbers.
+
+#include <cstddef>
+#include <libtwofloat/arithmetics/quad-word-arithmetic.hpp>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <stdexcept>
+
+namespace twofloat {
+namespace quadword {
+
+/// \brief Batched versions of the quad-word operations.
+/// \details Each operation applies the corresponding scalar operation of the
+/// `quadword` namespace element-wise. The numbers are loaded into vectors of
+/// the widest instruction set of the CPU (`four<simd<T, N>>`), which is
+/// selected at runtime like for the matrix products, and the remaining
+/// elements are processed one by one. Since the quad-word operations are free
+/// of branches, the results are bitwise identical to the scalar operations.
+/// All operations process `z.size()` elements and throw
+/// `std::invalid_argument` if `x` or `y` is shorter than `z`. The output may
+/// alias the inputs.
+namespace batch {
+
+namespace details {
+template <typename V, typename T>
+inline four<V> load(const four<T> *x, std::size_t i) {
+  if constexpr (is_simd_v<V>) {
+    four<V> v;
+    for (std::size_t k = 0; k < 4; ++k)
+      for (std::size_t lane = 0; lane < V::size(); ++lane)
+        v[k].v[lane] = x[i + lane][k];
+    return v;
+  } else {
+    return x[i];
+  }
+}
+
+template <typename V, typename T>
+inline void store(const four<V> &v, four<T> *z, std::size_t i) {
+  if constexpr (is_simd_v<V>) {
+    for (std::size_t k = 0; k < 4; ++k)
+      for (std::size_t lane = 0; lane < V::size(); ++lane)
+        z[i + lane][k] = v[k][lane];
+  } else {
+    z[i] = v;
+  }
+}
+
+/// \brief Calculates `z_i = op(x_i, y_i)` with vectors of `W` lanes and the
+/// remaining elements one by one, with the same operations.
+template <std::size_t W, typename T, typename Op>
+void apply(const Op &op, span<const four<T>> x, span<const four<T>> y,
+           span<four<T>> z) {
+  using V = simd<T, W>;
+  const std::size_t n = z.size();
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    store(op(load<V>(x.data(), i), load<V>(y.data(), i)), z.data(), i);
+  for (; i < n; ++i)
+    store(op(load<T>(x.data(), i), load<T>(y.data(), i)), z.data(), i);
+}
+
+template <typename T, typename Op>
+void apply(const Op &op, span<const four<T>> x, span<const four<T>> y,
+           span<four<T>> z) {
+  if (x.size() < z.size() || y.size() < z.size())
+    throw std::invalid_argument("quadword::batch: x or y is shorter than z");
+  twofloat::details::vectorized<T>(
+      [&](auto w) { apply<decltype(w)::value>(op, x, y, z); });
+}
+}  // namespace details
+
+/// \brief Adds two arrays of quad-word numbers element-wise.
+/// \details See `quadword::add` for the supported modes.
+/// \param x The first summands.
+/// \param y The second summands.
+/// \param z The array receiving the sums.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void add(span<const four<T>> x, span<const four<T>> y,
+                span<four<T>> z) {
+  details::apply(
+      [](const auto &a, const auto &b) { return quadword::add<mode>(a, b); },
+      x, y, z);
+}
+
+/// \brief Subtracts two arrays of quad-word numbers element-wise.
+/// \details See `quadword::sub` for the supported modes.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void sub(span<const four<T>> x, span<const four<T>> y,
+                span<four<T>> z) {
+  details::apply(
+      [](const auto &a, const auto &b) { return quadword::sub<mode>(a, b); },
+      x, y, z);
+}
+
+/// \brief Multiplies two arrays of quad-word numbers element-wise.
+/// \details See `quadword::mul` for the supported modes.
+/// \tparam mode The mode (sloppy or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode mode, bool useFMA, typename T>
+inline void mul(span<const four<T>> x, span<const four<T>> y,
+                span<four<T>> z) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return quadword::mul<mode, useFMA>(a, b);
+      },
+      x, y, z);
+}
+
+/// \brief Divides two arrays of quad-word numbers element-wise.
+/// \details See `quadword::div` for the supported modes.
+/// \tparam mode The mode (sloppy or accurate).
+/// \tparam useFMA Whether to use FMA instructions.
+template <Mode mode, bool useFMA, typename T>
+inline void div(span<const four<T>> x, span<const four<T>> y,
+                span<four<T>> z) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return quadword::div<mode, useFMA>(a, b);
+      },
+      x, y, z);
+}
+
+}  // namespace batch
+}  // namespace quadword
+}  // namespace twofloat
@@ -0,0 +1,751 @@
+#pragma once
+
+/// \file blas.hpp
+/// \brief Implements linear algebra operations on vectors and matrices of
+/// double-word numbers.
+
+#include <algorithm>
+#include <cstddef>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/details/target.hpp>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace twofloat {
+
+/// \brief Linear algebra operations on double-word numbers in the style of
+/// BLAS.
+/// \details The matrices are stored in row-major order as arrays of `two<T>`,
+/// and the leading dimension (e.g. `lda`) is the distance between two rows.
+/// Vectors are either spans of contiguous elements or pointers with an
+/// increment (e.g. `incx`), the distance between two elements. The arithmetic
+/// is selected by a policy (see policy.hpp); `policy::doubleword<true>`
+/// corresponds to `doubleword::mul<Mode::Fast, true>` and
+/// `doubleword::add<Mode::Accurate>`.
+///
+/// All results are normalized with `Policy::normalize` when they are stored,
+/// and every element is calculated with the same sequence of operations
+/// regardless of the vector instructions and the number of threads.
+namespace blas {
+
+namespace details {
+/// \brief The number of rows of the tiles of C that are computed by the
+/// micro-kernel.
+inline constexpr std::size_t microRows = 4;
+
+/// \brief The number of vectors per row of the tiles of C that are computed
+/// by the micro-kernel.
+inline constexpr std::size_t microVectors = 2;
+
+/// \brief The block sizes in the dimensions M, N and K.
+/// \details A block of `blockRows` rows of A and `blockDepth` columns is
+/// packed so that it stays in the L2 cache, and a panel of `blockDepth` rows
+/// and one micro-tile of columns of B stays in the L1 cache. The results do
+/// not depend on the block sizes.
+inline constexpr std::size_t blockRows = 64;
+inline constexpr std::size_t blockCols = 256;
+inline constexpr std::size_t blockDepth = 256;
+
+/// \brief The operands of a matrix product.
+template <typename T>
+struct gemmArgs {
+  std::size_t M, N, K;
+  const two<T> *A;
+  std::size_t lda;
+  const two<T> *B;
+  std::size_t ldb;
+  two<T> *C;
+  std::size_t ldc;
+};
+
+/// \brief Packs the rows `[m0, m0 + mc)` and columns `[k0, k0 + kc)` of A
+/// into panels of `microRows` rows. Within a panel, the high words and the low
+/// words of each column are contiguous. Missing rows are padded with zeros.
+template <typename T>
+void packA(const gemmArgs<T> &args, std::size_t m0, std::size_t mc,
+           std::size_t k0, std::size_t kc, T *h, T *l) {
+  constexpr std::size_t MR = microRows;
+  for (std::size_t p = 0; p < mc; p += MR) {
+    for (std::size_t k = 0; k < kc; ++k) {
+      for (std::size_t i = 0; i < MR; ++i) {
+        two<T> a;
+        if (p + i < mc) a = args.A[(m0 + p + i) * args.lda + k0 + k];
+        h[(p * kc) + k * MR + i] = a.h;
+        l[(p * kc) + k * MR + i] = a.l;
+      }
+    }
+  }
+}
+
+/// \brief Packs the rows `[k0, k0 + kc)` and columns `[n0, n0 + nc)` of B
+/// into panels of `NR` columns, like `packA`.
+template <std::size_t NR, typename T>
+void packB(const gemmArgs<T> &args, std::size_t k0, std::size_t kc,
+           std::size_t n0, std::size_t nc, T *h, T *l) {
+  for (std::size_t p = 0; p < nc; p += NR) {
+    for (std::size_t k = 0; k < kc; ++k) {
+      const two<T> *row = args.B + (k0 + k) * args.ldb + n0 + p;
+      for (std::size_t j = 0; j < NR; ++j) {
+        two<T> b;
+        if (p + j < nc) b = row[j];
+        h[(p * kc) + k * NR + j] = b.h;
+        l[(p * kc) + k * NR + j] = b.l;
+      }
+    }
+  }
+}
+
+/// \brief Accumulates the product of a packed panel of A and a packed panel
+/// of B into a tile of `microRows` x `microVectors` vectors.
+template <typename P, typename V, typename T>
+inline void microKernel(std::size_t kc, const T *ah, const T *al, const T *bh,
+                        const T *bl, two<V> (&acc)[microRows][microVectors]) {
+  constexpr std::size_t MR = microRows, NV = microVectors, W = V::size();
+  for (std::size_t k = 0; k < kc; ++k) {
+    two<V> b[NV];
+    for (std::size_t v = 0; v < NV; ++v)
+      b[v] = {V::load(bh + (k * NV + v) * W), V::load(bl + (k * NV + v) * W)};
+    for (std::size_t i = 0; i < MR; ++i) {
+      two<V> a(V(ah[k * MR + i]), V(al[k * MR + i]));
+      for (std::size_t v = 0; v < NV; ++v)
+        acc[i][v] = P::fma(a, b[v], acc[i][v]);
+    }
+  }
+}
+
+/// \brief Computes the block of C with the rows `[m0, m0 + mc)` and the
+/// columns `[n0, n0 + nc)` with vectors of `W` lanes.
+template <typename P, std::size_t W, typename T>
+void gemmBlock(const gemmArgs<T> &args, std::size_t m0, std::size_t mc,
+               std::size_t n0, std::size_t nc) {
+  using V = simd<T, W>;
+  constexpr std::size_t MR = microRows, NV = microVectors, NR = NV * W;
+
+  const std::size_t mcPadded = (mc + MR - 1) / MR * MR;
+  const std::size_t ncPadded = (nc + NR - 1) / NR * NR;
+  const std::size_t kcMax = std::min(blockDepth, args.K);
+  std::vector<T> ah(mcPadded * kcMax), al(mcPadded * kcMax);
+  std::vector<T> bh(ncPadded * kcMax), bl(ncPadded * kcMax);
+
+  // Without columns of A, the loop over K does not initialize C
+  if (args.K == 0) {
+    for (std::size_t i = 0; i < mc; ++i)
+      for (std::size_t j = 0; j < nc; ++j)
+        args.C[(m0 + i) * args.ldc + n0 + j] = two<T>();
+    return;
+  }
+
+  for (std::size_t k0 = 0; k0 < args.K; k0 += blockDepth) {
+    const std::size_t kc = std::min(blockDepth, args.K - k0);
+    const bool first = k0 == 0, last = k0 + kc == args.K;
+    packA(args, m0, mc, k0, kc, ah.data(), al.data());
+    packB<NR>(args, k0, kc, n0, nc, bh.data(), bl.data());
+
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+      for (std::size_t ir = 0; ir < mc; ir += MR) {
+        const std::size_t rows = std::min(MR, mc - ir);
+        const std::size_t cols = std::min(NR, nc - jr);
+
+        // The partial sums are stored in C between the blocks of K, without
+        // normalization
+        two<V> acc[MR][NV];
+        T ch[NR], cl[NR];
+        for (std::size_t i = 0; i < MR; ++i) {
+          two<T> *c = args.C + (m0 + ir + i) * args.ldc + n0 + jr;
+          for (std::size_t j = 0; j < NR; ++j) {
+            two<T> cij;
+            if (!first && i < rows && j < cols) cij = c[j];
+            ch[j] = cij.h;
+            cl[j] = cij.l;
+          }
+          for (std::size_t v = 0; v < NV; ++v)
+            acc[i][v] = {V::load(ch + v * W), V::load(cl + v * W)};
+        }
+
+        microKernel<P>(kc, ah.data() + ir * kc, al.data() + ir * kc,
+                       bh.data() + jr * kc, bl.data() + jr * kc, acc);
+
+        for (std::size_t i = 0; i < rows; ++i) {
+          two<T> *c = args.C + (m0 + ir + i) * args.ldc + n0 + jr;
+          for (std::size_t v = 0; v < NV; ++v) {
+            two<V> cv = last ? P::normalize(acc[i][v]) : acc[i][v];
+            cv.h.store(ch + v * W);
+            cv.l.store(cl + v * W);
+          }
+          for (std::size_t j = 0; j < cols; ++j) c[j] = two<T>(ch[j], cl[j]);
+        }
+      }
+    }
+  }
+}
+
+// Versions that are compiled for the vector instructions of the CPU regardless
+// of the compiler flags
+template <typename P, typename T>
+TWOFLOAT_TARGET_FMA void gemmBlockAVX2(const gemmArgs<T> &args,
+                                       std::size_t m0, std::size_t mc,
+                                       std::size_t n0, std::size_t nc) {
+  gemmBlock<P, 32 / sizeof(T)>(args, m0, mc, n0, nc);
+}
+
+template <typename P, typename T>
+TWOFLOAT_TARGET_AVX512 void gemmBlockAVX512(const gemmArgs<T> &args,
+                                            std::size_t m0, std::size_t mc,
+                                            std::size_t n0, std::size_t nc) {
+  gemmBlock<P, 64 / sizeof(T)>(args, m0, mc, n0, nc);
+}
+}  // namespace details
+
+/// \brief Calculates the matrix product `C = A B`.
+/// \details The matrices are packed in blocks into a structure-of-arrays
+/// layout, and a micro-kernel computes tiles of C with the vector
+/// instructions of the CPU (selected at runtime, see cpu.hpp). Each element of
+/// C is accumulated in the order of k with `Policy::fma`, i.e. `c = fma(a_ik,
+/// b_kj, c)` starting from zero, and normalized with `Policy::normalize`.
+/// The results are therefore bitwise identical to this triple loop,
+/// independent of the instruction set and of the number of threads. With
+/// `policy::pair`, the result is only faithful for `K` below the bound of
+/// Lange and Rump (see `pair::faithfulOperations`).
+/// \param M The number of rows of A and C.
+/// \param N The number of columns of B and C.
+/// \param K The number of columns of A and rows of B.
+/// \param A The M x K matrix A.
+/// \param lda The leading dimension of A, at least K.
+/// \param B The K x N matrix B.
+/// \param ldb The leading dimension of B, at least N.
+/// \param C The M x N matrix C, which must not overlap A or B.
+/// \param ldc The leading dimension of C, at least N.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void gemm(std::size_t M, std::size_t N, std::size_t K, const two<T> *A,
+          std::size_t lda, const two<T> *B, std::size_t ldb, two<T> *C,
+          std::size_t ldc, unsigned threads = 0) {
+  using namespace details;
+  const gemmArgs<T> args{M, N, K, A, lda, B, ldb, C, ldc};
+  const std::size_t blocksM = (M + blockRows - 1) / blockRows;
+  const std::size_t blocksN = (N + blockCols - 1) / blockCols;
+  const cpu::InstructionSet isa = cpu::instructionSet();
+
+  twofloat::details::parallelFor(
+      blocksM * blocksN, threads, [&](std::size_t b) {
+        const std::size_t m0 = b / blocksN * blockRows;
+        const std::size_t n0 = b % blocksN * blockCols;
+        const std::size_t mc = std::min(blockRows, M - m0);
+        const std::size_t nc = std::min(blockCols, N - n0);
+#if defined(TWOFLOAT_HAS_AVX512)
+        if (isa == cpu::InstructionSet::AVX512)
+          return gemmBlockAVX512<Policy>(args, m0, mc, n0, nc);
+#endif
+#if defined(TWOFLOAT_HAS_AVX2)
+        if (isa == cpu::InstructionSet::AVX2)
+          return gemmBlockAVX2<Policy>(args, m0, mc, n0, nc);
+#endif
+        gemmBlock<Policy, 16 / sizeof(T)>(args, m0, mc, n0, nc);
+      });
+}
+
+/// \brief Selects the triangle of a triangular matrix.
+enum class Uplo { Upper, Lower };
+
+/// \brief Selects whether the diagonal of a triangular matrix is implicitly
+/// one (`Unit`) or stored in the matrix (`NonUnit`).
+enum class Diag { NonUnit, Unit };
+
+namespace details {
+/// \brief The number of rows of A per block of work of `gemv` and the number
+/// of problems per block of work of the batched routines.
+inline constexpr std::size_t blockItems = 256;
+
+using twofloat::details::identity_t;
+using twofloat::details::vectorized;
+
+/// \brief An increment of one that is known at compile time, which turns the
+/// strided accesses of the kernels into contiguous ones.
+using unit = std::integral_constant<std::size_t, 1>;
+
+template <typename V, typename T, typename Inc, std::size_t... I>
+inline two<V> gatherLanes(const two<T> *x, Inc inc, std::index_sequence<I...>) {
+  using N = typename V::native_type;
+  return two<V>(V(N{x[I * inc].h...}), V(N{x[I * inc].l...}));
+}
+
+/// \brief Loads the `count` elements `x[0], x[inc], ...` into the lanes of a
+/// vector. The remaining lanes are zero.
+/// \details Full vectors are loaded without a round trip through memory, and
+/// contiguous ones with shuffles.
+template <typename V, typename T, typename Inc>
+inline two<V> gather(const two<T> *x, Inc inc, std::size_t count) {
+  static_assert(sizeof(two<T>) == 2 * sizeof(T));
+  if (count == V::size()) {
+    two<V> res;
+    if constexpr (std::is_same_v<Inc, unit>)
+      load_interleaved(reinterpret_cast<const T *>(x), res.h, res.l);
+    else
+      res = gatherLanes<V>(x, inc, std::make_index_sequence<V::size()>());
+    return res;
+  }
+
+  T h[V::size()], l[V::size()];
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    two<T> xk;
+    if (k < count) xk = x[k * inc];
+    h[k] = xk.h;
+    l[k] = xk.l;
+  }
+  return {V::load(h), V::load(l)};
+}
+
+/// \brief Stores the first `count` lanes of a vector to `x[0], x[inc], ...`.
+template <typename V, typename T, typename Inc>
+inline void scatter(const two<V> &v, two<T> *x, Inc inc, std::size_t count) {
+  if constexpr (std::is_same_v<Inc, unit>) {
+    if (count == V::size())
+      return store_interleaved(reinterpret_cast<T *>(x), v.h, v.l);
+  }
+  for (std::size_t k = 0; k < count; ++k) x[k * inc] = two<T>(v.h[k], v.l[k]);
+}
+
+template <typename V, typename T>
+inline two<V> broadcast(const two<T> &x) {
+  return two<V>(V(x.h), V(x.l));
+}
+
+/// \brief Calculates `y = alpha x + y` with vectors of `W` lanes.
+template <typename P, std::size_t W, typename T, typename IncX, typename IncY>
+void axpyKernel(std::size_t n, const two<T> &alpha, const two<T> *x,
+                IncX incx, two<T> *y, IncY incy) {
+  using V = simd<T, W>;
+  const two<V> a = broadcast<V>(alpha);
+  for (std::size_t i = 0; i < n; i += W) {
+    const std::size_t count = std::min(W, n - i);
+    two<V> xi = gather<V>(x + i * incx, incx, count);
+    two<V> yi = gather<V>(y + i * incy, incy, count);
+    scatter(P::normalize(P::fma(a, xi, yi)), y + i * incy, incy, count);
+  }
+}
+
+/// \brief Calculates `x = alpha x` with vectors of `W` lanes.
+template <typename P, std::size_t W, typename T, typename Inc>
+void scalKernel(std::size_t n, const two<T> &alpha, two<T> *x, Inc inc) {
+  using V = simd<T, W>;
+  const two<V> a = broadcast<V>(alpha);
+  for (std::size_t i = 0; i < n; i += W) {
+    const std::size_t count = std::min(W, n - i);
+    two<V> xi = gather<V>(x + i * inc, inc, count);
+    scatter(P::normalize(P::mul(a, xi)), x + i * inc, inc, count);
+  }
+}
+
+/// \brief Calculates the rows `[m0, m0 + mc)` of `y = A x`. The lanes of the
+/// vectors hold consecutive rows, which are accumulated in the order of the
+/// columns like in `gemm`.
+template <typename P, std::size_t W, typename T, typename IncX, typename IncY>
+void gemvKernel(std::size_t m0, std::size_t mc, std::size_t N,
+                const two<T> *A, std::size_t lda, const two<T> *x, IncX incx,
+                two<T> *y, IncY incy) {
+  using V = simd<T, W>;
+  for (std::size_t i = m0; i < m0 + mc; i += W) {
+    const std::size_t rows = std::min(W, m0 + mc - i);
+    two<V> acc;
+    for (std::size_t j = 0; j < N; ++j)
+      acc = P::fma(gather<V>(A + i * lda + j, lda, rows),
+                   broadcast<V>(x[j * incx]), acc);
+    scatter(P::normalize(acc), y + i * incy, incy, rows);
+  }
+}
+
+/// \brief Solves `A x = b` for a triangular matrix, with vectors of `W`
+/// lanes.
+/// \details Once `x_j` is known, it is eliminated from the remaining
+/// equations with the column j of A (a strided `axpy`), so the inner loop is
+/// vectorized. Each `x_i` is thus calculated as `b_i - sum_j a_ij x_j`, with
+/// the sum in the order in which the `x_j` are solved, and then divided by
+/// `a_ii`.
+template <typename P, std::size_t W, typename T, typename Inc>
+void trsvKernel(Uplo uplo, Diag diag, std::size_t N, const two<T> *A,
+                std::size_t lda, two<T> *x, Inc inc) {
+  using V = simd<T, W>;
+  const bool lower = uplo == Uplo::Lower;
+  for (std::size_t step = 0; step < N; ++step) {
+    const std::size_t j = lower ? step : N - 1 - step;
+    two<T> xj = x[j * inc];
+    if (diag == Diag::NonUnit) xj = P::div(xj, A[j * lda + j]);
+    xj = P::normalize(xj);
+    x[j * inc] = xj;
+
+    // The partial sums of the unknowns are stored in x without normalization
+    const two<V> minusXj = broadcast<V>(two<T>(-xj.h, -xj.l));
+    const std::size_t begin = lower ? j + 1 : 0, end = lower ? N : j;
+    for (std::size_t i = begin; i < end; i += W) {
+      const std::size_t rows = std::min(W, end - i);
+      two<V> xi = gather<V>(x + i * inc, inc, rows);
+      xi = P::fma(gather<V>(A + i * lda + j, lda, rows), minusXj, xi);
+      scatter(xi, x + i * inc, inc, rows);
+    }
+  }
+}
+
+/// \brief Calculates the rows `[m0, m0 + mc)` of `A = alpha x y^T + A` with
+/// vectors of `W` lanes.
+template <typename P, std::size_t W, typename T, typename IncX, typename IncY>
+void gerKernel(std::size_t m0, std::size_t mc, std::size_t N,
+               const two<T> &alpha, const two<T> *x, IncX incx,
+               const two<T> *y, IncY incy, two<T> *A, std::size_t lda) {
+  using V = simd<T, W>;
+  for (std::size_t i = m0; i < m0 + mc; ++i) {
+    const two<V> t = broadcast<V>(P::mul(alpha, x[i * incx]));
+    two<T> *row = A + i * lda;
+    for (std::size_t j = 0; j < N; j += W) {
+      const std::size_t cols = std::min(W, N - j);
+      two<V> aij = gather<V>(row + j, unit(), cols);
+      two<V> yj = gather<V>(y + j * incy, incy, cols);
+      scatter(P::normalize(P::fma(t, yj, aij)), row + j, unit(), cols);
+    }
+  }
+}
+}  // namespace details
+
+/// \brief Calculates `y = alpha x + y`.
+/// \details Each element is calculated as `Policy::fma(alpha, x_i, y_i)`.
+/// The elements are processed in vectors of the widest instruction set of the
+/// CPU, with a fast path for contiguous vectors.
+/// \param n The number of elements.
+/// \param alpha The scalar.
+/// \param x The vector x.
+/// \param incx The increment of x, at least 1.
+/// \param y The vector y, which must not overlap x.
+/// \param incy The increment of y, at least 1.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void axpy(std::size_t n, const two<T> &alpha, const two<T> *x,
+          std::size_t incx, two<T> *y, std::size_t incy) {
+  details::vectorized<T>([&](auto w) {
+    constexpr std::size_t W = decltype(w)::value;
+    if (incx == 1 && incy == 1)
+      details::axpyKernel<Policy, W>(n, alpha, x, details::unit(), y,
+                                     details::unit());
+    else
+      details::axpyKernel<Policy, W>(n, alpha, x, incx, y, incy);
+  });
+}
+
+/// \brief Calculates `y = alpha x + y` for contiguous vectors, see `axpy`.
+/// \param y The vector y, of the same size as `x`.
+/// \throws std::invalid_argument if the sizes of `x` and `y` differ.
+template <typename Policy, typename T>
+void axpy(const two<T> &alpha, span<const two<details::identity_t<T>>> x,
+          span<two<details::identity_t<T>>> y) {
+  if (x.size() != y.size())
+    throw std::invalid_argument("blas::axpy: x and y have different sizes");
+  axpy<Policy>(x.size(), alpha, x.data(), 1, y.data(), 1);
+}
+
+/// \brief Calculates `x = alpha x`.
+/// \details Each element is calculated as `Policy::mul(alpha, x_i)`.
+/// \param n The number of elements.
+/// \param alpha The scalar.
+/// \param x The vector x.
+/// \param incx The increment of x, at least 1.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void scal(std::size_t n, const two<T> &alpha, two<T> *x, std::size_t incx) {
+  details::vectorized<T>([&](auto w) {
+    constexpr std::size_t W = decltype(w)::value;
+    if (incx == 1)
+      details::scalKernel<Policy, W>(n, alpha, x, details::unit());
+    else
+      details::scalKernel<Policy, W>(n, alpha, x, incx);
+  });
+}
+
+/// \brief Calculates `x = alpha x` for a contiguous vector, see `scal`.
+template <typename Policy, typename T>
+void scal(const two<T> &alpha, span<two<details::identity_t<T>>> x) {
+  scal<Policy>(x.size(), alpha, x.data(), 1);
+}
+
+/// \brief Calculates the matrix-vector product `y = A x`.
+/// \details Each element of y is accumulated in the order of the columns with
+/// `Policy::fma`, i.e. `y_i = fma(a_ij, x_j, y_i)` starting from zero, so the
+/// result is bitwise identical to `gemm` with a single column. The lanes of
+/// the vectors hold consecutive rows of A.
+/// \param M The number of rows of A and elements of y.
+/// \param N The number of columns of A and elements of x.
+/// \param A The M x N matrix A.
+/// \param lda The leading dimension of A, at least N.
+/// \param x The vector x.
+/// \param incx The increment of x, at least 1.
+/// \param y The vector y, which must not overlap A or x.
+/// \param incy The increment of y, at least 1.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void gemv(std::size_t M, std::size_t N, const two<T> *A, std::size_t lda,
+          const two<T> *x, std::size_t incx, two<T> *y, std::size_t incy,
+          unsigned threads = 0) {
+  using details::blockItems;
+  twofloat::details::parallelFor(
+      (M + blockItems - 1) / blockItems, threads, [&](std::size_t b) {
+        const std::size_t m0 = b * blockItems;
+        const std::size_t mc = std::min(blockItems, M - m0);
+        details::vectorized<T>([&](auto w) {
+          constexpr std::size_t W = decltype(w)::value;
+          if (incx == 1 && incy == 1)
+            details::gemvKernel<Policy, W>(m0, mc, N, A, lda, x,
+                                           details::unit(), y,
+                                           details::unit());
+          else
+            details::gemvKernel<Policy, W>(m0, mc, N, A, lda, x, incx, y,
+                                           incy);
+        });
+      });
+}
+
+/// \brief Calculates `y = A x` for contiguous vectors, see `gemv`.
+/// \param A The matrix A with `y.size()` rows and `x.size()` columns.
+/// \throws std::invalid_argument if `lda` is less than `x.size()`.
+template <typename Policy, typename T>
+void gemv(const two<T> *A, std::size_t lda,
+          span<const two<details::identity_t<T>>> x,
+          span<two<details::identity_t<T>>> y, unsigned threads = 0) {
+  if (lda < x.size())
+    throw std::invalid_argument(
+        "blas::gemv: lda is less than the number of columns");
+  gemv<Policy>(y.size(), x.size(), A, lda, x.data(), 1, y.data(), 1,
+               threads);
+}
+
+/// \brief Solves the triangular system `A x = b`.
+/// \details The unknowns are solved in the order of the rows (`Uplo::Lower`)
+/// or in the reverse order (`Uplo::Upper`). Each `x_i` is calculated as
+/// `b_i - sum_j a_ij x_j` with `Policy::fma`, with the sum in the order in
+/// which the `x_j` are solved, divided by `a_ii` with `Policy::div` and
+/// normalized.
+/// \param uplo The triangle of A that is used.
+/// \param diag Whether the diagonal of A is implicitly one.
+/// \param N The order of A.
+/// \param A The N x N matrix A. The other triangle is not accessed.
+/// \param lda The leading dimension of A, at least N.
+/// \param x On entry the right-hand side b, on exit the solution x.
+/// \param incx The increment of x, at least 1.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void trsv(Uplo uplo, Diag diag, std::size_t N, const two<T> *A,
+          std::size_t lda, two<T> *x, std::size_t incx) {
+  details::vectorized<T>([&](auto w) {
+    constexpr std::size_t W = decltype(w)::value;
+    if (incx == 1)
+      details::trsvKernel<Policy, W>(uplo, diag, N, A, lda, x,
+                                     details::unit());
+    else
+      details::trsvKernel<Policy, W>(uplo, diag, N, A, lda, x, incx);
+  });
+}
+
+/// \brief Solves `A x = b` for a contiguous vector, see `trsv`.
+/// \throws std::invalid_argument if `lda` is less than `x.size()`.
+template <typename Policy, typename T>
+void trsv(Uplo uplo, Diag diag, const two<T> *A, std::size_t lda,
+          span<two<details::identity_t<T>>> x) {
+  if (lda < x.size())
+    throw std::invalid_argument("blas::trsv: lda is less than the order");
+  trsv<Policy>(uplo, diag, x.size(), A, lda, x.data(), 1);
+}
+
+/// \brief Calculates the rank-1 update `A = alpha x y^T + A`.
+/// \details Each row is scaled as `t_i = Policy::mul(alpha, x_i)`, and each
+/// element is calculated as `Policy::fma(t_i, y_j, a_ij)`.
+/// \param M The number of rows of A and elements of x.
+/// \param N The number of columns of A and elements of y.
+/// \param alpha The scalar.
+/// \param x The vector x.
+/// \param incx The increment of x, at least 1.
+/// \param y The vector y.
+/// \param incy The increment of y, at least 1.
+/// \param A The M x N matrix A, which must not overlap x or y.
+/// \param lda The leading dimension of A, at least N.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void ger(std::size_t M, std::size_t N, const two<T> &alpha, const two<T> *x,
+         std::size_t incx, const two<T> *y, std::size_t incy, two<T> *A,
+         std::size_t lda) {
+  details::vectorized<T>([&](auto w) {
+    constexpr std::size_t W = decltype(w)::value;
+    if (incx == 1 && incy == 1)
+      details::gerKernel<Policy, W>(0, M, N, alpha, x, details::unit(), y,
+                                    details::unit(), A, lda);
+    else
+      details::gerKernel<Policy, W>(0, M, N, alpha, x, incx, y, incy, A, lda);
+  });
+}
+
+/// \brief Calculates `A = alpha x y^T + A` for contiguous vectors, see `ger`.
+/// \param A The matrix A with `x.size()` rows and `y.size()` columns.
+/// \throws std::invalid_argument if `lda` is less than `y.size()`.
+template <typename Policy, typename T>
+void ger(const two<T> &alpha, span<const two<details::identity_t<T>>> x,
+         span<const two<details::identity_t<T>>> y, two<T> *A,
+         std::size_t lda) {
+  if (lda < y.size())
+    throw std::invalid_argument(
+        "blas::ger: lda is less than the number of columns");
+  ger<Policy>(x.size(), y.size(), alpha, x.data(), 1, y.data(), 1, A, lda);
+}
+
+/// \brief Batched versions of the routines for many small problems of the
+/// same size.
+/// \details The operands of problem `b` start at `stride * b` elements after
+/// the given pointers (e.g. `x + strideX * b`), and the vectors of each
+/// problem are contiguous. The lanes of the vectors hold different problems,
+/// so the routines are vectorized even if the vectors are shorter than a
+/// vector register. Each problem is calculated with the same operations as
+/// the corresponding unbatched routine, so the results are bitwise identical.
+namespace batch {
+
+namespace details {
+using namespace blas::details;
+
+template <typename P, std::size_t W, typename T>
+void axpyKernel(std::size_t n, std::size_t b0, std::size_t bc,
+                const two<T> *alpha, const two<T> *x, std::size_t strideX,
+                two<T> *y, std::size_t strideY) {
+  using V = simd<T, W>;
+  for (std::size_t b = b0; b < b0 + bc; b += W) {
+    const std::size_t count = std::min(W, b0 + bc - b);
+    const two<V> a = gather<V>(alpha + b, unit(), count);
+    for (std::size_t i = 0; i < n; ++i) {
+      two<T> *yi = y + b * strideY + i;
+      two<V> xv = gather<V>(x + b * strideX + i, strideX, count);
+      two<V> yv = gather<V>(yi, strideY, count);
+      scatter(P::normalize(P::fma(a, xv, yv)), yi, strideY, count);
+    }
+  }
+}
+
+template <typename P, std::size_t W, typename T>
+void scalKernel(std::size_t n, std::size_t b0, std::size_t bc,
+                const two<T> *alpha, two<T> *x, std::size_t strideX) {
+  using V = simd<T, W>;
+  for (std::size_t b = b0; b < b0 + bc; b += W) {
+    const std::size_t count = std::min(W, b0 + bc - b);
+    const two<V> a = gather<V>(alpha + b, unit(), count);
+    for (std::size_t i = 0; i < n; ++i) {
+      two<T> *xi = x + b * strideX + i;
+      two<V> xv = gather<V>(xi, strideX, count);
+      scatter(P::normalize(P::mul(a, xv)), xi, strideX, count);
+    }
+  }
+}
+
+template <typename P, std::size_t W, typename T>
+void gemvKernel(std::size_t M, std::size_t N, std::size_t b0, std::size_t bc,
+                const two<T> *A, std::size_t lda, std::size_t strideA,
+                const two<T> *x, std::size_t strideX, two<T> *y,
+                std::size_t strideY) {
+  using V = simd<T, W>;
+  for (std::size_t b = b0; b < b0 + bc; b += W) {
+    const std::size_t count = std::min(W, b0 + bc - b);
+    for (std::size_t i = 0; i < M; ++i) {
+      two<V> acc;
+      for (std::size_t j = 0; j < N; ++j)
+        acc = P::fma(gather<V>(A + b * strideA + i * lda + j, strideA, count),
+                     gather<V>(x + b * strideX + j, strideX, count), acc);
+      scatter(P::normalize(acc), y + b * strideY + i, strideY, count);
+    }
+  }
+}
+
+/// \brief Calls `kernel(W, b0, bc)` in parallel for the blocks of problems.
+template <typename T, typename Kernel>
+void forBlocks(std::size_t batchSize, unsigned threads, const Kernel &kernel) {
+  twofloat::details::parallelFor(
+      (batchSize + blockItems - 1) / blockItems, threads, [&](std::size_t b) {
+        const std::size_t b0 = b * blockItems;
+        const std::size_t bc = std::min(blockItems, batchSize - b0);
+        vectorized<T>([&](auto w) { kernel(w, b0, bc); });
+      });
+}
+}  // namespace details
+
+/// \brief Calculates `y_b = alpha_b x_b + y_b` for `batchSize` problems, see
+/// blas::axpy.
+/// \param n The number of elements of each vector.
+/// \param batchSize The number of problems.
+/// \param alpha The `batchSize` scalars.
+/// \param x The vectors x.
+/// \param strideX The distance between two vectors x, at least n.
+/// \param y The vectors y, which must not overlap x.
+/// \param strideY The distance between two vectors y, at least n.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void axpy(std::size_t n, std::size_t batchSize, const two<T> *alpha,
+          const two<T> *x, std::size_t strideX, two<T> *y,
+          std::size_t strideY, unsigned threads = 0) {
+  details::forBlocks<T>(batchSize, threads, [&](auto w, auto b0, auto bc) {
+    details::axpyKernel<Policy, decltype(w)::value>(n, b0, bc, alpha, x,
+                                                    strideX, y, strideY);
+  });
+}
+
+/// \brief Calculates `x_b = alpha_b x_b` for `batchSize` problems, see
+/// blas::scal.
+/// \param n The number of elements of each vector.
+/// \param batchSize The number of problems.
+/// \param alpha The `batchSize` scalars.
+/// \param x The vectors x.
+/// \param strideX The distance between two vectors x, at least n.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void scal(std::size_t n, std::size_t batchSize, const two<T> *alpha,
+          two<T> *x, std::size_t strideX, unsigned threads = 0) {
+  details::forBlocks<T>(batchSize, threads, [&](auto w, auto b0, auto bc) {
+    details::scalKernel<Policy, decltype(w)::value>(n, b0, bc, alpha, x,
+                                                    strideX);
+  });
+}
+
+/// \brief Calculates `y_b = A_b x_b` for `batchSize` problems, see
+/// blas::gemv.
+/// \param M The number of rows of each matrix A.
+/// \param N The number of columns of each matrix A.
+/// \param batchSize The number of problems.
+/// \param A The matrices A.
+/// \param lda The leading dimension of the matrices A, at least N.
+/// \param strideA The distance between two matrices A, at least `M * lda`.
+/// \param x The vectors x.
+/// \param strideX The distance between two vectors x, at least N.
+/// \param y The vectors y, which must not overlap A or x.
+/// \param strideY The distance between two vectors y, at least M.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void gemv(std::size_t M, std::size_t N, std::size_t batchSize,
+          const two<T> *A, std::size_t lda, std::size_t strideA,
+          const two<T> *x, std::size_t strideX, two<T> *y,
+          std::size_t strideY, unsigned threads = 0) {
+  details::forBlocks<T>(batchSize, threads, [&](auto w, auto b0, auto bc) {
+    details::gemvKernel<Policy, decltype(w)::value>(
+        M, N, b0, bc, A, lda, strideA, x, strideX, y, strideY);
+  });
+}
+
+}  // namespace batch
+
+}  // namespace blas
+}  // namespace twofloat
@@ -0,0 +1,448 @@
+#pragma once
+
+/// \file charconv.hpp
+/// \brief Implements the conversion of double-word numbers from and to
+/// decimal strings, like `std::from_chars` and `std::to_chars`.
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/details/decimal-tables.hpp>
+#include <libtwofloat/limits.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace twofloat {
+
+namespace details {
+__extension__ typedef unsigned __int128 uint128;
+
+/// \brief The number of significant digits that are parsed. More digits
+/// only affect the decimal exponent.
+inline constexpr int maxParsedDigits = 38;
+
+/// \brief The largest number of significant digits that are printed.
+inline constexpr int maxPrintedDigits = 36;
+
+/// \brief A number `m 2^e` with a 128-bit significand.
+struct wideFloat {
+  uint128 m;
+  int e;
+};
+
+inline int countlZero(uint128 x) {
+  const std::uint64_t hi = static_cast<std::uint64_t>(x >> 64);
+  return hi ? __builtin_clzll(hi)
+            : 64 + __builtin_clzll(static_cast<std::uint64_t>(x));
+}
+
+/// \brief Shifts the most significant bit of `m != 0` to bit 127.
+inline wideFloat normalize(uint128 m, int e) {
+  const int s = countlZero(m);
+  return {m << s, e - s};
+}
+
+/// \brief Multiplies two normalized numbers.
+/// \details The result is normalized and truncated to 128 bits, i.e. its
+/// relative error is below 2^-126.
+inline wideFloat multiply(const wideFloat &a, const wideFloat &b) {
+  const std::uint64_t a1 = a.m >> 64, a0 = static_cast<std::uint64_t>(a.m);
+  const std::uint64_t b1 = b.m >> 64, b0 = static_cast<std::uint64_t>(b.m);
+  const uint128 p11 = uint128(a1) * b1, p10 = uint128(a1) * b0,
+                p01 = uint128(a0) * b1, p00 = uint128(a0) * b0;
+  const uint128 mid = (p00 >> 64) + static_cast<std::uint64_t>(p10) +
+                      static_cast<std::uint64_t>(p01);
+  const uint128 hi = p11 + (p10 >> 64) + (p01 >> 64) + (mid >> 64);
+  const std::uint64_t lo = static_cast<std::uint64_t>(mid);
+  // The product of two numbers in [2^127, 2^128) is at least 2^254
+  if (hi >> 127) return {hi, a.e + b.e + 128};
+  return {(hi << 1) | (lo >> 63), a.e + b.e + 127};
+}
+
+/// \brief Returns `10^q` for `q` in the range of `decimalPowers`.
+inline wideFloat power10(int q) {
+  const decimalPower &t = decimalPowers[q - minDecimalPower];
+  return {(uint128(t.hi) << 64) | t.lo, t.exponent};
+}
+
+/// \brief The powers of ten that are exact in 64 bits.
+inline constexpr std::uint64_t integerPowers10[20] = {
+    1u,
+    10u,
+    100u,
+    1000u,
+    10000u,
+    100000u,
+    1000000u,
+    10000000u,
+    100000000u,
+    1000000000u,
+    10000000000u,
+    100000000000u,
+    1000000000000u,
+    10000000000000u,
+    100000000000000u,
+    1000000000000000u,
+    10000000000000000u,
+    100000000000000000u,
+    1000000000000000000u,
+    10000000000000000000u};
+
+/// \brief Returns `10^n` for `n <= 38`.
+inline uint128 integerPower10(int n) {
+  return n < 20 ? integerPowers10[n]
+                : uint128(integerPowers10[19]) * integerPowers10[n - 19];
+}
+
+/// \brief Returns `x 2^e` like `std::ldexp`, but without a function call if
+/// `2^e` is a normal number.
+inline double scale(double x, int e) {
+  if (e < -1022 || e > 1023) return std::ldexp(x, e);
+  const std::uint64_t bits = static_cast<std::uint64_t>(e + 1023) << 52;
+  double s;
+  std::memcpy(&s, &bits, sizeof(s));
+  return x * s;
+}
+
+/// \brief Returns `floor(log2(|x|))` of a finite `x != 0`.
+inline int binaryExponent(double x) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const int e = static_cast<int>((bits >> 52) & 0x7ff);
+  return e ? e - 1023 : std::ilogb(x);
+}
+
+/// \brief Converts a normalized 128-bit number to a double-word number.
+/// \details The high word is the upper 64 bits rounded to nearest, and the
+/// low word is the remainder of the 128 bits, which is rounded once more.
+inline two<double> toDoubleWord(const wideFloat &v) {
+  const std::uint64_t hi = v.m >> 64, lo = static_cast<std::uint64_t>(v.m);
+  const double h = static_cast<double>(hi);
+  // |hi - h| <= 2^10 is calculated modulo 2^64, since h may be rounded up
+  // to 2^64
+  const std::uint64_t rounded = h == 0x1p64 ? 0 : static_cast<std::uint64_t>(h);
+  const double r = static_cast<double>(static_cast<std::int64_t>(hi - rounded));
+  const double l = r * 0x1p64 + static_cast<double>(lo);
+  return algorithms::FastTwoSum(scale(h, v.e + 64), scale(l, v.e));
+}
+
+/// \brief Whether `[first, last)` starts with `word`, ignoring the case.
+inline bool startsWith(const char *first, const char *last, const char *word) {
+  for (; *word; ++word, ++first)
+    if (first == last || (*first | 0x20) != *word) return false;
+  return true;
+}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline std::uint64_t loadEight(const char *p) {
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  if constexpr (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    v = __builtin_bswap64(v);
+  return v;
+}
+
+/// \brief Returns the end of the digits starting at `p`, checking 8
+/// characters at once (Lemire 2021).
+inline const char *skipDigits(const char *p, const char *last) {
+  for (; last - p >= 8; p += 8) {
+    const std::uint64_t v = loadEight(p);
+    if (((v & 0xf0f0f0f0f0f0f0f0u) |
+         (((v + 0x0606060606060606u) & 0xf0f0f0f0f0f0f0f0u) >> 4)) !=
+        0x3333333333333333u)
+      break;
+  }
+  while (p != last && isDigit(*p)) ++p;
+  return p;
+}
+
+/// \brief Returns the value of 8 digits, calculated with 3 multiplications
+/// instead of 8 (Lemire 2021).
+inline std::uint32_t eightDigits(const char *p) {
+  std::uint64_t v = loadEight(p);
+  v = ((v & 0x0f0f0f0f0f0f0f0fu) * 2561) >> 8;
+  v = ((v & 0x00ff00ff00ff00ffu) * 6553601) >> 16;
+  return static_cast<std::uint32_t>(
+      ((v & 0x0000ffff0000ffffu) * 42949672960001u) >> 32);
+}
+
+/// \brief Appends the digits in `[first, last)` to `m` until it has
+/// `maxParsedDigits` digits.
+/// \return The number of appended digits.
+inline long appendDigits(const char *first, const char *last, uint128 &m,
+                         int &digits) {
+  const long n = std::min<long>(last - first, maxParsedDigits - digits);
+  const char *p = first, *const end = first + n;
+  for (; end - p >= 8; p += 8) m = m * 100000000u + eightDigits(p);
+  for (; p != end; ++p) m = m * 10 + static_cast<unsigned>(*p - '0');
+  digits += static_cast<int>(n);
+  return n;
+}
+
+/// \brief Writes the `n <= 9` lowest decimal digits of `v`, two at a time.
+inline void writeDigits(char *out, std::uint32_t v, int n) {
+  static constexpr char pairs[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233"
+      "34353637383940414243444546474849505152535455565758596061626364656667"
+      "6869707172737475767778798081828384858687888990919293949596979899";
+  for (; n >= 2; n -= 2, v /= 100)
+    std::memcpy(out + n - 2, pairs + v % 100 * 2, 2);
+  if (n) out[0] = static_cast<char>('0' + v % 10);
+}
+
+/// \brief Writes the `n <= 18` lowest decimal digits of `v`, as two
+/// independent halves.
+inline void writeDigits(char *out, std::uint64_t v, int n) {
+  if (n <= 9) return writeDigits(out, static_cast<std::uint32_t>(v), n);
+  writeDigits(out, static_cast<std::uint32_t>(v / 1000000000u), n - 9);
+  writeDigits(out + n - 9, static_cast<std::uint32_t>(v % 1000000000u), 9);
+}
+
+/// \brief Parses a decimal number to the nearest double-word number.
+/// \details Up to 38 significant digits are accumulated exactly in an
+/// integer `m`, and the value `m 10^q` is calculated like in the algorithm
+/// of Eisel and Lemire (Lemire 2021, https://arxiv.org/abs/2101.11408), with
+/// 128 instead of 64 bits: the integer is multiplied by a 128-bit power of
+/// ten from a table, and the upper 128 bits of the product are rounded to a
+/// double-word number. The relative error is below 2^-104. Numbers with up to
+/// 15 digits and a small exponent are converted exactly with `TwoProd`.
+inline std::from_chars_result parse(const char *first, const char *last,
+                                    two<double> &value) {
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const char *p = first;
+  const bool negative = p != last && *p == '-';
+  if (negative) ++p;
+  if (p != last && !isDigit(*p) && *p != '.') {
+    if (startsWith(p, last, "inf")) {
+      p += startsWith(p, last, "infinity") ? 8 : 3;
+      value = two<double>(negative ? -inf : inf);
+      return {p, std::errc()};
+    }
+    if (startsWith(p, last, "nan")) {
+      p += 3;
+      // An optional sequence of letters, digits and underscores in brackets
+      if (p != last && *p == '(') {
+        const char *q = p + 1;
+        while (q != last && (isDigit(*q) || *q == '_' ||
+                             ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z')))
+          ++q;
+        if (q != last && *q == ')') p = q + 1;
+      }
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      value = two<double>(negative ? -nan : nan);
+      return {p, std::errc()};
+    }
+    return {first, std::errc::invalid_argument};
+  }
+
+  // The significant digits start after the leading zeros, and the first
+  // 38 of them are accumulated
+  const char *const digitsBegin = p;
+  while (p != last && *p == '0') ++p;
+  const char *const intBegin = p;
+  p = skipDigits(p, last);
+  const char *const intEnd = p;
+  const char *fracBegin = p, *fracEnd = p;
+  if (p != last && *p == '.') {
+    fracBegin = ++p;
+    p = skipDigits(p, last);
+    fracEnd = p;
+  }
+  if (intEnd == digitsBegin && fracEnd == fracBegin)
+    return {first, std::errc::invalid_argument};
+  long exponent = 0;
+  if (intBegin == intEnd) {
+    const char *q = fracBegin;
+    while (q != fracEnd && *q == '0') ++q;
+    exponent -= q - fracBegin;
+    fracBegin = q;
+  }
+  uint128 m = 0;
+  int digits = 0;
+  const long intDigits = appendDigits(intBegin, intEnd, m, digits);
+  const long fracDigits = appendDigits(fracBegin, fracEnd, m, digits);
+  exponent += (intEnd - intBegin - intDigits) - fracDigits;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    const char *e = p + 1;
+    const bool negativeExponent = e != last && *e == '-';
+    if (e != last && (*e == '-' || *e == '+')) ++e;
+    if (e != last && isDigit(*e)) {
+      long x = 0;
+      for (; e != last && isDigit(*e); ++e)
+        if (x < 100000) x = x * 10 + (*e - '0');
+      exponent += negativeExponent ? -x : x;
+      p = e;
+    }
+  }
+
+  if (m == 0) {
+    value = two<double>(negative ? -0.0 : 0.0);
+    return {p, std::errc()};
+  }
+  // The value is at least 10^309 or below 10^-325
+  if (exponent > 309 || digits + exponent < -324)
+    return {p, std::errc::result_out_of_range};
+  two<double> r;
+  if (m < (uint128(1) << 53) && exponent >= 0 && exponent <= 22) {
+    double s = 1;
+    for (long i = 0; i < exponent; ++i) s *= 10;
+    r = algorithms::TwoProd(static_cast<double>(m), s);
+  } else {
+    r = toDoubleWord(
+        multiply(normalize(m, 0), power10(static_cast<int>(exponent))));
+  }
+  if (!std::isfinite(r.h) || r.h == 0)
+    return {p, std::errc::result_out_of_range};
+  value = negative ? two<double>(-r.h, -r.l) : r;
+  return {p, std::errc()};
+}
+}  // namespace details
+
+/// \brief Parses a double-word number from a decimal string.
+/// \details Accepts the format of `std::from_chars` with
+/// `std::chars_format::general`, i.e. an optional minus sign, digits with an
+/// optional decimal point and an optional exponent, or `inf`, `infinity` and
+/// `nan`. The result is not correctly rounded, but its relative error is
+/// below `2^-104`, i.e. within a few units in the last place of the low word
+/// for `double`. The output of `to_chars` with the default precision
+/// therefore parses to a number that prints to the same string, whose low
+/// word may differ from the original one in the last bits. Numbers with more
+/// than 38 significant digits are truncated. On error, `value` is not
+/// modified and `ec` is
+/// `std::errc::invalid_argument` if no number was found, or
+/// `std::errc::result_out_of_range` if it overflows or underflows.
+/// \param first The first character.
+/// \param last The end of the string.
+/// \param value The parsed number.
+/// \return The end of the parsed number and the error code.
+/// \tparam T The underlying floating point type (`float` or `double`).
+template <typename T>
+std::from_chars_result from_chars(const char *first, const char *last,
+                                  two<T> &value) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "from_chars supports two<float> and two<double>");
+  two<double> r;
+  std::from_chars_result res = details::parse(first, last, r);
+  if (res.ec != std::errc()) return res;
+  if constexpr (std::is_same_v<T, double>) {
+    value = r;
+  } else {
+    const float h = static_cast<float>(r.h);
+    if (std::isinf(h) || h == 0)
+      return {res.ptr, std::errc::result_out_of_range};
+    value = two<float>(h, static_cast<float>((r.h - h) + r.l));
+  }
+  return res;
+}
+
+/// \brief Prints a double-word number in scientific notation.
+/// \details Prints `precision` significant digits in the format
+/// `d.ddde±dd` of `std::chars_format::scientific`, or `inf`, `-inf`, `nan`.
+/// The digits are rounded from the exact value of `x.h + x.l` by a 128-bit
+/// fixed-point multiplication with a power of ten (see `from_chars`), so
+/// they are correct except when the value is very close to a midpoint of
+/// the last digit. The default precision prints 32 digits for `two<double>`,
+/// which `from_chars` parses back to a relative error of at most `1e-31`, and
+/// to a number that prints to the same string. On error, `ec` is
+/// `std::errc::value_too_large` and the contents of the buffer are
+/// unspecified.
+/// \param first The first character of the buffer.
+/// \param last The end of the buffer.
+/// \param x The number.
+/// \param precision The number of significant digits, between 1 and 36.
+/// \return The end of the printed number and the error code.
+/// \tparam T The underlying floating point type (`float` or `double`).
+template <typename T>
+std::to_chars_result to_chars(
+    char *first, char *last, const two<T> &x,
+    int precision = std::numeric_limits<two<T>>::digits10 + 1) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "to_chars supports two<float> and two<double>");
+  using details::uint128;
+  const int p = std::clamp(precision, 1, details::maxPrintedDigits);
+  two<double> v = algorithms::TwoSum(static_cast<double>(x.h),
+                                     static_cast<double>(x.l));
+  const bool negative = std::signbit(v.h == 0 ? x.h : v.h);
+  if (negative) v = two<double>(-v.h, -v.l);
+
+  auto text = [&](const char *s) -> std::to_chars_result {
+    char *out = first;
+    if (negative && out != last) *out++ = '-';
+    for (; *s; ++s) {
+      if (out == last) return {last, std::errc::value_too_large};
+      *out++ = *s;
+    }
+    return {out, std::errc()};
+  };
+  if (std::isnan(v.h)) return text("nan");
+  if (std::isinf(v.h)) return text("inf");
+
+  // The p digits D of the value v = D 10^(k + 1 - p)
+  uint128 d = 0;
+  int k = 0;
+  if (v.h != 0) {
+    // v as a 128-bit fixed-point number V 2^f. The low word is at most half
+    // a unit in the last place of the high word, and its bits below 2^f are
+    // truncated
+    const int eh = details::binaryExponent(v.h);
+    const int f = eh - 125;
+    const uint128 fixed =
+        static_cast<uint128>(details::scale(v.h, -f)) +
+        static_cast<uint128>(static_cast<__int128>(details::scale(v.l, -f)));
+    const details::wideFloat w = details::normalize(fixed, f);
+    // floor(eh log10(2))
+    k = (eh * 78913) >> 18;
+    const uint128 lower = details::integerPower10(p - 1), upper = lower * 10;
+    // The estimate of k is off by at most one, and rounding up to 10^p
+    // increments it
+    for (int i = 0; i < 3; ++i) {
+      const details::wideFloat s =
+          details::multiply(w, details::power10(p - 1 - k));
+      const int shift = -s.e;
+      d = shift > 127 ? 0 : (s.m >> shift) + ((s.m >> (shift - 1)) & 1);
+      if (d >= upper)
+        ++k;
+      else if (d < lower)
+        --k;
+      else
+        break;
+    }
+  }
+
+  const int ek = k < 0 ? -k : k;
+  const int expDigits = ek >= 100 ? 3 : 2;
+  const long length = negative + p + (p > 1) + 2 + expDigits;
+  if (last - first < length) return {last, std::errc::value_too_large};
+  char *out = first;
+  if (negative) *out++ = '-';
+  // The digits are written after the first one, which is then moved in
+  // front of the decimal point
+  if (p > 18) {
+    const std::uint64_t split = details::integerPowers10[18];
+    const std::uint64_t q = static_cast<std::uint64_t>(d / split);
+    details::writeDigits(out + 1, q, p - 18);
+    const std::uint64_t r = static_cast<std::uint64_t>(d - uint128(q) * split);
+    details::writeDigits(out + p - 17, r, 18);
+  } else {
+    details::writeDigits(out + 1, static_cast<std::uint64_t>(d), p);
+  }
+  out[0] = out[1];
+  if (p > 1) {
+    out[1] = '.';
+    out += p + 1;
+  } else {
+    out += 1;
+  }
+  *out++ = 'e';
+  *out++ = k < 0 ? '-' : '+';
+  details::writeDigits(out, static_cast<std::uint32_t>(ek), expDigits);
+  return {out + expDigits, std::errc()};
+}
+
+}  // namespace twofloat
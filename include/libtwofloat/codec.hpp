@@ -0,0 +1,497 @@
+#pragma once
+
+/// \file codec.hpp
+/// \brief Implements a lossless compression of arrays of double-word numbers.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace twofloat {
+namespace codec {
+
+namespace details {
+/// \brief The number of double-word numbers per block. The blocks are
+/// compressed independently, and in parallel.
+inline constexpr std::size_t blockSize = std::size_t(1) << 16;
+
+/// \brief The largest block size that is accepted by `decode`, which limits
+/// the memory that a short stream can make `decode` allocate.
+inline constexpr std::size_t maxBlockSize = std::size_t(1) << 20;
+
+/// \brief The number of numbers that are shuffled into byte planes at once.
+inline constexpr std::size_t shuffleTile = 64;
+
+/// \brief The start of a stream, whose last character is the version.
+inline constexpr char magic[8] = {'T', 'F', 'C', 'O', 'D', 'E', 'C', 1};
+
+/// \brief The size of the header of a stream: the magic, the word size, the
+/// number of numbers and the block size.
+inline constexpr std::size_t headerSize = 32;
+
+/// \brief The bit fields of the floating point type `T`.
+template <typename T>
+struct format;
+
+template <>
+struct format<double> {
+  using bits = std::uint64_t;
+  static constexpr int mantissa = 52, exponent = 11, digits = 53;
+};
+
+template <>
+struct format<float> {
+  using bits = std::uint32_t;
+  static constexpr int mantissa = 23, exponent = 8, digits = 24;
+};
+
+template <typename T>
+typename format<T>::bits toBits(T x) {
+  typename format<T>::bits b;
+  std::memcpy(&b, &x, sizeof(b));
+  return b;
+}
+
+template <typename T>
+T fromBits(typename format<T>::bits b) {
+  T x;
+  std::memcpy(&x, &b, sizeof(x));
+  return x;
+}
+
+/// \brief Replaces the exponent of the low word `l` by its distance to the
+/// predicted exponent of a normalized number, `exponent(h) - digits`.
+/// \details For a normalized number, `|l| <= ulp(h) / 2`, so the distance is
+/// a small non-negative number, usually below 8. The distance is calculated
+/// modulo the range of the exponent field, so the transform is bijective for
+/// any bit patterns, including unnormalized numbers and special values.
+template <typename T>
+typename format<T>::bits predictLow(typename format<T>::bits h,
+                                    typename format<T>::bits l, bool inverse) {
+  using F = format<T>;
+  using U = typename F::bits;
+  constexpr U mask = (U(1) << F::exponent) - 1;
+  const U eh = (h >> F::mantissa) & mask, el = (l >> F::mantissa) & mask;
+  const U e = inverse ? eh - F::digits - el : eh - el - F::digits;
+  return (l & ~(mask << F::mantissa)) | ((e & mask) << F::mantissa);
+}
+
+inline void put(std::vector<std::uint8_t> &out, std::uint64_t v, int bytes) {
+  for (int i = 0; i < bytes; ++i)
+    out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+inline std::uint64_t get(const std::uint8_t *p, int bytes) {
+  std::uint64_t v = 0;
+  for (int i = 0; i < bytes; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+  return v;
+}
+
+/// \brief The encodings of a byte plane.
+enum class Plane : std::uint8_t { Raw = 0, Constant = 1, Rans = 2 };
+
+/// \brief The precision of the probabilities of the rANS coder.
+inline constexpr int probabilityBits = 12;
+inline constexpr std::uint32_t probabilityScale = 1u << probabilityBits;
+
+/// \brief The lower bound of the state of the rANS coder, which is kept in
+/// `[ransLow, 256 ransLow)` by shifting bytes in and out.
+inline constexpr std::uint32_t ransLow = 1u << 23;
+
+/// \brief The number of interleaved states of the rANS coder.
+inline constexpr std::size_t ransWays = 4;
+
+/// \brief Scales the counts of the `n` bytes of a plane to frequencies that
+/// sum up to `probabilityScale`, keeping every present byte.
+inline void normalizeFrequencies(const std::uint32_t (&count)[256],
+                                 std::size_t n, std::uint32_t (&freq)[256]) {
+  std::int64_t sum = 0;
+  int largest = 0;
+  for (int s = 0; s < 256; ++s) {
+    freq[s] = count[s] == 0 ? 0
+                            : std::max<std::uint32_t>(
+                                  1, static_cast<std::uint32_t>(
+                                         std::uint64_t(count[s]) *
+                                         probabilityScale / n));
+    sum += freq[s];
+    if (freq[s] > freq[largest]) largest = s;
+  }
+  // The rounding error is assigned to the most frequent bytes
+  while (sum != probabilityScale) {
+    if (sum < probabilityScale) {
+      freq[largest] += static_cast<std::uint32_t>(probabilityScale - sum);
+      sum = probabilityScale;
+    } else {
+      const std::uint32_t d = static_cast<std::uint32_t>(
+          std::min<std::int64_t>(sum - probabilityScale, freq[largest] - 1));
+      freq[largest] -= d;
+      sum -= d;
+      for (int s = 0; s < 256; ++s)
+        if (freq[s] > freq[largest]) largest = s;
+    }
+  }
+}
+
+/// \brief The constants to encode a byte with the rANS coder, which replace
+/// the division by its frequency by a multiplication (Giesen 2014).
+struct encoderSymbol {
+  std::uint32_t xMax = 0, reciprocal = 0, bias = 0, complement = 0;
+  int shift = 0;
+
+  encoderSymbol() = default;
+  encoderSymbol(std::uint32_t start, std::uint32_t freq)
+      : xMax(((ransLow >> probabilityBits) << 8) * freq),
+        complement(probabilityScale - freq) {
+    if (freq < 2) {
+      // x / 1 = x with the reciprocal 2^32 - 1, if the bias compensates
+      reciprocal = ~0u;
+      bias = start + probabilityScale - 1;
+      return;
+    }
+    int bits = 0;
+    while (freq > (1u << bits)) ++bits;
+    reciprocal = static_cast<std::uint32_t>(
+        ((std::uint64_t(1) << (bits + 31)) + freq - 1) / freq);
+    shift = bits - 1;
+    bias = start;
+  }
+};
+
+/// \brief Appends the `n` bytes of a plane to `out`, compressed with an
+/// order-0 rANS coder (Duda 2013), or as a single byte if they are all equal,
+/// or uncompressed if the coder does not make them smaller.
+inline void encodePlane(const std::uint8_t *plane, std::size_t n,
+                        std::vector<std::uint8_t> &out) {
+  // Runs of equal bytes would serialize the increments of a single histogram
+  std::uint32_t partial[4][256] = {}, count[256];
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    for (std::size_t k = 0; k < 4; ++k) ++partial[k][plane[i + k]];
+  for (; i < n; ++i) ++partial[0][plane[i]];
+  for (int s = 0; s < 256; ++s)
+    count[s] = partial[0][s] + partial[1][s] + partial[2][s] + partial[3][s];
+  int symbols = 0;
+  for (int s = 0; s < 256; ++s) symbols += count[s] != 0;
+  if (symbols == 1) {
+    out.push_back(static_cast<std::uint8_t>(Plane::Constant));
+    out.push_back(plane[0]);
+    return;
+  }
+
+  // Planes of nearly uniformly distributed bytes, e.g. of the trailing bits
+  // of the mantissas, are not worth coding
+  double bits = 0;
+  for (int s = 0; s < 256; ++s)
+    if (count[s] != 0) bits -= count[s] * std::log2(double(count[s]) / n);
+  if (bits > 0.99 * 8 * n) {
+    out.push_back(static_cast<std::uint8_t>(Plane::Raw));
+    out.insert(out.end(), plane, plane + n);
+    return;
+  }
+
+  std::uint32_t freq[256];
+  normalizeFrequencies(count, n, freq);
+  encoderSymbol symbol[256];
+  for (std::uint32_t s = 0, c = 0; s < 256; c += freq[s], ++s)
+    symbol[s] = encoderSymbol(c, freq[s]);
+
+  // The symbols are encoded in reverse order, and the bytes are written
+  // backwards, so that the decoder reads both forwards. Each symbol emits at
+  // most 2 bytes, which are written without branches. The symbol `i` is
+  // coded with the state `i % ransWays`, which breaks the dependency of each
+  // symbol on the previous one.
+  std::vector<std::uint8_t> buffer(2 * n + 4 * ransWays);
+  std::uint8_t *const end = buffer.data() + buffer.size();
+  std::uint8_t *p = end;
+  std::uint32_t x[ransWays];
+  for (std::uint32_t &xi : x) xi = ransLow;
+  const auto step = [&](std::uint32_t &xi, std::uint8_t s) {
+    const encoderSymbol &e = symbol[s];
+    for (int k = 0; k < 2; ++k) {
+      const bool flush = xi >= e.xMax;
+      p[-1] = static_cast<std::uint8_t>(xi);
+      p -= flush;
+      xi >>= 8 * flush;
+    }
+    const std::uint32_t q = static_cast<std::uint32_t>(
+                                (std::uint64_t(xi) * e.reciprocal) >> 32) >>
+                            e.shift;
+    xi += e.bias + q * e.complement;
+  };
+  i = n;
+  for (; i % ransWays != 0; --i) step(x[(i - 1) % ransWays], plane[i - 1]);
+  for (; i != 0; i -= ransWays)
+    for (std::size_t w = ransWays; w-- > 0;)
+      step(x[w], plane[i - ransWays + w]);
+  for (std::size_t w = ransWays; w-- > 0;)
+    for (int k = 3; k >= 0; --k)
+      *--p = static_cast<std::uint8_t>(x[w] >> (8 * k));
+
+  const std::size_t payload = static_cast<std::size_t>(end - p);
+  if (2 + 3 * std::size_t(symbols) + 4 + payload >= n) {
+    out.push_back(static_cast<std::uint8_t>(Plane::Raw));
+    out.insert(out.end(), plane, plane + n);
+    return;
+  }
+  out.push_back(static_cast<std::uint8_t>(Plane::Rans));
+  put(out, static_cast<std::uint64_t>(symbols), 2);
+  for (int s = 0; s < 256; ++s)
+    if (freq[s] != 0) {
+      put(out, static_cast<std::uint64_t>(s), 1);
+      put(out, freq[s], 2);
+    }
+  put(out, payload, 4);
+  out.insert(out.end(), p, end);
+}
+
+/// \brief Decodes a plane of `n` bytes starting at `p` and advances `p`.
+/// \return Whether the plane is well-formed.
+inline bool decodePlane(const std::uint8_t *&p, const std::uint8_t *end,
+                        std::uint8_t *plane, std::size_t n) {
+  if (p == end) return false;
+  const Plane mode = static_cast<Plane>(*p++);
+  if (mode == Plane::Raw) {
+    if (static_cast<std::size_t>(end - p) < n) return false;
+    std::memcpy(plane, p, n);
+    p += n;
+    return true;
+  }
+  if (mode == Plane::Constant) {
+    if (p == end) return false;
+    std::memset(plane, *p++, n);
+    return true;
+  }
+  if (mode != Plane::Rans || end - p < 2) return false;
+
+  const std::size_t symbols = get(p, 2);
+  p += 2;
+  if (symbols == 0 || symbols > 256 ||
+      static_cast<std::size_t>(end - p) < 3 * symbols + 4)
+    return false;
+  std::uint32_t freq[256] = {}, start[256] = {};
+  std::uint8_t lookup[probabilityScale];
+  std::uint32_t c = 0;
+  for (std::size_t i = 0; i < symbols; ++i, p += 3) {
+    const std::uint8_t s = p[0];
+    const std::uint32_t f = static_cast<std::uint32_t>(get(p + 1, 2));
+    if (f == 0 || freq[s] != 0 || c + f > probabilityScale) return false;
+    freq[s] = f;
+    start[s] = c;
+    std::memset(lookup + c, s, f);
+    c += f;
+  }
+  if (c != probabilityScale) return false;
+  const std::size_t payload = get(p, 4);
+  p += 4;
+  if (payload < 4 * ransWays || static_cast<std::size_t>(end - p) < payload)
+    return false;
+
+  const std::uint8_t *q = p + 4 * ransWays, *const qEnd = p + payload;
+  std::uint32_t x[ransWays];
+  for (std::size_t w = 0; w < ransWays; ++w)
+    x[w] = static_cast<std::uint32_t>(get(p + 4 * w, 4));
+  // Reads past the end of a corrupted payload return zeros
+  const std::uint8_t zero = 0;
+  const auto step = [&](std::uint32_t &xi, std::uint8_t &s) {
+    const std::uint32_t slot = xi & (probabilityScale - 1);
+    s = lookup[slot];
+    xi = freq[s] * (xi >> probabilityBits) + slot - start[s];
+    for (int k = 0; k < 2; ++k) {
+      const bool read = xi < ransLow;
+      const std::uint8_t next = *(q < qEnd ? q : &zero);
+      xi = read ? (xi << 8) | next : xi;
+      q += read;
+    }
+  };
+  std::size_t i = 0;
+  for (; i + ransWays <= n; i += ransWays)
+    for (std::size_t w = 0; w < ransWays; ++w) step(x[w], plane[i + w]);
+  for (; i < n; ++i) step(x[i % ransWays], plane[i]);
+  if (q != qEnd) return false;
+  p = qEnd;
+  return true;
+}
+
+/// \brief Appends a block of `n` numbers to `out`.
+/// \details The high words are predicted by the previous high word (XOR),
+/// which leaves the leading bytes zero if neighbouring numbers are close,
+/// and the exponents of the low words by the high words (`predictLow`). The
+/// bytes of the results are then grouped by their position (byte-plane
+/// shuffle), so that the predictable bytes form planes of their own, and
+/// each plane is compressed with `encodePlane`.
+template <typename T>
+void encodeBlock(const T *h, const T *l, std::size_t n,
+                 std::vector<std::uint8_t> &out) {
+  using U = typename format<T>::bits;
+  constexpr std::size_t W = sizeof(U);
+  std::vector<std::uint8_t> planes(2 * W * n);
+  // The words are shuffled in tiles of a cache line per plane, as the planes
+  // of blocks of a power of two of numbers map to the same cache sets
+  U words[2][shuffleTile];
+  U previous = 0;
+  for (std::size_t first = 0; first < n; first += shuffleTile) {
+    const std::size_t m = std::min(shuffleTile, n - first);
+    for (std::size_t i = 0; i < m; ++i) {
+      const U hb = toBits(h[first + i]);
+      words[0][i] = hb ^ previous;
+      words[1][i] = predictLow<T>(hb, toBits(l[first + i]), false);
+      previous = hb;
+    }
+    for (std::size_t k = 0; k < 2 * W; ++k) {
+      std::uint8_t *const plane = planes.data() + k * n + first;
+      for (std::size_t i = 0; i < m; ++i)
+        plane[i] = static_cast<std::uint8_t>(words[k / W][i] >> (8 * (k % W)));
+    }
+  }
+  for (std::size_t k = 0; k < 2 * W; ++k)
+    encodePlane(planes.data() + k * n, n, out);
+}
+
+/// \brief Decodes a block of `n` numbers, see `encodeBlock`.
+/// \return Whether the block is well-formed.
+template <typename T>
+bool decodeBlock(const std::uint8_t *p, const std::uint8_t *end, T *h, T *l,
+                 std::size_t n) {
+  using U = typename format<T>::bits;
+  constexpr std::size_t W = sizeof(U);
+  std::vector<std::uint8_t> planes(2 * W * n);
+  for (std::size_t k = 0; k < 2 * W; ++k)
+    if (!decodePlane(p, end, planes.data() + k * n, n)) return false;
+  if (p != end) return false;
+  U words[2][shuffleTile];
+  U previous = 0;
+  for (std::size_t first = 0; first < n; first += shuffleTile) {
+    const std::size_t m = std::min(shuffleTile, n - first);
+    std::memset(words, 0, sizeof(words));
+    for (std::size_t k = 0; k < 2 * W; ++k) {
+      const std::uint8_t *const plane = planes.data() + k * n + first;
+      for (std::size_t i = 0; i < m; ++i)
+        words[k / W][i] |= U(plane[i]) << (8 * (k % W));
+    }
+    for (std::size_t i = 0; i < m; ++i) {
+      const U hb = words[0][i] ^ previous;
+      previous = hb;
+      h[first + i] = fromBits<T>(hb);
+      l[first + i] = fromBits<T>(predictLow<T>(hb, words[1][i], true));
+    }
+  }
+  return true;
+}
+}  // namespace details
+
+/// \brief Compresses an array of double-word numbers losslessly.
+/// \details The low word of a normalized number is at most half a unit in
+/// the last place of the high word, so its exponent is predictable from the
+/// high word, and the high words of neighbouring numbers often share their
+/// sign, exponent and leading digits. The numbers are split into blocks of
+/// 65536 numbers, which are transformed with these predictions, split into
+/// byte planes and entropy coded (see `details::encodeBlock`) independently
+/// on `threads` threads. The output is the same for any number of threads.
+/// How much the data shrink depends on them: the exponents of the low words
+/// save about 1 byte per number, and low words with few significant bits,
+/// e.g. of numbers converted from `T`, or smooth data save much more. Any
+/// bit patterns are reproduced exactly, including unnormalized numbers and
+/// special values.
+/// \param values The numbers.
+/// \param threads The number of threads, or 0 for the number of hardware
+/// threads.
+/// \return The compressed numbers.
+/// \tparam T The underlying floating point type (`float` or `double`).
+template <typename T>
+std::vector<std::uint8_t> encode(soa_span<const T> values,
+                                 unsigned threads = 0) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "encode supports two<float> and two<double>");
+  const std::size_t n = values.size();
+  const std::size_t blocks = (n + details::blockSize - 1) / details::blockSize;
+  std::vector<std::vector<std::uint8_t>> encoded(blocks);
+  twofloat::details::parallelFor(blocks, threads, [&](std::size_t b) {
+    const std::size_t first = b * details::blockSize;
+    details::encodeBlock(values.h_data() + first, values.l_data() + first,
+                         std::min(details::blockSize, n - first), encoded[b]);
+  });
+
+  std::vector<std::uint8_t> out(details::magic, details::magic + 8);
+  details::put(out, sizeof(T), 4);
+  details::put(out, 0, 4);
+  details::put(out, n, 8);
+  details::put(out, details::blockSize, 8);
+  for (const std::vector<std::uint8_t> &block : encoded)
+    details::put(out, block.size(), 8);
+  for (const std::vector<std::uint8_t> &block : encoded)
+    out.insert(out.end(), block.begin(), block.end());
+  return out;
+}
+
+/// \brief Decompresses numbers compressed by `encode`.
+/// \details The blocks are decoded independently on `threads` threads. Fails
+/// with `std::errc::invalid_argument` if the data are not a complete stream
+/// of `two<T>`, and with `std::errc::not_supported` for another version of
+/// the format. On error, `values` is not modified.
+/// \param data The compressed numbers.
+/// \param values The decompressed numbers.
+/// \param threads The number of threads, or 0 for the number of hardware
+/// threads.
+/// \tparam T The underlying floating point type (`float` or `double`).
+template <typename T>
+std::error_code decode(span<const std::uint8_t> data, soa_vector<T> &values,
+                       unsigned threads = 0) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                "decode supports two<float> and two<double>");
+  const auto invalid = std::make_error_code(std::errc::invalid_argument);
+  const std::uint8_t *const begin = data.data();
+  if (data.size() < details::headerSize ||
+      std::memcmp(begin, details::magic, 7) != 0)
+    return invalid;
+  if (begin[7] != details::magic[7])
+    return std::make_error_code(std::errc::not_supported);
+  const std::uint64_t n = details::get(begin + 16, 8);
+  const std::uint64_t size = details::get(begin + 24, 8);
+  if (details::get(begin + 8, 4) != sizeof(T) || size == 0 ||
+      size > details::maxBlockSize)
+    return invalid;
+  // Every block has its length and 2 sizeof(T) planes of at least 2 bytes,
+  // which bounds n by the size of the data before anything is allocated
+  constexpr std::size_t minBlockBytes = 4 * sizeof(T);
+  const std::uint64_t blocks = n / size + (n % size != 0);
+  if (blocks > (data.size() - details::headerSize) / (8 + minBlockBytes))
+    return invalid;
+
+  // The offsets of the blocks
+  std::vector<std::size_t> offsets(blocks + 1);
+  offsets[0] = details::headerSize + 8 * blocks;
+  for (std::size_t b = 0; b < blocks; ++b) {
+    const std::uint64_t bytes = details::get(begin + 32 + 8 * b, 8);
+    if (bytes < minBlockBytes || bytes > data.size() - offsets[b])
+      return invalid;
+    offsets[b + 1] = offsets[b] + bytes;
+  }
+  if (offsets[blocks] != data.size()) return invalid;
+
+  soa_vector<T> result(n);
+  std::atomic<bool> ok{true};
+  twofloat::details::parallelFor(blocks, threads, [&](std::size_t b) {
+    const std::size_t first = b * size;
+    if (!details::decodeBlock(begin + offsets[b], begin + offsets[b + 1],
+                              result.h_data() + first,
+                              result.l_data() + first,
+                              std::min<std::size_t>(size, n - first)))
+      ok = false;
+  });
+  if (!ok) return invalid;
+  values = std::move(result);
+  return {};
+}
+
+}  // namespace codec
+}  // namespace twofloat
@@ -0,0 +1,268 @@
+#pragma once
+
+/// \file complex.hpp
+/// \brief Implements complex double-word numbers and their arithmetic.
+
+#include <cstddef>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <stdexcept>
+
+namespace twofloat {
+
+/// \brief A complex number whose real and imaginary parts are double-word
+/// numbers.
+/// \details `std::complex` is only specified for the built-in floating point
+/// types, and composing the complex product from the double-word operations
+/// normalizes every intermediate result. The operations in the `doubleword`
+/// namespace instead calculate each part of a product or quotient with a
+/// single normalization. With a vector type (`complex<simd<double, 4>>`), it
+/// represents several numbers at once.
+/// \tparam T The underlying floating point type or vector.
+template <typename T>
+struct complex {
+  /// \brief The real part.
+  two<T> re;
+
+  /// \brief The imaginary part.
+  two<T> im;
+
+  /// \brief Default constructor, zero.
+  constexpr complex() : re(), im() {}
+
+  /// \brief Constructs an instance from its real and imaginary parts.
+  constexpr complex(const two<T> &re, const two<T> &im) : re(re), im(im) {}
+
+  /// \brief Constructs a real number.
+  constexpr explicit complex(const two<T> &re) : re(re), im() {}
+};
+
+namespace doubleword {
+
+namespace details {
+/// \brief Calculates `a b + c d` with a single normalization.
+/// \details The products of the high words are calculated exactly with
+/// `TwoProd` and their sum with `TwoSum`. The error terms of both products
+/// and the cross products with the low words are accumulated in a single
+/// floating point number, like in `DWTimesDW2` (Joldeş et al. 2017), and the
+/// result is normalized once with `TwoSum`, which does not require that the
+/// high word dominates the low word. The error is a small multiple of
+/// `u² (|a b| + |c d|)`; like for every complex product, the relative error
+/// of a part can be larger if the two products cancel.
+template <bool useFMA, typename T>
+constexpr two<T> dot2(const two<T> &a, const two<T> &b, const two<T> &c,
+                      const two<T> &d) {
+  const two<T> p = algorithms::TwoProd<T, useFMA>(a.h, b.h);
+  const two<T> q = algorithms::TwoProd<T, useFMA>(c.h, d.h);
+  const two<T> s = algorithms::TwoSum(p.h, q.h);
+  // The two products are accumulated independently, which shortens the
+  // dependency chain
+  T t(0);
+  if constexpr (useFMA) {
+    const T ta = algorithms::fma(a.h, b.l, algorithms::fma(a.l, b.h, p.l));
+    const T tc = algorithms::fma(c.h, d.l, algorithms::fma(c.l, d.h, q.l));
+    t = ta + tc;
+  } else {
+    t = (p.l + (a.h * b.l + a.l * b.h)) + (q.l + (c.h * d.l + c.l * d.h));
+  }
+  return algorithms::TwoSum(s.h, s.l + t);
+}
+
+template <typename T>
+constexpr two<T> negate(const two<T> &x) {
+  return two<T>(-x.h, -x.l);
+}
+}  // namespace details
+
+/// \brief Adds two complex double-word numbers.
+/// \tparam mode The mode of the additions of the parts, see `add`.
+template <Mode mode, typename T>
+constexpr complex<T> add(const complex<T> &x, const complex<T> &y) {
+  return {add<mode>(x.re, y.re), add<mode>(x.im, y.im)};
+}
+
+/// \brief Subtracts two complex double-word numbers.
+/// \tparam mode The mode of the subtractions of the parts, see `sub`.
+template <Mode mode, typename T>
+constexpr complex<T> sub(const complex<T> &x, const complex<T> &y) {
+  return {sub<mode>(x.re, y.re), sub<mode>(x.im, y.im)};
+}
+
+/// \brief Returns the complex conjugate, which is exact.
+template <typename T>
+constexpr complex<T> conj(const complex<T> &x) {
+  return {x.re, details::negate(x.im)};
+}
+
+/// \brief Multiplies two complex double-word numbers.
+/// \details Each part is calculated as a sum of two products with a single
+/// normalization (see `details::dot2`), i.e. with 2 instead of 6
+/// normalizations for the product composed of `mul` and `add`.
+/// \param x The first factor.
+/// \param y The second factor.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+constexpr complex<T> mul(const complex<T> &x, const complex<T> &y) {
+  return {details::dot2<useFMA>(x.re, y.re, details::negate(x.im), y.im),
+          details::dot2<useFMA>(x.re, y.im, x.im, y.re)};
+}
+
+/// \brief Calculates the squared absolute value `|x|²`.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+constexpr two<T> norm(const complex<T> &x) {
+  return details::dot2<useFMA>(x.re, x.re, x.im, x.im);
+}
+
+/// \brief Divides two complex double-word numbers.
+/// \details Calculates `x conj(y) / |y|²`, where both parts of the numerator
+/// and the denominator are calculated with a single normalization each, and
+/// the parts are divided by `div<Mode::Fast, useFMA>`. Like the textbook
+/// formula, the result overflows or underflows if `|y|²` does.
+/// \param x The dividend.
+/// \param y The divisor.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+constexpr complex<T> div(const complex<T> &x, const complex<T> &y) {
+  const two<T> n = norm<useFMA>(y);
+  const two<T> re = details::dot2<useFMA>(x.re, y.re, x.im, y.im);
+  const two<T> im =
+      details::dot2<useFMA>(x.im, y.re, details::negate(x.re), y.im);
+  return {div<Mode::Fast, useFMA>(re, n), div<Mode::Fast, useFMA>(im, n)};
+}
+
+namespace batch {
+
+namespace details {
+/// \brief A view over complex double-word numbers stored as four arrays.
+template <typename T>
+struct planes {
+  T *rh, *rl, *ih, *il;
+};
+
+template <typename T>
+planes<const T> view(soa_span<const T> re, soa_span<const T> im) {
+  return {re.h_data(), re.l_data(), im.h_data(), im.l_data()};
+}
+
+template <typename V, typename T>
+inline complex<V> load(const planes<const T> &x, std::size_t i) {
+  if constexpr (is_simd_v<V>)
+    return {two<V>(V::load(x.rh + i), V::load(x.rl + i)),
+            two<V>(V::load(x.ih + i), V::load(x.il + i))};
+  else
+    return {two<V>(x.rh[i], x.rl[i]), two<V>(x.ih[i], x.il[i])};
+}
+
+template <typename V, typename T>
+inline void store(const complex<V> &v, soa_span<T> re, soa_span<T> im,
+                  std::size_t i) {
+  if constexpr (is_simd_v<V>) {
+    v.re.h.store(re.h_data() + i);
+    v.re.l.store(re.l_data() + i);
+    v.im.h.store(im.h_data() + i);
+    v.im.l.store(im.l_data() + i);
+  } else {
+    re[i] = v.re;
+    im[i] = v.im;
+  }
+}
+
+/// \brief Calculates `z_i = op(x_i, y_i)` with vectors of `W` lanes and the
+/// remaining elements one by one, with the same operations.
+template <std::size_t W, typename T, typename Op>
+void apply(const Op &op, const planes<const T> &x, const planes<const T> &y,
+           soa_span<T> zRe, soa_span<T> zIm) {
+  using V = simd<T, W>;
+  const std::size_t n = zRe.size();
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    store(op(load<V>(x, i), load<V>(y, i)), zRe, zIm, i);
+  for (; i < n; ++i) store(op(load<T>(x, i), load<T>(y, i)), zRe, zIm, i);
+}
+
+template <typename T, typename Op>
+void apply(const Op &op, soa_span<const T> xRe, soa_span<const T> xIm,
+           soa_span<const T> yRe, soa_span<const T> yIm, soa_span<T> zRe,
+           soa_span<T> zIm) {
+  const std::size_t n = zRe.size();
+  if (zIm.size() != n || xRe.size() != n || xIm.size() != n ||
+      yRe.size() != n || yIm.size() != n)
+    throw std::invalid_argument(
+        "doubleword::batch: the complex arrays have different sizes");
+  const planes<const T> x = view(xRe, xIm), y = view(yRe, yIm);
+  twofloat::details::vectorized<T>([&](auto w) {
+    apply<decltype(w)::value>(op, x, y, zRe, zIm);
+  });
+}
+}  // namespace details
+
+/// \brief Adds two arrays of complex double-word numbers element-wise.
+/// \details The complex numbers are stored as structure of arrays, i.e. the
+/// real and imaginary parts are separate `soa_span`s. Like the other batched
+/// operations, the elements are processed in vectors of the widest
+/// instruction set of the CPU, and the results are bitwise identical to the
+/// scalar operation. All six arrays must have the same size. The outputs may
+/// alias the inputs.
+/// \throws std::invalid_argument if the sizes of the arrays differ.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void add(soa_span<const T> xRe, soa_span<const T> xIm,
+                soa_span<const T> yRe, soa_span<const T> yIm, soa_span<T> zRe,
+                soa_span<T> zIm) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return doubleword::add<mode>(a, b);
+      },
+      xRe, xIm, yRe, yIm, zRe, zIm);
+}
+
+/// \brief Subtracts two arrays of complex double-word numbers element-wise,
+/// see `add`.
+/// \tparam mode The mode (sloppy or accurate).
+template <Mode mode, typename T>
+inline void sub(soa_span<const T> xRe, soa_span<const T> xIm,
+                soa_span<const T> yRe, soa_span<const T> yIm, soa_span<T> zRe,
+                soa_span<T> zIm) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return doubleword::sub<mode>(a, b);
+      },
+      xRe, xIm, yRe, yIm, zRe, zIm);
+}
+
+/// \brief Multiplies two arrays of complex double-word numbers element-wise
+/// with the fused complex product, see `add`.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void mul(soa_span<const T> xRe, soa_span<const T> xIm,
+                soa_span<const T> yRe, soa_span<const T> yIm, soa_span<T> zRe,
+                soa_span<T> zIm) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return doubleword::mul<useFMA>(a, b);
+      },
+      xRe, xIm, yRe, yIm, zRe, zIm);
+}
+
+/// \brief Divides two arrays of complex double-word numbers element-wise,
+/// see `add`.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+inline void div(soa_span<const T> xRe, soa_span<const T> xIm,
+                soa_span<const T> yRe, soa_span<const T> yIm, soa_span<T> zRe,
+                soa_span<T> zIm) {
+  details::apply(
+      [](const auto &a, const auto &b) {
+        return doubleword::div<useFMA>(a, b);
+      },
+      xRe, xIm, yRe, yIm, zRe, zIm);
+}
+
+}  // namespace batch
+}  // namespace doubleword
+}  // namespace twofloat
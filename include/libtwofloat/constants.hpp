@@ -30,8 +30,9 @@ struct constants {
 
   /// \brief The number of bits that x2 fits into when splitting x into x1+x2 in
   /// algorithms::Split.
-  /// \details Calculated as t/2. See Boldo 2006 Algorithm 1 and 2 for details.
-  static const constexpr int SplitS = t / 2;
+  /// \details Calculated as ⌈t/2⌉, so that the products of the parts are
+  /// exact for odd t as well. See Boldo 2006 Algorithm 1 and 2 for details.
+  static const constexpr int SplitS = (t + 1) / 2;
 
   /// \brief A constant used to split a floating point number into the sum of
   /// two floating point numbers.
@@ -56,4 +57,4 @@ struct constants {
   static const constexpr T SplitScaleUpFactor = 1.0 / SplitScaleDownFactor;
 };
 }  // namespace algorithms
-}  // namespace twofloat
\ No newline at end of file
+}  // namespace twofloat
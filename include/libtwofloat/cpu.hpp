@@ -0,0 +1,93 @@
+#pragma once
+
+/// \file cpu.hpp
+/// \brief Detects the instruction sets supported by the CPU at runtime.
+/// \details The detection runs once, when it is first needed. The batched
+/// operations and the runtime-dispatched wrappers use it to select the
+/// fastest implementation that the CPU supports.
+
+#include <atomic>
+#include <libtwofloat/details/target.hpp>
+
+namespace twofloat {
+
+/// \brief Runtime detection of CPU features.
+namespace cpu {
+
+/// \brief The instruction sets for which vectorized implementations exist,
+/// ordered by increasing width.
+enum class InstructionSet { Scalar, AVX2, AVX512 };
+
+/// \brief The CPU features relevant to the library.
+struct Features {
+  /// \brief Fused multiply-add instructions.
+  bool fma = false;
+
+  /// \brief AVX2 instructions.
+  bool avx2 = false;
+
+  /// \brief AVX-512 foundation instructions.
+  bool avx512f = false;
+};
+
+namespace details {
+inline Features detect() {
+  Features f;
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES)
+  __builtin_cpu_init();
+  f.fma = __builtin_cpu_supports("fma");
+  f.avx2 = __builtin_cpu_supports("avx2");
+  f.avx512f = __builtin_cpu_supports("avx512f");
+#else
+  // Without target attributes, code can only use the globally enabled
+  // instruction sets, which the CPU must support anyway.
+#if defined(__FMA__)
+  f.fma = true;
+#endif
+#if defined(__AVX2__)
+  f.avx2 = true;
+#endif
+#if defined(__AVX512F__)
+  f.avx512f = true;
+#endif
+#endif
+  return f;
+}
+
+inline std::atomic<InstructionSet> &maxInstructionSet() {
+  static std::atomic<InstructionSet> max{InstructionSet::AVX512};
+  return max;
+}
+}  // namespace details
+
+/// \brief Returns the features of the CPU. They are detected on the first
+/// call.
+inline const Features &features() {
+  static const Features f = details::detect();
+  return f;
+}
+
+/// \brief Returns true if the CPU supports fused multiply-add instructions.
+inline bool hasFMA() { return features().fma; }
+
+/// \brief Returns the widest instruction set that is supported by the CPU and
+/// not excluded by `setMaxInstructionSet`.
+inline InstructionSet instructionSet() {
+  const Features &f = features();
+  InstructionSet best = InstructionSet::Scalar;
+  if (f.avx2 && f.fma) best = InstructionSet::AVX2;
+  if (f.avx512f && f.avx2 && f.fma) best = InstructionSet::AVX512;
+
+  InstructionSet max = details::maxInstructionSet().load();
+  return best < max ? best : max;
+}
+
+/// \brief Restricts the instruction sets used by the batched operations, e.g.
+/// to compare results or performance across instruction sets on a single
+/// machine.
+inline void setMaxInstructionSet(InstructionSet max) {
+  details::maxInstructionSet().store(max);
+}
+
+}  // namespace cpu
+}  // namespace twofloat
@@ -0,0 +1,760 @@
+#pragma once
+
+/// \file decimal-tables.hpp
+/// \brief The powers of ten of the decimal conversions in charconv.hpp.
+/// \details The values were computed with exact rational arithmetic.
+
+#include <cstdint>
+
+namespace twofloat {
+namespace details {
+
+/// \brief A power of ten `(hi 2^64 + lo) 2^exponent`, where the 128-bit
+/// significand is rounded to nearest and its most significant bit is set.
+struct decimalPower {
+  std::uint64_t hi, lo;
+  int exponent;
+};
+
+/// \brief The exponents of the first and the last entry of `decimalPowers`.
+/// \details Parsing needs the powers from 10^-362 (38 digits below the
+/// smallest subnormal number) and printing up to 10^360 (36 digits of the
+/// smallest subnormal number).
+inline constexpr int minDecimalPower = -364, maxDecimalPower = 364;
+
+/// \brief The powers of ten `10^(minDecimalPower + i)`.
+inline constexpr decimalPower decimalPowers[maxDecimalPower -
+                                           minDecimalPower + 1] = {
+    {0xe1afa13afbd14d6du, 0x82189c09a3a1ec21u, -1337},  // 10^-364
+    {0x8d0dc4c4dd62d064u, 0x714f618606453395u, -1333},  // 10^-363
+    {0xb05135f614bb847du, 0x8da339e787d6807au, -1330},  // 10^-362
+    {0xdc65837399ea659cu, 0xf10c086169cc2099u, -1327},  // 10^-361
+    {0x89bf722840327f82u, 0x16a7853ce21f945fu, -1323},  // 10^-360
+    {0xac2f4eb2503f1f62u, 0x9c51668c1aa77977u, -1320},  // 10^-359
+    {0xd73b225ee44ee73bu, 0x4365c02f215157d5u, -1317},  // 10^-358
+    {0x8684f57b4eb15085u, 0x0a1f981d74d2d6e5u, -1313},  // 10^-357
+    {0xa82632da225da4a6u, 0x4ca77e24d2078c9eu, -1310},  // 10^-356
+    {0xd22fbf90aaf50dcfu, 0xdfd15dae06896fc6u, -1307},  // 10^-355
+    {0x835dd7ba6ad928a1u, 0xebe2da8cc415e5dcu, -1303},  // 10^-354
+    {0xa4354da9058f72cau, 0x66db912ff51b5f53u, -1300},  // 10^-353
+    {0xcd42a11346f34f7du, 0x0092757bf2623727u, -1297},  // 10^-352
+    {0x8049a4ac0c5811aeu, 0x205b896d777d6279u, -1293},  // 10^-351
+    {0xa05c0dd70f6e1619u, 0xa8726bc8d55cbb17u, -1290},  // 10^-350
+    {0xc873114cd3499ba0u, 0x128f06bb0ab3e9ddu, -1287},  // 10^-349
+    {0xfa8fd5a0081c0288u, 0x1732c869cd60e454u, -1284},  // 10^-348
+    {0x9c99e58405118195u, 0x0e7fbd42205c8eb4u, -1280},  // 10^-347
+    {0xc3c05ee50655e1fau, 0x521fac92a873b261u, -1277},  // 10^-346
+    {0xf4b0769e47eb5a78u, 0xe6a797b752909efau, -1274},  // 10^-345
+    {0x98ee4a22ecf3188bu, 0x9028bed2939a635cu, -1270},  // 10^-344
+    {0xbf29dcaba82fdeaeu, 0x7432ee873880fc33u, -1267},  // 10^-343
+    {0xeef453d6923bd65au, 0x113faa2906a13b40u, -1264},  // 10^-342
+    {0x9558b4661b6565f8u, 0x4ac7ca59a424c508u, -1260},  // 10^-341
+    {0xbaaee17fa23ebf76u, 0x5d79bcf00d2df64au, -1257},  // 10^-340
+    {0xe95a99df8ace6f53u, 0xf4d82c2c107973dcu, -1254},  // 10^-339
+    {0x91d8a02bb6c10594u, 0x79071b9b8a4be86au, -1250},  // 10^-338
+    {0xb64ec836a47146f9u, 0x9748e2826cdee284u, -1247},  // 10^-337
+    {0xe3e27a444d8d98b7u, 0xfd1b1b2308169b25u, -1244},  // 10^-336
+    {0x8e6d8c6ab0787f72u, 0xfe30f0f5e50e20f7u, -1240},  // 10^-335
+    {0xb208ef855c969f4fu, 0xbdbd2d335e51a935u, -1237},  // 10^-334
+    {0xde8b2b66b3bc4723u, 0xad2c788035e61382u, -1234},  // 10^-333
+    {0x8b16fb203055ac76u, 0x4c3bcb5021afcc31u, -1230},  // 10^-332
+    {0xaddcb9e83c6b1793u, 0xdf4abe242a1bbf3eu, -1227},  // 10^-331
+    {0xd953e8624b85dd78u, 0xd71d6dad34a2af0du, -1224},  // 10^-330
+    {0x87d4713d6f33aa6bu, 0x8672648c40e5ad68u, -1220},  // 10^-329
+    {0xa9c98d8ccb009506u, 0x680efdaf511f18c2u, -1217},  // 10^-328
+    {0xd43bf0effdc0ba48u, 0x0212bd1b2566def3u, -1214},  // 10^-327
+    {0x84a57695fe98746du, 0x014bb630f7604b58u, -1210},  // 10^-326
+    {0xa5ced43b7e3e9188u, 0x419ea3bd35385e2eu, -1207},  // 10^-325
+    {0xcf42894a5dce35eau, 0x52064cac828675b9u, -1204},  // 10^-324
+    {0x818995ce7aa0e1b2u, 0x7343efebd1940994u, -1200},  // 10^-323
+    {0xa1ebfb4219491a1fu, 0x1014ebe6c5f90bf9u, -1197},  // 10^-322
+    {0xca66fa129f9b60a6u, 0xd41a26e077774ef7u, -1194},  // 10^-321
+    {0xfd00b897478238d0u, 0x8920b098955522b5u, -1191},  // 10^-320
+    {0x9e20735e8cb16382u, 0x55b46e5f5d5535b1u, -1187},  // 10^-319
+    {0xc5a890362fddbc62u, 0xeb2189f734aa831du, -1184},  // 10^-318
+    {0xf712b443bbd52b7bu, 0xa5e9ec7501d523e4u, -1181},  // 10^-317
+    {0x9a6bb0aa55653b2du, 0x47b233c92125366fu, -1177},  // 10^-316
+    {0xc1069cd4eabe89f8u, 0x999ec0bb696e840au, -1174},  // 10^-315
+    {0xf148440a256e2c76u, 0xc00670ea43ca250du, -1171},  // 10^-314
+    {0x96cd2a865764dbcau, 0x380406926a5e5728u, -1167},  // 10^-313
+    {0xbc807527ed3e12bcu, 0xc605083704f5ecf2u, -1164},  // 10^-312
+    {0xeba09271e88d976bu, 0xf7864a44c633682fu, -1161},  // 10^-311
+    {0x93445b8731587ea3u, 0x7ab3ee6afbe0211du, -1157},  // 10^-310
+    {0xb8157268fdae9e4cu, 0x5960ea05bad82965u, -1154},  // 10^-309
+    {0xe61acf033d1a45dfu, 0x6fb92487298e33beu, -1151},  // 10^-308
+    {0x8fd0c16206306babu, 0xa5d3b6d479f8e057u, -1147},  // 10^-307
+    {0xb3c4f1ba87bc8696u, 0x8f48a4899877186cu, -1144},  // 10^-306
+    {0xe0b62e2929aba83cu, 0x331acdabfe94de87u, -1141},  // 10^-305
+    {0x8c71dcd9ba0b4925u, 0x9ff0c08b7f1d0b15u, -1137},  // 10^-304
+    {0xaf8e5410288e1b6fu, 0x07ecf0ae5ee44ddau, -1134},  // 10^-303
+    {0xdb71e91432b1a24au, 0xc9e82cd9f69d6150u, -1131},  // 10^-302
+    {0x892731ac9faf056eu, 0xbe311c083a225cd2u, -1127},  // 10^-301
+    {0xab70fe17c79ac6cau, 0x6dbd630a48aaf407u, -1124},  // 10^-300
+    {0xd64d3d9db981787du, 0x092cbbccdad5b108u, -1121},  // 10^-299
+    {0x85f0468293f0eb4eu, 0x25bbf56008c58ea5u, -1117},  // 10^-298
+    {0xa76c582338ed2621u, 0xaf2af2b80af6f24eu, -1114},  // 10^-297
+    {0xd1476e2c07286faau, 0x1af5af660db4aee2u, -1111},  // 10^-296
+    {0x82cca4db847945cau, 0x50d98d9fc890ed4du, -1107},  // 10^-295
+    {0xa37fce126597973cu, 0xe50ff107bab528a1u, -1104},  // 10^-294
+    {0xcc5fc196fefd7d0cu, 0x1e53ed49a96272c9u, -1101},  // 10^-293
+    {0xff77b1fcbebcdc4fu, 0x25e8e89c13bb0f7bu, -1098},  // 10^-292
+    {0x9faacf3df73609b1u, 0x77b191618c54e9adu, -1094},  // 10^-291
+    {0xc795830d75038c1du, 0xd59df5b9ef6a2418u, -1091},  // 10^-290
+    {0xf97ae3d0d2446f25u, 0x4b0573286b44ad1eu, -1088},  // 10^-289
+    {0x9becce62836ac577u, 0x4ee367f9430aec33u, -1084},  // 10^-288
+    {0xc2e801fb244576d5u, 0x229c41f793cda73fu, -1081},  // 10^-287
+    {0xf3a20279ed56d48au, 0x6b43527578c1110fu, -1078},  // 10^-286
+    {0x9845418c345644d6u, 0x830a13896b78aaaau, -1074},  // 10^-285
+    {0xbe5691ef416bd60cu, 0x23cc986bc656d554u, -1071},  // 10^-284
+    {0xedec366b11c6cb8fu, 0x2cbfbe86b7ec8aa9u, -1068},  // 10^-283
+    {0x94b3a202eb1c3f39u, 0x7bf7d71432f3d6aau, -1064},  // 10^-282
+    {0xb9e08a83a5e34f07u, 0xdaf5ccd93fb0cc54u, -1061},  // 10^-281
+    {0xe858ad248f5c22c9u, 0xd1b3400f8f9cff69u, -1058},  // 10^-280
+    {0x91376c36d99995beu, 0x23100809b9c21fa2u, -1054},  // 10^-279
+    {0xb58547448ffffb2du, 0xabd40a0c2832a78au, -1051},  // 10^-278
+    {0xe2e69915b3fff9f9u, 0x16c90c8f323f516du, -1048},  // 10^-277
+    {0x8dd01fad907ffc3bu, 0xae3da7d97f6792e4u, -1044},  // 10^-276
+    {0xb1442798f49ffb4au, 0x99cd11cfdf41779du, -1041},  // 10^-275
+    {0xdd95317f31c7fa1du, 0x40405643d711d584u, -1038},  // 10^-274
+    {0x8a7d3eef7f1cfc52u, 0x482835ea666b2572u, -1034},  // 10^-273
+    {0xad1c8eab5ee43b66u, 0xda3243650005eecfu, -1031},  // 10^-272
+    {0xd863b256369d4a40u, 0x90bed43e40076a83u, -1028},  // 10^-271
+    {0x873e4f75e2224e68u, 0x5a7744a6e804a292u, -1024},  // 10^-270
+    {0xa90de3535aaae202u, 0x711515d0a205cb36u, -1021},  // 10^-269
+    {0xd3515c2831559a83u, 0x0d5a5b44ca873e04u, -1018},  // 10^-268
+    {0x8412d9991ed58091u, 0xe858790afe9486c2u, -1014},  // 10^-267
+    {0xa5178fff668ae0b6u, 0x626e974dbe39a873u, -1011},  // 10^-266
+    {0xce5d73ff402d98e3u, 0xfb0a3d212dc81290u, -1008},  // 10^-265
+    {0x80fa687f881c7f8eu, 0x7ce66634bc9d0b9au, -1004},  // 10^-264
+    {0xa139029f6a239f72u, 0x1c1fffc1ebc44e80u, -1001},  // 10^-263
+    {0xc987434744ac874eu, 0xa327ffb266b56220u, -998},  // 10^-262
+    {0xfbe9141915d7a922u, 0x4bf1ff9f0062baa8u, -995},  // 10^-261
+    {0x9d71ac8fada6c9b5u, 0x6f773fc3603db4a9u, -991},  // 10^-260
+    {0xc4ce17b399107c22u, 0xcb550fb4384d21d4u, -988},  // 10^-259
+    {0xf6019da07f549b2bu, 0x7e2a53a146606a48u, -985},  // 10^-258
+    {0x99c102844f94e0fbu, 0x2eda7444cbfc426du, -981},  // 10^-257
+    {0xc0314325637a1939u, 0xfa911155fefb5309u, -978},  // 10^-256
+    {0xf03d93eebc589f88u, 0x793555ab7eba27cbu, -975},  // 10^-255
+    {0x96267c7535b763b5u, 0x4bc1558b2f3458dfu, -971},  // 10^-254
+    {0xbbb01b9283253ca2u, 0x9eb1aaedfb016f16u, -968},  // 10^-253
+    {0xea9c227723ee8bcbu, 0x465e15a979c1cadcu, -965},  // 10^-252
+    {0x92a1958a7675175fu, 0x0bfacd89ec191ecau, -961},  // 10^-251
+    {0xb749faed14125d36u, 0xcef980ec671f667cu, -958},  // 10^-250
+    {0xe51c79a85916f484u, 0x82b7e12780e7401bu, -955},  // 10^-249
+    {0x8f31cc0937ae58d2u, 0xd1b2ecb8b0908811u, -951},  // 10^-248
+    {0xb2fe3f0b8599ef07u, 0x861fa7e6dcb4aa15u, -948},  // 10^-247
+    {0xdfbdcece67006ac9u, 0x67a791e093e1d49au, -945},  // 10^-246
+    {0x8bd6a141006042bdu, 0xe0c8bb2c5c6d24e0u, -941},  // 10^-245
+    {0xaecc49914078536du, 0x58fae9f773886e19u, -938},  // 10^-244
+    {0xda7f5bf590966848u, 0xaf39a475506a899fu, -935},  // 10^-243
+    {0x888f99797a5e012du, 0x6d8406c952429603u, -931},  // 10^-242
+    {0xaab37fd7d8f58178u, 0xc8e5087ba6d33b84u, -928},  // 10^-241
+    {0xd5605fcdcf32e1d6u, 0xfb1e4a9a90880a65u, -925},  // 10^-240
+    {0x855c3be0a17fcd26u, 0x5cf2eea09a55067fu, -921},  // 10^-239
+    {0xa6b34ad8c9dfc06fu, 0xf42faa48c0ea481fu, -918},  // 10^-238
+    {0xd0601d8efc57b08bu, 0xf13b94daf124da27u, -915},  // 10^-237
+    {0x823c12795db6ce57u, 0x76c53d08d6b70858u, -911},  // 10^-236
+    {0xa2cb1717b52481edu, 0x54768c4b0c64ca6eu, -908},  // 10^-235
+    {0xcb7ddcdda26da268u, 0xa9942f5dcf7dfd0au, -905},  // 10^-234
+    {0xfe5d54150b090b02u, 0xd3f93b35435d7c4cu, -902},  // 10^-233
+    {0x9efa548d26e5a6e1u, 0xc47bc5014a1a6db0u, -898},  // 10^-232
+    {0xc6b8e9b0709f109au, 0x359ab6419ca1091bu, -895},  // 10^-231
+    {0xf867241c8cc6d4c0u, 0xc30163d203c94b62u, -892},  // 10^-230
+    {0x9b407691d7fc44f8u, 0x79e0de63425dcf1du, -888},  // 10^-229
+    {0xc21094364dfb5636u, 0x985915fc12f542e5u, -885},  // 10^-228
+    {0xf294b943e17a2bc4u, 0x3e6f5b7b17b2939eu, -882},  // 10^-227
+    {0x979cf3ca6cec5b5au, 0xa705992ceecf9c43u, -878},  // 10^-226
+    {0xbd8430bd08277231u, 0x50c6ff782a838353u, -875},  // 10^-225
+    {0xece53cec4a314ebdu, 0xa4f8bf5635246428u, -872},  // 10^-224
+    {0x940f4613ae5ed136u, 0x871b7795e136be99u, -868},  // 10^-223
+    {0xb913179899f68584u, 0x28e2557b59846e3fu, -865},  // 10^-222
+    {0xe757dd7ec07426e5u, 0x331aeada2fe589cfu, -862},  // 10^-221
+    {0x9096ea6f3848984fu, 0x3ff0d2c85def7622u, -858},  // 10^-220
+    {0xb4bca50b065abe63u, 0x0fed077a756b53aau, -855},  // 10^-219
+    {0xe1ebce4dc7f16dfbu, 0xd3e8495912c62894u, -852},  // 10^-218
+    {0x8d3360f09cf6e4bdu, 0x64712dd7abbbd95du, -848},  // 10^-217
+    {0xb080392cc4349decu, 0xbd8d794d96aacfb4u, -845},  // 10^-216
+    {0xdca04777f541c567u, 0xecf0d7a0fc5583a1u, -842},  // 10^-215
+    {0x89e42caaf9491b60u, 0xf41686c49db57245u, -838},  // 10^-214
+    {0xac5d37d5b79b6239u, 0x311c2875c522ced6u, -835},  // 10^-213
+    {0xd77485cb25823ac7u, 0x7d633293366b828bu, -832},  // 10^-212
+    {0x86a8d39ef77164bcu, 0xae5dff9c02033197u, -828},  // 10^-211
+    {0xa8530886b54dbdebu, 0xd9f57f830283fdfdu, -825},  // 10^-210
+    {0xd267caa862a12d66u, 0xd072df63c324fd7cu, -822},  // 10^-209
+    {0x8380dea93da4bc60u, 0x4247cb9e59f71e6du, -818},  // 10^-208
+    {0xa46116538d0deb78u, 0x52d9be85f074e609u, -815},  // 10^-207
+    {0xcd795be870516656u, 0x67902e276c921f8bu, -812},  // 10^-206
+    {0x806bd9714632dff6u, 0x00ba1cd8a3db53b7u, -808},  // 10^-205
+    {0xa086cfcd97bf97f3u, 0x80e8a40eccd228a5u, -805},  // 10^-204
+    {0xc8a883c0fdaf7df0u, 0x6122cd128006b2ceu, -802},  // 10^-203
+    {0xfad2a4b13d1b5d6cu, 0x796b805720085f81u, -799},  // 10^-202
+    {0x9cc3a6eec6311a63u, 0xcbe3303674053bb1u, -795},  // 10^-201
+    {0xc3f490aa77bd60fcu, 0xbedbfc4411068a9du, -792},  // 10^-200
+    {0xf4f1b4d515acb93bu, 0xee92fb5515482d44u, -789},  // 10^-199
+    {0x991711052d8bf3c5u, 0x751bdd152d4d1c4bu, -785},  // 10^-198
+    {0xbf5cd54678eef0b6u, 0xd262d45a78a0635du, -782},  // 10^-197
+    {0xef340a98172aace4u, 0x86fb897116c87c35u, -779},  // 10^-196
+    {0x9580869f0e7aac0eu, 0xd45d35e6ae3d4da1u, -775},  // 10^-195
+    {0xbae0a846d2195712u, 0x8974836059cca109u, -772},  // 10^-194
+    {0xe998d258869facd7u, 0x2bd1a438703fc94bu, -769},  // 10^-193
+    {0x91ff83775423cc06u, 0x7b6306a34627ddcfu, -765},  // 10^-192
+    {0xb67f6455292cbf08u, 0x1a3bc84c17b1d543u, -762},  // 10^-191
+    {0xe41f3d6a7377eecau, 0x20caba5f1d9e4a94u, -759},  // 10^-190
+    {0x8e938662882af53eu, 0x547eb47b7282ee9cu, -755},  // 10^-189
+    {0xb23867fb2a35b28du, 0xe99e619a4f23aa43u, -752},  // 10^-188
+    {0xdec681f9f4c31f31u, 0x6405fa00e2ec94d4u, -749},  // 10^-187
+    {0x8b3c113c38f9f37eu, 0xde83bc408dd3dd05u, -745},  // 10^-186
+    {0xae0b158b4738705eu, 0x9624ab50b148d446u, -742},  // 10^-185
+    {0xd98ddaee19068c76u, 0x3badd624dd9b0957u, -739},  // 10^-184
+    {0x87f8a8d4cfa417c9u, 0xe54ca5d70a80e5d6u, -735},  // 10^-183
+    {0xa9f6d30a038d1dbcu, 0x5e9fcf4ccd211f4cu, -732},  // 10^-182
+    {0xd47487cc8470652bu, 0x7647c3200069671fu, -729},  // 10^-181
+    {0x84c8d4dfd2c63f3bu, 0x29ecd9f40041e073u, -725},  // 10^-180
+    {0xa5fb0a17c777cf09u, 0xf468107100525890u, -722},  // 10^-179
+    {0xcf79cc9db955c2ccu, 0x7182148d4066eeb4u, -719},  // 10^-178
+    {0x81ac1fe293d599bfu, 0xc6f14cd848405531u, -715},  // 10^-177
+    {0xa21727db38cb002fu, 0xb8ada00e5a506a7du, -712},  // 10^-176
+    {0xca9cf1d206fdc03bu, 0xa6d90811f0e4851cu, -709},  // 10^-175
+    {0xfd442e4688bd304au, 0x908f4a166d1da663u, -706},  // 10^-174
+    {0x9e4a9cec15763e2eu, 0x9a598e4e043287feu, -702},  // 10^-173
+    {0xc5dd44271ad3cdbau, 0x40eff1e1853f29feu, -699},  // 10^-172
+    {0xf7549530e188c128u, 0xd12bee59e68ef47du, -696},  // 10^-171
+    {0x9a94dd3e8cf578b9u, 0x82bb74f8301958ceu, -692},  // 10^-170
+    {0xc13a148e3032d6e7u, 0xe36a52363c1faf02u, -689},  // 10^-169
+    {0xf18899b1bc3f8ca1u, 0xdc44e6c3cb279ac2u, -686},  // 10^-168
+    {0x96f5600f15a7b7e5u, 0x29ab103a5ef8c0b9u, -682},  // 10^-167
+    {0xbcb2b812db11a5deu, 0x7415d448f6b6f0e8u, -679},  // 10^-166
+    {0xebdf661791d60f56u, 0x111b495b3464ad21u, -676},  // 10^-165
+    {0x936b9fcebb25c995u, 0xcab10dd900beec35u, -672},  // 10^-164
+    {0xb84687c269ef3bfbu, 0x3d5d514f40eea742u, -669},  // 10^-163
+    {0xe65829b3046b0afau, 0x0cb4a5a3112a5113u, -666},  // 10^-162
+    {0x8ff71a0fe2c2e6dcu, 0x47f0e785eaba72acu, -662},  // 10^-161
+    {0xb3f4e093db73a093u, 0x59ed216765690f57u, -659},  // 10^-160
+    {0xe0f218b8d25088b8u, 0x306869c13ec3532cu, -656},  // 10^-159
+    {0x8c974f7383725573u, 0x1e414218c73a13fcu, -652},  // 10^-158
+    {0xafbd2350644eeacfu, 0xe5d1929ef90898fbu, -649},  // 10^-157
+    {0xdbac6c247d62a583u, 0xdf45f746b74abf39u, -646},  // 10^-156
+    {0x894bc396ce5da772u, 0x6b8bba8c328eb784u, -642},  // 10^-155
+    {0xab9eb47c81f5114fu, 0x066ea92f3f326565u, -639},  // 10^-154
+    {0xd686619ba27255a2u, 0xc80a537b0efefebeu, -636},  // 10^-153
+    {0x8613fd0145877585u, 0xbd06742ce95f5f37u, -632},  // 10^-152
+    {0xa798fc4196e952e7u, 0x2c48113823b73704u, -629},  // 10^-151
+    {0xd17f3b51fca3a7a0u, 0xf75a15862ca504c5u, -626},  // 10^-150
+    {0x82ef85133de648c4u, 0x9a984d73dbe722fbu, -622},  // 10^-149
+    {0xa3ab66580d5fdaf5u, 0xc13e60d0d2e0ebbau, -619},  // 10^-148
+    {0xcc963fee10b7d1b3u, 0x318df905079926a9u, -616},  // 10^-147
+    {0xffbbcfe994e5c61fu, 0xfdf17746497f7053u, -613},  // 10^-146
+    {0x9fd561f1fd0f9bd3u, 0xfeb6ea8bedefa634u, -609},  // 10^-145
+    {0xc7caba6e7c5382c8u, 0xfe64a52ee96b8fc1u, -606},  // 10^-144
+    {0xf9bd690a1b68637bu, 0x3dfdce7aa3c673b1u, -603},  // 10^-143
+    {0x9c1661a651213e2du, 0x06bea10ca65c084fu, -599},  // 10^-142
+    {0xc31bfa0fe5698db8u, 0x486e494fcff30a62u, -596},  // 10^-141
+    {0xf3e2f893dec3f126u, 0x5a89dba3c3efccfbu, -593},  // 10^-140
+    {0x986ddb5c6b3a76b7u, 0xf89629465a75e01du, -589},  // 10^-139
+    {0xbe89523386091465u, 0xf6bbb397f1135824u, -586},  // 10^-138
+    {0xee2ba6c0678b597fu, 0x746aa07ded582e2du, -583},  // 10^-137
+    {0x94db483840b717efu, 0xa8c2a44eb4571cdcu, -579},  // 10^-136
+    {0xba121a4650e4ddebu, 0x92f34d62616ce413u, -576},  // 10^-135
+    {0xe896a0d7e51e1566u, 0x77b020baf9c81d18u, -573},  // 10^-134
+    {0x915e2486ef32cd60u, 0x0ace1474dc1d122fu, -569},  // 10^-133
+    {0xb5b5ada8aaff80b8u, 0x0d819992132456bbu, -566},  // 10^-132
+    {0xe3231912d5bf60e6u, 0x10e1fff697ed6c69u, -563},  // 10^-131
+    {0x8df5efabc5979c8fu, 0xca8d3ffa1ef463c2u, -559},  // 10^-130
+    {0xb1736b96b6fd83b3u, 0xbd308ff8a6b17cb2u, -556},  // 10^-129
+    {0xddd0467c64bce4a0u, 0xac7cb3f6d05ddbdfu, -553},  // 10^-128
+    {0x8aa22c0dbef60ee4u, 0x6bcdf07a423aa96bu, -549},  // 10^-127
+    {0xad4ab7112eb3929du, 0x86c16c98d2c953c6u, -546},  // 10^-126
+    {0xd89d64d57a607744u, 0xe871c7bf077ba8b8u, -543},  // 10^-125
+    {0x87625f056c7c4a8bu, 0x11471cd764ad4973u, -539},  // 10^-124
+    {0xa93af6c6c79b5d2du, 0xd598e40d3dd89bcfu, -536},  // 10^-123
+    {0xd389b47879823479u, 0x4aff1d108d4ec2c3u, -533},  // 10^-122
+    {0x843610cb4bf160cbu, 0xcedf722a585139bau, -529},  // 10^-121
+    {0xa54394fe1eedb8feu, 0xc2974eb4ee658829u, -526},  // 10^-120
+    {0xce947a3da6a9273eu, 0x733d226229feea33u, -523},  // 10^-119
+    {0x811ccc668829b887u, 0x0806357d5a3f5260u, -519},  // 10^-118
+    {0xa163ff802a3426a8u, 0xca07c2dcb0cf26f8u, -516},  // 10^-117
+    {0xc9bcff6034c13052u, 0xfc89b393dd02f0b6u, -513},  // 10^-116
+    {0xfc2c3f3841f17c67u, 0xbbac2078d443ace3u, -510},  // 10^-115
+    {0x9d9ba7832936edc0u, 0xd54b944b84aa4c0eu, -506},  // 10^-114
+    {0xc5029163f384a931u, 0x0a9e795e65d4df11u, -503},  // 10^-113
+    {0xf64335bcf065d37du, 0x4d4617b5ff4a16d6u, -500},  // 10^-112
+    {0x99ea0196163fa42eu, 0x504bced1bf8e4e46u, -496},  // 10^-111
+    {0xc06481fb9bcf8d39u, 0xe45ec2862f71e1d7u, -493},  // 10^-110
+    {0xf07da27a82c37088u, 0x5d767327bb4e5a4du, -490},  // 10^-109
+    {0x964e858c91ba2655u, 0x3a6a07f8d510f870u, -486},  // 10^-108
+    {0xbbe226efb628afeau, 0x890489f70a55368cu, -483},  // 10^-107
+    {0xeadab0aba3b2dbe5u, 0x2b45ac74ccea842fu, -480},  // 10^-106
+    {0x92c8ae6b464fc96fu, 0x3b0b8bc90012929du, -476},  // 10^-105
+    {0xb77ada0617e3bbcbu, 0x09ce6ebb40173745u, -473},  // 10^-104
+    {0xe55990879ddcaabdu, 0xcc420a6a101d0516u, -470},  // 10^-103
+    {0x8f57fa54c2a9eab6u, 0x9fa946824a12232eu, -466},  // 10^-102
+    {0xb32df8e9f3546564u, 0x47939822dc96abf9u, -463},  // 10^-101
+    {0xdff9772470297ebdu, 0x59787e2b93bc56f7u, -460},  // 10^-100
+    {0x8bfbea76c619ef36u, 0x57eb4edb3c55b65bu, -456},  // 10^-99
+    {0xaefae51477a06b03u, 0xede622920b6b23f1u, -453},  // 10^-98
+    {0xdab99e59958885c4u, 0xe95fab368e45ecedu, -450},  // 10^-97
+    {0x88b402f7fd75539bu, 0x11dbcb0218ebb414u, -446},  // 10^-96
+    {0xaae103b5fcd2a881u, 0xd652bdc29f26a11au, -443},  // 10^-95
+    {0xd59944a37c0752a2u, 0x4be76d3346f04960u, -440},  // 10^-94
+    {0x857fcae62d8493a5u, 0x6f70a4400c562ddcu, -436},  // 10^-93
+    {0xa6dfbd9fb8e5b88eu, 0xcb4ccd500f6bb953u, -433},  // 10^-92
+    {0xd097ad07a71f26b2u, 0x7e2000a41346a7a8u, -430},  // 10^-91
+    {0x825ecc24c873782fu, 0x8ed400668c0c28c9u, -426},  // 10^-90
+    {0xa2f67f2dfa90563bu, 0x728900802f0f32fbu, -423},  // 10^-89
+    {0xcbb41ef979346bcau, 0x4f2b40a03ad2ffbau, -420},  // 10^-88
+    {0xfea126b7d78186bcu, 0xe2f610c84987bfa8u, -417},  // 10^-87
+    {0x9f24b832e6b0f436u, 0x0dd9ca7d2df4d7c9u, -413},  // 10^-86
+    {0xc6ede63fa05d3143u, 0x91503d1c79720dbbu, -410},  // 10^-85
+    {0xf8a95fcf88747d94u, 0x75a44c6397ce912au, -407},  // 10^-84
+    {0x9b69dbe1b548ce7cu, 0xc986afbe3ee11abau, -403},  // 10^-83
+    {0xc24452da229b021bu, 0xfbe85badce996169u, -400},  // 10^-82
+    {0xf2d56790ab41c2a2u, 0xfae27299423fb9c3u, -397},  // 10^-81
+    {0x97c560ba6b0919a5u, 0xdccd879fc967d41au, -393},  // 10^-80
+    {0xbdb6b8e905cb600fu, 0x5400e987bbc1c921u, -390},  // 10^-79
+    {0xed246723473e3813u, 0x290123e9aab23b69u, -387},  // 10^-78
+    {0x9436c0760c86e30bu, 0xf9a0b6720aaf6521u, -383},  // 10^-77
+    {0xb94470938fa89bceu, 0xf808e40e8d5b3e6au, -380},  // 10^-76
+    {0xe7958cb87392c2c2u, 0xb60b1d1230b20e04u, -377},  // 10^-75
+    {0x90bd77f3483bb9b9u, 0xb1c6f22b5e6f48c3u, -373},  // 10^-74
+    {0xb4ecd5f01a4aa828u, 0x1e38aeb6360b1af3u, -370},  // 10^-73
+    {0xe2280b6c20dd5232u, 0x25c6da63c38de1b0u, -367},  // 10^-72
+    {0x8d590723948a535fu, 0x579c487e5a38ad0eu, -363},  // 10^-71
+    {0xb0af48ec79ace837u, 0x2d835a9df0c6d852u, -360},  // 10^-70
+    {0xdcdb1b2798182244u, 0xf8e431456cf88e66u, -357},  // 10^-69
+    {0x8a08f0f8bf0f156bu, 0x1b8e9ecb641b5900u, -353},  // 10^-68
+    {0xac8b2d36eed2dac5u, 0xe272467e3d222f40u, -350},  // 10^-67
+    {0xd7adf884aa879177u, 0x5b0ed81dcc6abb10u, -347},  // 10^-66
+    {0x86ccbb52ea94baeau, 0x98e947129fc2b4eau, -343},  // 10^-65
+    {0xa87fea27a539e9a5u, 0x3f2398d747b36224u, -340},  // 10^-64
+    {0xd29fe4b18e88640eu, 0x8eec7f0d19a03aadu, -337},  // 10^-63
+    {0x83a3eeeef9153e89u, 0x1953cf68300424acu, -333},  // 10^-62
+    {0xa48ceaaab75a8e2bu, 0x5fa8c3423c052dd7u, -330},  // 10^-61
+    {0xcdb02555653131b6u, 0x3792f412cb06794du, -327},  // 10^-60
+    {0x808e17555f3ebf11u, 0xe2bbd88bbee40bd0u, -323},  // 10^-59
+    {0xa0b19d2ab70e6ed6u, 0x5b6aceaeae9d0ec4u, -320},  // 10^-58
+    {0xc8de047564d20a8bu, 0xf245825a5a445275u, -317},  // 10^-57
+    {0xfb158592be068d2eu, 0xeed6e2f0f0d56713u, -314},  // 10^-56
+    {0x9ced737bb6c4183du, 0x55464dd69685606cu, -310},  // 10^-55
+    {0xc428d05aa4751e4cu, 0xaa97e14c3c26b887u, -307},  // 10^-54
+    {0xf53304714d9265dfu, 0xd53dd99f4b3066a8u, -304},  // 10^-53
+    {0x993fe2c6d07b7fabu, 0xe546a8038efe4029u, -300},  // 10^-52
+    {0xbf8fdb78849a5f96u, 0xde98520472bdd033u, -297},  // 10^-51
+    {0xef73d256a5c0f77cu, 0x963e66858f6d4440u, -294},  // 10^-50
+    {0x95a8637627989aadu, 0xdde7001379a44aa8u, -290},  // 10^-49
+    {0xbb127c53b17ec159u, 0x5560c018580d5d52u, -287},  // 10^-48
+    {0xe9d71b689dde71afu, 0xaab8f01e6e10b4a7u, -284},  // 10^-47
+    {0x9226712162ab070du, 0xcab3961304ca70e8u, -280},  // 10^-46
+    {0xb6b00d69bb55c8d1u, 0x3d607b97c5fd0d22u, -277},  // 10^-45
+    {0xe45c10c42a2b3b05u, 0x8cb89a7db77c506bu, -274},  // 10^-44
+    {0x8eb98a7a9a5b04e3u, 0x77f3608e92adb243u, -270},  // 10^-43
+    {0xb267ed1940f1c61cu, 0x55f038b237591ed3u, -267},  // 10^-42
+    {0xdf01e85f912e37a3u, 0x6b6c46dec52f6688u, -264},  // 10^-41
+    {0x8b61313bbabce2c6u, 0x2323ac4b3b3da015u, -260},  // 10^-40
+    {0xae397d8aa96c1b77u, 0xabec975e0a0d081bu, -257},  // 10^-39
+    {0xd9c7dced53c72255u, 0x96e7bd358c904a21u, -254},  // 10^-38
+    {0x881cea14545c7575u, 0x7e50d64177da2e55u, -250},  // 10^-37
+    {0xaa242499697392d2u, 0xdde50bd1d5d0b9eau, -247},  // 10^-36
+    {0xd4ad2dbfc3d07787u, 0x955e4ec64b44e864u, -244},  // 10^-35
+    {0x84ec3c97da624ab4u, 0xbd5af13bef0b113fu, -240},  // 10^-34
+    {0xa6274bbdd0fadd61u, 0xecb1ad8aeacdd58eu, -237},  // 10^-33
+    {0xcfb11ead453994bau, 0x67de18eda5814af2u, -234},  // 10^-32
+    {0x81ceb32c4b43fcf4u, 0x80eacf948770ced7u, -230},  // 10^-31
+    {0xa2425ff75e14fc31u, 0xa1258379a94d028du, -227},  // 10^-30
+    {0xcad2f7f5359a3b3eu, 0x096ee45813a04330u, -224},  // 10^-29
+    {0xfd87b5f28300ca0du, 0x8bca9d6e188853fcu, -221},  // 10^-28
+    {0x9e74d1b791e07e48u, 0x775ea264cf55347eu, -217},  // 10^-27
+    {0xc612062576589ddau, 0x95364afe032a819du, -214},  // 10^-26
+    {0xf79687aed3eec551u, 0x3a83ddbd83f52205u, -211},  // 10^-25
+    {0x9abe14cd44753b52u, 0xc4926a9672793543u, -207},  // 10^-24
+    {0xc16d9a0095928a27u, 0x75b7053c0f178294u, -204},  // 10^-23
+    {0xf1c90080baf72cb1u, 0x5324c68b12dd6338u, -201},  // 10^-22
+    {0x971da05074da7beeu, 0xd3f6fc16ebca5e03u, -197},  // 10^-21
+    {0xbce5086492111aeau, 0x88f4bb1ca6bcf584u, -194},  // 10^-20
+    {0xec1e4a7db69561a5u, 0x2b31e9e3d06c32e5u, -191},  // 10^-19
+    {0x9392ee8e921d5d07u, 0x3aff322e62439fcfu, -187},  // 10^-18
+    {0xb877aa3236a4b449u, 0x09befeb9fad487c3u, -184},  // 10^-17
+    {0xe69594bec44de15bu, 0x4c2ebe687989a9b4u, -181},  // 10^-16
+    {0x901d7cf73ab0acd9u, 0x0f9d37014bf60a10u, -177},  // 10^-15
+    {0xb424dc35095cd80fu, 0x538484c19ef38c94u, -174},  // 10^-14
+    {0xe12e13424bb40e13u, 0x2865a5f206b06fbau, -171},  // 10^-13
+    {0x8cbccc096f5088cbu, 0xf93f87b7442e45d4u, -167},  // 10^-12
+    {0xafebff0bcb24aafeu, 0xf78f69a51539d749u, -164},  // 10^-11
+    {0xdbe6fecebdedd5beu, 0xb573440e5a884d1bu, -161},  // 10^-10
+    {0x89705f4136b4a597u, 0x31680a88f8953031u, -157},  // 10^-9
+    {0xabcc77118461cefcu, 0xfdc20d2b36ba7c3du, -154},  // 10^-8
+    {0xd6bf94d5e57a42bcu, 0x3d32907604691b4du, -151},  // 10^-7
+    {0x8637bd05af6c69b5u, 0xa63f9a49c2c1b110u, -147},  // 10^-6
+    {0xa7c5ac471b478423u, 0x0fcf80dc33721d54u, -144},  // 10^-5
+    {0xd1b71758e219652bu, 0xd3c36113404ea4a9u, -141},  // 10^-4
+    {0x83126e978d4fdf3bu, 0x645a1cac083126e9u, -137},  // 10^-3
+    {0xa3d70a3d70a3d70au, 0x3d70a3d70a3d70a4u, -134},  // 10^-2
+    {0xccccccccccccccccu, 0xcccccccccccccccdu, -131},  // 10^-1
+    {0x8000000000000000u, 0x0000000000000000u, -127},  // 10^0
+    {0xa000000000000000u, 0x0000000000000000u, -124},  // 10^1
+    {0xc800000000000000u, 0x0000000000000000u, -121},  // 10^2
+    {0xfa00000000000000u, 0x0000000000000000u, -118},  // 10^3
+    {0x9c40000000000000u, 0x0000000000000000u, -114},  // 10^4
+    {0xc350000000000000u, 0x0000000000000000u, -111},  // 10^5
+    {0xf424000000000000u, 0x0000000000000000u, -108},  // 10^6
+    {0x9896800000000000u, 0x0000000000000000u, -104},  // 10^7
+    {0xbebc200000000000u, 0x0000000000000000u, -101},  // 10^8
+    {0xee6b280000000000u, 0x0000000000000000u, -98},  // 10^9
+    {0x9502f90000000000u, 0x0000000000000000u, -94},  // 10^10
+    {0xba43b74000000000u, 0x0000000000000000u, -91},  // 10^11
+    {0xe8d4a51000000000u, 0x0000000000000000u, -88},  // 10^12
+    {0x9184e72a00000000u, 0x0000000000000000u, -84},  // 10^13
+    {0xb5e620f480000000u, 0x0000000000000000u, -81},  // 10^14
+    {0xe35fa931a0000000u, 0x0000000000000000u, -78},  // 10^15
+    {0x8e1bc9bf04000000u, 0x0000000000000000u, -74},  // 10^16
+    {0xb1a2bc2ec5000000u, 0x0000000000000000u, -71},  // 10^17
+    {0xde0b6b3a76400000u, 0x0000000000000000u, -68},  // 10^18
+    {0x8ac7230489e80000u, 0x0000000000000000u, -64},  // 10^19
+    {0xad78ebc5ac620000u, 0x0000000000000000u, -61},  // 10^20
+    {0xd8d726b7177a8000u, 0x0000000000000000u, -58},  // 10^21
+    {0x878678326eac9000u, 0x0000000000000000u, -54},  // 10^22
+    {0xa968163f0a57b400u, 0x0000000000000000u, -51},  // 10^23
+    {0xd3c21bcecceda100u, 0x0000000000000000u, -48},  // 10^24
+    {0x84595161401484a0u, 0x0000000000000000u, -44},  // 10^25
+    {0xa56fa5b99019a5c8u, 0x0000000000000000u, -41},  // 10^26
+    {0xcecb8f27f4200f3au, 0x0000000000000000u, -38},  // 10^27
+    {0x813f3978f8940984u, 0x4000000000000000u, -34},  // 10^28
+    {0xa18f07d736b90be5u, 0x5000000000000000u, -31},  // 10^29
+    {0xc9f2c9cd04674edeu, 0xa400000000000000u, -28},  // 10^30
+    {0xfc6f7c4045812296u, 0x4d00000000000000u, -25},  // 10^31
+    {0x9dc5ada82b70b59du, 0xf020000000000000u, -21},  // 10^32
+    {0xc5371912364ce305u, 0x6c28000000000000u, -18},  // 10^33
+    {0xf684df56c3e01bc6u, 0xc732000000000000u, -15},  // 10^34
+    {0x9a130b963a6c115cu, 0x3c7f400000000000u, -11},  // 10^35
+    {0xc097ce7bc90715b3u, 0x4b9f100000000000u, -8},  // 10^36
+    {0xf0bdc21abb48db20u, 0x1e86d40000000000u, -5},  // 10^37
+    {0x96769950b50d88f4u, 0x1314448000000000u, -1},  // 10^38
+    {0xbc143fa4e250eb31u, 0x17d955a000000000u, 2},  // 10^39
+    {0xeb194f8e1ae525fdu, 0x5dcfab0800000000u, 5},  // 10^40
+    {0x92efd1b8d0cf37beu, 0x5aa1cae500000000u, 9},  // 10^41
+    {0xb7abc627050305adu, 0xf14a3d9e40000000u, 12},  // 10^42
+    {0xe596b7b0c643c719u, 0x6d9ccd05d0000000u, 15},  // 10^43
+    {0x8f7e32ce7bea5c6fu, 0xe4820023a2000000u, 19},  // 10^44
+    {0xb35dbf821ae4f38bu, 0xdda2802c8a800000u, 22},  // 10^45
+    {0xe0352f62a19e306eu, 0xd50b2037ad200000u, 25},  // 10^46
+    {0x8c213d9da502de45u, 0x4526f422cc340000u, 29},  // 10^47
+    {0xaf298d050e4395d6u, 0x9670b12b7f410000u, 32},  // 10^48
+    {0xdaf3f04651d47b4cu, 0x3c0cdd765f114000u, 35},  // 10^49
+    {0x88d8762bf324cd0fu, 0xa5880a69fb6ac800u, 39},  // 10^50
+    {0xab0e93b6efee0053u, 0x8eea0d047a457a00u, 42},  // 10^51
+    {0xd5d238a4abe98068u, 0x72a4904598d6d880u, 45},  // 10^52
+    {0x85a36366eb71f041u, 0x47a6da2b7f864750u, 49},  // 10^53
+    {0xa70c3c40a64e6c51u, 0x999090b65f67d924u, 52},  // 10^54
+    {0xd0cf4b50cfe20765u, 0xfff4b4e3f741cf6du, 55},  // 10^55
+    {0x82818f1281ed449fu, 0xbff8f10e7a8921a4u, 59},  // 10^56
+    {0xa321f2d7226895c7u, 0xaff72d52192b6a0du, 62},  // 10^57
+    {0xcbea6f8ceb02bb39u, 0x9bf4f8a69f764490u, 65},  // 10^58
+    {0xfee50b7025c36a08u, 0x02f236d04753d5b5u, 68},  // 10^59
+    {0x9f4f2726179a2245u, 0x01d762422c946591u, 72},  // 10^60
+    {0xc722f0ef9d80aad6u, 0x424d3ad2b7b97ef5u, 75},  // 10^61
+    {0xf8ebad2b84e0d58bu, 0xd2e0898765a7deb2u, 78},  // 10^62
+    {0x9b934c3b330c8577u, 0x63cc55f49f88eb2fu, 82},  // 10^63
+    {0xc2781f49ffcfa6d5u, 0x3cbf6b71c76b25fbu, 85},  // 10^64
+    {0xf316271c7fc3908au, 0x8bef464e3945ef7au, 88},  // 10^65
+    {0x97edd871cfda3a56u, 0x97758bf0e3cbb5acu, 92},  // 10^66
+    {0xbde94e8e43d0c8ecu, 0x3d52eeed1cbea317u, 95},  // 10^67
+    {0xed63a231d4c4fb27u, 0x4ca7aaa863ee4bddu, 98},  // 10^68
+    {0x945e455f24fb1cf8u, 0x8fe8caa93e74ef6au, 102},  // 10^69
+    {0xb975d6b6ee39e436u, 0xb3e2fd538e122b45u, 105},  // 10^70
+    {0xe7d34c64a9c85d44u, 0x60dbbca87196b616u, 108},  // 10^71
+    {0x90e40fbeea1d3a4au, 0xbc8955e946fe31ceu, 112},  // 10^72
+    {0xb51d13aea4a488ddu, 0x6babab6398bdbe41u, 115},  // 10^73
+    {0xe264589a4dcdab14u, 0xc696963c7eed2dd2u, 118},  // 10^74
+    {0x8d7eb76070a08aecu, 0xfc1e1de5cf543ca3u, 122},  // 10^75
+    {0xb0de65388cc8ada8u, 0x3b25a55f43294bccu, 125},  // 10^76
+    {0xdd15fe86affad912u, 0x49ef0eb713f39ebfu, 128},  // 10^77
+    {0x8a2dbf142dfcc7abu, 0x6e3569326c784337u, 132},  // 10^78
+    {0xacb92ed9397bf996u, 0x49c2c37f07965405u, 135},  // 10^79
+    {0xd7e77a8f87daf7fbu, 0xdc33745ec97be906u, 138},  // 10^80
+    {0x86f0ac99b4e8dafdu, 0x69a028bb3ded71a4u, 142},  // 10^81
+    {0xa8acd7c0222311bcu, 0xc40832ea0d68ce0du, 145},  // 10^82
+    {0xd2d80db02aabd62bu, 0xf50a3fa490c30190u, 148},  // 10^83
+    {0x83c7088e1aab65dbu, 0x792667c6da79e0fau, 152},  // 10^84
+    {0xa4b8cab1a1563f52u, 0x577001b891185939u, 155},  // 10^85
+    {0xcde6fd5e09abcf26u, 0xed4c0226b55e6f87u, 158},  // 10^86
+    {0x80b05e5ac60b6178u, 0x544f8158315b05b4u, 162},  // 10^87
+    {0xa0dc75f1778e39d6u, 0x696361ae3db1c721u, 165},  // 10^88
+    {0xc913936dd571c84cu, 0x03bc3a19cd1e38eau, 168},  // 10^89
+    {0xfb5878494ace3a5fu, 0x04ab48a04065c724u, 171},  // 10^90
+    {0x9d174b2dcec0e47bu, 0x62eb0d64283f9c76u, 175},  // 10^91
+    {0xc45d1df942711d9au, 0x3ba5d0bd324f8394u, 178},  // 10^92
+    {0xf5746577930d6500u, 0xca8f44ec7ee36479u, 181},  // 10^93
+    {0x9968bf6abbe85f20u, 0x7e998b13cf4e1eccu, 185},  // 10^94
+    {0xbfc2ef456ae276e8u, 0x9e3fedd8c321a67fu, 188},  // 10^95
+    {0xefb3ab16c59b14a2u, 0xc5cfe94ef3ea101eu, 191},  // 10^96
+    {0x95d04aee3b80ece5u, 0xbba1f1d158724a13u, 195},  // 10^97
+    {0xbb445da9ca61281fu, 0x2a8a6e45ae8edc98u, 198},  // 10^98
+    {0xea1575143cf97226u, 0xf52d09d71a3293beu, 201},  // 10^99
+    {0x924d692ca61be758u, 0x593c2626705f9c56u, 205},  // 10^100
+    {0xb6e0c377cfa2e12eu, 0x6f8b2fb00c77836cu, 208},  // 10^101
+    {0xe498f455c38b997au, 0x0b6dfb9c0f956447u, 211},  // 10^102
+    {0x8edf98b59a373fecu, 0x4724bd4189bd5eacu, 215},  // 10^103
+    {0xb2977ee300c50fe7u, 0x58edec91ec2cb658u, 218},  // 10^104
+    {0xdf3d5e9bc0f653e1u, 0x2f2967b66737e3edu, 221},  // 10^105
+    {0x8b865b215899f46cu, 0xbd79e0d20082ee74u, 225},  // 10^106
+    {0xae67f1e9aec07187u, 0xecd8590680a3aa11u, 228},  // 10^107
+    {0xda01ee641a708de9u, 0xe80e6f4820cc9496u, 231},  // 10^108
+    {0x884134fe908658b2u, 0x3109058d147fdcdeu, 235},  // 10^109
+    {0xaa51823e34a7eedeu, 0xbd4b46f0599fd415u, 238},  // 10^110
+    {0xd4e5e2cdc1d1ea96u, 0x6c9e18ac7007c91au, 241},  // 10^111
+    {0x850fadc09923329eu, 0x03e2cf6bc604ddb0u, 245},  // 10^112
+    {0xa6539930bf6bff45u, 0x84db8346b786151du, 248},  // 10^113
+    {0xcfe87f7cef46ff16u, 0xe612641865679a64u, 251},  // 10^114
+    {0x81f14fae158c5f6eu, 0x4fcb7e8f3f60c07eu, 255},  // 10^115
+    {0xa26da3999aef7749u, 0xe3be5e330f38f09eu, 258},  // 10^116
+    {0xcb090c8001ab551cu, 0x5cadf5bfd3072cc5u, 261},  // 10^117
+    {0xfdcb4fa002162a63u, 0x73d9732fc7c8f7f7u, 264},  // 10^118
+    {0x9e9f11c4014dda7eu, 0x2867e7fddcdd9afau, 268},  // 10^119
+    {0xc646d63501a1511du, 0xb281e1fd541501b9u, 271},  // 10^120
+    {0xf7d88bc24209a565u, 0x1f225a7ca91a4227u, 274},  // 10^121
+    {0x9ae757596946075fu, 0x3375788de9b06958u, 278},  // 10^122
+    {0xc1a12d2fc3978937u, 0x0052d6b1641c83aeu, 281},  // 10^123
+    {0xf209787bb47d6b84u, 0xc0678c5dbd23a49au, 284},  // 10^124
+    {0x9745eb4d50ce6332u, 0xf840b7ba963646e0u, 288},  // 10^125
+    {0xbd176620a501fbffu, 0xb650e5a93bc3d898u, 291},  // 10^126
+    {0xec5d3fa8ce427affu, 0xa3e51f138ab4cebeu, 294},  // 10^127
+    {0x93ba47c980e98cdfu, 0xc66f336c36b10137u, 298},  // 10^128
+    {0xb8a8d9bbe123f017u, 0xb80b0047445d4185u, 301},  // 10^129
+    {0xe6d3102ad96cec1du, 0xa60dc059157491e6u, 304},  // 10^130
+    {0x9043ea1ac7e41392u, 0x87c89837ad68db30u, 308},  // 10^131
+    {0xb454e4a179dd1877u, 0x29babe4598c311fcu, 311},  // 10^132
+    {0xe16a1dc9d8545e94u, 0xf4296dd6fef3d67bu, 314},  // 10^133
+    {0x8ce2529e2734bb1du, 0x1899e4a65f58660du, 318},  // 10^134
+    {0xb01ae745b101e9e4u, 0x5ec05dcff72e7f90u, 321},  // 10^135
+    {0xdc21a1171d42645du, 0x76707543f4fa1f74u, 324},  // 10^136
+    {0x899504ae72497ebau, 0x6a06494a791c53a8u, 328},  // 10^137
+    {0xabfa45da0edbde69u, 0x0487db9d17636892u, 331},  // 10^138
+    {0xd6f8d7509292d603u, 0x45a9d2845d3c42b7u, 334},  // 10^139
+    {0x865b86925b9bc5c2u, 0x0b8a2392ba45a9b2u, 338},  // 10^140
+    {0xa7f26836f282b732u, 0x8e6cac7768d7141fu, 341},  // 10^141
+    {0xd1ef0244af2364ffu, 0x3207d795430cd927u, 344},  // 10^142
+    {0x8335616aed761f1fu, 0x7f44e6bd49e807b8u, 348},  // 10^143
+    {0xa402b9c5a8d3a6e7u, 0x5f16206c9c6209a6u, 351},  // 10^144
+    {0xcd036837130890a1u, 0x36dba887c37a8c10u, 354},  // 10^145
+    {0x802221226be55a64u, 0xc2494954da2c978au, 358},  // 10^146
+    {0xa02aa96b06deb0fdu, 0xf2db9baa10b7bd6cu, 361},  // 10^147
+    {0xc83553c5c8965d3du, 0x6f92829494e5acc7u, 364},  // 10^148
+    {0xfa42a8b73abbf48cu, 0xcb772339ba1f17f9u, 367},  // 10^149
+    {0x9c69a97284b578d7u, 0xff2a760414536efcu, 371},  // 10^150
+    {0xc38413cf25e2d70du, 0xfef5138519684abbu, 374},  // 10^151
+    {0xf46518c2ef5b8cd1u, 0x7eb258665fc25d69u, 377},  // 10^152
+    {0x98bf2f79d5993802u, 0xef2f773ffbd97a62u, 381},  // 10^153
+    {0xbeeefb584aff8603u, 0xaafb550ffacfd8fau, 384},  // 10^154
+    {0xeeaaba2e5dbf6784u, 0x95ba2a53f983cf39u, 387},  // 10^155
+    {0x952ab45cfa97a0b2u, 0xdd945a747bf26184u, 391},  // 10^156
+    {0xba756174393d88dfu, 0x94f971119aeef9e4u, 394},  // 10^157
+    {0xe912b9d1478ceb17u, 0x7a37cd5601aab85eu, 397},  // 10^158
+    {0x91abb422ccb812eeu, 0xac62e055c10ab33bu, 401},  // 10^159
+    {0xb616a12b7fe617aau, 0x577b986b314d6009u, 404},  // 10^160
+    {0xe39c49765fdf9d94u, 0xed5a7e85fda0b80bu, 407},  // 10^161
+    {0x8e41ade9fbebc27du, 0x14588f13be847307u, 411},  // 10^162
+    {0xb1d219647ae6b31cu, 0x596eb2d8ae258fc9u, 414},  // 10^163
+    {0xde469fbd99a05fe3u, 0x6fca5f8ed9aef3bbu, 417},  // 10^164
+    {0x8aec23d680043beeu, 0x25de7bb9480d5855u, 421},  // 10^165
+    {0xada72ccc20054ae9u, 0xaf561aa79a10ae6au, 424},  // 10^166
+    {0xd910f7ff28069da4u, 0x1b2ba1518094da05u, 427},  // 10^167
+    {0x87aa9aff79042286u, 0x90fb44d2f05d0843u, 431},  // 10^168
+    {0xa99541bf57452b28u, 0x353a1607ac744a54u, 434},  // 10^169
+    {0xd3fa922f2d1675f2u, 0x42889b8997915ce9u, 437},  // 10^170
+    {0x847c9b5d7c2e09b7u, 0x69956135febada11u, 441},  // 10^171
+    {0xa59bc234db398c25u, 0x43fab9837e699096u, 444},  // 10^172
+    {0xcf02b2c21207ef2eu, 0x94f967e45e03f4bbu, 447},  // 10^173
+    {0x8161afb94b44f57du, 0x1d1be0eebac278f5u, 451},  // 10^174
+    {0xa1ba1ba79e1632dcu, 0x6462d92a69731732u, 454},  // 10^175
+    {0xca28a291859bbf93u, 0x7d7b8f7503cfdcffu, 457},  // 10^176
+    {0xfcb2cb35e702af78u, 0x5cda735244c3d43fu, 460},  // 10^177
+    {0x9defbf01b061adabu, 0x3a0888136afa64a7u, 464},  // 10^178
+    {0xc56baec21c7a1916u, 0x088aaa1845b8fdd1u, 467},  // 10^179
+    {0xf6c69a72a3989f5bu, 0x8aad549e57273d45u, 470},  // 10^180
+    {0x9a3c2087a63f6399u, 0x36ac54e2f678864bu, 474},  // 10^181
+    {0xc0cb28a98fcf3c7fu, 0x84576a1bb416a7deu, 477},  // 10^182
+    {0xf0fdf2d3f3c30b9fu, 0x656d44a2a11c51d5u, 480},  // 10^183
+    {0x969eb7c47859e743u, 0x9f644ae5a4b1b325u, 484},  // 10^184
+    {0xbc4665b596706114u, 0x873d5d9f0dde1fefu, 487},  // 10^185
+    {0xeb57ff22fc0c7959u, 0xa90cb506d155a7eau, 490},  // 10^186
+    {0x9316ff75dd87cbd8u, 0x09a7f12442d588f3u, 494},  // 10^187
+    {0xb7dcbf5354e9beceu, 0x0c11ed6d538aeb2fu, 497},  // 10^188
+    {0xe5d3ef282a242e81u, 0x8f1668c8a86da5fbu, 500},  // 10^189
+    {0x8fa475791a569d10u, 0xf96e017d694487bdu, 504},  // 10^190
+    {0xb38d92d760ec4455u, 0x37c981dcc395a9acu, 507},  // 10^191
+    {0xe070f78d3927556au, 0x85bbe253f47b1417u, 510},  // 10^192
+    {0x8c469ab843b89562u, 0x93956d7478ccec8eu, 514},  // 10^193
+    {0xaf58416654a6babbu, 0x387ac8d1970027b2u, 517},  // 10^194
+    {0xdb2e51bfe9d0696au, 0x06997b05fcc0319fu, 520},  // 10^195
+    {0x88fcf317f22241e2u, 0x441fece3bdf81f03u, 524},  // 10^196
+    {0xab3c2fddeeaad25au, 0xd527e81cad7626c4u, 527},  // 10^197
+    {0xd60b3bd56a5586f1u, 0x8a71e223d8d3b075u, 530},  // 10^198
+    {0x85c7056562757456u, 0xf6872d5667844e49u, 534},  // 10^199
+    {0xa738c6bebb12d16cu, 0xb428f8ac016561dbu, 537},  // 10^200
+    {0xd106f86e69d785c7u, 0xe13336d701beba52u, 540},  // 10^201
+    {0x82a45b450226b39cu, 0xecc0024661173473u, 544},  // 10^202
+    {0xa34d721642b06084u, 0x27f002d7f95d0190u, 547},  // 10^203
+    {0xcc20ce9bd35c78a5u, 0x31ec038df7b441f4u, 550},  // 10^204
+    {0xff290242c83396ceu, 0x7e67047175a15271u, 553},  // 10^205
+    {0x9f79a169bd203e41u, 0x0f0062c6e984d387u, 557},  // 10^206
+    {0xc75809c42c684dd1u, 0x52c07b78a3e60868u, 560},  // 10^207
+    {0xf92e0c3537826145u, 0xa7709a56ccdf8a83u, 563},  // 10^208
+    {0x9bbcc7a142b17ccbu, 0x88a66076400bb692u, 567},  // 10^209
+    {0xc2abf989935ddbfeu, 0x6acff893d00ea436u, 570},  // 10^210
+    {0xf356f7ebf83552feu, 0x0583f6b8c4124d43u, 573},  // 10^211
+    {0x98165af37b2153deu, 0xc3727a337a8b704au, 577},  // 10^212
+    {0xbe1bf1b059e9a8d6u, 0x744f18c0592e4c5du, 580},  // 10^213
+    {0xeda2ee1c7064130cu, 0x1162def06f79df74u, 583},  // 10^214
+    {0x9485d4d1c63e8be7u, 0x8addcb5645ac2ba8u, 587},  // 10^215
+    {0xb9a74a0637ce2ee1u, 0x6d953e2bd7173693u, 590},  // 10^216
+    {0xe8111c87c5c1ba99u, 0xc8fa8db6ccdd0437u, 593},  // 10^217
+    {0x910ab1d4db9914a0u, 0x1d9c9892400a22a2u, 597},  // 10^218
+    {0xb54d5e4a127f59c8u, 0x2503beb6d00cab4bu, 600},  // 10^219
+    {0xe2a0b5dc971f303au, 0x2e44ae64840fd61eu, 603},  // 10^220
+    {0x8da471a9de737e24u, 0x5ceaecfed289e5d3u, 607},  // 10^221
+    {0xb10d8e1456105dadu, 0x7425a83e872c5f47u, 610},  // 10^222
+    {0xdd50f1996b947518u, 0xd12f124e28f77719u, 613},  // 10^223
+    {0x8a5296ffe33cc92fu, 0x82bd6b70d99aaa70u, 617},  // 10^224
+    {0xace73cbfdc0bfb7bu, 0x636cc64d1001550cu, 620},  // 10^225
+    {0xd8210befd30efa5au, 0x3c47f7e05401aa4fu, 623},  // 10^226
+    {0x8714a775e3e95c78u, 0x65acfaec34810a71u, 627},  // 10^227
+    {0xa8d9d1535ce3b396u, 0x7f1839a741a14d0du, 630},  // 10^228
+    {0xd31045a8341ca07cu, 0x1ede48111209a051u, 633},  // 10^229
+    {0x83ea2b892091e44du, 0x934aed0aab460432u, 637},  // 10^230
+    {0xa4e4b66b68b65d60u, 0xf81da84d5617853fu, 640},  // 10^231
+    {0xce1de40642e3f4b9u, 0x36251260ab9d668fu, 643},  // 10^232
+    {0x80d2ae83e9ce78f3u, 0xc1d72b7c6b426019u, 647},  // 10^233
+    {0xa1075a24e4421730u, 0xb24cf65b8612f820u, 650},  // 10^234
+    {0xc94930ae1d529cfcu, 0xdee033f26797b628u, 653},  // 10^235
+    {0xfb9b7cd9a4a7443cu, 0x169840ef017da3b1u, 656},  // 10^236
+    {0x9d412e0806e88aa5u, 0x8e1f289560ee864fu, 660},  // 10^237
+    {0xc491798a08a2ad4eu, 0xf1a6f2bab92a27e3u, 663},  // 10^238
+    {0xf5b5d7ec8acb58a2u, 0xae10af696774b1dbu, 666},  // 10^239
+    {0x9991a6f3d6bf1765u, 0xacca6da1e0a8ef29u, 670},  // 10^240
+    {0xbff610b0cc6edd3fu, 0x17fd090a58d32af3u, 673},  // 10^241
+    {0xeff394dcff8a948eu, 0xddfc4b4cef07f5b0u, 676},  // 10^242
+    {0x95f83d0a1fb69cd9u, 0x4abdaf101564f98eu, 680},  // 10^243
+    {0xbb764c4ca7a4440fu, 0x9d6d1ad41abe37f2u, 683},  // 10^244
+    {0xea53df5fd18d5513u, 0x84c86189216dc5eeu, 686},  // 10^245
+    {0x92746b9be2f8552cu, 0x32fd3cf5b4e49bb5u, 690},  // 10^246
+    {0xb7118682dbb66a77u, 0x3fbc8c33221dc2a2u, 693},  // 10^247
+    {0xe4d5e82392a40515u, 0x0fabaf3feaa5334au, 696},  // 10^248
+    {0x8f05b1163ba6832du, 0x29cb4d87f2a7400eu, 700},  // 10^249
+    {0xb2c71d5bca9023f8u, 0x743e20e9ef511012u, 703},  // 10^250
+    {0xdf78e4b2bd342cf6u, 0x914da9246b255417u, 706},  // 10^251
+    {0x8bab8eefb6409c1au, 0x1ad089b6c2f7548eu, 710},  // 10^252
+    {0xae9672aba3d0c320u, 0xa184ac2473b529b2u, 713},  // 10^253
+    {0xda3c0f568cc4f3e8u, 0xc9e5d72d90a2741eu, 716},  // 10^254
+    {0x8865899617fb1871u, 0x7e2fa67c7a658893u, 720},  // 10^255
+    {0xaa7eebfb9df9de8du, 0xddbb901b98feeab8u, 723},  // 10^256
+    {0xd51ea6fa85785631u, 0x552a74227f3ea565u, 726},  // 10^257
+    {0x8533285c936b35deu, 0xd53a88958f87275fu, 730},  // 10^258
+    {0xa67ff273b8460356u, 0x8a892abaf368f137u, 733},  // 10^259
+    {0xd01fef10a657842cu, 0x2d2b7569b0432d85u, 736},  // 10^260
+    {0x8213f56a67f6b29bu, 0x9c3b29620e29fc73u, 740},  // 10^261
+    {0xa298f2c501f45f42u, 0x8349f3ba91b47b90u, 743},  // 10^262
+    {0xcb3f2f7642717713u, 0x241c70a936219a74u, 746},  // 10^263
+    {0xfe0efb53d30dd4d7u, 0xed238cd383aa0111u, 749},  // 10^264
+    {0x9ec95d1463e8a506u, 0xf4363804324a40abu, 753},  // 10^265
+    {0xc67bb4597ce2ce48u, 0xb143c6053edcd0d5u, 756},  // 10^266
+    {0xf81aa16fdc1b81dau, 0xdd94b7868e94050au, 759},  // 10^267
+    {0x9b10a4e5e9913128u, 0xca7cf2b4191c8327u, 763},  // 10^268
+    {0xc1d4ce1f63f57d72u, 0xfd1c2f611f63a3f0u, 766},  // 10^269
+    {0xf24a01a73cf2dccfu, 0xbc633b39673c8cecu, 769},  // 10^270
+    {0x976e41088617ca01u, 0xd5be0503e085d814u, 773},  // 10^271
+    {0xbd49d14aa79dbc82u, 0x4b2d8644d8a74e19u, 776},  // 10^272
+    {0xec9c459d51852ba2u, 0xddf8e7d60ed1219fu, 779},  // 10^273
+    {0x93e1ab8252f33b45u, 0xcabb90e5c942b503u, 783},  // 10^274
+    {0xb8da1662e7b00a17u, 0x3d6a751f3b936244u, 786},  // 10^275
+    {0xe7109bfba19c0c9du, 0x0cc512670a783ad5u, 789},  // 10^276
+    {0x906a617d450187e2u, 0x27fb2b80668b24c5u, 793},  // 10^277
+    {0xb484f9dc9641e9dau, 0xb1f9f660802dedf6u, 796},  // 10^278
+    {0xe1a63853bbd26451u, 0x5e7873f8a0396974u, 799},  // 10^279
+    {0x8d07e33455637eb2u, 0xdb0b487b6423e1e8u, 803},  // 10^280
+    {0xb049dc016abc5e5fu, 0x91ce1a9a3d2cda63u, 806},  // 10^281
+    {0xdc5c5301c56b75f7u, 0x7641a140cc7810fbu, 809},  // 10^282
+    {0x89b9b3e11b6329bau, 0xa9e904c87fcb0a9du, 813},  // 10^283
+    {0xac2820d9623bf429u, 0x546345fa9fbdcd44u, 816},  // 10^284
+    {0xd732290fbacaf133u, 0xa97c177947ad4095u, 819},  // 10^285
+    {0x867f59a9d4bed6c0u, 0x49ed8eabcccc485du, 823},  // 10^286
+    {0xa81f301449ee8c70u, 0x5c68f256bfff5a75u, 826},  // 10^287
+    {0xd226fc195c6a2f8cu, 0x73832eec6fff3112u, 829},  // 10^288
+    {0x83585d8fd9c25db7u, 0xc831fd53c5ff7eabu, 833},  // 10^289
+    {0xa42e74f3d032f525u, 0xba3e7ca8b77f5e56u, 836},  // 10^290
+    {0xcd3a1230c43fb26fu, 0x28ce1bd2e55f35ebu, 839},  // 10^291
+    {0x80444b5e7aa7cf85u, 0x7980d163cf5b81b3u, 843},  // 10^292
+    {0xa0555e361951c366u, 0xd7e105bcc3326220u, 846},  // 10^293
+    {0xc86ab5c39fa63440u, 0x8dd9472bf3fefaa8u, 849},  // 10^294
+    {0xfa856334878fc150u, 0xb14f98f6f0feb952u, 852},  // 10^295
+    {0x9c935e00d4b9d8d2u, 0x6ed1bf9a569f33d3u, 856},  // 10^296
+    {0xc3b8358109e84f07u, 0x0a862f80ec4700c8u, 859},  // 10^297
+    {0xf4a642e14c6262c8u, 0xcd27bb612758c0fau, 862},  // 10^298
+    {0x98e7e9cccfbd7dbdu, 0x8038d51cb897789cu, 866},  // 10^299
+    {0xbf21e44003acdd2cu, 0xe0470a63e6bd56c3u, 869},  // 10^300
+    {0xeeea5d5004981478u, 0x1858ccfce06cac74u, 872},  // 10^301
+    {0x95527a5202df0ccbu, 0x0f37801e0c43ebc9u, 876},  // 10^302
+    {0xbaa718e68396cffdu, 0xd30560258f54e6bbu, 879},  // 10^303
+    {0xe950df20247c83fdu, 0x47c6b82ef32a2069u, 882},  // 10^304
+    {0x91d28b7416cdd27eu, 0x4cdc331d57fa5442u, 886},  // 10^305
+    {0xb6472e511c81471du, 0xe0133fe4adf8e952u, 889},  // 10^306
+    {0xe3d8f9e563a198e5u, 0x58180fddd97723a7u, 892},  // 10^307
+    {0x8e679c2f5e44ff8fu, 0x570f09eaa7ea7648u, 896},  // 10^308
+    {0xb201833b35d63f73u, 0x2cd2cc6551e513dau, 899},  // 10^309
+    {0xde81e40a034bcf4fu, 0xf8077f7ea65e58d1u, 902},  // 10^310
+    {0x8b112e86420f6191u, 0xfb04afaf27faf783u, 906},  // 10^311
+    {0xadd57a27d29339f6u, 0x79c5db9af1f9b563u, 909},  // 10^312
+    {0xd94ad8b1c7380874u, 0x18375281ae7822bcu, 912},  // 10^313
+    {0x87cec76f1c830548u, 0x8f2293910d0b15b6u, 916},  // 10^314
+    {0xa9c2794ae3a3c69au, 0xb2eb3875504ddb23u, 919},  // 10^315
+    {0xd433179d9c8cb841u, 0x5fa60692a46151ecu, 922},  // 10^316
+    {0x849feec281d7f328u, 0xdbc7c41ba6bcd333u, 926},  // 10^317
+    {0xa5c7ea73224deff3u, 0x12b9b522906c0800u, 929},  // 10^318
+    {0xcf39e50feae16befu, 0xd768226b34870a00u, 932},  // 10^319
+    {0x81842f29f2cce375u, 0xe6a1158300d46640u, 936},  // 10^320
+    {0xa1e53af46f801c53u, 0x60495ae3c1097fd0u, 939},  // 10^321
+    {0xca5e89b18b602368u, 0x385bb19cb14bdfc4u, 942},  // 10^322
+    {0xfcf62c1dee382c42u, 0x46729e03dd9ed7b5u, 945},  // 10^323
+    {0x9e19db92b4e31ba9u, 0x6c07a2c26a8346d1u, 949},  // 10^324
+    {0xc5a05277621be293u, 0xc7098b7305241886u, 952},  // 10^325
+    {0xf70867153aa2db38u, 0xb8cbee4fc66d1ea7u, 955},  // 10^326
+    {0x9a65406d44a5c903u, 0x737f74f1dc043328u, 959},  // 10^327
+    {0xc0fe908895cf3b44u, 0x505f522e53053ff2u, 962},  // 10^328
+    {0xf13e34aabb430a15u, 0x647726b9e7c68fefu, 965},  // 10^329
+    {0x96c6e0eab509e64du, 0x5eca783430dc19f5u, 969},  // 10^330
+    {0xbc789925624c5fe0u, 0xb67d16413d132073u, 972},  // 10^331
+    {0xeb96bf6ebadf77d8u, 0xe41c5bd18c57e88fu, 975},  // 10^332
+    {0x933e37a534cbaae7u, 0x8e91b962f7b6f15au, 979},  // 10^333
+    {0xb80dc58e81fe95a1u, 0x723627bbb5a4adb0u, 982},  // 10^334
+    {0xe61136f2227e3b09u, 0xcec3b1aaa30dd91cu, 985},  // 10^335
+    {0x8fcac257558ee4e6u, 0x213a4f0aa5e8a7b2u, 989},  // 10^336
+    {0xb3bd72ed2af29e1fu, 0xa988e2cd4f62d19eu, 992},  // 10^337
+    {0xe0accfa875af45a7u, 0x93eb1b80a33b8605u, 995},  // 10^338
+    {0x8c6c01c9498d8b88u, 0xbc72f130660533c3u, 999},  // 10^339
+    {0xaf87023b9bf0ee6au, 0xeb8fad7c7f8680b4u, 1002},  // 10^340
+    {0xdb68c2ca82ed2a05u, 0xa67398db9f6820e1u, 1005},  // 10^341
+    {0x892179be91d43a43u, 0x88083f8943a1148du, 1009},  // 10^342
+    {0xab69d82e364948d4u, 0x6a0a4f6b948959b0u, 1012},  // 10^343
+    {0xd6444e39c3db9b09u, 0x848ce34679abb01cu, 1015},  // 10^344
+    {0x85eab0e41a6940e5u, 0xf2d80e0c0c0b4e12u, 1019},  // 10^345
+    {0xa7655d1d2103911fu, 0x6f8e118f0f0e2196u, 1022},  // 10^346
+    {0xd13eb46469447567u, 0x4b7195f2d2d1a9fbu, 1025},  // 10^347
+    {0x82c730bec1cac960u, 0x8f26fdb7c3c30a3du, 1029},  // 10^348
+    {0xa378fcee723d7bb8u, 0xb2f0bd25b4b3ccccu, 1032},  // 10^349
+    {0xcc573c2a0eccdaa6u, 0xdfacec6f21e0c000u, 1035},  // 10^350
+    {0xff6d0b3492801150u, 0x9798278aea58efffu, 1038},  // 10^351
+    {0x9fa42700db900ad2u, 0x5ebf18b6d2779600u, 1042},  // 10^352
+    {0xc78d30c112740d86u, 0xf66edee487157b80u, 1045},  // 10^353
+    {0xf9707cf1571110e8u, 0xb40a969da8dada5fu, 1048},  // 10^354
+    {0x9be64e16d66aaa91u, 0x70869e228988c87cu, 1052},  // 10^355
+    {0xc2dfe19c8c055535u, 0xcca845ab2beafa9bu, 1055},  // 10^356
+    {0xf397da03af06aa83u, 0x3fd25715f6e5b941u, 1058},  // 10^357
+    {0x983ee8424d642a92u, 0x07e3766dba4f93c9u, 1062},  // 10^358
+    {0xbe4ea252e0bd3536u, 0x89dc540928e378bbu, 1065},  // 10^359
+    {0xede24ae798ec8284u, 0x2c53690b731c56eau, 1068},  // 10^360
+    {0x94ad6ed0bf93d192u, 0x9bb421a727f1b652u, 1072},  // 10^361
+    {0xb9d8ca84ef78c5f7u, 0x42a12a10f1ee23e7u, 1075},  // 10^362
+    {0xe84efd262b56f775u, 0x134974952e69ace0u, 1078},  // 10^363
+    {0x91315e37db165aa9u, 0x2c0de8dd3d020c0cu, 1082},  // 10^364
+};
+
+}  // namespace details
+}  // namespace twofloat
@@ -0,0 +1,53 @@
+#pragma once
+
+/// \file dispatch.hpp
+/// \brief Implements the runtime selection of the vector width that the
+/// vectorized modules (blas.hpp, sparse.hpp, fft.hpp, ...) share.
+
+#include <cstddef>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/details/target.hpp>
+#include <type_traits>
+
+namespace twofloat {
+namespace details {
+
+/// \brief Excludes a parameter from template argument deduction, so that
+/// containers can be passed for spans.
+template <typename T>
+struct identity {
+  using type = T;
+};
+template <typename T>
+using identity_t = typename identity<T>::type;
+
+// Calls f with the number of lanes of the vectors of the instruction set as a
+// std::integral_constant, in a function that is compiled for the instruction
+// set regardless of the compiler flags
+template <typename T, typename F>
+TWOFLOAT_TARGET_FMA void vectorizedAVX2(const F &f) {
+  f(std::integral_constant<std::size_t, 32 / sizeof(T)>());
+}
+
+template <typename T, typename F>
+TWOFLOAT_TARGET_AVX512 void vectorizedAVX512(const F &f) {
+  f(std::integral_constant<std::size_t, 64 / sizeof(T)>());
+}
+
+/// \brief Calls `f(w)` with the widest vectors that the CPU supports (see
+/// cpu.hpp), where `decltype(w)::value` is the number of lanes.
+template <typename T, typename F>
+void vectorized(const F &f) {
+  const cpu::InstructionSet isa = cpu::instructionSet();
+#if defined(TWOFLOAT_HAS_AVX512)
+  if (isa == cpu::InstructionSet::AVX512) return vectorizedAVX512<T>(f);
+#endif
+#if defined(TWOFLOAT_HAS_AVX2)
+  if (isa == cpu::InstructionSet::AVX2) return vectorizedAVX2<T>(f);
+#endif
+  (void)isa;
+  f(std::integral_constant<std::size_t, 16 / sizeof(T)>());
+}
+
+}  // namespace details
+}  // namespace twofloat
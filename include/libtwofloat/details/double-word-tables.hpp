@@ -0,0 +1,332 @@
+#pragma once
+
+/// \file double-word-tables.hpp
+/// \brief Constants and tables of the elementary functions in
+/// double-word-functions.hpp.
+/// \details Every constant `c` is stored as the double-word number `{h, l}`
+/// with `h = RN(c)` and `l = RN(c - h)`. The values were computed with exact
+/// rational arithmetic from 80-digit decimal approximations and are written as
+/// hexadecimal floating point literals, so they are exact.
+
+namespace twofloat {
+namespace doubleword {
+namespace details {
+
+/// \brief The constants for the floating point type `T`.
+/// \details
+/// - `ln2`: log(2).
+/// - `expInvL`: RN(64 / log(2)).
+/// - `expL`: log(2)/64 split into parts for the Cody-Waite argument reduction
+///   of `exp`. All parts but the last have few enough bits that their product
+///   with the reduced exponent is exact.
+template <typename T>
+struct tables;
+
+template <>
+struct tables<double> {
+  static constexpr double ln2[2] = {0x1.62e42fefa39efp-1,
+                                    0x1.abc9e3b39803fp-56};
+  static constexpr double expInvL = 0x1.71547652b82fep+6;
+  static constexpr double expL[3] = {0x1.62e42fefap-7, 0x1.cf79abc9ep-46,
+                                     0x1.d9cc01f97b57ap-85};
+  // 2^(j/64) for j = 0, ..., 63
+  static constexpr double exp2[64][2] = {
+      {0x1p+0, 0x0p+0},
+      {0x1.02c9a3e778061p+0, -0x1.19083535b085dp-56},
+      {0x1.059b0d3158574p+0, 0x1.d73e2a475b465p-55},
+      {0x1.0874518759bc8p+0, 0x1.186be4bb284ffp-57},
+      {0x1.0b5586cf9890fp+0, 0x1.8a62e4adc610bp-54},
+      {0x1.0e3ec32d3d1a2p+0, 0x1.03a1727c57b53p-59},
+      {0x1.11301d0125b51p+0, -0x1.6c51039449b3ap-54},
+      {0x1.1429aaea92dep+0, -0x1.32fbf9af1369ep-54},
+      {0x1.172b83c7d517bp+0, -0x1.19041b9d78a76p-55},
+      {0x1.1a35beb6fcb75p+0, 0x1.e5b4c7b4968e4p-55},
+      {0x1.1d4873168b9aap+0, 0x1.e016e00a2643cp-54},
+      {0x1.2063b88628cd6p+0, 0x1.dc775814a8495p-55},
+      {0x1.2387a6e756238p+0, 0x1.9b07eb6c70573p-54},
+      {0x1.26b4565e27cddp+0, 0x1.2bd339940e9d9p-55},
+      {0x1.29e9df51fdee1p+0, 0x1.612e8afad1255p-55},
+      {0x1.2d285a6e4030bp+0, 0x1.0024754db41d5p-54},
+      {0x1.306fe0a31b715p+0, 0x1.6f46ad23182e4p-55},
+      {0x1.33c08b26416ffp+0, 0x1.32721843659a6p-54},
+      {0x1.371a7373aa9cbp+0, -0x1.63aeabf42eae2p-54},
+      {0x1.3a7db34e59ff7p+0, -0x1.5e436d661f5e3p-56},
+      {0x1.3dea64c123422p+0, 0x1.ada0911f09ebcp-55},
+      {0x1.4160a21f72e2ap+0, -0x1.ef3691c309278p-58},
+      {0x1.44e086061892dp+0, 0x1.89b7a04ef80dp-59},
+      {0x1.486a2b5c13cdp+0, 0x1.3c1a3b69062fp-56},
+      {0x1.4bfdad5362a27p+0, 0x1.d4397afec42e2p-56},
+      {0x1.4f9b2769d2ca7p+0, -0x1.4b309d25957e3p-54},
+      {0x1.5342b569d4f82p+0, -0x1.07abe1db13cadp-55},
+      {0x1.56f4736b527dap+0, 0x1.9bb2c011d93adp-54},
+      {0x1.5ab07dd485429p+0, 0x1.6324c054647adp-54},
+      {0x1.5e76f15ad2148p+0, 0x1.ba6f93080e65ep-54},
+      {0x1.6247eb03a5585p+0, -0x1.383c17e40b497p-54},
+      {0x1.6623882552225p+0, -0x1.bb60987591c34p-54},
+      {0x1.6a09e667f3bcdp+0, -0x1.bdd3413b26456p-54},
+      {0x1.6dfb23c651a2fp+0, -0x1.bbe3a683c88abp-57},
+      {0x1.71f75e8ec5f74p+0, -0x1.16e4786887a99p-55},
+      {0x1.75feb564267c9p+0, -0x1.0245957316dd3p-54},
+      {0x1.7a11473eb0187p+0, -0x1.41577ee04992fp-55},
+      {0x1.7e2f336cf4e62p+0, 0x1.05d02ba15797ep-56},
+      {0x1.82589994cce13p+0, -0x1.d4c1dd41532d8p-54},
+      {0x1.868d99b4492edp+0, -0x1.fc6f89bd4f6bap-54},
+      {0x1.8ace5422aa0dbp+0, 0x1.6e9f156864b27p-54},
+      {0x1.8f1ae99157736p+0, 0x1.5cc13a2e3976cp-55},
+      {0x1.93737b0cdc5e5p+0, -0x1.75fc781b57ebcp-57},
+      {0x1.97d829fde4e5p+0, -0x1.d185b7c1b85d1p-54},
+      {0x1.9c49182a3f09p+0, 0x1.c7c46b071f2bep-56},
+      {0x1.a0c667b5de565p+0, -0x1.359495d1cd533p-54},
+      {0x1.a5503b23e255dp+0, -0x1.d2f6edb8d41e1p-54},
+      {0x1.a9e6b5579fdbfp+0, 0x1.0fac90ef7fd31p-54},
+      {0x1.ae89f995ad3adp+0, 0x1.7a1cd345dcc81p-54},
+      {0x1.b33a2b84f15fbp+0, -0x1.2805e3084d708p-57},
+      {0x1.b7f76f2fb5e47p+0, -0x1.5584f7e54ac3bp-56},
+      {0x1.bcc1e904bc1d2p+0, 0x1.23dd07a2d9e84p-55},
+      {0x1.c199bdd85529cp+0, 0x1.11065895048ddp-55},
+      {0x1.c67f12e57d14bp+0, 0x1.2884dff483cadp-54},
+      {0x1.cb720dcef9069p+0, 0x1.503cbd1e949dbp-56},
+      {0x1.d072d4a07897cp+0, -0x1.cbc3743797a9cp-54},
+      {0x1.d5818dcfba487p+0, 0x1.2ed02d75b3707p-55},
+      {0x1.da9e603db3285p+0, 0x1.c2300696db532p-54},
+      {0x1.dfc97337b9b5fp+0, -0x1.1a5cd4f184b5cp-54},
+      {0x1.e502ee78b3ff6p+0, 0x1.39e8980a9cc8fp-55},
+      {0x1.ea4afa2a490dap+0, -0x1.e9c23179c2893p-54},
+      {0x1.efa1bee615a27p+0, 0x1.dc7f486a4b6bp-54},
+      {0x1.f50765b6e454p+0, 0x1.9d3e12dd8a18bp-54},
+      {0x1.fa7c1819e90d8p+0, 0x1.74853f3a5931ep-55},
+  };
+  // log(j/64) for j = 45, ..., 91
+  static constexpr double log[47][2] = {
+      {-0x1.68ac83e9c6a14p-2, -0x1.a64eadd740178p-58},
+      {-0x1.522ae0738a3d8p-2, 0x1.8f7e9b38a6979p-57},
+      {-0x1.3c25277333184p-2, 0x1.2ad27e50a8ec6p-56},
+      {-0x1.269621134db92p-2, -0x1.e0efadd9db02bp-56},
+      {-0x1.1178e8227e47cp-2, 0x1.0e63a5f01c691p-57},
+      {-0x1.f991c6cb3b379p-3, -0x1.f665066f980a2p-57},
+      {-0x1.d1037f2655e7bp-3, -0x1.60629242471a2p-57},
+      {-0x1.a93ed3c8ad9e3p-3, -0x1.bcafa9de97203p-57},
+      {-0x1.823c16551a3c2p-3, 0x1.1232ce70be781p-57},
+      {-0x1.5bf406b543db2p-3, 0x1.1f5b44c0df7e7p-61},
+      {-0x1.365fcb0159016p-3, -0x1.7d411a5b944adp-58},
+      {-0x1.1178e8227e47cp-3, 0x1.0e63a5f01c691p-58},
+      {-0x1.da727638446a2p-4, -0x1.401fa71733019p-58},
+      {-0x1.9335e5d594989p-4, 0x1.478a85704ccb7p-58},
+      {-0x1.4d3115d207eacp-4, -0x1.769f42c7842ccp-58},
+      {-0x1.08598b59e3a07p-4, 0x1.dd7009902bf32p-58},
+      {-0x1.894aa149fb343p-5, -0x1.a8be97660a23dp-60},
+      {-0x1.0415d89e74444p-5, -0x1.c05cf1d753622p-59},
+      {-0x1.0205658935847p-6, -0x1.27c8e8416e71fp-60},
+      {0x0p+0, 0x0p+0},
+      {0x1.fc0a8b0fc03e4p-7, -0x1.83092c59642a1p-62},
+      {0x1.f829b0e7833p-6, 0x1.33e3f04f1ef23p-60},
+      {0x1.77458f632dcfcp-5, 0x1.18d3ca87b9296p-59},
+      {0x1.f0a30c01162a6p-5, 0x1.85f325c5bbacdp-59},
+      {0x1.341d7961bd1d1p-4, -0x1.b599f227becbbp-58},
+      {0x1.6f0d28ae56b4cp-4, -0x1.906d99184b992p-58},
+      {0x1.a926d3a4ad563p-4, 0x1.942f48aa70ea9p-58},
+      {0x1.e27076e2af2e6p-4, -0x1.61578001e0162p-60},
+      {0x1.0d77e7cd08e59p-3, 0x1.9a5dc5e9030acp-57},
+      {0x1.29552f81ff523p-3, 0x1.301771c407dbfp-57},
+      {0x1.44d2b6ccb7d1ep-3, 0x1.9f4f6543e1f88p-57},
+      {0x1.5ff3070a793d4p-3, -0x1.bc60efafc6f6ep-58},
+      {0x1.7ab890210d909p-3, 0x1.be36b2d6a0608p-59},
+      {0x1.9525a9cf456b4p-3, 0x1.d904c1d4e2e26p-57},
+      {0x1.af3c94e80bff3p-3, -0x1.398cff3641985p-58},
+      {0x1.c8ff7c79a9a22p-3, -0x1.4f689f8434012p-57},
+      {0x1.e27076e2af2e6p-3, -0x1.61578001e0162p-59},
+      {0x1.fb9186d5e3e2bp-3, -0x1.caaae64f21acbp-57},
+      {0x1.0a324e27390e3p-2, 0x1.7dcfde8061c03p-56},
+      {0x1.1675cababa60ep-2, 0x1.ce63eab883717p-61},
+      {0x1.22941fbcf7966p-2, -0x1.76f5eb09628afp-56},
+      {0x1.2e8e2bae11d31p-2, -0x1.8f4cdb95ebdf9p-56},
+      {0x1.3a64c556945eap-2, -0x1.c68651945f97cp-57},
+      {0x1.4618bc21c5ec2p-2, 0x1.f42decdeccf1dp-56},
+      {0x1.51aad872df82dp-2, 0x1.3927ac19f55e3p-59},
+      {0x1.5d1bdbf5809cap-2, 0x1.4236383dc7fe1p-56},
+      {0x1.686c81e9b14afp-2, -0x1.ddea0f7f58e3dp-57},
+  };
+  // 1/k! for k = 0, ..., 11
+  static constexpr double invFactorial[12][2] = {
+      {0x1p+0, 0x0p+0},
+      {0x1p+0, 0x0p+0},
+      {0x1p-1, 0x0p+0},
+      {0x1.5555555555555p-3, 0x1.5555555555555p-57},
+      {0x1.5555555555555p-5, 0x1.5555555555555p-59},
+      {0x1.1111111111111p-7, 0x1.1111111111111p-63},
+      {0x1.6c16c16c16c17p-10, -0x1.f49f49f49f49fp-65},
+      {0x1.a01a01a01a01ap-13, 0x1.a01a01a01a01ap-73},
+      {0x1.a01a01a01a01ap-16, 0x1.a01a01a01a01ap-76},
+      {0x1.71de3a556c734p-19, -0x1.c154f8ddc6cp-73},
+      {0x1.27e4fb7789f5cp-22, 0x1.cbbc05b4fa99ap-76},
+      {0x1.ae64567f544e4p-26, -0x1.c062e06d1f209p-80},
+  };
+  // 1/(2k+1) for k = 0, ..., 8
+  static constexpr double invOdd[9][2] = {
+      {0x1p+0, 0x0p+0},
+      {0x1.5555555555555p-2, 0x1.5555555555555p-56},
+      {0x1.999999999999ap-3, -0x1.999999999999ap-57},
+      {0x1.2492492492492p-3, 0x1.2492492492492p-57},
+      {0x1.c71c71c71c71cp-4, 0x1.c71c71c71c71cp-58},
+      {0x1.745d1745d1746p-4, -0x1.745d1745d1746p-59},
+      {0x1.3b13b13b13b14p-4, -0x1.3b13b13b13b14p-58},
+      {0x1.1111111111111p-4, 0x1.1111111111111p-60},
+      {0x1.e1e1e1e1e1e1ep-5, 0x1.e1e1e1e1e1e1ep-61},
+  };
+};
+
+template <>
+struct tables<float> {
+  static constexpr float ln2[2] = {0x1.62e43p-1f, -0x1.05c61p-29f};
+  static constexpr float expInvL = 0x1.715476p+6f;
+  static constexpr float expL[4] = {0x1.63p-7f, -0x1.bdp-19f, -0x1.06p-35f,
+                                    0x1.cf79acp-46f};
+  // 2^(j/64) for j = 0, ..., 63
+  static constexpr float exp2[64][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {0x1.02c9a4p+0f, -0x1.887fap-28f},
+      {0x1.059b0ep+0f, -0x1.9d4f52p-25f},
+      {0x1.087452p+0f, -0x1.e2990ep-26f},
+      {0x1.0b5586p+0f, 0x1.9f3122p-25f},
+      {0x1.0e3ec4p+0f, -0x1.a585ccp-25f},
+      {0x1.11301ep+0f, -0x1.fdb496p-25f},
+      {0x1.1429aap+0f, 0x1.d525bcp-25f},
+      {0x1.172b84p+0f, -0x1.c15742p-27f},
+      {0x1.1a35bep+0f, 0x1.6df96ep-25f},
+      {0x1.1d4874p+0f, -0x1.d2e8cap-25f},
+      {0x1.2063b8p+0f, 0x1.0c519ap-25f},
+      {0x1.2387a6p+0f, 0x1.ceac48p-25f},
+      {0x1.26b456p+0f, 0x1.789f38p-26f},
+      {0x1.29e9ep+0f, -0x1.5c0424p-25f},
+      {0x1.2d285ap+0f, 0x1.b900c2p-26f},
+      {0x1.306fep+0f, 0x1.4636e2p-25f},
+      {0x1.33c08cp+0f, -0x1.b37d2p-25f},
+      {0x1.371a74p+0f, -0x1.18aac6p-25f},
+      {0x1.3a7db4p+0f, -0x1.634c02p-25f},
+      {0x1.3dea64p+0f, 0x1.824684p-25f},
+      {0x1.4160a2p+0f, 0x1.f72e2ap-28f},
+      {0x1.44e086p+0f, 0x1.8624b4p-30f},
+      {0x1.486a2cp+0f, -0x1.47d866p-25f},
+      {0x1.4bfdaep+0f, -0x1.593abcp-25f},
+      {0x1.4f9b28p+0f, -0x1.2c5a6cp-25f},
+      {0x1.5342b6p+0f, -0x1.2c561p-25f},
+      {0x1.56f474p+0f, -0x1.295b04p-25f},
+      {0x1.5ab07ep+0f, -0x1.5bd5ecp-27f},
+      {0x1.5e76f2p+0f, -0x1.4a5bd6p-25f},
+      {0x1.6247ecp+0f, -0x1.f8b55p-25f},
+      {0x1.662388p+0f, 0x1.2a9112p-27f},
+      {0x1.6a09e6p+0f, 0x1.9fcef4p-26f},
+      {0x1.6dfb24p+0f, -0x1.cd72e8p-27f},
+      {0x1.71f75ep+0f, 0x1.1d8beep-25f},
+      {0x1.75feb6p+0f, -0x1.37b306p-25f},
+      {0x1.7a1148p+0f, -0x1.829fdp-25f},
+      {0x1.7e2f34p+0f, -0x1.261634p-25f},
+      {0x1.82589ap+0f, -0x1.accc7cp-26f},
+      {0x1.868d9ap+0f, -0x1.2edb44p-26f},
+      {0x1.8ace54p+0f, 0x1.15506ep-27f},
+      {0x1.8f1aeap+0f, -0x1.baa232p-26f},
+      {0x1.93737cp+0f, -0x1.e64744p-25f},
+      {0x1.97d82ap+0f, -0x1.0d8d84p-31f},
+      {0x1.9c4918p+0f, 0x1.51f848p-27f},
+      {0x1.a0c668p+0f, -0x1.2886a6p-26f},
+      {0x1.a5503cp+0f, -0x1.b83b54p-25f},
+      {0x1.a9e6b6p+0f, -0x1.50c048p-25f},
+      {0x1.ae89fap+0f, -0x1.a94b14p-26f},
+      {0x1.b33a2cp+0f, -0x1.ec3a82p-26f},
+      {0x1.b7f77p+0f, -0x1.a09438p-25f},
+      {0x1.bcc1eap+0f, -0x1.f687c6p-25f},
+      {0x1.c199bep+0f, -0x1.3d56b2p-27f},
+      {0x1.c67f12p+0f, 0x1.cafa2ap-25f},
+      {0x1.cb720ep+0f, -0x1.8837ccp-27f},
+      {0x1.d072d4p+0f, 0x1.40f13p-25f},
+      {0x1.d5818ep+0f, -0x1.822dbcp-27f},
+      {0x1.da9e6p+0f, 0x1.ed9942p-27f},
+      {0x1.dfc974p+0f, -0x1.908c94p-25f},
+      {0x1.e502eep+0f, 0x1.e2cffep-26f},
+      {0x1.ea4afap+0f, 0x1.52486cp-27f},
+      {0x1.efa1bep+0f, 0x1.cc2b44p-25f},
+      {0x1.f50766p+0f, -0x1.246ebp-26f},
+      {0x1.fa7c18p+0f, 0x1.9e90d8p-28f},
+  };
+  // log(j/64) for j = 45, ..., 91
+  static constexpr float log[47][2] = {
+      {-0x1.68ac84p-2f, 0x1.6395ecp-30f},
+      {-0x1.522aep-2f, -0x1.ce28f6p-28f},
+      {-0x1.3c2528p-2f, 0x1.1999dp-27f},
+      {-0x1.269622p-2f, 0x1.d9648ep-27f},
+      {-0x1.1178e8p-2f, -0x1.13f23ep-29f},
+      {-0x1.f991c6p-3f, -0x1.96767p-28f},
+      {-0x1.d1038p-3f, 0x1.b3543p-28f},
+      {-0x1.a93ed4p-3f, 0x1.ba930ep-30f},
+      {-0x1.823c16p-3f, -0x1.5468fp-29f},
+      {-0x1.5bf406p-3f, -0x1.6a87b6p-28f},
+      {-0x1.365fccp-3f, 0x1.fd4dfep-28f},
+      {-0x1.1178e8p-3f, -0x1.13f23ep-30f},
+      {-0x1.da7276p-4f, -0x1.c22352p-31f},
+      {-0x1.9335e6p-4f, 0x1.535b3cp-31f},
+      {-0x1.4d3116p-4f, 0x1.6fc0aap-31f},
+      {-0x1.08598cp-4f, 0x1.4c38cp-29f},
+      {-0x1.894aa2p-5f, 0x1.6c0998p-30f},
+      {-0x1.0415d8p-5f, -0x1.3ce888p-30f},
+      {-0x1.020566p-6f, 0x1.db29eep-32f},
+      {0x0p+0f, 0x0p+0f},
+      {0x1.fc0a8cp-7f, -0x1.e07f84p-32f},
+      {0x1.f829bp-6f, 0x1.cf066p-31f},
+      {0x1.77459p-5f, -0x1.39a46p-30f},
+      {0x1.f0a30cp-5f, 0x1.162a66p-37f},
+      {0x1.341d7ap-4f, -0x1.3c85c6p-29f},
+      {0x1.6f0d28p-4f, 0x1.5cad6ap-29f},
+      {0x1.a926d4p-4f, -0x1.6d4aa8p-30f},
+      {0x1.e27076p-4f, 0x1.c55e5cp-29f},
+      {0x1.0d77e8p-3f, -0x1.97b8d4p-30f},
+      {0x1.29553p-3f, -0x1.f802b8p-29f},
+      {0x1.44d2b6p-3f, 0x1.996fa4p-28f},
+      {0x1.5ff308p-3f, -0x1.eb0d86p-28f},
+      {0x1.7ab89p-3f, 0x1.086c84p-30f},
+      {0x1.9525aap-3f, -0x1.85d4a6p-30f},
+      {0x1.af3c94p-3f, 0x1.d017fep-28f},
+      {0x1.c8ff7cp-3f, 0x1.e6a688p-29f},
+      {0x1.e27076p-3f, 0x1.c55e5cp-28f},
+      {0x1.fb9186p-3f, 0x1.abc7c6p-28f},
+      {0x1.0a324ep-2f, 0x1.39c872p-29f},
+      {0x1.1675cap-2f, 0x1.7574c2p-27f},
+      {0x1.22942p-2f, -0x1.0c21a6p-28f},
+      {0x1.2e8e2cp-2f, -0x1.47b8b4p-28f},
+      {0x1.3a64c6p-2f, -0x1.52d742p-27f},
+      {0x1.4618bcp-2f, 0x1.0e2f62p-29f},
+      {0x1.51aad8p-2f, 0x1.cb7e0cp-28f},
+      {0x1.5d1bdcp-2f, -0x1.4fec6cp-31f},
+      {0x1.686c82p-2f, -0x1.64eb52p-30f},
+  };
+  // 1/k! for k = 0, ..., 11
+  static constexpr float invFactorial[12][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {0x1p+0f, 0x0p+0f},
+      {0x1p-1f, 0x0p+0f},
+      {0x1.555556p-3f, -0x1.555556p-28f},
+      {0x1.555556p-5f, -0x1.555556p-30f},
+      {0x1.111112p-7f, -0x1.dddddep-32f},
+      {0x1.6c16c2p-10f, -0x1.27d27ep-35f},
+      {0x1.a01a02p-13f, -0x1.7f97fap-39f},
+      {0x1.a01a02p-16f, -0x1.7f97fap-42f},
+      {0x1.71de3ap-19f, 0x1.55b1ccp-45f},
+      {0x1.27e4fcp-22f, -0x1.10ec14p-47f},
+      {0x1.ae6456p-26f, 0x1.fd5138p-52f},
+  };
+  // 1/(2k+1) for k = 0, ..., 8
+  static constexpr float invOdd[9][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {0x1.555556p-2f, -0x1.555556p-27f},
+      {0x1.99999ap-3f, -0x1.99999ap-29f},
+      {0x1.24924ap-3f, -0x1.b6db6ep-28f},
+      {0x1.c71c72p-4f, -0x1.c71c72p-31f},
+      {0x1.745d18p-4f, -0x1.745d18p-29f},
+      {0x1.3b13b2p-4f, -0x1.89d89ep-29f},
+      {0x1.111112p-4f, -0x1.dddddep-29f},
+      {0x1.e1e1e2p-5f, -0x1.e1e1e2p-33f},
+  };
+};
+
+}  // namespace details
+}  // namespace doubleword
+}  // namespace twofloat
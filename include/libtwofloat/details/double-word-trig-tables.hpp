@@ -0,0 +1,313 @@
+#pragma once
+
+/// \file double-word-trig-tables.hpp
+/// \brief Constants and tables of the trigonometric functions in
+/// double-word-trigonometry.hpp.
+/// \details The constants are stored like in double-word-tables.hpp. They were
+/// computed with exact rational arithmetic from π to 2000 bits.
+
+namespace twofloat {
+namespace doubleword {
+namespace details {
+
+/// \brief The constants for the floating point type `T`.
+/// \details
+/// - `halfPi`: π/2.
+/// - `invHalfPi`: RN(2/π).
+/// - `halfPiParts`: π/2 split into parts for the Cody-Waite argument
+///   reduction. All parts but the last have few enough bits that their
+///   product with a quadrant number of up to 2^20 (double) or 2^12 (float) is
+///   exact.
+/// - `twoOverPiChunks`: the bits of 2/π for the Payne-Hanek argument
+///   reduction of larger arguments, which always uses double.
+template <typename T>
+struct trigTables;
+
+template <>
+struct trigTables<double> {
+  static constexpr double halfPi[2] = {0x1.921fb54442d18p+0,
+                                       0x1.1a62633145c07p-54};
+  static constexpr double invHalfPi = 0x1.45f306dc9c883p-1;
+  static constexpr double halfPiParts[5] = {0x1.921fb544p+0, 0x1.0b4611a6p-34,
+                                            0x1.3198a2ep-69, 0x1.b839a252p-104,
+                                            0x1.27044533e63ap-142};
+  // sin(j/64) and cos(j/64) for j = 0, ..., 51
+  static constexpr double sin[52][2] = {
+      {0x0p+0, 0x0p+0},
+      {0x1.fffaaaaeeeed5p-7, -0x1.2ab639a9f0776p-63},
+      {0x1.ffeaaaeeee86fp-6, -0x1.cd406fb224ae2p-60},
+      {0x1.7fdc01032fba9p-5, -0x1.599bdf46e997ap-59},
+      {0x1.ffaaaeeed4edbp-5, -0x1.2d16d32684b69p-59},
+      {0x1.3facb12d1755bp-4, -0x1.921915299468bp-58},
+      {0x1.7f701032550e4p-4, 0x1.afc2d1800501ap-60},
+      {0x1.bf1b78568391dp-4, 0x1.e91841dea4cc8p-58},
+      {0x1.feaaeee86ee36p-4, -0x1.afcb2bcc6f03bp-59},
+      {0x1.1f0d3d7afceafp-3, -0x1.6ef95099769a5p-57},
+      {0x1.3eb312c5d66cbp-3, 0x1.47d666b66cb91p-57},
+      {0x1.5e44fcfa126f3p-3, -0x1.6f443063f89b6p-57},
+      {0x1.7dc102fbaf2b5p-3, 0x1.5ab50e23c97c3p-59},
+      {0x1.9d252d0cec312p-3, 0x1.9c43d80b1137dp-58},
+      {0x1.bc6f84edc6199p-3, 0x1.9c1a56a7b0cabp-57},
+      {0x1.db9e15fb5a5dp-3, -0x1.32e20d6cc6fc2p-57},
+      {0x1.faaeed4f31577p-3, -0x1.15d88508e32b8p-57},
+      {0x1.0cd00cef36436p-2, -0x1.9fb0a0c93e2b4p-56},
+      {0x1.1c37d64c6b876p-2, 0x1.46076fe0dcff4p-56},
+      {0x1.2b8ddc43eb49fp-2, 0x1.1553899f2d807p-57},
+      {0x1.3ad129769d3d8p-2, 0x1.03d550487839ap-63},
+      {0x1.4a00c9b0f3d2p-2, 0x1.823ba6bb08eadp-56},
+      {0x1.591bc9fa2f597p-2, 0x1.7c74bac3fe0cbp-57},
+      {0x1.682138a38d7f7p-2, -0x1.d889202444aadp-56},
+      {0x1.7710255764214p-2, -0x1.6ead7314bb6cep-57},
+      {0x1.85e7a12826949p-2, 0x1.8a40e9b5facep-56},
+      {0x1.94a6be9f546c5p-2, -0x1.69ce13e683f58p-56},
+      {0x1.a34c91cc50ccap-2, -0x1.a310e3b50cecdp-58},
+      {0x1.b1d8305321617p-2, -0x1.ae242cb99f519p-56},
+      {0x1.c048b17b140a3p-2, 0x1.19fe6757e9fa7p-57},
+      {0x1.ce9d2e3d4a51fp-2, -0x1.2fc8a12dae298p-57},
+      {0x1.dcd4c15329c9ap-2, 0x1.0d4c6e171fd9ap-56},
+      {0x1.eaee8744b05fp-2, -0x1.789b43c9b027dp-58},
+      {0x1.f8e99e76abc97p-2, 0x1.9d950af2d00a3p-58},
+      {0x1.0362939c69955p-1, -0x1.2d8cd78397b01p-55},
+      {0x1.0a4021e9e1001p-1, -0x1.6f643a13914f6p-55},
+      {0x1.110d0c4b69c3bp-1, 0x1.d918998809981p-55},
+      {0x1.17c8e5f2eedbp-1, 0x1.35e57102e2488p-57},
+      {0x1.1e7343236574cp-1, 0x1.22a3fa4f41d5ap-56},
+      {0x1.250bb93788bbbp-1, 0x1.ea3d02457bccep-56},
+      {0x1.2b91dea88421ep-1, -0x1.fa371db216abp-55},
+      {0x1.32054b148bc4fp-1, 0x1.f6b42095a135bp-55},
+      {0x1.386597456282bp-1, -0x1.10fada93b07a8p-56},
+      {0x1.3eb25d36cd53ap-1, -0x1.be570e1570fcp-58},
+      {0x1.44eb381cf386bp-1, -0x1.3ed6c1e6a5505p-55},
+      {0x1.4b0fc46aab761p-1, 0x1.0da05738cc59cp-61},
+      {0x1.511f9fd7b351cp-1, -0x1.5c0e861c48831p-55},
+      {0x1.571a6966d59b3p-1, 0x1.c843b4d0fb197p-58},
+      {0x1.5cffc16bf8f0dp-1, 0x1.96cb370eb578ap-55},
+      {0x1.62cf49921ac79p-1, -0x1.edd9855b6241ap-55},
+      {0x1.6888a4e134b2fp-1, -0x1.6b7d37644d5e6p-55},
+      {0x1.6e2b77c40bde1p-1, -0x1.0e729857fad53p-56},
+  };
+  static constexpr double cos[52][2] = {
+      {0x1p+0, 0x0p+0},
+      {0x1.fff000155549fp-1, 0x1.28a28a03a5ef3p-55},
+      {0x1.ffc00155527d3p-1, -0x1.3b54492d89b5bp-55},
+      {0x1.ff7006bfdf99fp-1, -0x1.8b3b560648d5fp-56},
+      {0x1.ff0015549f4d3p-1, 0x1.328387b99426fp-55},
+      {0x1.fe7034129ef6fp-1, -0x1.cbf4337c96f97p-57},
+      {0x1.fdc06bf7e6b9bp-1, 0x1.31902b535f8dbp-55},
+      {0x1.fcf0c800e99b1p-1, 0x1.ea3d786d186acp-57},
+      {0x1.fc015527d5bd3p-1, 0x1.b68f35094efb8p-55},
+      {0x1.faf22263c4bd3p-1, -0x1.52ace133a2769p-58},
+      {0x1.f9c340a7cc428p-1, 0x1.c5b6b063b7462p-55},
+      {0x1.f874c2e1eecf6p-1, -0x1.c6514e1332b16p-55},
+      {0x1.f706bdf9ece1cp-1, -0x1.698c80c36dcb4p-55},
+      {0x1.f57948cff6797p-1, 0x1.e3a0d3e03b1d4p-57},
+      {0x1.f3cc7c3b3d16ep-1, -0x1.21a3ad28a3494p-57},
+      {0x1.f20073086649fp-1, 0x1.b940416c1984bp-56},
+      {0x1.f01549f7deea1p-1, 0x1.d3c1e99e5cafdp-55},
+      {0x1.ee0b1fbc0f11cp-1, -0x1.bfd2380bbc3b1p-59},
+      {0x1.ebe214f76efa8p-1, -0x1.02f9f12ba543ep-55},
+      {0x1.e99a4c3a7cd83p-1, -0x1.2264b1bc53ce8p-55},
+      {0x1.e733ea0193d4p-1, -0x1.6428b3546ce13p-55},
+      {0x1.e4af14b2a449cp-1, -0x1.68ca02e8a6833p-55},
+      {0x1.e20bf49acd6c1p-1, -0x1.660aec7ef636bp-58},
+      {0x1.df4ab3ebd875ep-1, -0x1.e2d8a7e6736c4p-55},
+      {0x1.dc6b7eb995912p-1, 0x1.4b364776dcd35p-58},
+      {0x1.d96e82f71a9dcp-1, 0x1.ff61bd5d2039dp-55},
+      {0x1.d653f073e404p-1, -0x1.76236434bec37p-55},
+      {0x1.d31bf8d8d7c06p-1, 0x1.e60dd3089cbddp-56},
+      {0x1.cfc6cfa52ad9fp-1, 0x1.8b5b5508f2a0dp-55},
+      {0x1.cc54aa2b2972ep-1, 0x1.4ee162ba83a98p-57},
+      {0x1.c8c5bf8ce1a84p-1, 0x1.ab3d1a1590123p-56},
+      {0x1.c51a48b8b175ep-1, -0x1.1bbb43b9aa88p-57},
+      {0x1.c1528065b7d5p-1, -0x1.892111312e828p-55},
+      {0x1.bd6ea310294f5p-1, 0x1.31bbcc88c109dp-56},
+      {0x1.b96eeef58840ep-1, 0x1.45a3cc78fadep-58},
+      {0x1.b553a410c104ep-1, 0x1.8ff7947027a15p-58},
+      {0x1.b11d04162a4c6p-1, 0x1.1dd561efbc0c2p-56},
+      {0x1.accb526f69de5p-1, 0x1.8fb6a8dd6b6ccp-55},
+      {0x1.a85ed4373e02dp-1, 0x1.9be06385ec792p-57},
+      {0x1.a3d7d0352bdcfp-1, -0x1.68dbaeca19669p-55},
+      {0x1.9f368ed912f85p-1, -0x1.1d200c5791606p-55},
+      {0x1.9a7b5a36a6514p-1, 0x1.722cfcc9fa7a9p-55},
+      {0x1.95a67e00cb1fdp-1, -0x1.0befda21f862dp-55},
+      {0x1.90b84784ddaf7p-1, -0x1.0feb10ab93b87p-56},
+      {0x1.8bb105a5dc9p-1, 0x1.863e03e9474c1p-55},
+      {0x1.869108d77a6c6p-1, 0x1.338ffe2bfe9ddp-56},
+      {0x1.8158a31916d5dp-1, -0x1.de8b90b8228dep-57},
+      {0x1.7c0827f09e54fp-1, -0x1.c73d6d72aee68p-57},
+      {0x1.769fec655211fp-1, -0x1.827d5cf8c68c5p-57},
+      {0x1.712046fa77678p-1, 0x1.425b0a5029c81p-55},
+      {0x1.6b898fa9efb5dp-1, 0x1.15ac786ccf4b2p-56},
+      {0x1.65dc1fdeb8cbap-1, -0x1.97c1b47337c77p-58},
+  };
+  // (-1)^k/(2k+1)! and (-1)^k/(2k)! for k = 0, ..., 5
+  static constexpr double sinCoeff[6][2] = {
+      {0x1p+0, 0x0p+0},
+      {-0x1.5555555555555p-3, -0x1.5555555555555p-57},
+      {0x1.1111111111111p-7, 0x1.1111111111111p-63},
+      {-0x1.a01a01a01a01ap-13, -0x1.a01a01a01a01ap-73},
+      {0x1.71de3a556c734p-19, -0x1.c154f8ddc6cp-73},
+      {-0x1.ae64567f544e4p-26, 0x1.c062e06d1f209p-80},
+  };
+  static constexpr double cosCoeff[6][2] = {
+      {0x1p+0, 0x0p+0},
+      {-0x1p-1, 0x0p+0},
+      {0x1.5555555555555p-5, 0x1.5555555555555p-59},
+      {-0x1.6c16c16c16c17p-10, 0x1.f49f49f49f49fp-65},
+      {0x1.a01a01a01a01ap-16, 0x1.a01a01a01a01ap-76},
+      {-0x1.27e4fb7789f5cp-22, -0x1.cbbc05b4fa99ap-76},
+  };
+  // The bits of 2/π after the binary point in chunks of 24 bits
+  static constexpr double twoOverPiChunks[56] = {
+      10680707.0, 7228996.0, 1387004.0, 2578385.0, 16069853.0, 12639074.0,
+      9804092.0, 4427841.0, 16666979.0, 11263675.0, 12935607.0, 2387514.0,
+      4345298.0, 14681673.0, 3074569.0, 13734428.0, 16653803.0, 1880361.0,
+      10960616.0, 8533493.0, 3062596.0, 8710556.0, 7349940.0, 6258241.0,
+      3772886.0, 3769171.0, 3798172.0, 8675211.0, 12450088.0, 3874808.0,
+      9961438.0, 366607.0, 15675153.0, 9132554.0, 7151469.0, 3571407.0,
+      2607881.0, 12013382.0, 4155038.0, 6285869.0, 7677882.0, 13102053.0,
+      15825725.0, 473591.0, 9065106.0, 15363067.0, 6271263.0, 9264392.0,
+      5636912.0, 4652155.0, 7056368.0, 13614112.0, 10155062.0, 1944035.0,
+      9527646.0, 15080200.0,
+  };
+};
+
+template <>
+struct trigTables<float> {
+  static constexpr float halfPi[2] = {0x1.921fb6p+0f, -0x1.777a5cp-25f};
+  static constexpr float invHalfPi = 0x1.45f306p-1f;
+  static constexpr float halfPiParts[7] = {0x1.922p+0f, -0x1.2aep-18f,
+                                           -0x1.deap-31f, 0x1.184p-44f,
+                                           0x1.a62p-58f, 0x1.8ccp-72f,
+                                           0x1.45c06ep-86f};
+  // sin(j/64) and cos(j/64) for j = 0, ..., 51
+  static constexpr float sin[52][2] = {
+      {0x0p+0f, 0x0p+0f},
+      {0x1.fffaaap-7f, 0x1.5ddddap-32f},
+      {0x1.ffeaaap-6f, 0x1.dddd0ep-31f},
+      {0x1.7fdc02p-5f, -0x1.f9a08ap-30f},
+      {0x1.ffaaaep-5f, 0x1.dda9dcp-30f},
+      {0x1.3facb2p-4f, -0x1.a5d154p-29f},
+      {0x1.7f701p-4f, 0x1.92a872p-31f},
+      {0x1.bf1b78p-4f, 0x1.5a0e48p-30f},
+      {0x1.feaaeep-4f, 0x1.d0ddc6p-29f},
+      {0x1.1f0d3ep-3f, -0x1.0a062ap-28f},
+      {0x1.3eb312p-3f, 0x1.8bacdap-28f},
+      {0x1.5e44fcp-3f, 0x1.f424dep-28f},
+      {0x1.7dc102p-3f, 0x1.f75e56p-28f},
+      {0x1.9d252ep-3f, -0x1.e6279ep-28f},
+      {0x1.bc6f84p-3f, 0x1.db8c34p-28f},
+      {0x1.db9e16p-3f, -0x1.2968c2p-33f},
+      {0x1.faaeeep-3f, -0x1.619d52p-28f},
+      {0x1.0cd00cp-2f, 0x1.de6c86p-27f},
+      {0x1.1c37d6p-2f, 0x1.31ae1ep-28f},
+      {0x1.2b8ddcp-2f, 0x1.0fad28p-28f},
+      {0x1.3ad12ap-2f, -0x1.12c584p-27f},
+      {0x1.4a00cap-2f, -0x1.3c30b8p-28f},
+      {0x1.591bcap-2f, -0x1.7429a4p-32f},
+      {0x1.682138p-2f, 0x1.471afep-27f},
+      {0x1.771026p-2f, -0x1.5137bep-27f},
+      {0x1.85e7a2p-2f, -0x1.afb2d6p-27f},
+      {0x1.94a6bep-2f, 0x1.3ea8d8p-27f},
+      {0x1.a34c92p-2f, -0x1.9d799cp-29f},
+      {0x1.b1d83p-2f, 0x1.4c8586p-28f},
+      {0x1.c048b2p-2f, -0x1.09d7ecp-27f},
+      {0x1.ce9d2ep-2f, 0x1.ea529p-29f},
+      {0x1.dcd4c2p-2f, -0x1.59ac6cp-27f},
+      {0x1.eaee88p-2f, -0x1.769f42p-27f},
+      {0x1.f8e99ep-2f, 0x1.daaf26p-28f},
+      {0x1.036294p-1f, -0x1.8e59aap-27f},
+      {0x1.0a4022p-1f, -0x1.61fp-29f},
+      {0x1.110d0cp-1f, 0x1.2da70ep-27f},
+      {0x1.17c8e6p-1f, -0x1.a224ap-30f},
+      {0x1.1e7344p-1f, -0x1.b93516p-26f},
+      {0x1.250bbap-1f, -0x1.90ee88p-26f},
+      {0x1.2b91dep-1f, 0x1.510844p-26f},
+      {0x1.32054cp-1f, -0x1.d6e876p-26f},
+      {0x1.386598p-1f, -0x1.753afap-26f},
+      {0x1.3eb25ep-1f, -0x1.926558p-26f},
+      {0x1.44eb38p-1f, 0x1.cf386ap-29f},
+      {0x1.4b0fc4p-1f, 0x1.aaadd8p-27f},
+      {0x1.511fap-1f, -0x1.426572p-28f},
+      {0x1.571a6ap-1f, -0x1.3254cap-26f},
+      {0x1.5cffc2p-1f, -0x1.280e1ep-26f},
+      {0x1.62cf4ap-1f, -0x1.b794e2p-27f},
+      {0x1.6888a4p-1f, 0x1.c26966p-26f},
+      {0x1.6e2b78p-1f, -0x1.dfa11p-28f},
+  };
+  static constexpr float cos[52][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {0x1.fffp-1f, 0x1.5554ap-29f},
+      {0x1.ffc002p-1f, -0x1.555b06p-26f},
+      {0x1.ff7006p-1f, 0x1.7fbf34p-26f},
+      {0x1.ff0016p-1f, -0x1.56c166p-26f},
+      {0x1.fe7034p-1f, 0x1.29ef6ep-29f},
+      {0x1.fdc06cp-1f, -0x1.0328cap-30f},
+      {0x1.fcf0c8p-1f, 0x1.d33624p-34f},
+      {0x1.fc0156p-1f, -0x1.b05486p-26f},
+      {0x1.faf222p-1f, 0x1.8f12f4p-27f},
+      {0x1.f9c34p-1f, 0x1.4f9886p-26f},
+      {0x1.f874c2p-1f, 0x1.c3dd9ep-26f},
+      {0x1.f706bep-1f, -0x1.84c792p-31f},
+      {0x1.f57948p-1f, 0x1.9fecf2p-26f},
+      {0x1.f3cc7cp-1f, 0x1.d9e8b6p-28f},
+      {0x1.f20074p-1f, -0x1.ef336cp-26f},
+      {0x1.f0154ap-1f, -0x1.0422bep-30f},
+      {0x1.ee0b2p-1f, -0x1.0fc3bap-27f},
+      {0x1.ebe214p-1f, 0x1.eeddf4p-26f},
+      {0x1.e99a4cp-1f, 0x1.d3e6c2p-28f},
+      {0x1.e733eap-1f, 0x1.93d3fap-33f},
+      {0x1.e4af14p-1f, 0x1.654894p-26f},
+      {0x1.e20bf4p-1f, 0x1.359ad8p-26f},
+      {0x1.df4ab4p-1f, -0x1.4278a2p-29f},
+      {0x1.dc6b7ep-1f, 0x1.732b22p-26f},
+      {0x1.d96e82p-1f, 0x1.ee353cp-26f},
+      {0x1.d653fp-1f, 0x1.cf901p-27f},
+      {0x1.d31bf8p-1f, 0x1.b1af8p-26f},
+      {0x1.cfc6dp-1f, -0x1.6b5498p-27f},
+      {0x1.cc54aap-1f, 0x1.594b98p-28f},
+      {0x1.c8c5cp-1f, -0x1.cc795ep-27f},
+      {0x1.c51a48p-1f, 0x1.7162ecp-26f},
+      {0x1.c1528p-1f, 0x1.96df54p-27f},
+      {0x1.bd6ea4p-1f, -0x1.dfad62p-26f},
+      {0x1.b96eeep-1f, 0x1.eb1082p-26f},
+      {0x1.b553a4p-1f, 0x1.0c104ep-29f},
+      {0x1.b11d04p-1f, 0x1.62a4c6p-29f},
+      {0x1.accb52p-1f, 0x1.bda77ap-27f},
+      {0x1.a85ed4p-1f, 0x1.b9f016p-28f},
+      {0x1.a3d7dp-1f, 0x1.a95ee8p-28f},
+      {0x1.9f368ep-1f, 0x1.b225fp-26f},
+      {0x1.9a7b5ap-1f, 0x1.b5328ap-28f},
+      {0x1.95a67ep-1f, 0x1.963f98p-34f},
+      {0x1.90b848p-1f, -0x1.ec8942p-27f},
+      {0x1.8bb106p-1f, -0x1.688dcp-27f},
+      {0x1.869108p-1f, 0x1.aef4d8p-26f},
+      {0x1.8158a4p-1f, -0x1.cdd254p-26f},
+      {0x1.7c0828p-1f, -0x1.ec3562p-30f},
+      {0x1.769fecp-1f, 0x1.954848p-27f},
+      {0x1.712046p-1f, 0x1.f4eedp-26f},
+      {0x1.6b899p-1f, -0x1.584128p-27f},
+      {0x1.65dc2p-1f, -0x1.0a39a4p-28f},
+  };
+  // (-1)^k/(2k+1)! and (-1)^k/(2k)! for k = 0, ..., 5
+  static constexpr float sinCoeff[6][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {-0x1.555556p-3f, 0x1.555556p-28f},
+      {0x1.111112p-7f, -0x1.dddddep-32f},
+      {-0x1.a01a02p-13f, 0x1.7f97fap-39f},
+      {0x1.71de3ap-19f, 0x1.55b1ccp-45f},
+      {-0x1.ae6456p-26f, -0x1.fd5138p-52f},
+  };
+  static constexpr float cosCoeff[6][2] = {
+      {0x1p+0f, 0x0p+0f},
+      {-0x1p-1f, 0x0p+0f},
+      {0x1.555556p-5f, -0x1.555556p-30f},
+      {-0x1.6c16c2p-10f, 0x1.27d27ep-35f},
+      {0x1.a01a02p-16f, -0x1.7f97fap-42f},
+      {-0x1.27e4fcp-22f, 0x1.10ec14p-47f},
+  };
+};
+
+}  // namespace details
+}  // namespace doubleword
+}  // namespace twofloat
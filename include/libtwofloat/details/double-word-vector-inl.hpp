@@ -0,0 +1,352 @@
+// NOTE: This file intentionally has no include guard. It is included once into
+// the namespace of every supported instruction set (e.g.
+// `twofloat::details::avx2`), which must provide the register wrappers `f64`,
+// `f32` and the alias `vec<T>` (see x86-vectors.hpp).
+
+/// \file double-word-vector-inl.hpp
+/// \brief Vectorized versions of the double-word algorithms and the loops of
+/// the batched operations.
+/// \details The algorithms operate on `vtwo<V>`, i.e. on the high and low words
+/// of `V::width` double-word numbers, and perform exactly the same sequence of
+/// floating point operations as the scalar algorithms in algorithms.hpp and
+/// double-word-arithmetic.hpp. The results are therefore bitwise identical.
+/// The elementary functions in double-word-functions.hpp are instead
+/// instantiated for `two<simd<T, V::width>>` and inlined into the loops.
+
+using Mode = ::twofloat::doubleword::Mode;
+
+/// \brief The high and low words of `V::width` double-word numbers.
+template <typename V>
+struct vtwo {
+  V h;
+  V l;
+};
+
+/// \brief Vectorized versions of the algorithms in algorithms.hpp.
+namespace algorithms {
+
+template <typename V>
+inline vtwo<V> FastTwoSum(V a, V b) {
+  vtwo<V> res;
+  res.h = a + b;
+  V z = res.h - a;
+  res.l = b - z;
+  return res;
+}
+
+template <typename V>
+inline vtwo<V> TwoSum(V a, V b) {
+  vtwo<V> res;
+  res.h = a + b;
+  V a1 = res.h - b;
+  V b1 = res.h - a1;
+  V da = a - a1;
+  V db = b - b1;
+  res.l = da + db;
+  return res;
+}
+
+template <typename V>
+inline vtwo<V> TwoDiff(V a, V b) {
+  vtwo<V> res;
+  res.h = a - b;
+  V a1 = res.h - a;
+  V b1 = res.h - a1;
+  V da = a - b1;
+  V db = b + a1;
+  res.l = da - db;
+  return res;
+}
+
+/// \details Both branches of the scalar algorithm are evaluated and the lanes
+/// that need scaling are selected afterwards.
+template <typename V>
+inline vtwo<V> Split(V x) {
+  using C = ::twofloat::algorithms::constants<typename V::scalar_type>;
+  const V c = V::broadcast(C::SplitC);
+
+  // Scaled down version to avoid overflows
+  V xs = x * V::broadcast(C::SplitScaleDownFactor);
+  V ps = xs * c;
+  V qs = xs - ps;
+  V x1s = ps + qs;
+  V x2s = xs - x1s;
+  x1s = x1s * V::broadcast(C::SplitScaleUpFactor);
+  x2s = x2s * V::broadcast(C::SplitScaleUpFactor);
+
+  // Unscaled version
+  V p = x * c;
+  V q = x - p;
+  V x1 = p + q;
+  V x2 = x - x1;
+
+  const V threshold = V::broadcast(C::SplitScaleThreshold);
+  return {select_gt(abs(x), threshold, x1s, x1),
+          select_gt(abs(x), threshold, x2s, x2)};
+}
+
+template <typename V>
+inline vtwo<V> Fast2Prod(V a, V b) {
+  vtwo<V> res;
+  res.h = a * b;
+  res.l = fma(a, b, -res.h);
+  return res;
+}
+
+template <bool useFMA, typename V>
+inline vtwo<V> TwoProd(V a, V b) {
+  if constexpr (useFMA) return Fast2Prod(a, b);
+
+  vtwo<V> res;
+  res.h = a * b;
+
+  vtwo<V> a1 = Split(a);
+  vtwo<V> b1 = Split(b);
+
+  res.l = ((a1.h * b1.h - res.h) + a1.h * b1.l + a1.l * b1.h) + a1.l * b1.l;
+  return res;
+}
+}  // namespace algorithms
+
+/// \brief Vectorized versions of the operations in double-word-arithmetic.hpp.
+namespace doubleword {
+
+template <typename V>
+inline vtwo<V> add(const vtwo<V> &x, V y) {
+  vtwo<V> s = algorithms::TwoSum(x.h, y);
+  V v = x.l + s.l;
+  return algorithms::FastTwoSum(s.h, v);
+}
+
+template <Mode mode, typename V>
+inline vtwo<V> add(const vtwo<V> &x, const vtwo<V> &y) {
+  if constexpr (mode == Mode::Sloppy) {
+    vtwo<V> s = algorithms::TwoSum(x.h, y.h);
+    V v = x.l + y.l;
+    V w = s.l + v;
+    return algorithms::FastTwoSum(s.h, w);
+  } else {
+    vtwo<V> s = algorithms::TwoSum(x.h, y.h);
+    vtwo<V> t = algorithms::TwoSum(x.l, y.l);
+    V c = s.l + t.h;
+    vtwo<V> v = algorithms::FastTwoSum(s.h, c);
+    V w = t.l + v.l;
+    return algorithms::FastTwoSum(v.h, w);
+  }
+}
+
+template <Mode mode, typename V>
+inline vtwo<V> sub(const vtwo<V> &x, const vtwo<V> &y) {
+  if constexpr (mode == Mode::Sloppy) {
+    vtwo<V> s = algorithms::TwoDiff(x.h, y.h);
+    V v = x.l - y.l;
+    V w = s.l + v;
+    return algorithms::FastTwoSum(s.h, w);
+  } else {
+    vtwo<V> s = algorithms::TwoDiff(x.h, y.h);
+    vtwo<V> t = algorithms::TwoDiff(x.l, y.l);
+    V c = s.l + t.h;
+    vtwo<V> v = algorithms::FastTwoSum(s.h, c);
+    V w = t.l + v.l;
+    return algorithms::FastTwoSum(v.h, w);
+  }
+}
+
+template <Mode p, bool useFMA, typename V>
+inline vtwo<V> mul(const vtwo<V> &x, V y) {
+  if constexpr (useFMA) {
+    vtwo<V> c = algorithms::Fast2Prod(x.h, y);
+    V cl3 = fma(x.l, y, c.l);
+    return algorithms::FastTwoSum(c.h, cl3);
+  } else if constexpr (p == Mode::Fast) {
+    vtwo<V> c = algorithms::TwoProd<false>(x.h, y);
+    V cl2 = x.l * y;
+    V cl3 = c.l + cl2;
+    return algorithms::FastTwoSum(c.h, cl3);
+  } else {
+    vtwo<V> c = algorithms::TwoProd<false>(x.h, y);
+    V cl2 = x.l * y;
+    vtwo<V> t = algorithms::FastTwoSum(c.h, cl2);
+    V tl2 = t.l + c.l;
+    return algorithms::FastTwoSum(t.h, tl2);
+  }
+}
+
+template <Mode p, bool useFMA, typename V>
+inline vtwo<V> mul(const vtwo<V> &x, const vtwo<V> &y) {
+  if constexpr (useFMA && p == Mode::Fast) {
+    vtwo<V> c = algorithms::Fast2Prod(x.h, y.h);
+    V tl = x.h * y.l;
+    V cl2 = fma(x.l, y.h, tl);
+    V cl3 = c.l + cl2;
+    return algorithms::FastTwoSum(c.h, cl3);
+  } else if constexpr (useFMA) {
+    vtwo<V> c = algorithms::Fast2Prod(x.h, y.h);
+    V tl0 = x.l * y.l;
+    V tl1 = fma(x.h, y.l, tl0);
+    V cl2 = fma(x.l, y.h, tl1);
+    V cl3 = c.l + cl2;
+    return algorithms::FastTwoSum(c.h, cl3);
+  } else {
+    vtwo<V> c = algorithms::TwoProd<false>(x.h, y.h);
+    V tl1 = x.h * y.l;
+    V tl2 = x.l * y.h;
+    V cl2 = tl1 + tl2;
+    V cl3 = c.l + cl2;
+    return algorithms::FastTwoSum(c.h, cl3);
+  }
+}
+
+template <Mode mode, bool useFMA, typename V>
+inline vtwo<V> div(const vtwo<V> &x, const vtwo<V> &y) {
+  if constexpr (mode == Mode::Fast) {
+    V th = x.h / y.h;
+    vtwo<V> r = mul<Mode::Accurate, useFMA>(y, th);
+    V pih = x.h - r.h;
+    V deltal = x.l - r.l;
+    V delta = pih + deltal;
+    V tl = delta / y.h;
+    return algorithms::FastTwoSum(th, tl);
+  } else {
+    const V one = V::broadcast(1);
+    V th = one / y.h;
+    V rh = fma(-y.h, th, one);
+    V rl = -(y.l * th);
+    vtwo<V> e = algorithms::FastTwoSum(rh, rl);
+    vtwo<V> delta = mul<Mode::Accurate, true>(e, th);
+    vtwo<V> m = add(delta, th);
+    return mul<Mode::Accurate, true>(x, m);
+  }
+}
+}  // namespace doubleword
+
+/// \brief The loops of the batched operations.
+/// \details Each function processes as many complete registers as possible
+/// and returns the number of processed elements. The remaining elements are
+/// processed by the caller using the scalar operations. The functions are
+/// static members so that the dispatcher can pass the kernels of an
+/// instruction set as a single object.
+struct batch {
+  template <typename T, typename Op>
+  static std::size_t apply(Op op, const T *xh, const T *xl, const T *yh,
+                           const T *yl, T *zh, T *zl, std::size_t n) {
+    using V = vec<T>;
+    std::size_t i = 0;
+    for (; i + V::width <= n; i += V::width) {
+      vtwo<V> x = {V::load(xh + i), V::load(xl + i)};
+      vtwo<V> y = {V::load(yh + i), V::load(yl + i)};
+      vtwo<V> z = op(x, y);
+      z.h.store(zh + i);
+      z.l.store(zl + i);
+    }
+    return i;
+  }
+
+  template <typename T, typename Op>
+  TWOFLOAT_FLATTEN static std::size_t applyUnary(Op op, const T *xh,
+                                                 const T *xl, T *zh, T *zl,
+                                                 std::size_t n) {
+    using W = ::twofloat::simd<T, vec<T>::width>;
+    std::size_t i = 0;
+    for (; i + W::size() <= n; i += W::size()) {
+      // Without optimization, the functions are not inlined and compiled for
+      // the default instruction set, which passes vectors by value
+      // differently. Vectors therefore only cross into them by reference.
+      ::twofloat::two<W> x;
+      std::memcpy(&x.h, xh + i, sizeof(W));
+      std::memcpy(&x.l, xl + i, sizeof(W));
+      ::twofloat::two<W> z = op(x);
+      z.h.store(zh + i);
+      z.l.store(zl + i);
+    }
+    return i;
+  }
+
+  template <Mode mode, typename T>
+  static std::size_t add(const T *xh, const T *xl, const T *yh, const T *yl,
+                         T *zh, T *zl, std::size_t n) {
+    return apply(
+        [](const auto &x, const auto &y) {
+          return doubleword::add<mode>(x, y);
+        },
+        xh, xl, yh, yl, zh, zl, n);
+  }
+
+  template <Mode mode, typename T>
+  static std::size_t sub(const T *xh, const T *xl, const T *yh, const T *yl,
+                         T *zh, T *zl, std::size_t n) {
+    return apply(
+        [](const auto &x, const auto &y) {
+          return doubleword::sub<mode>(x, y);
+        },
+        xh, xl, yh, yl, zh, zl, n);
+  }
+
+  template <Mode mode, bool useFMA, typename T>
+  static std::size_t mul(const T *xh, const T *xl, const T *yh, const T *yl,
+                         T *zh, T *zl, std::size_t n) {
+    return apply(
+        [](const auto &x, const auto &y) {
+          return doubleword::mul<mode, useFMA>(x, y);
+        },
+        xh, xl, yh, yl, zh, zl, n);
+  }
+
+  template <Mode mode, bool useFMA, typename T>
+  static std::size_t div(const T *xh, const T *xl, const T *yh, const T *yl,
+                         T *zh, T *zl, std::size_t n) {
+    return apply(
+        [](const auto &x, const auto &y) {
+          return doubleword::div<mode, useFMA>(x, y);
+        },
+        xh, xl, yh, yl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t sqrt(const T *xh, const T *xl, T *zh, T *zl,
+                          std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::sqrt<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t exp(const T *xh, const T *xl, T *zh, T *zl,
+                         std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::exp<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t log(const T *xh, const T *xl, T *zh, T *zl,
+                         std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::log<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t sin(const T *xh, const T *xl, T *zh, T *zl,
+                         std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::sin<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t cos(const T *xh, const T *xl, T *zh, T *zl,
+                         std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::cos<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+
+  template <bool useFMA, typename T>
+  static std::size_t tan(const T *xh, const T *xl, T *zh, T *zl,
+                         std::size_t n) {
+    return applyUnary(
+        [](const auto &x) { return ::twofloat::doubleword::tan<useFMA>(x); },
+        xh, xl, zh, zl, n);
+  }
+};
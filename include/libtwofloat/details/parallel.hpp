@@ -0,0 +1,60 @@
+#pragma once
+
+/// \file parallel.hpp
+/// \brief Implements a minimal parallel loop over independent blocks of work.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace twofloat {
+namespace details {
+
+/// \brief Returns the number of threads to use if the caller requests
+/// `threads` threads, where 0 selects the number of hardware threads.
+inline unsigned threadCount(unsigned threads) {
+  if (threads != 0) return threads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// \brief Calls `f(i)` for every block `i` in `[0, nBlocks)` using up to
+/// `threads` threads (0 for the number of hardware threads).
+/// \details The blocks are distributed dynamically. Which thread processes a
+/// block is therefore unspecified, so `f` must only write results that belong
+/// to its block. The calling thread participates in the work.
+template <typename F>
+void parallelFor(std::size_t nBlocks, unsigned threads, F f) {
+  threads = static_cast<unsigned>(
+      std::min<std::size_t>(threadCount(threads), nBlocks));
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < nBlocks; ++i) f(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < nBlocks; i = next++) f(i);
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();
+  for (std::thread &thread : pool) thread.join();
+}
+
+/// \brief Combines the `n` values pairwise in a binary tree, i.e. in an order
+/// that only depends on `n`, and returns the result.
+/// \details The values are overwritten. Requires that `n > 0`.
+template <typename T, typename Combine>
+T treeReduce(T *values, std::size_t n, Combine combine) {
+  for (std::size_t stride = 1; stride < n; stride *= 2)
+    for (std::size_t i = 0; i + stride < n; i += 2 * stride)
+      values[i] = combine(values[i], values[i + stride]);
+  return values[0];
+}
+
+}  // namespace details
+}  // namespace twofloat
@@ -0,0 +1,74 @@
+#pragma once
+
+/// \file target.hpp
+/// \brief Macros to compile code for instruction sets that are not enabled
+/// globally, e.g. AVX2 code in a binary that must also run on older CPUs.
+/// \details With GCC and Clang on x86, code between
+/// `TWOFLOAT_BEGIN_TARGET_AVX2` and `TWOFLOAT_END_TARGET` is compiled for AVX2
+/// (with FMA), regardless of the compiler flags. Such code must only be
+/// executed after checking that the CPU supports the instruction set (see
+/// cpu.hpp). With other compilers, an instruction set is only available if it
+/// is enabled globally (e.g. `/arch:AVX2`) and the macros expand to nothing.
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+/// \brief Whether code for other instruction sets can be compiled on demand.
+#define TWOFLOAT_TARGET_ATTRIBUTES 1
+#endif
+
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES) || \
+    (defined(__AVX2__) && defined(__FMA__))
+#define TWOFLOAT_HAS_AVX2 1
+#endif
+
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES) || defined(__AVX512F__)
+#define TWOFLOAT_HAS_AVX512 1
+#endif
+
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES) && defined(__clang__)
+#define TWOFLOAT_BEGIN_TARGET_AVX2                                          \
+  _Pragma(                                                                  \
+      "clang attribute push(__attribute__((target(\"avx2,fma\"))), apply_to " \
+      "= function)")
+#define TWOFLOAT_BEGIN_TARGET_AVX512                                      \
+  _Pragma(                                                                \
+      "clang attribute push(__attribute__((target(\"avx512f,avx2,fma\"))), " \
+      "apply_to = function)")
+#define TWOFLOAT_END_TARGET _Pragma("clang attribute pop")
+#elif defined(TWOFLOAT_TARGET_ATTRIBUTES)
+#define TWOFLOAT_BEGIN_TARGET_AVX2 \
+  _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+#define TWOFLOAT_BEGIN_TARGET_AVX512 \
+  _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+#define TWOFLOAT_END_TARGET _Pragma("GCC pop_options")
+#else
+#define TWOFLOAT_BEGIN_TARGET_AVX2
+#define TWOFLOAT_BEGIN_TARGET_AVX512
+#define TWOFLOAT_END_TARGET
+#endif
+
+/// \brief Compiles a function with FMA instructions and inlines all calls into
+/// it, so that `std::fma` in the called templates maps to an instruction.
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES)
+#define TWOFLOAT_TARGET_FMA __attribute__((target("fma"), flatten))
+#else
+#define TWOFLOAT_TARGET_FMA
+#endif
+
+/// \brief Compiles a function with AVX-512 instructions and inlines all calls
+/// into it, like `TWOFLOAT_TARGET_FMA`.
+#if defined(TWOFLOAT_TARGET_ATTRIBUTES)
+#define TWOFLOAT_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx2,fma"), flatten))
+#else
+#define TWOFLOAT_TARGET_AVX512
+#endif
+
+/// \brief Inlines all calls into a function, so that templates defined
+/// outside of a target region are compiled for the instruction set of the
+/// function.
+#if defined(__GNUC__) || defined(__clang__)
+#define TWOFLOAT_FLATTEN __attribute__((flatten))
+#else
+#define TWOFLOAT_FLATTEN
+#endif
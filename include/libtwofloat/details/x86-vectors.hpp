@@ -0,0 +1,189 @@
+#pragma once
+
+/// \file x86-vectors.hpp
+/// \brief Thin wrappers around x86 vector registers that are used by the
+/// batched operations.
+/// \details Each instruction set has its own namespace with a wrapper for
+/// double precision (`f64`) and single precision (`f32`) registers. The
+/// wrappers provide the arithmetic operators (as members, since GCC does not
+/// apply target pragmas to friend functions), so that the vectorized
+/// algorithms can be written exactly like their scalar counterparts. Every
+/// operation maps to a single IEEE 754 operation per lane, which keeps the
+/// results of the vectorized algorithms bitwise identical to the scalar ones.
+///
+/// The wrappers (and all code using them) are compiled for their instruction
+/// set using the macros in target.hpp and must only be used after checking
+/// the CPU features at runtime.
+
+#include <cstddef>
+#include <cstdint>
+#include <libtwofloat/details/target.hpp>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace twofloat {
+namespace details {
+
+#if defined(TWOFLOAT_HAS_AVX2)
+TWOFLOAT_BEGIN_TARGET_AVX2
+/// \brief Vector registers of the AVX2 instruction set (with FMA).
+namespace avx2 {
+
+/// \brief Four double precision numbers.
+struct f64 {
+  using scalar_type = double;
+  static constexpr std::size_t width = 4;
+
+  __m256d v;
+
+  static f64 load(const double *p) { return {_mm256_loadu_pd(p)}; }
+  static f64 broadcast(double x) { return {_mm256_set1_pd(x)}; }
+  void store(double *p) const { _mm256_storeu_pd(p, v); }
+
+  f64 operator+(f64 b) const { return {_mm256_add_pd(v, b.v)}; }
+  f64 operator-(f64 b) const { return {_mm256_sub_pd(v, b.v)}; }
+  f64 operator*(f64 b) const { return {_mm256_mul_pd(v, b.v)}; }
+  f64 operator/(f64 b) const { return {_mm256_div_pd(v, b.v)}; }
+  f64 operator-() const { return {_mm256_xor_pd(v, _mm256_set1_pd(-0.0))}; }
+};
+
+inline f64 fma(f64 a, f64 b, f64 c) {
+  return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+}
+
+inline f64 abs(f64 a) {
+  return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+}
+
+/// \brief Returns `a > b ? x : y` for each lane.
+inline f64 select_gt(f64 a, f64 b, f64 x, f64 y) {
+  __m256d mask = _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ);
+  return {_mm256_blendv_pd(y.v, x.v, mask)};
+}
+
+/// \brief Eight single precision numbers.
+struct f32 {
+  using scalar_type = float;
+  static constexpr std::size_t width = 8;
+
+  __m256 v;
+
+  static f32 load(const float *p) { return {_mm256_loadu_ps(p)}; }
+  static f32 broadcast(float x) { return {_mm256_set1_ps(x)}; }
+  void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+  f32 operator+(f32 b) const { return {_mm256_add_ps(v, b.v)}; }
+  f32 operator-(f32 b) const { return {_mm256_sub_ps(v, b.v)}; }
+  f32 operator*(f32 b) const { return {_mm256_mul_ps(v, b.v)}; }
+  f32 operator/(f32 b) const { return {_mm256_div_ps(v, b.v)}; }
+  f32 operator-() const { return {_mm256_xor_ps(v, _mm256_set1_ps(-0.0f))}; }
+};
+
+inline f32 fma(f32 a, f32 b, f32 c) {
+  return {_mm256_fmadd_ps(a.v, b.v, c.v)};
+}
+
+inline f32 abs(f32 a) {
+  return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)};
+}
+
+/// \brief Returns `a > b ? x : y` for each lane.
+inline f32 select_gt(f32 a, f32 b, f32 x, f32 y) {
+  __m256 mask = _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ);
+  return {_mm256_blendv_ps(y.v, x.v, mask)};
+}
+
+/// \brief The register type holding numbers of type T.
+template <typename T>
+using vec = std::conditional_t<std::is_same_v<T, double>, f64, f32>;
+}  // namespace avx2
+TWOFLOAT_END_TARGET
+#endif
+
+#if defined(TWOFLOAT_HAS_AVX512)
+TWOFLOAT_BEGIN_TARGET_AVX512
+/// \brief Vector registers of the AVX-512 foundation instruction set.
+namespace avx512 {
+
+/// \brief Eight double precision numbers.
+struct f64 {
+  using scalar_type = double;
+  static constexpr std::size_t width = 8;
+
+  __m512d v;
+
+  static f64 load(const double *p) { return {_mm512_loadu_pd(p)}; }
+  static f64 broadcast(double x) { return {_mm512_set1_pd(x)}; }
+  void store(double *p) const { _mm512_storeu_pd(p, v); }
+
+  f64 operator+(f64 b) const { return {_mm512_add_pd(v, b.v)}; }
+  f64 operator-(f64 b) const { return {_mm512_sub_pd(v, b.v)}; }
+  f64 operator*(f64 b) const { return {_mm512_mul_pd(v, b.v)}; }
+  f64 operator/(f64 b) const { return {_mm512_div_pd(v, b.v)}; }
+  f64 operator-() const {
+    // Floating point xor requires AVX512DQ, so flip the sign bit with an
+    // integer xor instead
+    const __m512i sign = _mm512_set1_epi64(INT64_C(-0x7fffffffffffffff) - 1);
+    return {
+        _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(v), sign))};
+  }
+};
+
+inline f64 fma(f64 a, f64 b, f64 c) {
+  return {_mm512_fmadd_pd(a.v, b.v, c.v)};
+}
+
+inline f64 abs(f64 a) { return {_mm512_abs_pd(a.v)}; }
+
+/// \brief Returns `a > b ? x : y` for each lane.
+inline f64 select_gt(f64 a, f64 b, f64 x, f64 y) {
+  __mmask8 mask = _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ);
+  return {_mm512_mask_blend_pd(mask, y.v, x.v)};
+}
+
+/// \brief Sixteen single precision numbers.
+struct f32 {
+  using scalar_type = float;
+  static constexpr std::size_t width = 16;
+
+  __m512 v;
+
+  static f32 load(const float *p) { return {_mm512_loadu_ps(p)}; }
+  static f32 broadcast(float x) { return {_mm512_set1_ps(x)}; }
+  void store(float *p) const { _mm512_storeu_ps(p, v); }
+
+  f32 operator+(f32 b) const { return {_mm512_add_ps(v, b.v)}; }
+  f32 operator-(f32 b) const { return {_mm512_sub_ps(v, b.v)}; }
+  f32 operator*(f32 b) const { return {_mm512_mul_ps(v, b.v)}; }
+  f32 operator/(f32 b) const { return {_mm512_div_ps(v, b.v)}; }
+  f32 operator-() const {
+    const __m512i sign = _mm512_set1_epi32(INT32_C(-0x7fffffff) - 1);
+    return {
+        _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(v), sign))};
+  }
+};
+
+inline f32 fma(f32 a, f32 b, f32 c) {
+  return {_mm512_fmadd_ps(a.v, b.v, c.v)};
+}
+
+inline f32 abs(f32 a) { return {_mm512_abs_ps(a.v)}; }
+
+/// \brief Returns `a > b ? x : y` for each lane.
+inline f32 select_gt(f32 a, f32 b, f32 x, f32 y) {
+  __mmask16 mask = _mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ);
+  return {_mm512_mask_blend_ps(mask, y.v, x.v)};
+}
+
+/// \brief The register type holding numbers of type T.
+template <typename T>
+using vec = std::conditional_t<std::is_same_v<T, double>, f64, f32>;
+}  // namespace avx512
+TWOFLOAT_END_TARGET
+#endif
+
+}  // namespace details
+}  // namespace twofloat
@@ -0,0 +1,241 @@
+#pragma once
+
+/// \file expression.hpp
+/// \brief Implements expression templates that evaluate arithmetic expressions
+/// of double-word numbers lazily.
+
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <type_traits>
+
+namespace twofloat {
+
+/// \brief Lazy evaluation of arithmetic expressions of double-word numbers.
+/// \details `lazy<Policy>(x)` wraps a double-word number, and the operators
+/// `+`, `-`, `*` and `/` on the wrapped number build the expression as a tree
+/// of types instead of calculating it. The expression is calculated when it
+/// is converted to `two<T>` or with `eval()`, with the arithmetic selected by
+/// the policy (see policy.hpp). The other operand of an operator may also be a
+/// `two<T>` or a floating point number of type `T`.
+///
+/// The evaluation fuses each sum or difference with a product as operand, e.g.
+/// `a * b + c`, into `Policy::fma`. With `policy::doubleword`, this is
+/// `doubleword::fma`, which accumulates the error terms of the product and
+/// the sum in one word and normalizes once (19 instead of 29 FP ops with
+/// FMA). With `policy::pair`, no intermediate result is normalized and the
+/// result of the whole expression is normalized once at the end.
+namespace expr {
+
+namespace details {
+struct plus {};
+struct minus {};
+struct times {};
+struct divides {};
+}  // namespace details
+
+/// \brief The base of all expressions.
+/// \tparam E The type of the expression.
+/// \tparam Policy The arithmetic (see policy.hpp).
+/// \tparam T The underlying floating point type or vector.
+template <typename E, typename Policy, typename T>
+struct expression {
+  using policy = Policy;
+  using value_type = T;
+
+  /// \brief Calculates the expression and normalizes the result.
+  two<T> eval() const {
+    return Policy::normalize(static_cast<const E &>(*this).compute());
+  }
+
+  /// \brief Calculates the expression, see `eval`.
+  operator two<T>() const { return eval(); }
+};
+
+/// \brief A double-word number in an expression.
+template <typename Policy, typename T>
+struct terminal : expression<terminal<Policy, T>, Policy, T> {
+  two<T> value;
+
+  explicit terminal(const two<T> &value) : value(value) {}
+
+  two<T> compute() const { return value; }
+};
+
+/// \brief A floating point number in an expression.
+template <typename Policy, typename T>
+struct scalar : expression<scalar<Policy, T>, Policy, T> {
+  T value;
+
+  explicit scalar(T value) : value(value) {}
+
+  two<T> compute() const { return two<T>(value); }
+};
+
+template <typename Op, typename L, typename R>
+struct binary;
+
+/// \brief Whether `E` is an expression.
+template <typename E>
+struct is_expression : std::false_type {};
+template <typename Policy, typename T>
+struct is_expression<terminal<Policy, T>> : std::true_type {};
+template <typename Policy, typename T>
+struct is_expression<scalar<Policy, T>> : std::true_type {};
+template <typename Op, typename L, typename R>
+struct is_expression<binary<Op, L, R>> : std::true_type {};
+template <typename E>
+inline constexpr bool is_expression_v = is_expression<E>::value;
+
+namespace details {
+template <typename E>
+inline constexpr bool isScalar = false;
+template <typename Policy, typename T>
+inline constexpr bool isScalar<scalar<Policy, T>> = true;
+
+template <typename E>
+inline constexpr bool isProduct = false;
+template <typename L, typename R>
+inline constexpr bool isProduct<binary<times, L, R>> = true;
+
+template <typename T>
+inline two<T> negate(const two<T> &x) {
+  return two<T>(-x.h, -x.l);
+}
+
+/// \brief Calculates `±(x * y) + z` for a product `x * y` with `Policy::fma`.
+template <bool negative, typename P, typename L, typename R, typename T>
+inline two<T> fused(const binary<times, L, R> &product, const two<T> &z) {
+  if constexpr (isScalar<R>) {
+    T y = negative ? -product.rhs.value : product.rhs.value;
+    return P::fma(product.lhs.compute(), y, z);
+  } else if constexpr (isScalar<L>) {
+    T y = negative ? -product.lhs.value : product.lhs.value;
+    return P::fma(product.rhs.compute(), y, z);
+  } else if constexpr (negative)
+    return P::fma(negate(product.lhs.compute()), product.rhs.compute(), z);
+  else
+    return P::fma(product.lhs.compute(), product.rhs.compute(), z);
+}
+}  // namespace details
+
+/// \brief A binary operation in an expression.
+/// \tparam Op The operation (`details::plus`, `minus`, `times` or `divides`).
+/// \tparam L The type of the left operand.
+/// \tparam R The type of the right operand.
+template <typename Op, typename L, typename R>
+struct binary : expression<binary<Op, L, R>, typename L::policy,
+                           typename L::value_type> {
+  static_assert(std::is_same_v<typename L::policy, typename R::policy>,
+                "The operands must use the same policy");
+  static_assert(std::is_same_v<typename L::value_type, typename R::value_type>,
+                "The operands must have the same type");
+
+  using P = typename L::policy;
+  using T = typename L::value_type;
+
+  L lhs;
+  R rhs;
+
+  binary(const L &lhs, const R &rhs) : lhs(lhs), rhs(rhs) {}
+
+  /// \brief Calculates the expression without the final normalization.
+  two<T> compute() const {
+    using namespace details;
+    if constexpr (std::is_same_v<Op, plus>) {
+      if constexpr (isProduct<L>)
+        return fused<false, P>(lhs, rhs.compute());
+      else if constexpr (isProduct<R>)
+        return fused<false, P>(rhs, lhs.compute());
+      else if constexpr (isScalar<R>)
+        return P::add(lhs.compute(), rhs.value);
+      else if constexpr (isScalar<L>)
+        return P::add(rhs.compute(), lhs.value);
+      else
+        return P::add(lhs.compute(), rhs.compute());
+    } else if constexpr (std::is_same_v<Op, minus>) {
+      if constexpr (isProduct<L>)
+        return fused<false, P>(lhs, negate(rhs.compute()));
+      else if constexpr (isProduct<R>)
+        return fused<true, P>(rhs, lhs.compute());
+      else if constexpr (isScalar<R>)
+        return P::sub(lhs.compute(), rhs.value);
+      else if constexpr (isScalar<L>)
+        return P::add(negate(rhs.compute()), lhs.value);
+      else
+        return P::sub(lhs.compute(), rhs.compute());
+    } else if constexpr (std::is_same_v<Op, times>) {
+      if constexpr (isScalar<R>)
+        return P::mul(lhs.compute(), rhs.value);
+      else if constexpr (isScalar<L>)
+        return P::mul(rhs.compute(), lhs.value);
+      else
+        return P::mul(lhs.compute(), rhs.compute());
+    } else {
+      if constexpr (isScalar<R>)
+        return P::div(lhs.compute(), rhs.value);
+      else
+        return P::div(lhs.compute(), rhs.compute());
+    }
+  }
+};
+
+/// \brief Wraps a double-word number into an expression that is evaluated
+/// with `Policy`.
+template <typename Policy, typename T>
+inline terminal<Policy, T> lazy(const two<T> &x) {
+  return terminal<Policy, T>(x);
+}
+
+namespace details {
+/// \brief Converts an operand of an operator to an expression of the same
+/// policy and type as `E`.
+template <typename E, typename X>
+inline auto operand(const X &x) {
+  using P = typename E::policy;
+  using T = typename E::value_type;
+  if constexpr (is_expression_v<X>)
+    return x;
+  else if constexpr (std::is_same_v<X, two<T>>)
+    return terminal<P, T>(x);
+  else
+    return scalar<P, T>(T(x));
+}
+
+template <typename L, typename R>
+using expression_t = std::conditional_t<is_expression_v<L>, L, R>;
+
+template <typename L, typename R>
+using enable_if_operands_t =
+    std::enable_if_t<is_expression_v<L> || is_expression_v<R>, int>;
+
+template <typename Op, typename L, typename R>
+inline auto make(const L &x, const R &y) {
+  using E = expression_t<L, R>;
+  auto lhs = operand<E>(x);
+  auto rhs = operand<E>(y);
+  return binary<Op, decltype(lhs), decltype(rhs)>(lhs, rhs);
+}
+}  // namespace details
+
+template <typename L, typename R, details::enable_if_operands_t<L, R> = 0>
+inline auto operator+(const L &x, const R &y) {
+  return details::make<details::plus>(x, y);
+}
+
+template <typename L, typename R, details::enable_if_operands_t<L, R> = 0>
+inline auto operator-(const L &x, const R &y) {
+  return details::make<details::minus>(x, y);
+}
+
+template <typename L, typename R, details::enable_if_operands_t<L, R> = 0>
+inline auto operator*(const L &x, const R &y) {
+  return details::make<details::times>(x, y);
+}
+
+template <typename L, typename R, details::enable_if_operands_t<L, R> = 0>
+inline auto operator/(const L &x, const R &y) {
+  return details::make<details::divides>(x, y);
+}
+
+}  // namespace expr
+}  // namespace twofloat
@@ -0,0 +1,430 @@
+#pragma once
+
+/// \file fft.hpp
+/// \brief Implements fast Fourier transforms of double-word complex vectors.
+
+#include <algorithm>
+#include <cstddef>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/complex.hpp>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/details/double-word-trig-tables.hpp>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace twofloat {
+
+/// \brief Fast Fourier transforms of complex vectors of double-word numbers.
+/// \details A complex vector is stored as a structure of arrays: the real and
+/// the imaginary parts are `soa_span`s, i.e. four arrays of the high and low
+/// words. The forward transform is `X_k = sum_j x_j exp(-2 π i jk / n)`, the
+/// inverse transform uses `exp(2 π i jk / n)` and divides by n, which is exact
+/// for the powers of two that are supported.
+///
+/// The transforms use the self-sorting Stockham algorithm with radix-4 stages
+/// and a final radix-2 stage for odd powers of two, so no bit reversal is
+/// needed. The butterflies are vectorized with the widest instruction set of
+/// the CPU, over consecutive butterflies that share a twiddle factor or, in
+/// the first stages, over consecutive twiddle factors. The twiddle factors are
+/// double-word numbers that are calculated once per size (see `plan::get`).
+/// The results are bitwise identical for any number of threads and any
+/// instruction set. The error is a small multiple of `log2(n) u²` relative
+/// to the largest element.
+namespace fft {
+
+namespace details {
+using twofloat::details::vectorized;
+
+/// \brief The number of butterflies per block of work.
+inline constexpr std::size_t blockButterflies = 1024;
+
+/// \brief Pointers to the arrays of a complex vector.
+template <typename T>
+struct planes {
+  T *rh, *rl, *ih, *il;
+};
+
+/// \brief Whether the twiddle factors of policy `P` are applied with the
+/// fused complex product `doubleword::mul`.
+template <typename P>
+struct fusedTwiddle : std::false_type {};
+template <bool useFMA, doubleword::Mode mulMode, doubleword::Mode addMode>
+struct fusedTwiddle<policy::doubleword<useFMA, mulMode, addMode>>
+    : std::true_type {
+  static constexpr bool fma = useFMA;
+};
+
+template <typename V>
+inline two<V> neg(const two<V> &x) {
+  return two<V>(-x.h, -x.l);
+}
+
+template <typename V, typename T, std::size_t... I>
+inline V loadLanes(const T *x, std::size_t inc, std::index_sequence<I...>) {
+  return V(typename V::native_type{x[I * inc]...});
+}
+
+/// \brief Loads `x[i], x[i + inc], ...` into the lanes of a vector.
+template <typename V, typename T>
+inline V load(const T *x, std::size_t i, std::size_t inc) {
+  if (inc == 1) return V::load(x + i);
+  return loadLanes<V>(x + i, inc, std::make_index_sequence<V::size()>());
+}
+
+template <typename V, typename T>
+inline void store(const V &v, T *x, std::size_t i, std::size_t inc) {
+  if (inc == 1) return v.store(x + i);
+  for (std::size_t k = 0; k < V::size(); ++k) x[i + k * inc] = v[k];
+}
+
+template <typename V, typename T>
+inline complex<V> load(const planes<T> &x, std::size_t i, std::size_t inc) {
+  return {two<V>(load<V>(x.rh, i, inc), load<V>(x.rl, i, inc)),
+          two<V>(load<V>(x.ih, i, inc), load<V>(x.il, i, inc))};
+}
+
+template <typename V, typename T>
+inline void store(const complex<V> &v, const planes<T> &x, std::size_t i,
+                  std::size_t inc) {
+  store(v.re.h, x.rh, i, inc);
+  store(v.re.l, x.rl, i, inc);
+  store(v.im.h, x.ih, i, inc);
+  store(v.im.l, x.il, i, inc);
+}
+
+template <typename P, typename V>
+inline complex<V> add(const complex<V> &x, const complex<V> &y) {
+  return {P::add(x.re, y.re), P::add(x.im, y.im)};
+}
+
+template <typename P, typename V>
+inline complex<V> sub(const complex<V> &x, const complex<V> &y) {
+  return {P::sub(x.re, y.re), P::sub(x.im, y.im)};
+}
+
+/// \brief Multiplies x by the twiddle factor `c - i s`, or by `c + i s` for
+/// the inverse transform, where `w = c + i s`.
+/// \details The double-word policies use the fused complex product, which
+/// normalizes each part once. Otherwise, each part is one product and one
+/// fused multiply-add of the policy.
+template <typename P, bool inverse, typename V>
+inline complex<V> twiddle(const complex<V> &x, const complex<V> &w) {
+  if constexpr (fusedTwiddle<P>::value) {
+    const complex<V> c = inverse ? w : doubleword::conj(w);
+    return doubleword::mul<fusedTwiddle<P>::fma>(x, c);
+  } else {
+    const two<V> s = inverse ? neg(w.im) : w.im;
+    return {P::fma(x.re, w.re, P::mul(x.im, s)),
+            P::fma(x.im, w.re, P::mul(neg(x.re), s))};
+  }
+}
+
+/// \brief Multiplies x by `-i`, or by `i` for the inverse transform.
+template <bool inverse, typename V>
+inline complex<V> rotateQuarter(const complex<V> &x) {
+  if constexpr (inverse)
+    return {neg(x.im), x.re};
+  else
+    return {x.im, neg(x.re)};
+}
+
+/// \brief The twiddle factors of a radix-4 stage, `cos(θ) - i sin(θ)` stored
+/// as `(cos(θ), sin(θ))`.
+template <typename T>
+struct stageTwiddles {
+  const T *ch, *cl, *sh, *sl;
+};
+
+/// \brief Calculates the radix-4 butterflies of a Stockham stage for the
+/// twiddle indices `p` in `[p0, p1)`, with vectors of `W` lanes.
+/// \details The stage reads `x[q + s (p + j m)]` for `j < 4` and writes
+/// `y[q + s (4 p + r)]` for `r < 4`, for all `q < s`. The lanes hold
+/// consecutive `q` if `s >= W`, and consecutive `p` otherwise, which
+/// requires that `p1 - p0` is a multiple of `W`.
+template <typename P, bool inverse, std::size_t W, typename T>
+void radix4(const planes<T> &x, const planes<T> &y,
+            const stageTwiddles<T> &w, std::size_t s, std::size_t m,
+            std::size_t p0, std::size_t p1) {
+  using V = simd<T, W>;
+  auto butterfly = [&](std::size_t p, std::size_t q, std::size_t inc,
+                       std::size_t outInc, const complex<V>(&tw)[3]) {
+    const complex<V> a0 = load<V>(x, q + s * p, inc);
+    const complex<V> a1 = load<V>(x, q + s * (p + m), inc);
+    const complex<V> a2 = load<V>(x, q + s * (p + 2 * m), inc);
+    const complex<V> a3 = load<V>(x, q + s * (p + 3 * m), inc);
+    const complex<V> t0 = add<P>(a0, a2), t1 = sub<P>(a0, a2);
+    const complex<V> t2 = add<P>(a1, a3);
+    const complex<V> t3 = rotateQuarter<inverse>(sub<P>(a1, a3));
+
+    const std::size_t out = q + s * 4 * p;
+    store(add<P>(t0, t2), y, out, outInc);
+    store(twiddle<P, inverse>(add<P>(t1, t3), tw[0]), y, out + s, outInc);
+    store(twiddle<P, inverse>(sub<P>(t0, t2), tw[1]), y, out + 2 * s, outInc);
+    store(twiddle<P, inverse>(sub<P>(t1, t3), tw[2]), y, out + 3 * s, outInc);
+  };
+
+  if (s >= W) {
+    for (std::size_t p = p0; p < p1; ++p) {
+      complex<V> tw[3];
+      for (std::size_t r = 0; r < 3; ++r)
+        tw[r] = {two<V>(V(w.ch[r * m + p]), V(w.cl[r * m + p])),
+                 two<V>(V(w.sh[r * m + p]), V(w.sl[r * m + p]))};
+      for (std::size_t q = 0; q < s; q += W) butterfly(p, q, 1, 1, tw);
+    }
+    return;
+  }
+
+  for (std::size_t p = p0; p < p1; p += W) {
+    complex<V> tw[3];
+    for (std::size_t r = 0; r < 3; ++r)
+      tw[r] = {two<V>(V::load(w.ch + r * m + p), V::load(w.cl + r * m + p)),
+               two<V>(V::load(w.sh + r * m + p), V::load(w.sl + r * m + p))};
+    for (std::size_t q = 0; q < s; ++q) butterfly(p, q, s, 4 * s, tw);
+  }
+}
+
+/// \brief Calculates the butterflies `y[q] = x[q] + x[q + s]` and
+/// `y[q + s] = x[q] - x[q + s]` of the final radix-2 stage for `q` in
+/// `[q0, q1)`, which must be a multiple of `W` apart.
+template <typename P, std::size_t W, typename T>
+void radix2(const planes<T> &x, const planes<T> &y, std::size_t s,
+            std::size_t q0, std::size_t q1) {
+  using V = simd<T, W>;
+  for (std::size_t q = q0; q < q1; q += W) {
+    const complex<V> a = load<V>(x, q, 1), b = load<V>(x, q + s, 1);
+    store(add<P>(a, b), y, q, 1);
+    store(sub<P>(a, b), y, q + s, 1);
+  }
+}
+}  // namespace details
+
+/// \brief The precomputed twiddle factors of the transforms of one size.
+/// \details A plan is immutable, so it can be shared by any number of
+/// threads. `get` returns cached plans, which is what the free functions
+/// `forward` and `inverse` use.
+/// \tparam T The floating point type, `float` or `double`.
+template <typename T>
+class plan {
+ public:
+  /// \brief Calculates the twiddle factors of the transforms of size `n`.
+  /// \details The factors are `exp(-2 π i k / n)` to double-word accuracy.
+  /// Only the first octant is evaluated with `doubleword::sincos`, the others
+  /// follow exactly from symmetries.
+  /// \param n The size of the transforms, a power of two.
+  /// \throws std::invalid_argument if `n` is not a power of two.
+  explicit plan(std::size_t n) : n_(checkSize(n)), radix2_(false) {
+    std::size_t len = n, s = 1, offset = 0;
+    for (; len >= 4; len /= 4, s *= 4) {
+      stages_.push_back({s, len / 4, offset});
+      offset += 3 * (len / 4);
+    }
+    radix2_ = len == 2;
+
+    ch_.resize(offset);
+    cl_.resize(offset);
+    sh_.resize(offset);
+    sl_.resize(offset);
+    const octant roots(n);
+    for (const stage &st : stages_)
+      for (std::size_t r = 1; r <= 3; ++r)
+        for (std::size_t p = 0; p < st.m; ++p) {
+          two<T> c, s;
+          roots(r * p * st.s, c, s);
+          const std::size_t i = st.offset + (r - 1) * st.m + p;
+          ch_[i] = c.h;
+          cl_[i] = c.l;
+          sh_[i] = s.h;
+          sl_[i] = s.l;
+        }
+  }
+
+  /// \brief Returns the plan of size `n`, which is calculated on the first
+  /// call and cached for the lifetime of the program. Thread-safe.
+  static std::shared_ptr<const plan> get(std::size_t n) {
+    static std::mutex mutex;
+    static std::unordered_map<std::size_t, std::shared_ptr<const plan>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const plan> &entry = cache[n];
+    if (!entry) entry = std::make_shared<const plan>(n);
+    return entry;
+  }
+
+  /// \brief Returns the size of the transforms.
+  std::size_t size() const noexcept { return n_; }
+
+  /// \brief Calculates the forward transform in place.
+  /// \param re The real parts, of `size()` elements.
+  /// \param im The imaginary parts, of `size()` elements.
+  /// \param threads The maximum number of threads, 0 for the number of
+  /// hardware threads. The result does not depend on it.
+  /// \throws std::invalid_argument if `re` or `im` do not have `size()`
+  /// elements.
+  /// \tparam Policy The arithmetic (see policy.hpp).
+  template <typename Policy>
+  void forward(soa_span<T> re, soa_span<T> im, unsigned threads = 0) const {
+    transform<Policy, false>(re, im, threads);
+  }
+
+  /// \brief Calculates the inverse transform in place, including the division
+  /// by the size, see `forward`.
+  template <typename Policy>
+  void inverse(soa_span<T> re, soa_span<T> im, unsigned threads = 0) const {
+    transform<Policy, true>(re, im, threads);
+    const T scale = T(1) / static_cast<T>(n_);
+    for (T *a : {re.h_data(), re.l_data(), im.h_data(), im.l_data()})
+      for (std::size_t i = 0; i < n_; ++i) a[i] *= scale;
+  }
+
+ private:
+  static std::size_t checkSize(std::size_t n) {
+    if (n == 0 || (n & (n - 1)) != 0)
+      throw std::invalid_argument("fft::plan: size is not a power of two");
+    return n;
+  }
+
+  /// \brief A radix-4 stage with the stride `s` and the quarter length `m`,
+  /// whose twiddle factors start at `offset`.
+  struct stage {
+    std::size_t s, m, offset;
+  };
+
+  /// \brief Calculates `cos(2 π k / n)` and `sin(2 π k / n)` from a table of
+  /// the first octant.
+  class octant {
+   public:
+    explicit octant(std::size_t n)
+        : n_(std::max<std::size_t>(n, 8)), scale_(n_ / n) {
+      using C = doubleword::details::trigTables<T>;
+      const two<T> halfPi(C::halfPi[0], C::halfPi[1]);
+      c_.resize(n_ / 8 + 1);
+      s_.resize(n_ / 8 + 1);
+      for (std::size_t j = 0; j <= n_ / 8; ++j) {
+        // 2 π j / n = π/2 (4 j / n), where 4 j / n is exact
+        const two<T> x = doubleword::mul<doubleword::Mode::Accurate, true>(
+            halfPi, static_cast<T>(4 * j) / static_cast<T>(n_));
+        doubleword::sincos<true>(x, s_[j], c_[j]);
+      }
+    }
+
+    void operator()(std::size_t k, two<T> &c, two<T> &s) const {
+      const std::size_t quarter = n_ / 4, a = k * scale_ % n_;
+      const std::size_t r = a % quarter;
+      if (2 * r <= quarter) {
+        c = c_[r];
+        s = s_[r];
+      } else {
+        c = s_[quarter - r];
+        s = c_[quarter - r];
+      }
+      // Rotate by the quadrant
+      for (std::size_t q = a / quarter; q > 0; --q)
+        std::swap(c, s), c = details::neg(c);
+    }
+
+   private:
+    std::size_t n_, scale_;
+    std::vector<two<T>> c_, s_;
+  };
+
+  template <typename Policy, bool inverse>
+  void transform(soa_span<T> re, soa_span<T> im, unsigned threads) const {
+    using details::planes;
+    const std::size_t n = n_;
+    if (re.size() != n || im.size() != n)
+      throw std::invalid_argument(
+          "fft::plan: re and im do not have the size of the plan");
+    std::vector<T> buffer(4 * n);
+    planes<T> x{re.h_data(), re.l_data(), im.h_data(), im.l_data()};
+    planes<T> y{buffer.data(), buffer.data() + n, buffer.data() + 2 * n,
+                buffer.data() + 3 * n};
+
+    for (const stage &st : stages_) {
+      const details::stageTwiddles<T> w{ch_.data() + st.offset,
+                                        cl_.data() + st.offset,
+                                        sh_.data() + st.offset,
+                                        sl_.data() + st.offset};
+      // Blocks of p with about blockButterflies butterflies each, which are
+      // powers of two and thus multiples of the number of lanes
+      const std::size_t block =
+          std::min(st.m, std::max<std::size_t>(
+                             1, details::blockButterflies / st.s));
+      twofloat::details::parallelFor(
+          st.m / block, threads, [&](std::size_t b) {
+            details::vectorized<T>([&](auto lanes) {
+              constexpr std::size_t W = decltype(lanes)::value;
+              const std::size_t p0 = b * block, p1 = p0 + block;
+              if (st.s < W && block < W)
+                details::radix4<Policy, inverse, 1>(x, y, w, st.s, st.m, p0,
+                                                    p1);
+              else
+                details::radix4<Policy, inverse, W>(x, y, w, st.s, st.m, p0,
+                                                    p1);
+            });
+          });
+      std::swap(x, y);
+    }
+
+    if (radix2_) {
+      const std::size_t s = n / 2;
+      const std::size_t block = std::min(s, details::blockButterflies);
+      twofloat::details::parallelFor(s / block, threads, [&](std::size_t b) {
+        details::vectorized<T>([&](auto lanes) {
+          constexpr std::size_t W = decltype(lanes)::value;
+          const std::size_t q0 = b * block, q1 = q0 + block;
+          if (block < W)
+            details::radix2<Policy, 1>(x, y, s, q0, q1);
+          else
+            details::radix2<Policy, W>(x, y, s, q0, q1);
+        });
+      });
+      std::swap(x, y);
+    }
+
+    if (x.rh != re.h_data()) {
+      std::copy(x.rh, x.rh + n, re.h_data());
+      std::copy(x.rl, x.rl + n, re.l_data());
+      std::copy(x.ih, x.ih + n, im.h_data());
+      std::copy(x.il, x.il + n, im.l_data());
+    }
+  }
+
+  std::size_t n_;
+  bool radix2_;
+  std::vector<stage> stages_;
+  std::vector<T> ch_, cl_, sh_, sl_;
+};
+
+/// \brief Calculates the forward transform in place with the cached plan of
+/// the size, see `plan::forward`.
+/// \param re The real parts, whose size is a power of two.
+/// \param im The imaginary parts, of the same size as `re`.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads.
+/// \throws std::invalid_argument if the size of `re` is not a power of two or
+/// the sizes of `re` and `im` differ.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+void forward(soa_span<T> re, soa_span<T> im, unsigned threads = 0) {
+  plan<T>::get(re.size())->template forward<Policy>(re, im, threads);
+}
+
+/// \brief Calculates the inverse transform in place with the cached plan of
+/// the size, see `plan::inverse`.
+template <typename Policy, typename T>
+void inverse(soa_span<T> re, soa_span<T> im, unsigned threads = 0) {
+  plan<T>::get(re.size())->template inverse<Policy>(re, im, threads);
+}
+
+}  // namespace fft
+}  // namespace twofloat
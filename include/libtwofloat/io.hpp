@@ -0,0 +1,516 @@
+#pragma once
+
+/// \file io.hpp
+/// \brief Implements a binary file format for arrays of double-word numbers,
+/// with chunked writing and memory-mapped reading.
+/// \details The functions use POSIX I/O (`pwrite`, `mmap`) and report errors
+/// as `std::error_code`, like the conversions in charconv.hpp.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace twofloat {
+namespace io {
+
+/// \brief The order of the words in a file.
+enum class Layout : std::uint32_t {
+  /// The high and low word of each number are adjacent, like in `two<T>`.
+  AoS = 0,
+  /// The high words of all numbers are followed by the low words, like in
+  /// `soa_vector`.
+  SoA = 1
+};
+
+namespace details {
+/// \brief The alignment of the data in a file: a page, which allows to map
+/// the words with their natural alignment, and a multiple of the block size
+/// for `O_DIRECT`.
+inline constexpr std::size_t alignment = 4096;
+
+inline constexpr char magic[8] = {'T', 'W', 'O', 'F', 'L', 'O', 'A', 'T'};
+
+/// \brief The version of the format, incremented on incompatible changes.
+inline constexpr std::uint32_t version = 1;
+
+/// \brief A marker of the byte order of the file, which is that of the
+/// writer.
+inline constexpr std::uint32_t byteOrder = 0x01020304;
+
+/// \brief The header at the start of a file.
+/// \details The high word of number `i` is at `highOffset + i stride` and
+/// the low word at `lowOffset + i stride`, where the stride is `sizeof(T)`
+/// for `Layout::SoA` and `2 sizeof(T)` for `Layout::AoS`. Both offsets of
+/// `Layout::SoA` are multiples of `alignment`. The rest of the first
+/// `alignment` bytes is zero.
+struct header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteOrder;
+  std::uint32_t wordSize;
+  std::uint32_t layout;
+  std::uint64_t count;
+  std::uint64_t highOffset;
+  std::uint64_t lowOffset;
+  std::uint64_t reserved[2];
+};
+static_assert(sizeof(header) == 64);
+
+inline std::uint64_t alignUp(std::uint64_t n) {
+  return (n + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+header makeHeader(std::uint64_t count, Layout layout) {
+  header h{};
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.version = version;
+  h.byteOrder = byteOrder;
+  h.wordSize = sizeof(T);
+  h.layout = static_cast<std::uint32_t>(layout);
+  h.count = count;
+  h.highOffset = alignment;
+  h.lowOffset = layout == Layout::SoA
+                    ? alignUp(alignment + count * sizeof(T))
+                    : alignment + sizeof(T);
+  return h;
+}
+
+/// \brief Returns the size of a file with the header `h`.
+inline std::uint64_t fileSize(const header &h) {
+  return h.layout == static_cast<std::uint32_t>(Layout::SoA)
+             ? h.lowOffset + h.count * h.wordSize
+             : h.highOffset + 2 * h.count * h.wordSize;
+}
+
+inline std::error_code lastError() {
+  return std::error_code(errno, std::generic_category());
+}
+
+/// \brief Writes `n` bytes at `offset`, continuing after partial writes.
+inline std::error_code writeAll(int fd, const void *data, std::size_t n,
+                                std::uint64_t offset) {
+  const char *p = static_cast<const char *>(data);
+  while (n > 0) {
+    const ssize_t w = ::pwrite(fd, p, n, static_cast<off_t>(offset));
+    if (w < 0) {
+      if (errno == EINTR) continue;
+      return lastError();
+    }
+    p += w;
+    n -= static_cast<std::size_t>(w);
+    offset += static_cast<std::uint64_t>(w);
+  }
+  return {};
+}
+
+/// \brief Reads `n` bytes at `offset`, continuing after partial reads.
+inline std::error_code readAll(int fd, void *data, std::size_t n,
+                               std::uint64_t offset) {
+  char *p = static_cast<char *>(data);
+  while (n > 0) {
+    const ssize_t r = ::pread(fd, p, n, static_cast<off_t>(offset));
+    if (r < 0) {
+      if (errno == EINTR) continue;
+      return lastError();
+    }
+    if (r == 0) return std::make_error_code(std::errc::invalid_argument);
+    p += r;
+    n -= static_cast<std::size_t>(r);
+    offset += static_cast<std::uint64_t>(r);
+  }
+  return {};
+}
+
+/// \brief Reads and validates the header of a file of `two<T>`.
+template <typename T>
+std::error_code readHeader(int fd, header &h) {
+  const auto invalid = std::make_error_code(std::errc::invalid_argument);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) return lastError();
+  const std::uint64_t bytes = static_cast<std::uint64_t>(st.st_size);
+  if (bytes < alignment || readAll(fd, &h, sizeof(h), 0)) return invalid;
+  if (std::memcmp(h.magic, magic, sizeof(h.magic)) != 0) return invalid;
+  if (h.version != version || h.byteOrder != byteOrder)
+    return std::make_error_code(std::errc::not_supported);
+  if (h.wordSize != sizeof(T) || h.layout > 1) return invalid;
+  const header expected = makeHeader<T>(h.count, static_cast<Layout>(h.layout));
+  if (h.count > bytes / sizeof(T) || h.highOffset != expected.highOffset ||
+      h.lowOffset != expected.lowOffset || fileSize(h) != bytes)
+    return invalid;
+  return {};
+}
+
+inline void *allocate(std::size_t bytes) {
+  return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+inline void deallocate(void *p) noexcept {
+  if (p) ::operator delete(p, std::align_val_t(alignment));
+}
+}  // namespace details
+
+/// \brief Writes an array of double-word numbers to a file in chunks.
+/// \details The numbers are appended with `write` in chunks of any size and
+/// collected in buffers of `chunkBytes` bytes per word, which are written
+/// with a single `pwrite` each. The header is written last by `close`, so a
+/// file whose writer did not finish is rejected by `mapped_file`. With
+/// `direct`, the file is opened with `O_DIRECT`, which bypasses the page
+/// cache for files that are much larger than the memory; if the file system
+/// does not support it, the writer falls back to buffered I/O (see
+/// `direct()`). `close` does not call `fsync`.
+/// \tparam T The underlying floating point type.
+template <typename T>
+class writer {
+  static_assert(std::is_floating_point_v<T>,
+                "writer supports the built-in floating point types");
+
+ public:
+  /// \brief The default size of the buffer of each word.
+  static constexpr std::size_t defaultChunkBytes = std::size_t(8) << 20;
+
+  writer() = default;
+  writer(const writer &) = delete;
+  writer &operator=(const writer &) = delete;
+
+  /// \brief Closes the file without writing the rest of the data.
+  ~writer() { release(); }
+
+  /// \brief Creates the file `path` for `count` numbers.
+  /// \param path The path of the file, which is truncated if it exists.
+  /// \param count The number of numbers that will be written.
+  /// \param layout The order of the words in the file.
+  /// \param direct Whether to write with `O_DIRECT`.
+  /// \param chunkBytes The size of the buffer of each word, rounded up to a
+  /// multiple of 4096 bytes.
+  std::error_code open(const std::string &path, std::size_t count,
+                       Layout layout = Layout::SoA, bool direct = false,
+                       std::size_t chunkBytes = defaultChunkBytes) {
+    release();
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+    if (direct) {
+      fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+      direct_ = fd_ >= 0;
+      if (fd_ < 0 && errno != EINVAL) return details::lastError();
+    }
+#endif
+    if (fd_ < 0) fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ < 0) return details::lastError();
+
+    header_ = details::makeHeader<T>(count, layout);
+    chunk_ = details::alignUp(std::max<std::size_t>(chunkBytes, 1)) / sizeof(T);
+    if (layout == Layout::AoS) chunk_ /= 2;
+    high_ = static_cast<T *>(details::allocate(2 * chunk_ * sizeof(T)));
+    low_ = high_ + chunk_;
+    return {};
+  }
+
+  /// \brief Appends numbers to the file.
+  /// \details Fails with `std::errc::invalid_argument` without writing if
+  /// the numbers exceed the count given to `open`.
+  std::error_code write(soa_span<const T> values) {
+    return append(values.size(), [&](std::size_t i, T &h, T &l) {
+      h = values.h_data()[i];
+      l = values.l_data()[i];
+    });
+  }
+
+  /// \brief Appends numbers stored as an array of `two<T>`, see above.
+  std::error_code write(span<const two<T>> values) {
+    return append(values.size(), [&](std::size_t i, T &h, T &l) {
+      h = values[i].h;
+      l = values[i].l;
+    });
+  }
+
+  /// \brief Writes the remaining data and the header, and closes the file.
+  /// \details Fails with `std::errc::invalid_argument` if fewer numbers
+  /// were written than announced, in which case the file is left without a
+  /// header.
+  std::error_code close() {
+    if (fd_ < 0) return std::make_error_code(std::errc::bad_file_descriptor);
+    std::error_code ec = flush();
+    if (!ec && written_ != header_.count)
+      ec = std::make_error_code(std::errc::invalid_argument);
+    if (!ec) {
+      char *block = static_cast<char *>(details::allocate(details::alignment));
+      std::memset(block, 0, details::alignment);
+      std::memcpy(block, &header_, sizeof(header_));
+      ec = details::writeAll(fd_, block, details::alignment, 0);
+      details::deallocate(block);
+    }
+    // The last chunk of O_DIRECT writes is padded to the block size
+    if (!ec && ::ftruncate(fd_, static_cast<off_t>(details::fileSize(
+                                    header_))) != 0)
+      ec = details::lastError();
+    if (::close(fd_) != 0 && !ec) ec = details::lastError();
+    fd_ = -1;
+    release();
+    return ec;
+  }
+
+  /// \brief Whether the file is written with `O_DIRECT`.
+  bool direct() const { return direct_; }
+
+  /// \brief Returns the number of numbers written so far.
+  std::size_t written() const { return written_; }
+
+ private:
+  template <typename Get>
+  std::error_code append(std::size_t n, const Get &get) {
+    if (fd_ < 0) return std::make_error_code(std::errc::bad_file_descriptor);
+    if (n > header_.count - written_)
+      return std::make_error_code(std::errc::invalid_argument);
+    const bool soa = header_.layout == static_cast<std::uint32_t>(Layout::SoA);
+    for (std::size_t i = 0; i < n;) {
+      const std::size_t m = std::min(n - i, chunk_ - buffered_);
+      if (soa)
+        for (std::size_t j = 0; j < m; ++j)
+          get(i + j, high_[buffered_ + j], low_[buffered_ + j]);
+      else
+        for (std::size_t j = 0; j < m; ++j)
+          get(i + j, high_[2 * (buffered_ + j)],
+              high_[2 * (buffered_ + j) + 1]);
+      buffered_ += m;
+      written_ += m;
+      i += m;
+      if (buffered_ == chunk_)
+        if (std::error_code ec = flush()) return ec;
+    }
+    return {};
+  }
+
+  /// \brief Writes the buffers at the position of the numbers in the file.
+  std::error_code flush() {
+    if (buffered_ == 0) return {};
+    const std::uint64_t first = written_ - buffered_;
+    const bool soa = header_.layout == static_cast<std::uint32_t>(Layout::SoA);
+    // With O_DIRECT, the last chunk is padded to the block size. The
+    // padding of the high words ends before the low words.
+    std::size_t bytes = (soa ? 1 : 2) * buffered_ * sizeof(T);
+    if (direct_) {
+      const std::size_t padded = details::alignUp(bytes);
+      std::memset(reinterpret_cast<char *>(high_) + bytes, 0, padded - bytes);
+      if (soa)
+        std::memset(reinterpret_cast<char *>(low_) + bytes, 0, padded - bytes);
+      bytes = padded;
+    }
+    std::error_code ec;
+    if (soa) {
+      ec = details::writeAll(fd_, high_, bytes,
+                             header_.highOffset + first * sizeof(T));
+      if (!ec)
+        ec = details::writeAll(fd_, low_, bytes,
+                               header_.lowOffset + first * sizeof(T));
+    } else {
+      ec = details::writeAll(fd_, high_, bytes,
+                             header_.highOffset + 2 * first * sizeof(T));
+    }
+    buffered_ = 0;
+    return ec;
+  }
+
+  void release() noexcept {
+    if (fd_ >= 0) ::close(fd_);
+    details::deallocate(high_);
+    fd_ = -1;
+    high_ = low_ = nullptr;
+    direct_ = false;
+    chunk_ = buffered_ = written_ = 0;
+  }
+
+  int fd_ = -1;
+  bool direct_ = false;
+  details::header header_{};
+  std::size_t chunk_ = 0;
+  std::size_t buffered_ = 0;
+  std::size_t written_ = 0;
+  T *high_ = nullptr;
+  T *low_ = nullptr;
+};
+
+/// \brief A read-only memory mapping of a file written by `writer`.
+/// \details The words are accessed in place, without copying or converting
+/// them: `planes()` returns the high and low words of a `Layout::SoA` file
+/// as a `soa_span`, which can be passed to the batched and BLAS operations,
+/// and `numbers()` the numbers of a `Layout::AoS` file. The pages are read
+/// from the disk when they are first accessed. `open` fails with
+/// `std::errc::invalid_argument` if the file is not a complete file of
+/// `two<T>`, and with `std::errc::not_supported` if it was written with
+/// another version or byte order.
+/// \tparam T The underlying floating point type.
+template <typename T>
+class mapped_file {
+  static_assert(std::is_floating_point_v<T>,
+                "mapped_file supports the built-in floating point types");
+
+ public:
+  mapped_file() = default;
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  mapped_file(mapped_file &&other) noexcept { swap(other); }
+
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    if (this != &other) {
+      close();
+      swap(other);
+    }
+    return *this;
+  }
+
+  ~mapped_file() { close(); }
+
+  /// \brief Maps the file `path`.
+  std::error_code open(const std::string &path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return details::lastError();
+    std::error_code ec = map(fd);
+    ::close(fd);
+    return ec;
+  }
+
+  /// \brief Unmaps the file. The spans become invalid.
+  void close() noexcept {
+    if (data_) ::munmap(data_, bytes_);
+    data_ = nullptr;
+    bytes_ = 0;
+    header_ = details::header{};
+  }
+
+  /// \brief Whether a file is mapped.
+  bool is_open() const { return data_ != nullptr; }
+
+  /// \brief Returns the number of numbers in the file.
+  std::size_t size() const { return header_.count; }
+
+  /// \brief Returns the order of the words in the file.
+  Layout layout() const { return static_cast<Layout>(header_.layout); }
+
+  /// \brief Returns the words of a `Layout::SoA` file, or an empty span for
+  /// other files.
+  soa_span<const T> planes() const {
+    if (!data_ || layout() != Layout::SoA) return {};
+    return {word(header_.highOffset), word(header_.lowOffset), size()};
+  }
+
+  /// \brief Returns the numbers of a `Layout::AoS` file, or an empty span
+  /// for other files.
+  span<const two<T>> numbers() const {
+    if (!data_ || layout() != Layout::AoS) return {};
+    static_assert(sizeof(two<T>) == 2 * sizeof(T));
+    return {reinterpret_cast<const two<T> *>(word(header_.highOffset)),
+            size()};
+  }
+
+  /// \brief Returns the number `i` in either layout.
+  two<T> operator[](std::size_t i) const {
+    const std::size_t stride = layout() == Layout::SoA ? 1 : 2;
+    return two<T>(word(header_.highOffset)[i * stride],
+                  word(header_.lowOffset)[i * stride]);
+  }
+
+  /// \brief Advises the kernel that the file will be read sequentially,
+  /// which increases the read-ahead.
+  void advise_sequential() const {
+    if (data_) ::madvise(data_, bytes_, MADV_SEQUENTIAL);
+  }
+
+ private:
+  std::error_code map(int fd) {
+    details::header h;
+    if (std::error_code ec = details::readHeader<T>(fd, h)) return ec;
+    const std::size_t bytes = details::fileSize(h);
+    void *p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) return details::lastError();
+    data_ = p;
+    bytes_ = bytes;
+    header_ = h;
+    return {};
+  }
+
+  const T *word(std::uint64_t offset) const {
+    return reinterpret_cast<const T *>(static_cast<const char *>(data_) +
+                                       offset);
+  }
+
+  void swap(mapped_file &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(header_, other.header_);
+  }
+
+  void *data_ = nullptr;
+  std::size_t bytes_ = 0;
+  details::header header_{};
+};
+
+/// \brief Writes an array of double-word numbers to the file `path`, see
+/// `writer`.
+template <typename T>
+std::error_code save(const std::string &path, soa_span<const T> values,
+                     Layout layout = Layout::SoA, bool direct = false) {
+  writer<T> w;
+  if (std::error_code ec = w.open(path, values.size(), layout, direct))
+    return ec;
+  if (std::error_code ec = w.write(values)) return ec;
+  return w.close();
+}
+
+/// \brief Reads the numbers of the file `path` into `values`, in either
+/// layout.
+/// \details The words of a `Layout::SoA` file are read with one `pread` per
+/// word directly into `values`, without conversion, so that reading is
+/// bounded by the bandwidth of the disk. The words of a `Layout::AoS` file are
+/// read in chunks and separated. On error, `values` is not modified.
+template <typename T>
+std::error_code load(const std::string &path, soa_vector<T> &values) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return details::lastError();
+  details::header h;
+  std::error_code ec = details::readHeader<T>(fd, h);
+  soa_vector<T> result;
+  if (!ec) result.resize(h.count);
+  if (!ec && h.layout == static_cast<std::uint32_t>(Layout::SoA)) {
+    ec = details::readAll(fd, result.h_data(), h.count * sizeof(T),
+                          h.highOffset);
+    if (!ec)
+      ec = details::readAll(fd, result.l_data(), h.count * sizeof(T),
+                            h.lowOffset);
+  } else if (!ec) {
+    const std::size_t chunk = writer<T>::defaultChunkBytes / sizeof(T) / 2;
+    std::vector<T> buffer(2 * chunk);
+    for (std::size_t i = 0; i < h.count && !ec; i += chunk) {
+      const std::size_t m = std::min<std::size_t>(chunk, h.count - i);
+      ec = details::readAll(fd, buffer.data(), 2 * m * sizeof(T),
+                            h.highOffset + 2 * i * sizeof(T));
+      for (std::size_t j = 0; j < m && !ec; ++j) {
+        result.h_data()[i + j] = buffer[2 * j];
+        result.l_data()[i + j] = buffer[2 * j + 1];
+      }
+    }
+  }
+  ::close(fd);
+  if (!ec) values = std::move(result);
+  return ec;
+}
+
+}  // namespace io
+}  // namespace twofloat
@@ -0,0 +1,299 @@
+#pragma once
+
+/// \file ir.hpp
+/// \brief Implements the solution of linear systems to double-word accuracy
+/// with mixed-precision iterative refinement.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/blas.hpp>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace twofloat {
+
+/// \brief Solution of linear systems with iterative refinement.
+/// \details The matrix is factorized once in the working precision `T` (e.g.
+/// `double`), which costs O(N^3) operations of `T`. The solution is then
+/// refined with the residuals `b - A x`, which are calculated with the
+/// double-word `blas::gemv` in O(N^2) double-word operations, and corrections
+/// that are solved with the factorization. Each step gains about
+/// `-log10(cond(A) u)` digits, until the solution is accurate to the
+/// double-word precision. For matrices that are large enough, the cost is
+/// therefore about that of a solve in `T`.
+namespace ir {
+
+namespace details {
+/// \brief Calculates `row[c] -= l * u[c]` for `c` in `[begin, end)` with
+/// vectors of `W` lanes.
+template <std::size_t W, typename T>
+inline void eliminate(T *row, T l, const T *u, std::size_t begin,
+                      std::size_t end) {
+  using V = simd<T, W>;
+  const V lv(l);
+  std::size_t c = begin;
+  for (; c + W <= end; c += W)
+    (V::load(row + c) - lv * V::load(u + c)).store(row + c);
+  for (; c < end; ++c) row[c] -= l * u[c];
+}
+
+/// \brief Eliminates the rows `[k0, k1)` of `a` from the rows `[i0, i1)`, in
+/// the columns `[c0, n)`.
+template <std::size_t W, typename T>
+void eliminateRows(T *a, std::size_t n, std::size_t i0, std::size_t i1,
+                   std::size_t k0, std::size_t k1, std::size_t c0) {
+  for (std::size_t i = i0; i < i1; ++i)
+    for (std::size_t k = k0; k < k1; ++k)
+      eliminate<W>(a + i * n, a[i * n + k], a + k * n, c0, n);
+}
+}  // namespace details
+
+/// \brief The LU factorization `P A = L U` of a square matrix with partial
+/// pivoting, in the floating point type `T`.
+/// \details The factorization is blocked: a panel of `blockSize` columns is
+/// factorized, the corresponding rows of U are solved, and the trailing
+/// matrix is updated in parallel over blocks of rows with the vector
+/// instructions of the CPU. The results do not depend on the number of
+/// threads.
+template <typename T>
+class lu {
+ public:
+  /// \brief The number of columns of a panel.
+  static constexpr std::size_t blockSize = 64;
+
+  /// \brief Factorizes the matrix A, rounded to `T`.
+  /// \param N The order of A.
+  /// \param A The N x N matrix A in row-major order.
+  /// \param lda The leading dimension of A, at least N.
+  /// \param threads The maximum number of threads, 0 for the number of
+  /// hardware threads. The result does not depend on it.
+  /// \throws std::invalid_argument if `lda` is less than N.
+  lu(std::size_t N, const two<T> *A, std::size_t lda, unsigned threads = 0)
+      : n_(checkOrder(N, lda)), a_(N * N), pivots_(N), singular_(false) {
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < N; ++j) a_[i * N + j] = A[i * lda + j].eval();
+    factorize(threads);
+  }
+
+  /// \brief Returns the order of the matrix.
+  std::size_t size() const noexcept { return n_; }
+
+  /// \brief Returns whether a pivot is zero, in which case `solve` divides by
+  /// zero.
+  bool singular() const noexcept { return singular_; }
+
+  /// \brief Solves `A x = b` in place.
+  /// \param x On entry the right-hand side b, on exit the solution x, of
+  /// `size()` elements.
+  void solve(T *x) const {
+    const std::size_t n = n_;
+    const T *a = a_.data();
+    for (std::size_t j = 0; j < n; ++j) std::swap(x[j], x[pivots_[j]]);
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < i; ++j) x[i] -= a[i * n + j] * x[j];
+    for (std::size_t i = n; i-- > 0;) {
+      for (std::size_t j = i + 1; j < n; ++j) x[i] -= a[i * n + j] * x[j];
+      x[i] /= a[i * n + i];
+    }
+  }
+
+ private:
+  static std::size_t checkOrder(std::size_t N, std::size_t lda) {
+    if (lda < N)
+      throw std::invalid_argument("ir::lu: lda is less than the order");
+    return N;
+  }
+
+  void factorize(unsigned threads) {
+    const std::size_t n = n_;
+    T *a = a_.data();
+    for (std::size_t k0 = 0; k0 < n; k0 += blockSize) {
+      const std::size_t k1 = std::min(n, k0 + blockSize);
+
+      // Panel: the columns [k0, k1), with whole rows swapped
+      for (std::size_t j = k0; j < k1; ++j) {
+        std::size_t p = j;
+        for (std::size_t i = j + 1; i < n; ++i)
+          if (std::abs(a[i * n + j]) > std::abs(a[p * n + j])) p = i;
+        pivots_[j] = p;
+        if (p != j) std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+
+        const T pivot = a[j * n + j];
+        if (pivot == 0) {
+          // The column below the pivot is zero as well
+          singular_ = true;
+          continue;
+        }
+        for (std::size_t i = j + 1; i < n; ++i) {
+          a[i * n + j] /= pivot;
+          for (std::size_t c = j + 1; c < k1; ++c)
+            a[i * n + c] -= a[i * n + j] * a[j * n + c];
+        }
+      }
+
+      // The rows [k0, k1) of U, and the trailing matrix in blocks of rows
+      twofloat::details::vectorized<T>([&](auto w) {
+        for (std::size_t j = k0; j < k1; ++j)
+          details::eliminateRows<decltype(w)::value>(a, n, j + 1, k1, j, j + 1,
+                                                     k1);
+      });
+      const std::size_t blocks = (n - k1 + blockSize - 1) / blockSize;
+      twofloat::details::parallelFor(blocks, threads, [&](std::size_t b) {
+        const std::size_t i0 = k1 + b * blockSize;
+        const std::size_t i1 = std::min(n, i0 + blockSize);
+        twofloat::details::vectorized<T>([&](auto w) {
+          details::eliminateRows<decltype(w)::value>(a, n, i0, i1, k0, k1, k1);
+        });
+      });
+    }
+  }
+
+  std::size_t n_;
+  std::vector<T> a_;
+  std::vector<std::size_t> pivots_;
+  bool singular_;
+};
+
+/// \brief The outcome of an iterative refinement.
+struct result {
+  /// \brief The number of refinement steps, i.e. of residuals.
+  std::size_t iterations = 0;
+
+  /// \brief Whether the refinement reached the tolerance, or stagnated at a
+  /// correction below the precision of `T`, i.e. at the accuracy that the
+  /// double-word residuals allow.
+  bool converged = false;
+
+  /// \brief The size of the last correction relative to the solution, in the
+  /// maximum norm.
+  double correction = 0;
+};
+
+/// \brief Solves linear systems with a cached factorization and iterative
+/// refinement.
+/// \details The factorization is calculated once in the constructor and
+/// reused for every right-hand side. The solver refers to the matrix for the
+/// residuals, so the matrix must outlive it and must not change.
+///
+/// The refinement stops when the correction is below `tolerance` relative to
+/// the solution, when a correction does not halve the previous one (the
+/// solution does not improve any more), or after `maxIterations` steps. Since
+/// the residuals have rounding errors of the double-word precision, the
+/// corrections of an ill-conditioned matrix stagnate at about `cond(A)`
+/// times this precision, which is also the accuracy of the solution.
+/// \tparam T The floating point type of the factorization.
+/// \tparam Policy The double-word arithmetic of the residuals and of the
+/// solution (see policy.hpp).
+template <typename T, typename Policy>
+class solver {
+ public:
+  /// \brief The default tolerance of the relative correction, the unit
+  /// roundoff of the double-word numbers.
+  static constexpr T defaultTolerance =
+      std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+  /// \brief Factorizes the matrix A, see `lu`.
+  /// \param N The order of A.
+  /// \param A The N x N matrix A in row-major order.
+  /// \param lda The leading dimension of A, at least N.
+  /// \param threads The maximum number of threads for the factorization and
+  /// the residuals, 0 for the number of hardware threads.
+  /// \throws std::invalid_argument if `lda` is less than N.
+  solver(std::size_t N, const two<T> *A, std::size_t lda,
+         unsigned threads = 0)
+      : A_(A), lda_(lda), threads_(threads), lu_(N, A, lda, threads) {}
+
+  /// \brief Returns the factorization.
+  const lu<T> &factorization() const noexcept { return lu_; }
+
+  /// \brief Solves `A x = b`.
+  /// \param b The right-hand side, of N elements.
+  /// \param x The solution, of N elements.
+  /// \param maxIterations The maximum number of refinement steps.
+  /// \param tolerance The relative size of the correction at which the
+  /// solution is accurate enough.
+  /// \throws std::invalid_argument if `b` or `x` do not have N elements.
+  result solve(span<const two<T>> b, span<two<T>> x,
+               std::size_t maxIterations = 10,
+               T tolerance = defaultTolerance) const {
+    const std::size_t n = lu_.size();
+    if (b.size() != n || x.size() != n)
+      throw std::invalid_argument(
+          "ir::solver: b and x do not have the order of the matrix");
+    std::vector<T> d(n);
+    std::vector<two<T>> ax(n);
+
+    for (std::size_t i = 0; i < n; ++i) d[i] = b[i].eval();
+    lu_.solve(d.data());
+    for (std::size_t i = 0; i < n; ++i) x[i] = two<T>(d[i]);
+
+    result res;
+    T previous = std::numeric_limits<T>::infinity();
+    while (!lu_.singular() && res.iterations < maxIterations) {
+      blas::gemv<Policy>(n, n, A_, lda_, x.data(), 1, ax.data(), 1, threads_);
+      for (std::size_t i = 0; i < n; ++i)
+        d[i] = Policy::sub(b[i], ax[i]).eval();
+      // The solution is exact, e.g. for b = 0, and the relative correction
+      // would be 0 / 0
+      if (std::all_of(d.begin(), d.end(), [](T r) { return r == 0; })) {
+        ++res.iterations;
+        res.converged = true;
+        break;
+      }
+      lu_.solve(d.data());
+
+      T correction = 0, norm = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        x[i] = Policy::normalize(Policy::add(x[i], d[i]));
+        correction = std::max(correction, std::abs(d[i]));
+        norm = std::max(norm, std::abs(x[i].h));
+      }
+      ++res.iterations;
+      res.correction = static_cast<double>(correction / norm);
+
+      if (correction <= tolerance * norm) {
+        res.converged = true;
+        break;
+      }
+      // The corrections stagnate at the accuracy that the residuals allow,
+      // or the refinement diverges (also for NaN)
+      if (!(correction <= previous / 2)) {
+        res.converged = correction <= std::numeric_limits<T>::epsilon() * norm;
+        break;
+      }
+      previous = correction;
+    }
+    return res;
+  }
+
+ private:
+  const two<T> *A_;
+  std::size_t lda_;
+  unsigned threads_;
+  lu<T> lu_;
+};
+
+/// \brief Solves `A x = b` with iterative refinement, see `solver`.
+/// \param A The square matrix A with `b.size()` rows in row-major order.
+/// \param lda The leading dimension of A, at least `b.size()`.
+/// \param b The right-hand side.
+/// \param x The solution, of the same size as `b`.
+/// \throws std::invalid_argument if `lda` is less than `b.size()` or the
+/// sizes of `b` and `x` differ.
+/// \tparam Policy The double-word arithmetic (see policy.hpp).
+template <typename Policy, typename T>
+result solve(const two<T> *A, std::size_t lda,
+             span<const two<twofloat::details::identity_t<T>>> b,
+             span<two<twofloat::details::identity_t<T>>> x) {
+  return solver<T, Policy>(b.size(), A, lda).solve(b, x);
+}
+
+}  // namespace ir
+}  // namespace twofloat
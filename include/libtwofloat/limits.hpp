@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <libtwofloat/twofloat.hpp>
 #include <limits>
 #include <type_traits>
@@ -28,4 +29,31 @@ class numeric_limits<::twofloat::two<T>> : public numeric_limits<T> {
     return numeric_limits<T>::epsilon() * numeric_limits<T>::epsilon();
   }
 };
+
+/// \brief Specialization of std::numeric_limits for
+/// twofloat::expansion<T, N>, which includes twofloat::four<T>.
+template <typename T, std::size_t N>
+class numeric_limits<::twofloat::expansion<T, N>> : public numeric_limits<T> {
+  // Make sure that T is a floating point type
+  static_assert(
+      is_floating_point<T>::value,
+      "twofloat::expansion<T, N> can only be specialized with a floating "
+      "point type.");
+
+ public:
+  /// \brief number of radix digits that can be represented without change
+  static constexpr int digits = numeric_limits<T>::digits * int(N);
+
+  /// \brief number of decimal digits that can be represented without change
+  /// \details Calculated as floor(digits * log10(2))
+  static constexpr int digits10 = (int)((digits - 1) * 0.30102999566);
+
+  /// \brief returns the difference between 1.0 and the next representable value
+  /// of the given floating-point type, the N-th power of the epsilon of T
+  static constexpr T epsilon() noexcept {
+    T e = 1;
+    for (std::size_t i = 0; i < N; ++i) e *= numeric_limits<T>::epsilon();
+    return e;
+  }
+};
 }  // namespace std
\ No newline at end of file
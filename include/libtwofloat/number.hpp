@@ -0,0 +1,238 @@
+#pragma once
+
+/// \file number.hpp
+/// \brief Implements a double-word number type with operator overloads.
+
+#include <cmath>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <type_traits>
+
+namespace twofloat {
+
+/// \brief A double-word number whose operators use the arithmetic selected by
+/// a policy.
+/// \details The arithmetics do not define operators for `two<T>`, because
+/// they implement several algorithms for most operations. `number` fixes the
+/// algorithms at compile time with a policy (see policy.hpp), so that generic
+/// code written for the built-in floating point types can run on double-word
+/// numbers. Each operator is an inline call to the policy and compiles to the
+/// same code as calling the arithmetic directly.
+///
+/// With `policy::pair`, the results are not normalized, and faithful rounding
+/// is only guaranteed for a limited number of operations (see
+/// pair-tracked.hpp). The comparison operators normalize their operands.
+/// \tparam T The underlying floating point type or vector.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename T, typename Policy>
+struct number {
+  /// \brief The double-word number.
+  two<T> value;
+
+  /// \brief Default constructor, zero.
+  number() : value() {}
+
+  /// \brief Constructs an instance from an arithmetic value. A value with more
+  /// precision than `T` is split into a high and a low word.
+  /// \details Integers are added in pieces of 16 bits, which are exact in
+  /// `T`, since the high word may round to a value outside of the range of
+  /// `U` (e.g. `INT_MAX` to 2^31 in `float`).
+  template <typename U, std::enable_if_t<std::is_arithmetic_v<U>, int> = 0>
+  number(U x) {
+    if constexpr (std::is_same_v<U, bool>) {
+      value = two<T>(static_cast<T>(x));
+    } else if constexpr (std::is_integral_v<U>) {
+      using W = std::make_unsigned_t<U>;
+      const W m = x < 0 ? W(W(0) - W(x)) : W(x);
+      for (int shift = (std::numeric_limits<W>::digits - 1) / 16 * 16;
+           shift >= 0; shift -= 16) {
+        const T piece = static_cast<T>(m & (W(0xffffu) << shift));
+        value = x < 0 ? doubleword::sub(value, piece)
+                      : doubleword::add(value, piece);
+      }
+    } else {
+      T h = static_cast<T>(x);
+      value = two<T>(h, static_cast<T>(x - static_cast<U>(h)));
+    }
+  }
+
+  /// \brief Constructs an instance from a floating point number or vector.
+  number(T x) : value(x) {}
+
+  /// \brief Constructs an instance from a double-word number.
+  explicit number(const two<T> &x) : value(x) {}
+
+  /// \brief Returns the normalized double-word number.
+  two<T> normalized() const { return Policy::normalize(value); }
+
+  /// \brief Evaluates the number to a single floating point number.
+  explicit operator T() const { return value.eval(); }
+
+  number &operator+=(const number &y) {
+    value = Policy::add(value, y.value);
+    return *this;
+  }
+  number &operator+=(T y) {
+    value = Policy::add(value, y);
+    return *this;
+  }
+
+  number &operator-=(const number &y) {
+    value = Policy::sub(value, y.value);
+    return *this;
+  }
+  number &operator-=(T y) {
+    value = Policy::sub(value, y);
+    return *this;
+  }
+
+  number &operator*=(const number &y) {
+    value = Policy::mul(value, y.value);
+    return *this;
+  }
+  number &operator*=(T y) {
+    value = Policy::mul(value, y);
+    return *this;
+  }
+
+  number &operator/=(const number &y) {
+    value = Policy::div(value, y.value);
+    return *this;
+  }
+  number &operator/=(T y) {
+    value = Policy::div(value, y);
+    return *this;
+  }
+};
+
+template <typename T, typename Policy>
+inline number<T, Policy> operator+(const number<T, Policy> &x) {
+  return x;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator-(const number<T, Policy> &x) {
+  return number<T, Policy>(two<T>(-x.value.h, -x.value.l));
+}
+
+template <typename T, typename Policy>
+inline number<T, Policy> operator+(number<T, Policy> x,
+                                   const number<T, Policy> &y) {
+  return x += y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator+(number<T, Policy> x,
+                                   std::common_type_t<T> y) {
+  return x += y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator+(std::common_type_t<T> x,
+                                   number<T, Policy> y) {
+  return y += x;
+}
+
+template <typename T, typename Policy>
+inline number<T, Policy> operator-(number<T, Policy> x,
+                                   const number<T, Policy> &y) {
+  return x -= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator-(number<T, Policy> x,
+                                   std::common_type_t<T> y) {
+  return x -= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator-(std::common_type_t<T> x,
+                                   const number<T, Policy> &y) {
+  return -y + x;
+}
+
+template <typename T, typename Policy>
+inline number<T, Policy> operator*(number<T, Policy> x,
+                                   const number<T, Policy> &y) {
+  return x *= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator*(number<T, Policy> x,
+                                   std::common_type_t<T> y) {
+  return x *= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator*(std::common_type_t<T> x,
+                                   number<T, Policy> y) {
+  return y *= x;
+}
+
+template <typename T, typename Policy>
+inline number<T, Policy> operator/(number<T, Policy> x,
+                                   const number<T, Policy> &y) {
+  return x /= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator/(number<T, Policy> x,
+                                   std::common_type_t<T> y) {
+  return x /= y;
+}
+template <typename T, typename Policy>
+inline number<T, Policy> operator/(std::common_type_t<T> x,
+                                   const number<T, Policy> &y) {
+  return number<T, Policy>(x) /= y;
+}
+
+namespace details {
+/// \brief Returns the normalized words of `x` for the comparisons.
+/// \details Normalized double-word numbers are unique, so they can be compared
+/// by their high words and then by their low words. Infinities are compared
+/// by their high words, since `FastTwoSum` makes their low words NaN, and
+/// also their high words in the normalization of the pair arithmetic. A NaN
+/// low word makes the number NaN.
+template <typename T, typename Policy>
+inline two<T> comparable(const number<T, Policy> &x) {
+  if (std::isinf(x.value.h)) return two<T>(x.value.h, T(0));
+  two<T> a = x.normalized();
+  if (std::isinf(a.h))
+    a.l = 0;
+  else if (std::isnan(a.l))
+    a.h = a.l;
+  return a;
+}
+}  // namespace details
+
+// The comparisons follow IEEE 754: every comparison with NaN is false,
+// except for `!=`
+template <typename T, typename Policy>
+inline bool operator==(const number<T, Policy> &x, const number<T, Policy> &y) {
+  const two<T> a = details::comparable(x), b = details::comparable(y);
+  return a.h == b.h && a.l == b.l;
+}
+template <typename T, typename Policy>
+inline bool operator!=(const number<T, Policy> &x, const number<T, Policy> &y) {
+  return !(x == y);
+}
+template <typename T, typename Policy>
+inline bool operator<(const number<T, Policy> &x, const number<T, Policy> &y) {
+  const two<T> a = details::comparable(x), b = details::comparable(y);
+  return a.h < b.h || (a.h == b.h && a.l < b.l);
+}
+template <typename T, typename Policy>
+inline bool operator<=(const number<T, Policy> &x, const number<T, Policy> &y) {
+  const two<T> a = details::comparable(x), b = details::comparable(y);
+  return a.h < b.h || (a.h == b.h && a.l <= b.l);
+}
+template <typename T, typename Policy>
+inline bool operator>(const number<T, Policy> &x, const number<T, Policy> &y) {
+  return y < x;
+}
+template <typename T, typename Policy>
+inline bool operator>=(const number<T, Policy> &x, const number<T, Policy> &y) {
+  return y <= x;
+}
+
+/// \brief Returns the absolute value of a number.
+template <typename T, typename Policy>
+inline number<T, Policy> abs(const number<T, Policy> &x) {
+  two<T> a = x.normalized();
+  return a.h < 0 ? -x : x;
+}
+
+}  // namespace twofloat
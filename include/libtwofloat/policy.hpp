@@ -0,0 +1,149 @@
+#pragma once
+
+/// \file policy.hpp
+/// \brief Implements policy types that select the arithmetic and the
+/// algorithms used by generic code.
+/// \details The arithmetics select their algorithms with template parameters
+/// at each call (e.g. `doubleword::mul<Mode::Fast, true>`). Generic code such
+/// as the polynomial evaluation in poly.hpp takes a policy instead, which
+/// fixes these choices once. A policy provides the static member functions
+/// `add`, `sub`, `mul` and `div` for two double-word operands and for a
+/// double-word and a floating point operand, `fma`, which calculates
+/// `x * y + z` for a double-word or floating point `y`, and `normalize`, which
+/// normalizes the result of a chain of operations.
+
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/twofloat.hpp>
+
+namespace twofloat {
+namespace policy {
+namespace dw = ::twofloat::doubleword;
+namespace pw = ::twofloat::pair;
+
+/// \brief Selects the double-word arithmetic.
+/// \details All results are normalized, so `normalize` does nothing. `fma`
+/// normalizes only once, see `doubleword::fma`.
+/// \tparam useFMA Whether to use FMA instructions.
+/// \tparam mulMode The mode of the multiplication (fast or accurate). Without
+/// FMA, only the fast mode is supported.
+/// \tparam addMode The mode of the addition and subtraction (sloppy or
+/// accurate).
+template <bool useFMA, dw::Mode mulMode = dw::Mode::Fast,
+          dw::Mode addMode = dw::Mode::Accurate>
+struct doubleword {
+  static_assert(mulMode == dw::Mode::Fast || useFMA,
+                "Only fast mode is supported without FMA");
+
+  template <typename T>
+  static two<T> add(const two<T> &x, const two<T> &y) {
+    return dw::add<addMode>(x, y);
+  }
+  template <typename T>
+  static two<T> add(const two<T> &x, T y) {
+    return dw::add(x, y);
+  }
+
+  template <typename T>
+  static two<T> sub(const two<T> &x, const two<T> &y) {
+    return dw::sub<addMode>(x, y);
+  }
+  template <typename T>
+  static two<T> sub(const two<T> &x, T y) {
+    return dw::sub(x, y);
+  }
+
+  template <typename T>
+  static two<T> mul(const two<T> &x, const two<T> &y) {
+    return dw::mul<mulMode, useFMA>(x, y);
+  }
+  template <typename T>
+  static two<T> mul(const two<T> &x, T y) {
+    return dw::mul<mulMode, useFMA>(x, y);
+  }
+
+  template <typename T>
+  static two<T> div(const two<T> &x, const two<T> &y) {
+    return dw::div<dw::Mode::Fast, useFMA>(x, y);
+  }
+  template <typename T>
+  static two<T> div(const two<T> &x, T y) {
+    return dw::div<useFMA>(x, y);
+  }
+
+  template <typename T>
+  static two<T> fma(const two<T> &x, const two<T> &y, const two<T> &z) {
+    return dw::fma<mulMode, addMode, useFMA>(x, y, z);
+  }
+  template <typename T>
+  static two<T> fma(const two<T> &x, T y, const two<T> &z) {
+    return dw::fma<mulMode, addMode, useFMA>(x, y, z);
+  }
+
+  template <typename T>
+  static two<T> normalize(const two<T> &x) {
+    return x;
+  }
+};
+
+/// \brief Selects the pair arithmetic.
+/// \details The results are not normalized. `normalize` normalizes them with
+/// `FastTwoSum`, so that the high word is the result rounded to working
+/// precision. The division of a pair by a floating point number uses
+/// `CPairDiv` with a zero low word.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA>
+struct pair {
+  template <typename T>
+  static two<T> add(const two<T> &x, const two<T> &y) {
+    return pw::add(x, y);
+  }
+  template <typename T>
+  static two<T> add(const two<T> &x, T y) {
+    return pw::add(x, y);
+  }
+
+  template <typename T>
+  static two<T> sub(const two<T> &x, const two<T> &y) {
+    return pw::sub(x, y);
+  }
+  template <typename T>
+  static two<T> sub(const two<T> &x, T y) {
+    return pw::sub(x, y);
+  }
+
+  template <typename T>
+  static two<T> mul(const two<T> &x, const two<T> &y) {
+    return pw::mul<useFMA>(x, y);
+  }
+  template <typename T>
+  static two<T> mul(const two<T> &x, T y) {
+    return pw::mul<useFMA>(x, y);
+  }
+
+  template <typename T>
+  static two<T> div(const two<T> &x, const two<T> &y) {
+    return pw::div<useFMA>(x, y);
+  }
+  template <typename T>
+  static two<T> div(const two<T> &x, T y) {
+    return pw::div<useFMA>(x, two<T>(y));
+  }
+
+  template <typename T>
+  static two<T> fma(const two<T> &x, const two<T> &y, const two<T> &z) {
+    return pw::add(pw::mul<useFMA>(x, y), z);
+  }
+  template <typename T>
+  static two<T> fma(const two<T> &x, T y, const two<T> &z) {
+    return pw::add(pw::mul<useFMA>(x, y), z);
+  }
+
+  template <typename T>
+  static two<T> normalize(const two<T> &x) {
+    return algorithms::FastTwoSum(x.h, x.l);
+  }
+};
+
+}  // namespace policy
+}  // namespace twofloat
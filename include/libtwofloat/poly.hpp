@@ -0,0 +1,169 @@
+#pragma once
+
+/// \file poly.hpp
+/// \brief Implements the evaluation of polynomials with double-word
+/// coefficients that are known at compile time.
+
+#include <cstddef>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace twofloat {
+
+/// \brief Evaluation of polynomials with Horner's scheme and Estrin's scheme.
+/// \details The coefficients are passed as a template argument, a reference
+/// to an array of static storage duration that holds the coefficients in
+/// increasing order of degree, either as `two<S>` or as pairs `{h, l}` of
+/// type `S[2]` like the tables in double-word-tables.hpp. The loops over the
+/// coefficients are unrolled at compile time. The arithmetic is selected by a
+/// policy (see policy.hpp).
+///
+/// With `policy::pair`, the evaluation skips the normalization after each
+/// operation. Lange and Rump (2020, Corollary 6.2) show that the result is
+/// still faithfully rounded to working precision, i.e. `eval()` is faithful,
+/// as long as the degree stays below a bound that grows like √(1/u).
+/// `policy::faithful` selects the pair arithmetic for the degrees up to
+/// `pairDegree<S>`, a conservative fraction of this bound, and the
+/// double-word arithmetic for higher degrees. Only the double-word arithmetic
+/// gives double-word accuracy.
+namespace poly {
+
+/// \brief The highest degree for which the pair arithmetic is used by
+/// `policy::faithful`, see `pair::faithfulOperations`.
+template <typename S>
+inline constexpr std::size_t pairDegree = pair::faithfulOperations<S>;
+
+}  // namespace poly
+
+namespace policy {
+/// \brief Selects the pair arithmetic for polynomials whose degree is at most
+/// `poly::pairDegree` and the double-word arithmetic otherwise.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA>
+struct faithful {};
+}  // namespace policy
+
+namespace poly {
+namespace details {
+
+/// \brief The policy used to evaluate a polynomial of degree `N` with
+/// coefficients of type `S`.
+template <typename Policy, typename S, std::size_t N>
+struct resolve {
+  using type = Policy;
+};
+template <bool useFMA, typename S, std::size_t N>
+struct resolve<policy::faithful<useFMA>, S, N> {
+  using type = std::conditional_t<(N <= pairDegree<S>), policy::pair<useFMA>,
+                                  policy::doubleword<useFMA>>;
+};
+
+/// \brief The type of the coefficients and their number.
+template <typename C>
+struct coefficients;
+template <typename S, std::size_t size>
+struct coefficients<S[size][2]> {
+  using type = S;
+  static constexpr std::size_t count = size;
+};
+template <typename S, std::size_t size>
+struct coefficients<two<S>[size]> {
+  using type = S;
+  static constexpr std::size_t count = size;
+};
+
+template <typename T, typename S>
+inline two<T> coefficient(const S (&c)[2]) {
+  return two<T>(T(c[0]), T(c[1]));
+}
+template <typename T, typename S>
+inline two<T> coefficient(const two<S> &c) {
+  return two<T>(T(c.h), T(c.l));
+}
+
+/// \brief Returns ⌊log2(n)⌋ for n > 0.
+constexpr std::size_t floorLog2(std::size_t n) {
+  std::size_t res = 0;
+  while (n >>= 1) ++res;
+  return res;
+}
+
+template <const auto &coeffs>
+using coefficients_t =
+    coefficients<std::remove_cv_t<std::remove_reference_t<decltype(coeffs)>>>;
+
+template <const auto &coeffs, typename P, typename T, std::size_t... k>
+inline two<T> horner(const two<T> &x, std::index_sequence<k...>) {
+  constexpr std::size_t N = sizeof...(k);
+  two<T> res = coefficient<T>(coeffs[N]);
+  // The fold runs from the coefficient of degree N - 1 down to 0
+  ((res = P::add(P::mul(res, x), coefficient<T>(coeffs[N - 1 - k]))), ...);
+  return res;
+}
+
+/// \brief Evaluates the coefficients `first, ..., first + n - 1` with
+/// Estrin's scheme, where `powers[i]` holds x^(2^i).
+template <const auto &coeffs, typename P, std::size_t first, std::size_t n,
+          typename T>
+inline two<T> estrin(const two<T> *powers) {
+  if constexpr (n == 1) {
+    return coefficient<T>(coeffs[first]);
+  } else {
+    // Split at the largest power of two below n
+    constexpr std::size_t level = floorLog2(n - 1);
+    constexpr std::size_t half = std::size_t(1) << level;
+    two<T> low = estrin<coeffs, P, first, half>(powers);
+    two<T> high = estrin<coeffs, P, first + half, n - half>(powers);
+    return P::add(P::mul(high, powers[level]), low);
+  }
+}
+}  // namespace details
+
+/// \brief Evaluates the polynomial `Σ coeffs[k] x^k` at `x` with Horner's
+/// scheme.
+/// \details Horner's scheme needs the fewest operations, but each one
+/// depends on the previous one.
+/// \param x The argument.
+/// \tparam coeffs The coefficients in increasing order of degree.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <const auto &coeffs, typename Policy, typename T>
+inline two<T> horner(const two<T> &x) {
+  using C = details::coefficients_t<coeffs>;
+  static_assert(C::count > 0, "The polynomial needs a coefficient");
+  using P = typename details::resolve<Policy, typename C::type,
+                                      C::count - 1>::type;
+  return P::normalize(details::horner<coeffs, P>(
+      x, std::make_index_sequence<C::count - 1>()));
+}
+
+/// \brief Evaluates the polynomial `Σ coeffs[k] x^k` at `x` with Estrin's
+/// scheme.
+/// \details Estrin's scheme evaluates the polynomial as a binary tree of
+/// polynomials in x, x², x⁴, ..., so that the independent subtrees can
+/// execute in parallel. It needs about log2(N) more multiplications than
+/// Horner's scheme, but its dependency chain is only logarithmic in the
+/// degree N.
+/// \param x The argument.
+/// \tparam coeffs The coefficients in increasing order of degree.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <const auto &coeffs, typename Policy, typename T>
+inline two<T> estrin(const two<T> &x) {
+  using C = details::coefficients_t<coeffs>;
+  static_assert(C::count > 0, "The polynomial needs a coefficient");
+  using P = typename details::resolve<Policy, typename C::type,
+                                      C::count - 1>::type;
+
+  constexpr std::size_t levels =
+      C::count == 1 ? 1 : details::floorLog2(C::count - 1) + 1;
+  two<T> powers[levels];
+  powers[0] = x;
+  for (std::size_t i = 1; i < levels; ++i)
+    powers[i] = P::mul(powers[i - 1], powers[i - 1]);
+  return P::normalize(details::estrin<coeffs, P, 0, C::count>(powers));
+}
+
+}  // namespace poly
+}  // namespace twofloat
@@ -0,0 +1,328 @@
+#pragma once
+
+/// \file reduce.hpp
+/// \brief Implements compensated reductions over arrays that return
+/// double-word results.
+
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace twofloat {
+
+/// \brief Reductions over arrays of floating point and double-word numbers:
+/// sums, dot products and norms.
+/// \details The reductions split the input into blocks of fixed size
+/// (`blockSize`), which are processed in parallel. Within a block, the lanes of
+/// a twofloat::simd vector serve as independent accumulators, so the loop is
+/// not limited by the latency of a single chain of error-free transformations.
+/// The accumulators and the partial results of the blocks are combined in a
+/// binary tree with `doubleword::add<Mode::Accurate>`.
+///
+/// Since neither the blocks nor the order of the combination depend on the
+/// number of threads, the results are bitwise identical for any number of
+/// threads.
+namespace reduce {
+
+/// \brief The number of elements that are summed sequentially by one thread.
+/// \details The results depend on this value, so changing it changes the
+/// results in the last bits.
+inline constexpr std::size_t blockSize = std::size_t(1) << 16;
+
+namespace details {
+using doubleword::Mode;
+
+/// \brief The vector type of the accumulators, 8 lanes of double or 16 lanes
+/// of float.
+template <typename T>
+using accumulator_t = simd<T, 64 / sizeof(T)>;
+
+/// \brief Combines the lanes of an accumulator in a binary tree.
+template <typename V>
+two<scalar_type_t<V>> foldLanes(const two<V> &acc) {
+  using T = scalar_type_t<V>;
+  two<T> lanes[V::size()];
+  for (std::size_t k = 0; k < V::size(); ++k) lanes[k] = {acc.h[k], acc.l[k]};
+  return twofloat::details::treeReduce(
+      lanes, V::size(), doubleword::add<Mode::Accurate, T>);
+}
+
+template <typename T>
+two<T> sumBlock(const T *x, std::size_t n) {
+  using V = accumulator_t<T>;
+  two<V> acc;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size())
+    acc = doubleword::add(acc, V::load(x + i));
+
+  two<T> res = foldLanes(acc);
+  for (; i < n; ++i) res = doubleword::add(res, x[i]);
+  return res;
+}
+
+template <typename T>
+two<T> sumBlock(const T *xh, const T *xl, std::size_t n) {
+  using V = accumulator_t<T>;
+  two<V> acc;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    two<V> x = {V::load(xh + i), V::load(xl + i)};
+    acc = doubleword::add<Mode::Accurate>(acc, x);
+  }
+
+  two<T> res = foldLanes(acc);
+  for (; i < n; ++i)
+    res = doubleword::add<Mode::Accurate>(res, two<T>(xh[i], xl[i]));
+  return res;
+}
+
+template <typename T>
+two<T> sumBlock(const two<T> *x, std::size_t n) {
+  using V = accumulator_t<T>;
+  two<V> acc;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    two<V> xi;
+    for (std::size_t k = 0; k < V::size(); ++k) {
+      xi.h.v[k] = x[i + k].h;
+      xi.l.v[k] = x[i + k].l;
+    }
+    acc = doubleword::add<Mode::Accurate>(acc, xi);
+  }
+
+  two<T> res = foldLanes(acc);
+  for (; i < n; ++i) res = doubleword::add<Mode::Accurate>(res, x[i]);
+  return res;
+}
+
+/// \brief Adds the product `a*b` to the unnormalized accumulator `acc`.
+/// \details This is the loop body of algorithm `Dot2` in Ogita et al. (2005):
+/// `acc.h` holds the floating point sum of the products and `acc.l` the sum of
+/// all rounding errors.
+template <bool useFMA, typename V>
+inline void dot2(two<V> &acc, V a, V b) {
+  two<V> p = algorithms::TwoProd<V, useFMA>(a, b);
+  two<V> s = algorithms::TwoSum(acc.h, p.h);
+  acc.h = s.h;
+  acc.l = acc.l + (s.l + p.l);
+}
+
+/// \brief Normalizes the lanes of a `Dot2` accumulator and combines them.
+template <typename V>
+two<scalar_type_t<V>> foldDot2(const two<V> &acc) {
+  return foldLanes(algorithms::TwoSum(acc.h, acc.l));
+}
+
+template <bool useFMA, typename T>
+two<T> dotBlock(const T *x, const T *y, std::size_t n) {
+  using V = accumulator_t<T>;
+  two<V> acc;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size())
+    dot2<useFMA>(acc, V::load(x + i), V::load(y + i));
+
+  two<T> res = foldDot2(acc);
+  for (; i < n; ++i) dot2<useFMA>(res, x[i], y[i]);
+  return algorithms::TwoSum(res.h, res.l);
+}
+
+/// \brief Sums the squares of `scale * x[i]`.
+/// \details Requires that `scale` is a power of two, so that the scaling is
+/// exact.
+template <bool useFMA, typename T>
+two<T> sumSquaresBlock(const T *x, std::size_t n, T scale) {
+  using V = accumulator_t<T>;
+  two<V> acc;
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    V xi = V::load(x + i) * scale;
+    dot2<useFMA>(acc, xi, xi);
+  }
+
+  two<T> res = foldDot2(acc);
+  for (; i < n; ++i) dot2<useFMA>(res, x[i] * scale, x[i] * scale);
+  return algorithms::TwoSum(res.h, res.l);
+}
+
+// Versions that are compiled with FMA instructions regardless of the compiler
+// flags, so that the lane-wise fma of twofloat::simd is vectorized
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> dotBlockFMA(const T *x, const T *y,
+                                       std::size_t n) {
+  return dotBlock<true>(x, y, n);
+}
+
+template <typename T>
+TWOFLOAT_TARGET_FMA two<T> sumSquaresBlockFMA(const T *x, std::size_t n,
+                                              T scale) {
+  return sumSquaresBlock<true>(x, n, scale);
+}
+
+/// \brief Returns the maximum absolute value of `x`, or NaN if `x` contains a
+/// NaN.
+template <typename T>
+T maxAbs(const T *x, std::size_t n) {
+  using V = accumulator_t<T>;
+  // The NaNs are summed separately, since the comparisons ignore them
+  V acc(0), nan(0);
+  std::size_t i = 0;
+  for (; i + V::size() <= n; i += V::size()) {
+    V xi = abs(V::load(x + i));
+    acc = select_gt(xi, acc, xi, acc);
+    nan += select_gt(xi, V(0), V(0), xi);
+  }
+
+  T res = 0;
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    if (std::isnan(nan[k])) return nan[k];
+    res = std::max(res, acc[k]);
+  }
+  for (; i < n; ++i) {
+    if (std::isnan(x[i])) return x[i];
+    res = std::max(res, std::abs(x[i]));
+  }
+  return res;
+}
+
+/// \brief Reduces `n` elements by calling `blockSum(begin, count)` for every
+/// block in parallel and summing the partial results.
+template <typename T, typename BlockSum>
+two<T> reduceBlocks(std::size_t n, unsigned threads, BlockSum blockSum) {
+  if (n == 0) return two<T>();
+
+  std::vector<two<T>> partials((n + blockSize - 1) / blockSize);
+  twofloat::details::parallelFor(
+      partials.size(), threads, [&](std::size_t b) {
+        std::size_t begin = b * blockSize;
+        partials[b] = blockSum(begin, std::min(blockSize, n - begin));
+      });
+  return twofloat::details::treeReduce(partials.data(), partials.size(),
+                                       doubleword::add<Mode::Accurate, T>);
+}
+}  // namespace details
+
+/// \brief Sums floating point numbers with a double-word result.
+/// \param x The numbers to sum.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+template <typename T>
+two<T> sum(span<const T> x, unsigned threads = 0) {
+  return details::reduceBlocks<T>(
+      x.size(), threads, [&](std::size_t begin, std::size_t count) {
+        return details::sumBlock(x.data() + begin, count);
+      });
+}
+
+/// \brief Sums double-word numbers.
+/// \param x The numbers to sum.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+template <typename T>
+two<T> sum(span<const two<T>> x, unsigned threads = 0) {
+  return details::reduceBlocks<T>(
+      x.size(), threads, [&](std::size_t begin, std::size_t count) {
+        return details::sumBlock(x.data() + begin, count);
+      });
+}
+
+/// \brief Sums double-word numbers stored as structure of arrays.
+/// \details The result is bitwise identical to the sum of the same numbers
+/// stored as array of structures.
+/// \param x The numbers to sum.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+template <typename T>
+two<T> sum(soa_span<const T> x, unsigned threads = 0) {
+  return details::reduceBlocks<T>(
+      x.size(), threads, [&](std::size_t begin, std::size_t count) {
+        return details::sumBlock(x.h_data() + begin, x.l_data() + begin,
+                                 count);
+      });
+}
+
+/// \brief Calculates the dot product of two arrays with a double-word result.
+/// \details This is algorithm `Dot2` in Ogita, Rump and Oishi (2005): the
+/// products are split with algorithms::TwoProd and summed with
+/// algorithms::TwoSum, while the errors are accumulated in a separate word.
+/// The result is as accurate as if computed in twice the working precision.
+/// \param x The first array.
+/// \param y The second array, of the same size as `x`.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \throws std::invalid_argument if the sizes of `x` and `y` differ.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+two<T> dot(span<const T> x, span<const T> y, unsigned threads = 0) {
+  if (x.size() != y.size())
+    throw std::invalid_argument("reduce::dot: x and y have different sizes");
+  return details::reduceBlocks<T>(
+      x.size(), threads, [&](std::size_t begin, std::size_t count) {
+        if constexpr (useFMA)
+          return details::dotBlockFMA(x.data() + begin, y.data() + begin,
+                                      count);
+        else
+          return details::dotBlock<false>(x.data() + begin, y.data() + begin,
+                                          count);
+      });
+}
+
+/// \brief Calculates the dot product of two arrays with a double-word result,
+/// using FMA instructions if the CPU supports them.
+template <typename T>
+two<T> dot(span<const T> x, span<const T> y, unsigned threads = 0) {
+  if (cpu::hasFMA()) return dot<true>(x, y, threads);
+  return dot<false>(x, y, threads);
+}
+
+/// \brief Calculates the euclidean norm of an array with a double-word result.
+/// \details The elements are scaled by a power of two so that the largest one
+/// is in [0.5, 1), which avoids overflow and underflow of the squares. The
+/// squares are summed like the products in `dot`. The norm is NaN if `x`
+/// contains a NaN, and infinite otherwise if `x` contains an infinity.
+/// \param x The array.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \tparam useFMA Whether to use FMA instructions.
+template <bool useFMA, typename T>
+two<T> nrm2(span<const T> x, unsigned threads = 0) {
+  T max = details::maxAbs(x.data(), x.size());
+  if (max == 0 || !std::isfinite(max)) return two<T>(max);
+
+  // The clamping keeps the scale finite for subnormal maxima
+  int exponent;
+  std::frexp(max, &exponent);
+  exponent = std::max(exponent, std::numeric_limits<T>::min_exponent);
+  const T scale = std::ldexp(T(1), -exponent);
+  two<T> sumSquares = details::reduceBlocks<T>(
+      x.size(), threads, [&](std::size_t begin, std::size_t count) {
+        if constexpr (useFMA)
+          return details::sumSquaresBlockFMA(x.data() + begin, count, scale);
+        else
+          return details::sumSquaresBlock<false>(x.data() + begin, count,
+                                                 scale);
+      });
+
+  two<T> res = doubleword::sqrt<useFMA>(sumSquares);
+  return {std::ldexp(res.h, exponent), std::ldexp(res.l, exponent)};
+}
+
+/// \brief Calculates the euclidean norm of an array with a double-word result,
+/// using FMA instructions if the CPU supports them.
+template <typename T>
+two<T> nrm2(span<const T> x, unsigned threads = 0) {
+  if (cpu::hasFMA()) return nrm2<true>(x, threads);
+  return nrm2<false>(x, threads);
+}
+
+}  // namespace reduce
+}  // namespace twofloat
@@ -0,0 +1,203 @@
+#pragma once
+
+/// \file simd.hpp
+/// \brief Implements a portable vector type that can be used as the
+/// underlying type of twofloat::two.
+/// \details `two<simd<T, N>>` represents `N` numbers in a single instance. All
+/// algorithms and arithmetics in this library are written with the arithmetic
+/// operators and the functions below, so they compile for `simd<T, N>` without
+/// changes and process `N` numbers at once. The type is based on the vector
+/// extensions of GCC and Clang, so the compiler maps it to the widest registers
+/// that are enabled (e.g. with `-mavx2`), and it converts from and to the
+/// corresponding intrinsic types (e.g. `__m256d` for `simd<double, 4>`).
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace twofloat {
+
+namespace details {
+template <typename T, std::size_t N>
+struct vector_extension {
+  // The typedef form, because GCC ignores the attribute in alias declarations
+  // of dependent types
+  typedef T type __attribute__((vector_size(N * sizeof(T))));
+};
+}  // namespace details
+
+/// \brief A vector of `N` floating point numbers of type `T`.
+/// \details All operations are element-wise. Scalars are implicitly broadcast
+/// to all lanes, so the vector can be mixed with constants of type `T`.
+/// \tparam N The number of lanes, must be a power of two.
+template <typename T, std::size_t N>
+struct simd {
+  static_assert(std::is_floating_point<T>::value,
+                "twofloat::simd<T, N> can only be instantiated with a floating "
+                "point type.");
+  static_assert(N > 0 && (N & (N - 1)) == 0,
+                "The number of lanes must be a power of two.");
+
+  /// \brief The type of a single lane.
+  using value_type = T;
+
+  /// \brief The vector type of the compiler.
+  using native_type = typename details::vector_extension<T, N>::type;
+
+  /// \brief The lanes of the vector.
+  native_type v;
+
+  /// \brief Default constructor, leaves the lanes uninitialized.
+  simd() = default;
+
+  /// \brief Broadcasts a number to all lanes.
+  simd(T x) : v(native_type{} + x) {}
+
+  /// \brief Constructs an instance from a vector of the compiler, e.g. from
+  /// an intrinsic type such as `__m256d`.
+  simd(native_type v) : v(v) {}
+
+  /// \brief Returns the number of lanes.
+  static constexpr std::size_t size() { return N; }
+
+  /// \brief Loads `N` numbers from unaligned memory.
+  static simd load(const T *p) {
+    simd res;
+    std::memcpy(&res.v, p, sizeof(res.v));
+    return res;
+  }
+
+  /// \brief Stores the lanes to unaligned memory.
+  void store(T *p) const { std::memcpy(p, &v, sizeof(v)); }
+
+  /// \brief Returns the number in lane `i`.
+  T operator[](std::size_t i) const { return v[i]; }
+
+  /// \brief Converts the instance to a vector of the compiler.
+  operator native_type() const { return v; }
+
+  simd operator-() const { return -v; }
+
+  simd &operator+=(const simd &b) { return v += b.v, *this; }
+  simd &operator-=(const simd &b) { return v -= b.v, *this; }
+  simd &operator*=(const simd &b) { return v *= b.v, *this; }
+  simd &operator/=(const simd &b) { return v /= b.v, *this; }
+
+  friend simd operator+(const simd &a, const simd &b) { return a.v + b.v; }
+  friend simd operator-(const simd &a, const simd &b) { return a.v - b.v; }
+  friend simd operator*(const simd &a, const simd &b) { return a.v * b.v; }
+  friend simd operator/(const simd &a, const simd &b) { return a.v / b.v; }
+};
+
+/// \brief Returns the absolute values of the lanes.
+template <typename T, std::size_t N>
+inline simd<T, N> abs(const simd<T, N> &a) {
+  // Clear the sign bits. Casts between vectors of the same size reinterpret
+  // the bits.
+  using I = std::conditional_t<sizeof(T) == 8, std::int64_t, std::int32_t>;
+  using bits = typename details::vector_extension<I, N>::type;
+  const bits mask = bits{} + std::numeric_limits<I>::max();
+  return (typename simd<T, N>::native_type)((bits)a.v & mask);
+}
+
+/// \brief Calculates `a*b+c` with infinite precision of the intermediate
+/// results for each lane.
+/// \details The compiler maps the loop to a vector FMA instruction if FMA is
+/// enabled.
+template <typename T, std::size_t N>
+inline simd<T, N> fma(const simd<T, N> &a, const simd<T, N> &b,
+                      const simd<T, N> &c) {
+  simd<T, N> res;
+  for (std::size_t i = 0; i < N; ++i)
+    res.v[i] = std::fma(a.v[i], b.v[i], c.v[i]);
+  return res;
+}
+
+/// \brief Returns `a > b ? x : y` for each lane.
+template <typename T, std::size_t N>
+inline simd<T, N> select_gt(const simd<T, N> &a, const simd<T, N> &b,
+                            const simd<T, N> &x, const simd<T, N> &y) {
+  // Blend with bit operations, which all instruction sets support, unlike
+  // the vector form of the conditional operator
+  using native_type = typename simd<T, N>::native_type;
+  auto mask = a.v > b.v;
+  using bits = decltype(mask);
+  return (native_type)(((bits)x.v & mask) | ((bits)y.v & ~mask));
+}
+
+/// \brief Applies the scalar function `f` to each lane of the arguments and
+/// returns the results as a vector. For floating point types, returns
+/// `f(x, xs...)`.
+/// \details Used for operations that have no vector equivalent, e.g. table
+/// lookups and `std::ldexp`, so that the same code works for scalars and
+/// vectors.
+template <typename F, typename T, typename... Ts>
+inline T lanewise(F f, const T &x, const Ts &...xs) {
+  if constexpr (is_simd_v<T>) {
+    T res;
+    for (std::size_t i = 0; i < T::size(); ++i)
+      res.v[i] = f(x.v[i], xs.v[i]...);
+    return res;
+  } else {
+    return f(x, xs...);
+  }
+}
+
+namespace details {
+/// \brief Selects the lanes `idx` of the concatenation of `a` and `b`.
+template <typename V, typename T, std::size_t N, std::size_t... idx>
+inline V shuffle(const V &a, const V &b) {
+#if defined(__clang__)
+  return __builtin_shufflevector(a, b, idx...);
+#else
+  using I = std::conditional_t<sizeof(T) == 8, std::int64_t, std::int32_t>;
+  using mask = typename vector_extension<I, N>::type;
+  return __builtin_shuffle(a, b, mask{static_cast<I>(idx)...});
+#endif
+}
+
+template <typename T, std::size_t N, std::size_t... I>
+inline void loadInterleaved(const T *p, simd<T, N> &x, simd<T, N> &y,
+                            std::index_sequence<I...>) {
+  using V = typename simd<T, N>::native_type;
+  V a, b;
+  std::memcpy(&a, p, sizeof(a));
+  std::memcpy(&b, p + N, sizeof(b));
+  x.v = shuffle<V, T, N, (2 * I)...>(a, b);
+  y.v = shuffle<V, T, N, (2 * I + 1)...>(a, b);
+}
+
+template <typename T, std::size_t N, std::size_t... I>
+inline void storeInterleaved(T *p, const simd<T, N> &x, const simd<T, N> &y,
+                             std::index_sequence<I...>) {
+  using V = typename simd<T, N>::native_type;
+  // Lane k of the result is x[k / 2] for even k and y[k / 2] otherwise
+  constexpr auto lane = [](std::size_t k) { return k % 2 ? N + k / 2 : k / 2; };
+  const V a = shuffle<V, T, N, lane(I)...>(x.v, y.v);
+  const V b = shuffle<V, T, N, lane(N + I)...>(x.v, y.v);
+  std::memcpy(p, &a, sizeof(a));
+  std::memcpy(p + N, &b, sizeof(b));
+}
+}  // namespace details
+
+/// \brief Loads `2 N` interleaved numbers `x0, y0, x1, y1, ...` from unaligned
+/// memory into the lanes of `x` and `y`, e.g. an array of `two<T>`.
+template <typename T, std::size_t N>
+inline void load_interleaved(const T *p, simd<T, N> &x, simd<T, N> &y) {
+  details::loadInterleaved(p, x, y, std::make_index_sequence<N>());
+}
+
+/// \brief Stores the lanes of `x` and `y` interleaved to unaligned memory,
+/// the inverse of `load_interleaved`.
+template <typename T, std::size_t N>
+inline void store_interleaved(T *p, const simd<T, N> &x,
+                              const simd<T, N> &y) {
+  details::storeInterleaved(p, x, y, std::make_index_sequence<N>());
+}
+
+}  // namespace twofloat
@@ -0,0 +1,313 @@
+#pragma once
+
+/// \file soa-vector.hpp
+/// \brief Implements a structure-of-arrays container for double-word numbers.
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace twofloat {
+
+/// \brief The alignment (in bytes) of the high and low word arrays of a
+/// `soa_vector`. This is the size of a cache line and of an AVX-512 register.
+inline constexpr std::size_t soa_alignment = 64;
+
+/// \brief A reference to a double-word number that is stored in a structure of
+/// arrays.
+/// \details Behaves like a `two<T>` whose members refer to the high and low
+/// word arrays, i.e. `v[i].h` and `v[i].l` can be read (and written, if `T` is
+/// not const) like the members of `two<T>`.
+/// \tparam T The floating point type, optionally const qualified.
+template <typename T>
+struct soa_reference {
+  /// \brief The high word of the referenced number.
+  T &h;
+
+  /// \brief The low word of the referenced number.
+  T &l;
+
+  soa_reference(T &h, T &l) : h(h), l(l) {}
+  soa_reference(const soa_reference &) = default;
+
+  /// \brief Converts the referenced number to a `two<T>`.
+  operator two<std::remove_const_t<T>>() const { return {h, l}; }
+
+  /// \brief Assigns a double-word number to the referenced number.
+  const soa_reference &operator=(const two<std::remove_const_t<T>> &x) const {
+    h = x.h;
+    l = x.l;
+    return *this;
+  }
+
+  /// \brief Assigns the value (not the reference) of another referenced
+  /// number.
+  const soa_reference &operator=(const soa_reference &x) const {
+    return *this = two<std::remove_const_t<T>>(x);
+  }
+
+  /// \brief Evaluates the referenced sum to a single floating point number of
+  /// the specified type.
+  template <typename U = std::remove_const_t<T>>
+  U eval() const {
+    return static_cast<U>(h) + static_cast<U>(l);
+  }
+};
+
+/// \brief A non-owning view over double-word numbers that are stored as a
+/// structure of arrays, i.e. with separate arrays for the high and low words.
+/// \tparam T The floating point type. Use `const T` for read-only views.
+template <typename T>
+class soa_span {
+  static_assert(
+      std::is_floating_point<T>::value,
+      "twofloat::soa_span<T> can only be instantiated with a floating point "
+      "type.");
+
+ public:
+  using value_type = two<std::remove_const_t<T>>;
+  using reference = soa_reference<T>;
+
+  /// \brief Constructs an empty view.
+  soa_span() : h_(nullptr), l_(nullptr), size_(0) {}
+
+  /// \brief Constructs a view over `size` numbers whose high and low words are
+  /// stored at `h` and `l` respectively.
+  soa_span(T *h, T *l, std::size_t size) : h_(h), l_(l), size_(size) {}
+
+  /// \brief Converts a mutable view to a read-only view.
+  template <typename U,
+            typename = std::enable_if_t<std::is_same_v<const U, T> &&
+                                        !std::is_same_v<U, T>>>
+  soa_span(const soa_span<U> &other)
+      : h_(other.h_data()), l_(other.l_data()), size_(other.size()) {}
+
+  /// \brief Returns the array of the high words.
+  T *h_data() const { return h_; }
+
+  /// \brief Returns the array of the low words.
+  T *l_data() const { return l_; }
+
+  /// \brief Returns the array of the high words as span.
+  span<T> h() const { return {h_, size_}; }
+
+  /// \brief Returns the array of the low words as span.
+  span<T> l() const { return {l_, size_}; }
+
+  /// \brief Returns the number of double-word numbers.
+  std::size_t size() const { return size_; }
+
+  /// \brief Returns true if the view contains no numbers.
+  bool empty() const { return size_ == 0; }
+
+  /// \brief Accesses the number at position `i` without bounds checking.
+  reference operator[](std::size_t i) const { return {h_[i], l_[i]}; }
+
+  /// \brief Returns a view over `count` numbers starting at `offset`.
+  soa_span subspan(std::size_t offset, std::size_t count) const {
+    return {h_ + offset, l_ + offset, count};
+  }
+
+ private:
+  T *h_;
+  T *l_;
+  std::size_t size_;
+};
+
+/// \brief A resizable array of double-word numbers stored as a structure of
+/// arrays.
+/// \details In contrast to `std::vector<two<T>>`, which interleaves the high
+/// and low words in memory, this container stores all high words and all low
+/// words in two separate arrays. Both arrays are aligned to `soa_alignment`
+/// bytes, which allows batched operations to load the high and low words of
+/// consecutive numbers with contiguous, aligned vector loads.
+/// \tparam T The underlying floating point type.
+template <typename T>
+class soa_vector {
+  static_assert(
+      std::is_floating_point<T>::value,
+      "twofloat::soa_vector<T> can only be instantiated with a floating point "
+      "type.");
+
+ public:
+  using value_type = two<T>;
+  using size_type = std::size_t;
+  using reference = soa_reference<T>;
+  using const_reference = soa_reference<const T>;
+
+  /// \brief Constructs an empty container.
+  soa_vector() noexcept : h_(nullptr), l_(nullptr), size_(0), capacity_(0) {}
+
+  /// \brief Constructs a container with `n` numbers that are zero.
+  explicit soa_vector(std::size_t n) : soa_vector(n, two<T>()) {}
+
+  /// \brief Constructs a container with `n` copies of `value`.
+  soa_vector(std::size_t n, const two<T> &value) : soa_vector() {
+    resize(n, value);
+  }
+
+  /// \brief Constructs a container from a list of double-word numbers.
+  soa_vector(std::initializer_list<two<T>> values) : soa_vector() {
+    assign(span<const two<T>>(values.begin(), values.size()));
+  }
+
+  /// \brief Constructs a container from an array of interleaved double-word
+  /// numbers.
+  explicit soa_vector(span<const two<T>> values) : soa_vector() {
+    assign(values);
+  }
+
+  soa_vector(const soa_vector &other) : soa_vector() {
+    reserve(other.size_);
+    std::copy_n(other.h_, other.size_, h_);
+    std::copy_n(other.l_, other.size_, l_);
+    size_ = other.size_;
+  }
+
+  soa_vector(soa_vector &&other) noexcept : soa_vector() { swap(other); }
+
+  soa_vector &operator=(soa_vector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~soa_vector() {
+    deallocate(h_);
+    deallocate(l_);
+  }
+
+  /// \brief Replaces the content with an array of interleaved double-word
+  /// numbers.
+  void assign(span<const two<T>> values) {
+    clear();
+    reserve(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      h_[i] = values[i].h;
+      l_[i] = values[i].l;
+    }
+    size_ = values.size();
+  }
+
+  /// \brief Copies the content into an array of interleaved double-word
+  /// numbers. `out` must hold at least `size()` numbers.
+  void copy_to(span<two<T>> out) const {
+    for (std::size_t i = 0; i < size_; ++i) out[i] = {h_[i], l_[i]};
+  }
+
+  /// \brief Returns the array of the high words.
+  T *h_data() noexcept { return h_; }
+  const T *h_data() const noexcept { return h_; }
+
+  /// \brief Returns the array of the low words.
+  T *l_data() noexcept { return l_; }
+  const T *l_data() const noexcept { return l_; }
+
+  /// \brief Returns the array of the high words as span.
+  span<T> h() noexcept { return {h_, size_}; }
+  span<const T> h() const noexcept { return {h_, size_}; }
+
+  /// \brief Returns the array of the low words as span.
+  span<T> l() noexcept { return {l_, size_}; }
+  span<const T> l() const noexcept { return {l_, size_}; }
+
+  /// \brief Accesses the number at position `i` without bounds checking.
+  reference operator[](std::size_t i) noexcept { return {h_[i], l_[i]}; }
+  const_reference operator[](std::size_t i) const noexcept {
+    return {h_[i], l_[i]};
+  }
+
+  /// \brief Returns the number of double-word numbers.
+  std::size_t size() const noexcept { return size_; }
+
+  /// \brief Returns the number of double-word numbers that fit into the
+  /// allocated storage.
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  /// \brief Returns true if the container holds no numbers.
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// \brief Returns the largest number of double-word numbers that can be
+  /// allocated.
+  static constexpr std::size_t max_size() noexcept {
+    return static_cast<std::size_t>(-1) / sizeof(T);
+  }
+
+  /// \brief Increases the capacity to at least `n` numbers.
+  void reserve(std::size_t n) {
+    if (n <= capacity_) return;
+
+    T *h = allocate(n);
+    T *l;
+    try {
+      l = allocate(n);
+    } catch (...) {
+      deallocate(h);
+      throw;
+    }
+    std::copy_n(h_, size_, h);
+    std::copy_n(l_, size_, l);
+    deallocate(h_);
+    deallocate(l_);
+    h_ = h;
+    l_ = l;
+    capacity_ = n;
+  }
+
+  /// \brief Resizes the container to `n` numbers. New numbers are set to
+  /// `value`.
+  void resize(std::size_t n, const two<T> &value = two<T>()) {
+    if (n > capacity_) reserve(std::max(n, 2 * capacity_));
+    if (n > size_) {
+      std::fill(h_ + size_, h_ + n, value.h);
+      std::fill(l_ + size_, l_ + n, value.l);
+    }
+    size_ = n;
+  }
+
+  /// \brief Appends a number at the end of the container.
+  void push_back(const two<T> &value) {
+    if (size_ == capacity_) reserve(std::max<std::size_t>(16, 2 * capacity_));
+    h_[size_] = value.h;
+    l_[size_] = value.l;
+    ++size_;
+  }
+
+  /// \brief Removes all numbers without releasing the storage.
+  void clear() noexcept { size_ = 0; }
+
+  void swap(soa_vector &other) noexcept {
+    std::swap(h_, other.h_);
+    std::swap(l_, other.l_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  /// \brief Returns a mutable view over all numbers.
+  operator soa_span<T>() noexcept { return {h_, l_, size_}; }
+
+  /// \brief Returns a read-only view over all numbers.
+  operator soa_span<const T>() const noexcept { return {h_, l_, size_}; }
+
+ private:
+  static T *allocate(std::size_t n) {
+    if (n > max_size()) throw std::bad_array_new_length();
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(soa_alignment)));
+  }
+
+  static void deallocate(T *p) noexcept {
+    if (p) ::operator delete(p, std::align_val_t(soa_alignment));
+  }
+
+  T *h_;
+  T *l_;
+  std::size_t size_;
+  std::size_t capacity_;
+};
+
+}  // namespace twofloat
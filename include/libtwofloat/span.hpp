@@ -0,0 +1,94 @@
+#pragma once
+
+/// \file span.hpp
+/// \brief Implements a minimal non-owning view over contiguous memory.
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace twofloat {
+
+/// \brief A non-owning view over a contiguous sequence of objects.
+/// \details The library only requires C++17, so `std::span` is not available.
+/// This class implements the subset of `std::span` (with dynamic extent) that
+/// is used by the array operations of the library. Like `std::span`, it can
+/// be constructed from C arrays and from any container that provides `data()`
+/// and `size()`, e.g. `std::vector` or `std::array`.
+template <typename T>
+class span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using pointer = T *;
+  using reference = T &;
+  using iterator = T *;
+
+  /// \brief Constructs an empty span.
+  constexpr span() noexcept : data_(nullptr), size_(0) {}
+
+  /// \brief Constructs a span over `size` objects starting at `data`.
+  constexpr span(T *data, std::size_t size) noexcept
+      : data_(data), size_(size) {}
+
+  /// \brief Constructs a span over a C array.
+  template <std::size_t N>
+  constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+
+  /// \brief Constructs a span over a container that provides `data()` and
+  /// `size()` (e.g. `std::vector`, `std::array` or another span).
+  template <typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<
+                std::remove_pointer_t<decltype(std::declval<Container &>()
+                                                   .data())> (*)[],
+                T (*)[]>>>
+  constexpr span(Container &c) noexcept : data_(c.data()), size_(c.size()) {}
+
+  /// \brief Constructs a read-only span over a temporary container.
+  template <typename Container,
+            typename = std::enable_if_t<
+                std::is_const_v<T> &&
+                std::is_convertible_v<
+                    std::remove_pointer_t<decltype(
+                        std::declval<const Container &>().data())> (*)[],
+                    T (*)[]>>>
+  constexpr span(const Container &&c) noexcept
+      : data_(c.data()), size_(c.size()) {}
+
+  /// \brief Returns a pointer to the first element.
+  constexpr T *data() const noexcept { return data_; }
+
+  /// \brief Returns the number of elements.
+  constexpr std::size_t size() const noexcept { return size_; }
+
+  /// \brief Returns true if the span contains no elements.
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  /// \brief Accesses the element at position `i` without bounds checking.
+  constexpr T &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + size_; }
+
+  /// \brief Returns a view over the first `count` elements.
+  constexpr span first(std::size_t count) const noexcept {
+    return {data_, count};
+  }
+
+  /// \brief Returns a view over `count` elements starting at `offset`.
+  constexpr span subspan(std::size_t offset, std::size_t count) const noexcept {
+    return {data_ + offset, count};
+  }
+
+  /// \brief Returns a view over all elements starting at `offset`.
+  constexpr span subspan(std::size_t offset) const noexcept {
+    return {data_ + offset, size_ - offset};
+  }
+
+ private:
+  T *data_;
+  std::size_t size_;
+};
+
+}  // namespace twofloat
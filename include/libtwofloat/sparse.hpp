@@ -0,0 +1,327 @@
+#pragma once
+
+/// \file sparse.hpp
+/// \brief Implements sparse matrices and sparse matrix-vector products with
+/// double-word vectors.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <libtwofloat/details/dispatch.hpp>
+#include <libtwofloat/details/parallel.hpp>
+#include <libtwofloat/simd.hpp>
+#include <libtwofloat/span.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace twofloat {
+
+/// \brief Sparse matrices in the CSR and SELL-C-σ formats and their products
+/// with double-word vectors.
+/// \details The values of a matrix are either double-word numbers (`two<T>`)
+/// or floating point numbers (`T`), e.g. a `double` matrix that is applied to
+/// `two<double>` vectors. The latter needs fewer bytes per nonzero and a
+/// cheaper product. The column indices are 32 bits wide.
+///
+/// The products `y = A x` accumulate each row in the order of its nonzeros
+/// with `Policy::fma` and store normalized results, so both formats give
+/// bitwise identical results for any number of threads. The rows are
+/// distributed over the threads in contiguous parts with about the same
+/// number of nonzeros.
+namespace sparse {
+
+namespace details {
+/// \brief The floating point type of the values of type `E`.
+template <typename E>
+struct value {
+  using type = E;
+};
+template <typename T>
+struct value<two<T>> {
+  using type = T;
+};
+template <typename E>
+using value_t = typename value<E>::type;
+}  // namespace details
+
+/// \brief A sparse matrix in the compressed sparse row (CSR) format.
+/// \details The nonzeros of row `i` are `values[k]` in the columns
+/// `colIdx[k]` for `k` in `[rowPtr[i], rowPtr[i + 1])`.
+/// \tparam E The type of the values, `two<T>` or `T`.
+template <typename E>
+struct csr {
+  using value_type = details::value_t<E>;
+
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+  std::vector<std::size_t> rowPtr;
+  std::vector<std::uint32_t> colIdx;
+  std::vector<E> values;
+
+  /// \brief Returns the number of nonzeros.
+  std::size_t nonzeros() const noexcept { return values.size(); }
+};
+
+/// \brief A sparse matrix in the SELL-C-σ format (Kreutzer et al. 2014).
+/// \details The rows are sorted by their number of nonzeros within windows
+/// of σ rows and grouped into chunks of `C` rows. The nonzeros of a chunk are
+/// padded to the length of its longest row and stored column by column, so
+/// that the `C` rows of a chunk are processed in the lanes of a vector with
+/// contiguous loads. The high and the low words of the values are stored in
+/// separate arrays. A large σ reduces the padding, at the cost of locality
+/// of the accesses to `y`.
+/// \tparam E The type of the values, `two<T>` or `T`.
+/// \tparam C The number of rows per chunk, a power of two.
+template <typename E, std::size_t C = 8>
+struct sell {
+  using value_type = details::value_t<E>;
+  static constexpr bool doubleWord = !std::is_same_v<E, value_type>;
+
+  std::size_t rows = 0;
+  std::size_t cols = 0;
+
+  /// \brief The offset of each chunk in `colIdx`, `h` and `l`, and the total
+  /// number of stored values at the end.
+  std::vector<std::size_t> chunkPtr;
+
+  /// \brief The number of nonzeros of each sorted row.
+  std::vector<std::uint32_t> rowLength;
+
+  /// \brief The original row of each sorted row.
+  std::vector<std::uint32_t> permutation;
+
+  std::vector<std::uint32_t> colIdx;
+
+  /// \brief The high words of the values, or the values if they are floating
+  /// point numbers.
+  std::vector<value_type> h;
+
+  /// \brief The low words of the values, empty if they are floating point
+  /// numbers.
+  std::vector<value_type> l;
+
+  sell() = default;
+
+  /// \brief Converts a matrix from the CSR format.
+  /// \param A The matrix.
+  /// \param sigma The number of rows in a window of sorting, a multiple of
+  /// `C`. 1 keeps the order of the rows.
+  explicit sell(const csr<E> &A, std::size_t sigma = 1)
+      : rows(A.rows), cols(A.cols) {
+    const std::size_t chunks = (rows + C - 1) / C;
+    permutation.resize(chunks * C);
+    std::iota(permutation.begin(), permutation.end(), std::uint32_t(0));
+    auto length = [&](std::uint32_t i) {
+      return i < rows ? A.rowPtr[i + 1] - A.rowPtr[i] : 0;
+    };
+    for (std::size_t w = 0; sigma > 1 && w < rows; w += sigma)
+      std::stable_sort(permutation.begin() + w,
+                       permutation.begin() + std::min(rows, w + sigma),
+                       [&](std::uint32_t a, std::uint32_t b) {
+                         return length(a) > length(b);
+                       });
+
+    rowLength.resize(chunks * C);
+    chunkPtr.assign(chunks + 1, 0);
+    for (std::size_t c = 0; c < chunks; ++c) {
+      std::size_t width = 0;
+      for (std::size_t r = 0; r < C; ++r) {
+        rowLength[c * C + r] =
+            static_cast<std::uint32_t>(length(permutation[c * C + r]));
+        width = std::max<std::size_t>(width, rowLength[c * C + r]);
+      }
+      chunkPtr[c + 1] = chunkPtr[c] + width * C;
+    }
+
+    // The padding refers to column 0 with the value 0
+    colIdx.assign(chunkPtr.back(), 0);
+    h.assign(chunkPtr.back(), 0);
+    if constexpr (doubleWord) l.assign(chunkPtr.back(), 0);
+    for (std::size_t c = 0; c < chunks; ++c) {
+      for (std::size_t r = 0; r < C; ++r) {
+        const std::size_t i = permutation[c * C + r];
+        for (std::size_t k = 0; k < rowLength[c * C + r]; ++k) {
+          const std::size_t src = A.rowPtr[i] + k;
+          const std::size_t dst = chunkPtr[c] + k * C + r;
+          colIdx[dst] = A.colIdx[src];
+          if constexpr (doubleWord) {
+            h[dst] = A.values[src].h;
+            l[dst] = A.values[src].l;
+          } else {
+            h[dst] = A.values[src];
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Returns the number of chunks, 0 for a default-constructed matrix.
+  std::size_t chunks() const noexcept {
+    return chunkPtr.empty() ? 0 : chunkPtr.size() - 1;
+  }
+};
+
+namespace details {
+using twofloat::details::vectorized;
+
+/// \brief Returns the first item of part `p` of `parts` parts with about the
+/// same number of nonzeros, where `ptr` are the offsets of the items.
+inline std::size_t partBegin(const std::vector<std::size_t> &ptr,
+                             std::size_t p, std::size_t parts) {
+  const std::size_t items = ptr.size() - 1;
+  if (p >= parts) return items;
+  const std::size_t target = ptr.back() / parts * p +
+                             ptr.back() % parts * p / parts;
+  return std::min<std::size_t>(
+      items, std::lower_bound(ptr.begin(), ptr.end(), target) - ptr.begin());
+}
+
+/// \brief Calls `f(begin, end)` in parallel for parts of the items with about
+/// the same number of nonzeros. Does nothing without items, including for the
+/// empty `ptr` of a default-constructed matrix.
+template <typename F>
+void forParts(const std::vector<std::size_t> &ptr, unsigned threads,
+              const F &f) {
+  if (ptr.size() < 2) return;
+  // More parts than threads, so that rows of different costs even out
+  const std::size_t parts =
+      std::min<std::size_t>(4 * twofloat::details::threadCount(threads),
+                            ptr.size() - 1);
+  twofloat::details::parallelFor(parts, threads, [&](std::size_t p) {
+    f(partBegin(ptr, p, parts), partBegin(ptr, p + 1, parts));
+  });
+}
+
+/// \brief Loads `x[col[0]], ..., x[col[C - 1]]` into the lanes of a vector.
+template <typename V, typename T, std::size_t... I>
+inline two<V> gatherColumns(const two<T> *x, const std::uint32_t *col,
+                            std::index_sequence<I...>) {
+  using N = typename V::native_type;
+  return two<V>(V(N{x[col[I]].h...}), V(N{x[col[I]].l...}));
+}
+
+/// \brief Calculates `a * x + acc` for a double-word or floating point value
+/// `a`, see the namespace sparse.
+template <typename P, typename A, typename X>
+inline X multiplyAdd(const A &a, const X &x, const X &acc) {
+  if constexpr (std::is_same_v<A, X>)
+    return P::fma(a, x, acc);
+  else
+    return P::fma(x, a, acc);
+}
+
+template <typename P, typename E, typename T>
+void csrKernel(const csr<E> &A, const two<T> *x, two<T> *y, std::size_t begin,
+               std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    two<T> acc;
+    for (std::size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k)
+      acc = multiplyAdd<P>(A.values[k], x[A.colIdx[k]], acc);
+    y[i] = P::normalize(acc);
+  }
+}
+
+template <typename P, typename E, std::size_t C, typename T>
+void sellKernel(const sell<E, C> &A, const two<T> *x, two<T> *y,
+                std::size_t begin, std::size_t end) {
+  using V = simd<T, C>;
+  for (std::size_t c = begin; c < end; ++c) {
+    // The lanes of the padding keep their sums, so that the result does not
+    // depend on x[0]
+    T lengths[C];
+    for (std::size_t r = 0; r < C; ++r) lengths[r] = T(A.rowLength[c * C + r]);
+    const V length = V::load(lengths);
+
+    two<V> acc;
+    const std::size_t width = (A.chunkPtr[c + 1] - A.chunkPtr[c]) / C;
+    for (std::size_t k = 0; k < width; ++k) {
+      const std::size_t offset = A.chunkPtr[c] + k * C;
+      const two<V> xk = gatherColumns<V>(x, A.colIdx.data() + offset,
+                                         std::make_index_sequence<C>());
+      two<V> sum;
+      if constexpr (sell<E, C>::doubleWord)
+        sum = P::fma(two<V>(V::load(A.h.data() + offset),
+                            V::load(A.l.data() + offset)),
+                     xk, acc);
+      else
+        sum = P::fma(xk, V::load(A.h.data() + offset), acc);
+      const V kv = V(T(k));
+      acc = two<V>(select_gt(length, kv, sum.h, acc.h),
+                   select_gt(length, kv, sum.l, acc.l));
+    }
+
+    acc = P::normalize(acc);
+    for (std::size_t r = 0; r < C; ++r) {
+      const std::size_t i = A.permutation[c * C + r];
+      if (i < A.rows) y[i] = two<T>(acc.h[r], acc.l[r]);
+    }
+  }
+}
+
+template <typename M>
+void checkSizes(const M &A, std::size_t x, std::size_t y) {
+  if (x < A.cols || y < A.rows)
+    throw std::invalid_argument(
+        "sparse::spmv: x or y is shorter than the matrix");
+}
+}  // namespace details
+
+/// \brief Calculates the sparse matrix-vector product `y = A x` for a matrix
+/// in the CSR format.
+/// \details Each row is accumulated in the order of its nonzeros with
+/// `Policy::fma(a_ij, x_j, y_i)`, or `Policy::fma(x_j, a_ij, y_i)` for
+/// floating point values, and normalized.
+/// \param A The matrix.
+/// \param x The vector x, of `A.cols` elements.
+/// \param y The vector y, of `A.rows` elements, which must not overlap x.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \throws std::invalid_argument if x has fewer than `A.cols` or y fewer than
+/// `A.rows` elements.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename E>
+void spmv(const csr<E> &A, span<const two<details::value_t<E>>> x,
+          span<two<details::value_t<E>>> y, unsigned threads = 0) {
+  using T = details::value_t<E>;
+  details::checkSizes(A, x.size(), y.size());
+  details::forParts(A.rowPtr, threads, [&](std::size_t begin,
+                                           std::size_t end) {
+    // The vector instructions are not used, but FMA instructions are
+    details::vectorized<T>([&](auto) {
+      details::csrKernel<Policy>(A, x.data(), y.data(), begin, end);
+    });
+  });
+}
+
+/// \brief Calculates the sparse matrix-vector product `y = A x` for a matrix
+/// in the SELL-C-σ format.
+/// \details The rows of a chunk are accumulated in the lanes of a vector,
+/// with the same operations as for the CSR format, so the results are
+/// bitwise identical.
+/// \param A The matrix.
+/// \param x The vector x, of `A.cols` elements.
+/// \param y The vector y, of `A.rows` elements, which must not overlap x.
+/// \param threads The maximum number of threads, 0 for the number of hardware
+/// threads. The result does not depend on it.
+/// \throws std::invalid_argument if x has fewer than `A.cols` or y fewer than
+/// `A.rows` elements.
+/// \tparam Policy The arithmetic (see policy.hpp).
+template <typename Policy, typename E, std::size_t C>
+void spmv(const sell<E, C> &A, span<const two<details::value_t<E>>> x,
+          span<two<details::value_t<E>>> y, unsigned threads = 0) {
+  using T = details::value_t<E>;
+  details::checkSizes(A, x.size(), y.size());
+  details::forParts(A.chunkPtr, threads, [&](std::size_t begin,
+                                             std::size_t end) {
+    details::vectorized<T>([&](auto) {
+      details::sellKernel<Policy>(A, x.data(), y.data(), begin, end);
+    });
+  });
+}
+
+}  // namespace sparse
+}  // namespace twofloat
@@ -1,8 +1,9 @@
 #pragma once
 
 /// \file twofloat.hpp
-/// \brief Implements the basic data structure used in all arithmetics.
+/// \brief Implements the basic data structures used in all arithmetics.
 
+#include <cstddef>
 #include <libtwofloat/constants.hpp>
 #include <limits>
 #include <type_traits>
@@ -10,17 +11,44 @@
 /// \brief A namespace for algorithms that operate on pairs of floating point
 namespace twofloat {
 
+/// \brief A vector of `N` floating point numbers (see simd.hpp).
+template <typename T, std::size_t N>
+struct simd;
+
+/// \brief Whether `T` is an instance of twofloat::simd.
+template <typename T>
+struct is_simd : std::false_type {};
+template <typename T, std::size_t N>
+struct is_simd<simd<T, N>> : std::true_type {};
+template <typename T>
+inline constexpr bool is_simd_v = is_simd<T>::value;
+
+/// \brief The type of a single number in `T`, i.e. `T` itself for floating
+/// point types and the lane type for vectors.
+template <typename T>
+struct scalar_type {
+  using type = T;
+};
+template <typename T, std::size_t N>
+struct scalar_type<simd<T, N>> {
+  using type = T;
+};
+template <typename T>
+using scalar_type_t = typename scalar_type<T>::type;
+
 /// \brief Represents a floating point number as the sum of two
 /// floating point numbers.
 /// \details The struct is templated to allow it to represent
-/// pairs of different floating point types (e.g. float and double).
+/// pairs of different floating point types (e.g. float and double). With a
+/// vector type (`two<simd<double, 4>>`), it represents several numbers at once
+/// (see simd.hpp).
 template <typename T>
 struct two {
-  // Make sure that T is a floating point type
+  // Make sure that T is a floating point type or a vector of them
   static_assert(
-      std::is_floating_point<T>::value,
+      std::is_floating_point<T>::value || is_simd_v<T>,
       "twofloat::two<T> can only be instantiated with a floating point "
-      "type.");
+      "type or twofloat::simd.");
 
   /// \brief The high word of the sum.
   T h;
@@ -29,20 +57,93 @@ struct two {
   T l;
 
   /// \brief Default constructor
-  two() : h(0), l(0) {}
+  constexpr two() : h(0), l(0) {}
 
   /// \brief Constructs an instance from a single floating point number.
-  explicit two(T h) : h(h), l(0) {}
+  constexpr explicit two(T h) : h(h), l(0) {}
 
   /// \brief Constructs an instance from two floating point numbers.
-  two(T h, T l) : h(h), l(l) {}
+  constexpr two(T h, T l) : h(h), l(l) {}
 
   /// \brief Evaluates the sum to a single floating point number of the
   /// specified type.
   template <typename U = T>
-  U eval() const {
+  constexpr U eval() const {
     return static_cast<U>(h) + static_cast<U>(l);
   }
 };
 
-}  // namespace twofloat
\ No newline at end of file
+/// \brief Represents a floating point number as the unevaluated sum of `N`
+/// floating point numbers (floating-point expansion, see
+/// multi-word-arithmetic.hpp).
+/// \details The components are ordered by decreasing magnitude and do not
+/// overlap, i.e. each component is at most half a unit in the last place of
+/// the previous one, which gives `N` times the precision of `T` with the same
+/// range. Like `two`, it represents several numbers at once with a vector
+/// type.
+/// \tparam N The number of components.
+template <typename T, std::size_t N>
+struct expansion {
+  // Make sure that T is a floating point type or a vector of them
+  static_assert(
+      std::is_floating_point<T>::value || is_simd_v<T>,
+      "twofloat::expansion<T, N> can only be instantiated with a floating "
+      "point type or twofloat::simd.");
+  static_assert(N >= 1, "An expansion has at least one component.");
+
+  /// \brief The components, in order of decreasing magnitude.
+  T x[N];
+
+  /// \brief Default constructor
+  constexpr expansion() : x{} {}
+
+  /// \brief Constructs an instance from a single floating point number.
+  constexpr explicit expansion(T x0) : x{x0} {}
+
+  /// \brief Constructs an instance from a double-word number.
+  constexpr explicit expansion(const two<T> &y) : x{y.h, y.l} {}
+
+  /// \brief Constructs an instance from `N` floating point numbers.
+  template <typename... U,
+            typename = std::enable_if_t<(N > 1) && sizeof...(U) == N>>
+  constexpr expansion(U... c) : x{static_cast<T>(c)...} {}
+
+  /// \brief Converts an expansion with `M` components, which are truncated
+  /// or padded with zeros.
+  /// \details This changes the precision of a number, e.g. if an adaptive
+  /// algorithm switches between instantiations.
+  template <std::size_t M, typename = std::enable_if_t<M != N>>
+  constexpr explicit expansion(const expansion<T, M> &y) : x{} {
+    for (std::size_t i = 0; i < N && i < M; ++i) x[i] = y[i];
+  }
+
+  /// \brief Returns the number of components.
+  static constexpr std::size_t size() { return N; }
+
+  /// \brief Returns the component `i`.
+  constexpr T &operator[](std::size_t i) { return x[i]; }
+  constexpr const T &operator[](std::size_t i) const { return x[i]; }
+
+  /// \brief Evaluates the sum to a single floating point number of the
+  /// specified type, starting with the smallest component.
+  template <typename U = T>
+  constexpr U eval() const {
+    U s = static_cast<U>(x[N - 1]);
+    for (std::size_t i = N - 1; i-- > 0;) s = static_cast<U>(x[i]) + s;
+    return s;
+  }
+};
+
+/// \brief Represents a floating point number as the unevaluated sum of four
+/// floating point numbers (quad-word, see quad-word-arithmetic.hpp), which
+/// gives four times the precision of `T`.
+template <typename T>
+using four = expansion<T, 4>;
+
+}  // namespace twofloat
+
+// The vector type relies on the vector extensions of GCC and Clang, so other
+// compilers only get the scalar types
+#if defined(__GNUC__) || defined(__clang__)
+#include <libtwofloat/simd.hpp>
+#endif
@@ -0,0 +1,325 @@
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/blas.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/policy.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace blas {
+namespace test {
+
+using doubleword::Mode;
+using twofloat::test::expectBitwiseEqual;
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::forEachInstructionSet;
+using twofloat::test::randomTwo;
+
+template <typename T>
+std::vector<two<T>> matrix(std::size_t rows, std::size_t cols,
+                           unsigned seed) {
+  return randomTwo<T>(seed, T(0x1p-30))(rows * cols);
+}
+
+/// \brief The triple loop that `gemm` is equivalent to.
+template <typename P, typename T>
+std::vector<two<T>> reference(std::size_t M, std::size_t N, std::size_t K,
+                              const std::vector<two<T>> &A,
+                              const std::vector<two<T>> &B) {
+  std::vector<two<T>> C(M * N);
+  for (std::size_t i = 0; i < M; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      two<T> c;
+      for (std::size_t k = 0; k < K; ++k)
+        c = P::fma(A[i * K + k], B[k * N + j], c);
+      C[i * N + j] = P::normalize(c);
+    }
+  }
+  return C;
+}
+
+template <typename P, typename T>
+void gemmTest() {
+  // Sizes that are not multiples of the tiles and blocks
+  const std::size_t M = 67, N = 37, K = 260;
+  std::vector<two<T>> A = matrix<T>(M, K, 1), B = matrix<T>(K, N, 2);
+  std::vector<two<T>> expected = reference<P>(M, N, K, A, B);
+
+  forEachInstructionSet([&]() {
+    for (unsigned threads : {1u, 3u}) {
+      // The leading dimension of C is larger than N
+      const std::size_t ldc = N + 3;
+      std::vector<two<T>> C(M * ldc, two<T>(T(7)));
+      gemm<P>(M, N, K, A.data(), K, B.data(), N, C.data(), ldc, threads);
+      for (std::size_t i = 0; i < M; ++i) {
+        for (std::size_t j = 0; j < N; ++j)
+          expectBitwiseEqual(C[i * ldc + j], expected[i * N + j]);
+        for (std::size_t j = N; j < ldc; ++j) EXPECT_EQ(C[i * ldc + j].h, 7);
+      }
+    }
+  });
+}
+
+TEST(Blas, GemmTest) {
+  gemmTest<policy::doubleword<false>, double>();
+  gemmTest<policy::doubleword<false>, float>();
+  gemmTest<policy::pair<false>, double>();
+}
+
+TEST(Blas, GemmFMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  gemmTest<policy::doubleword<true>, double>();
+  gemmTest<policy::doubleword<true, Mode::Accurate, Mode::Sloppy>, float>();
+  gemmTest<policy::pair<true>, double>();
+}
+
+TEST(Blas, GemmAccuracyTest) {
+  // The product of a matrix with determinant 10 and its inverse
+  using P = policy::doubleword<false>;
+  const two<double> A[] = {two<double>(4.0), two<double>(7.0),
+                           two<double>(2.0), two<double>(6.0)};
+  const two<double> tenth =
+      doubleword::div<Mode::Fast, false>(two<double>(1.0), two<double>(10.0));
+  const two<double> B[] = {doubleword::mul<Mode::Fast, false>(tenth, 6.0),
+                           doubleword::mul<Mode::Fast, false>(tenth, -7.0),
+                           doubleword::mul<Mode::Fast, false>(tenth, -2.0),
+                           doubleword::mul<Mode::Fast, false>(tenth, 4.0)};
+  two<double> C[4];
+  gemm<P>(2, 2, 2, A, 2, B, 2, C, 2);
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+  for (std::size_t i = 0; i < 4; ++i)
+    EXPECT_LE(std::abs(C[i].h - (i % 3 == 0)) + std::abs(C[i].l), 16 * u * u);
+
+  // Without columns of A, C is zero
+  gemm<P>(2, 2, 0, A, 2, B, 2, C, 2);
+  for (const two<double> &c : C) EXPECT_EQ(c.h, 0);
+}
+
+template <typename P, typename T>
+void level1Test() {
+  const std::size_t n = 19, inc = 3;
+  const two<T> alpha = matrix<T>(1, 1, 3)[0];
+  std::vector<two<T>> x = matrix<T>(n, inc, 4), y = matrix<T>(n, inc, 5);
+
+  std::vector<two<T>> axpyExpected(n), scalExpected(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    axpyExpected[i] = P::normalize(P::fma(alpha, x[i * inc], y[i * inc]));
+    scalExpected[i] = P::normalize(P::mul(alpha, x[i * inc]));
+  }
+
+  forEachInstructionSet([&]() {
+    // Strided
+    std::vector<two<T>> z = y;
+    axpy<P>(n, alpha, x.data(), inc, z.data(), inc);
+    for (std::size_t i = 0; i < n; ++i) {
+      expectBitwiseEqual(z[i * inc], axpyExpected[i]);
+      for (std::size_t k = 1; k < inc; ++k)
+        expectBitwiseEqual(z[i * inc + k], y[i * inc + k]);
+    }
+    z = x;
+    scal<P>(n, alpha, z.data(), inc);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(z[i * inc], scalExpected[i]);
+
+    // Contiguous
+    std::vector<two<T>> xc(n), yc(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      xc[i] = x[i * inc];
+      yc[i] = y[i * inc];
+    }
+    axpy<P>(alpha, xc, yc);
+    scal<P>(alpha, xc);
+    for (std::size_t i = 0; i < n; ++i) {
+      expectBitwiseEqual(yc[i], axpyExpected[i]);
+      expectBitwiseEqual(xc[i], scalExpected[i]);
+    }
+  });
+}
+
+TEST(Blas, Level1Test) {
+  level1Test<policy::doubleword<false>, double>();
+  level1Test<policy::doubleword<false>, float>();
+  level1Test<policy::pair<false>, double>();
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  level1Test<policy::doubleword<true>, double>();
+  level1Test<policy::pair<true>, float>();
+}
+
+template <typename P, typename T>
+void level2Test() {
+  const std::size_t M = 37, N = 29, lda = N + 2;
+  const two<T> alpha = matrix<T>(1, 1, 6)[0];
+  std::vector<two<T>> A = matrix<T>(M, lda, 7);
+  std::vector<two<T>> x = matrix<T>(N, 1, 8), y = matrix<T>(M, 1, 9);
+  std::vector<two<T>> Ak(M * N);
+  for (std::size_t i = 0; i < M; ++i)
+    for (std::size_t j = 0; j < N; ++j) Ak[i * N + j] = A[i * lda + j];
+  const std::vector<two<T>> gemvExpected = reference<P>(M, 1, N, Ak, x);
+
+  // A square matrix with a dominant diagonal for the triangular solves
+  std::vector<two<T>> L = matrix<T>(N, lda, 10);
+  for (std::size_t i = 0; i < N; ++i) L[i * lda + i].h += 4;
+
+  forEachInstructionSet([&]() {
+    // The strided vectors are columns of a matrix
+    const std::size_t inc = 2;
+    std::vector<two<T>> xs(N * inc), ys(M * inc);
+    for (std::size_t j = 0; j < N; ++j) xs[j * inc] = x[j];
+    for (unsigned threads : {1u, 3u}) {
+      std::vector<two<T>> yc(M);
+      gemv<P>(A.data(), lda, x, yc, threads);
+      gemv<P>(M, N, A.data(), lda, xs.data(), inc, ys.data(), inc, threads);
+      for (std::size_t i = 0; i < M; ++i) {
+        expectBitwiseEqual(yc[i], gemvExpected[i]);
+        expectBitwiseEqual(ys[i * inc], gemvExpected[i]);
+      }
+    }
+
+    std::vector<two<T>> B = A, Bs = A;
+    ger<P>(alpha, y, x, B.data(), lda);
+    std::vector<two<T>> ys2(M * inc);
+    for (std::size_t i = 0; i < M; ++i) ys2[i * inc] = y[i];
+    ger<P>(M, N, alpha, ys2.data(), inc, xs.data(), inc, Bs.data(), lda);
+    for (std::size_t i = 0; i < M; ++i) {
+      const two<T> t = P::mul(alpha, y[i]);
+      for (std::size_t j = 0; j < N; ++j) {
+        const two<T> expected = P::normalize(P::fma(t, x[j], A[i * lda + j]));
+        expectBitwiseEqual(B[i * lda + j], expected);
+        expectBitwiseEqual(Bs[i * lda + j], expected);
+      }
+      for (std::size_t j = N; j < lda; ++j)
+        expectBitwiseEqual(B[i * lda + j], A[i * lda + j]);
+    }
+
+    for (Uplo uplo : {Uplo::Lower, Uplo::Upper}) {
+      for (Diag diag : {Diag::NonUnit, Diag::Unit}) {
+        // The elimination order of the unknowns
+        std::vector<two<T>> expected = x;
+        for (std::size_t step = 0; step < N; ++step) {
+          const std::size_t j = uplo == Uplo::Lower ? step : N - 1 - step;
+          if (diag == Diag::NonUnit)
+            expected[j] = P::div(expected[j], L[j * lda + j]);
+          expected[j] = P::normalize(expected[j]);
+          const two<T> minusXj(-expected[j].h, -expected[j].l);
+          for (std::size_t i = 0; i < N; ++i)
+            if (uplo == Uplo::Lower ? i > j : i < j)
+              expected[i] = P::fma(L[i * lda + j], minusXj, expected[i]);
+        }
+
+        std::vector<two<T>> xc = x;
+        trsv<P>(uplo, diag, L.data(), lda, xc);
+        std::vector<two<T>> xt = xs;
+        trsv<P>(uplo, diag, N, L.data(), lda, xt.data(), inc);
+        for (std::size_t i = 0; i < N; ++i) {
+          expectBitwiseEqual(xc[i], expected[i]);
+          expectBitwiseEqual(xt[i * inc], expected[i]);
+        }
+      }
+    }
+  });
+}
+
+TEST(Blas, Level2Test) {
+  level2Test<policy::doubleword<false>, double>();
+  level2Test<policy::doubleword<false>, float>();
+  level2Test<policy::pair<false>, double>();
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  level2Test<policy::doubleword<true>, double>();
+  level2Test<policy::pair<true>, float>();
+}
+
+TEST(Blas, SizeErrorsTest) {
+  using P = policy::doubleword<false>;
+  const two<double> alpha(2.0);
+  std::vector<two<double>> A = matrix<double>(4, 4, 13), x(4), y(3);
+  const span<const two<double>> cx(x), cy(y);
+  const std::vector<two<double>> unchanged = y;
+  EXPECT_THROW(axpy<P>(alpha, cx, span<two<double>>(y)),
+               std::invalid_argument);
+  EXPECT_THROW(axpy<P>(alpha, cy, span<two<double>>(x)),
+               std::invalid_argument);
+  // A with 3 rows and 4 columns, but a leading dimension of 3
+  EXPECT_THROW(gemv<P>(A.data(), 3, cx, span<two<double>>(y)),
+               std::invalid_argument);
+  EXPECT_THROW(ger<P>(alpha, cy, cx, A.data(), 3), std::invalid_argument);
+  EXPECT_THROW(trsv<P>(Uplo::Lower, Diag::Unit, A.data(), 3,
+                       span<two<double>>(x)),
+               std::invalid_argument);
+  expectBitwiseEqualArrays<two<double>>(y, unchanged);
+
+  EXPECT_NO_THROW(gemv<P>(A.data(), 4, cx, span<two<double>>(y)));
+  EXPECT_NO_THROW(ger<P>(alpha, cy, cx, A.data(), 4));
+}
+
+TEST(Blas, TrsvAccuracyTest) {
+  // The residual of the solution is of the order of the double-word precision
+  using P = policy::doubleword<false>;
+  const std::size_t N = 50;
+  std::vector<two<double>> L = matrix<double>(N, N, 11);
+  for (std::size_t i = 0; i < N; ++i) L[i * N + i].h += 8;
+  std::vector<two<double>> b = matrix<double>(N, 1, 12), x = b, r(N);
+  trsv<P>(Uplo::Lower, Diag::NonUnit, L.data(), N, x);
+
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+  for (std::size_t i = 0; i < N; ++i) {
+    two<double> s = b[i];
+    for (std::size_t j = 0; j <= i; ++j)
+      s = doubleword::sub<Mode::Accurate>(
+          s, doubleword::mul<Mode::Fast, false>(L[i * N + j], x[j]));
+    EXPECT_LE(std::abs(s.h), 64 * N * u * u);
+  }
+}
+
+template <typename P, typename T>
+void batchTest() {
+  // The batch is not a multiple of the vectors, and the vectors are shorter
+  // than the lanes
+  const std::size_t batchSize = 300, M = 3, N = 5, lda = N + 1;
+  const std::size_t strideA = M * lda + 2, strideX = N + 1, strideY = M + 2;
+  std::vector<two<T>> alpha = matrix<T>(batchSize, 1, 13);
+  std::vector<two<T>> A = matrix<T>(batchSize, strideA, 14);
+  std::vector<two<T>> x = matrix<T>(batchSize, strideX, 15);
+  std::vector<two<T>> y = matrix<T>(batchSize, strideY, 16);
+
+  std::vector<two<T>> axpyExpected = x, scalExpected = x, gemvExpected = y;
+  for (std::size_t b = 0; b < batchSize; ++b) {
+    axpy<P>(N, alpha[b], A.data() + b * strideA, 1,
+            axpyExpected.data() + b * strideX, 1);
+    scal<P>(N, alpha[b], scalExpected.data() + b * strideX, 1);
+    gemv<P>(M, N, A.data() + b * strideA, lda, x.data() + b * strideX, 1,
+            gemvExpected.data() + b * strideY, 1, 1);
+  }
+
+  forEachInstructionSet([&]() {
+    for (unsigned threads : {1u, 3u}) {
+      std::vector<two<T>> xa = x, xs = x, yg = y;
+      batch::axpy<P>(N, batchSize, alpha.data(), A.data(), strideA, xa.data(),
+                     strideX, threads);
+      batch::scal<P>(N, batchSize, alpha.data(), xs.data(), strideX, threads);
+      batch::gemv<P>(M, N, batchSize, A.data(), lda, strideA, x.data(),
+                     strideX, yg.data(), strideY, threads);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        expectBitwiseEqual(xa[i], axpyExpected[i]);
+        expectBitwiseEqual(xs[i], scalExpected[i]);
+      }
+      for (std::size_t i = 0; i < y.size(); ++i)
+        expectBitwiseEqual(yg[i], gemvExpected[i]);
+    }
+  });
+}
+
+TEST(Blas, BatchTest) {
+  batchTest<policy::doubleword<false>, double>();
+  batchTest<policy::doubleword<false>, float>();
+  batchTest<policy::pair<false>, double>();
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  batchTest<policy::doubleword<true>, double>();
+}
+
+}  // namespace test
+}  // namespace blas
+}  // namespace twofloat
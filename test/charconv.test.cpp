@@ -0,0 +1,165 @@
+#include <cmath>
+#include <cstring>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/charconv.hpp>
+#include <libtwofloat/details/double-word-trig-tables.hpp>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace test {
+
+using doubleword::Mode;
+
+template <typename T>
+two<T> parse(const std::string &s) {
+  two<T> x;
+  const std::from_chars_result res =
+      from_chars(s.data(), s.data() + s.size(), x);
+  EXPECT_EQ(res.ec, std::errc()) << s;
+  EXPECT_EQ(res.ptr, s.data() + s.size()) << s;
+  return x;
+}
+
+template <typename T>
+std::string print(const two<T> &x, int precision) {
+  char buffer[64];
+  const std::to_chars_result res =
+      to_chars(buffer, buffer + sizeof(buffer), x, precision);
+  EXPECT_EQ(res.ec, std::errc());
+  return std::string(buffer, res.ptr);
+}
+
+/// \brief Returns `|x - y|` relative to `|y|`.
+template <typename T>
+double error(const two<T> &x, const two<T> &y) {
+  const two<T> d = doubleword::sub<Mode::Accurate>(x, y);
+  return std::abs(double(d.h) / double(y.h));
+}
+
+TEST(FromCharsTest, Constants) {
+  using C = doubleword::details::trigTables<double>;
+  const two<double> pi(2 * C::halfPi[0], 2 * C::halfPi[1]);
+  EXPECT_LE(error(parse<double>("3.14159265358979323846264338327950288"), pi),
+            1e-32);
+  const two<double> tenth =
+      doubleword::div<Mode::Accurate, true>(two<double>(1), two<double>(10));
+  EXPECT_LE(error(parse<double>("0.1"), tenth), 1e-32);
+  EXPECT_LE(error(parse<double>("1e-1"), tenth), 1e-32);
+
+  // Exact values
+  const two<double> x = parse<double>("123456789012345678901234567890");
+  EXPECT_EQ(x.h, 123456789012345678901234567890.0);
+  EXPECT_EQ(parse<double>("1e22").h, 1e22);
+  EXPECT_EQ(parse<double>("1e22").l, 0);
+  EXPECT_EQ(parse<double>("-0.5").h, -0.5);
+  EXPECT_EQ(parse<double>("-0.5").l, 0);
+  EXPECT_EQ(parse<double>("4.9406564584124654e-324").h,
+            std::numeric_limits<double>::denorm_min());
+  EXPECT_EQ(parse<double>("1.7976931348623157e308").h,
+            std::numeric_limits<double>::max());
+}
+
+TEST(FromCharsTest, Syntax) {
+  EXPECT_EQ(parse<double>("1.5E+3").h, 1500);
+  EXPECT_EQ(parse<double>(".25").h, 0.25);
+  EXPECT_EQ(parse<double>("7.").h, 7);
+  EXPECT_TRUE(std::signbit(parse<double>("-0").h));
+  EXPECT_TRUE(std::isinf(parse<double>("-Infinity").h));
+  EXPECT_TRUE(std::isinf(parse<double>("inf").h));
+  EXPECT_TRUE(std::isnan(parse<double>("nan(123)").h));
+
+  // The parse stops before an exponent without digits
+  const std::string s = "2.5e+x";
+  two<double> x;
+  std::from_chars_result res = from_chars(s.data(), s.data() + s.size(), x);
+  EXPECT_EQ(res.ec, std::errc());
+  EXPECT_EQ(res.ptr, s.data() + 3);
+  EXPECT_EQ(x.h, 2.5);
+
+  // Errors leave the value unmodified
+  for (const char *bad : {"", "-", ".", "e5", "+1", "x"}) {
+    x = two<double>(42);
+    res = from_chars(bad, bad + std::strlen(bad), x);
+    EXPECT_EQ(res.ec, std::errc::invalid_argument) << bad;
+    EXPECT_EQ(res.ptr, bad);
+    EXPECT_EQ(x.h, 42);
+  }
+  for (const char *big : {"1e309", "1e-400", "-2e400"}) {
+    res = from_chars(big, big + std::strlen(big), x);
+    EXPECT_EQ(res.ec, std::errc::result_out_of_range) << big;
+    EXPECT_EQ(res.ptr, big + std::strlen(big));
+    EXPECT_EQ(x.h, 42);
+  }
+  const char *big = "1e39";
+  two<float> f(1);
+  res = from_chars(big, big + 4, f);
+  EXPECT_EQ(res.ec, std::errc::result_out_of_range);
+  EXPECT_EQ(f.h, 1);
+}
+
+TEST(ToCharsTest, Format) {
+  using C = doubleword::details::trigTables<double>;
+  const two<double> pi(2 * C::halfPi[0], 2 * C::halfPi[1]);
+  EXPECT_EQ(print(pi, 32), "3.1415926535897932384626433832795e+00");
+  EXPECT_EQ(print(pi, 1), "3e+00");
+  EXPECT_EQ(print(two<double>(-1e-300), 3), "-1.00e-300");
+  EXPECT_EQ(print(two<double>(0.5), 2), "5.0e-01");
+  EXPECT_EQ(print(two<double>(9.96), 2), "1.0e+01");
+  EXPECT_EQ(print(two<double>(0), 3), "0.00e+00");
+  EXPECT_EQ(print(two<double>(-0.0), 1), "-0e+00");
+  EXPECT_EQ(print(two<double>(1, 0x1p-60), 20), "1.0000000000000000009e+00");
+  EXPECT_EQ(print(two<double>(std::numeric_limits<double>::infinity()), 5),
+            "inf");
+  EXPECT_EQ(print(two<double>(-std::numeric_limits<double>::quiet_NaN()), 5),
+            "-nan");
+  EXPECT_EQ(print(two<double>(std::numeric_limits<double>::denorm_min()), 5),
+            "4.9407e-324");
+
+  // The default precision
+  char buffer[64];
+  std::to_chars_result res = to_chars(buffer, buffer + 64, two<double>(1));
+  EXPECT_EQ(std::string(buffer, res.ptr),
+            "1.0000000000000000000000000000000e+00");
+  res = to_chars(buffer, buffer + 64, two<float>(1));
+  EXPECT_EQ(std::string(buffer, res.ptr), "1.00000000000000e+00");
+
+  res = to_chars(buffer, buffer + 8, pi);
+  EXPECT_EQ(res.ec, std::errc::value_too_large);
+  EXPECT_EQ(res.ptr, buffer + 8);
+}
+
+/// \brief Prints and parses random numbers whose low words are normal.
+template <typename T>
+void roundTripTest(int precision, double tolerance, int maxExponent) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<T> mantissa(1, 10);
+  std::uniform_int_distribution<int> exponent(-maxExponent, maxExponent);
+  for (int i = 0; i < 10000; ++i) {
+    const T scale = std::pow(T(10), T(exponent(gen)));
+    const two<T> x = algorithms::FastTwoSum(
+        mantissa(gen) * scale,
+        mantissa(gen) * scale * std::numeric_limits<T>::epsilon() / 64);
+    const std::string s = print(x, precision);
+    const two<T> y = parse<T>(s);
+    ASSERT_LE(error(y, x), tolerance) << s;
+    // The default precision is short enough that printing the parsed number
+    // gives the same string
+    if (precision <= std::numeric_limits<two<T>>::digits10 + 1) {
+      ASSERT_EQ(print(y, precision), s);
+    }
+  }
+}
+
+TEST(ToCharsTest, RoundTripDouble) {
+  roundTripTest<double>(32, 1e-31, 280);
+  roundTripTest<double>(34, 1e-32, 280);
+}
+
+TEST(ToCharsTest, RoundTripFloat) { roundTripTest<float>(15, 1e-14, 20); }
+
+}  // namespace test
+}  // namespace twofloat
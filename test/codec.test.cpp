@@ -0,0 +1,184 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/codec.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <limits>
+#include <random>
+#include <system_error>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace codec {
+namespace test {
+
+using twofloat::test::expectBitwiseEqualArrays;
+
+/// \brief Returns `n` random numbers whose low words have all their bits.
+template <typename T>
+soa_vector<T> randomNumbers(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> dist(-1, 1);
+  soa_vector<T> v(n);
+  for (std::size_t i = 0; i < n; ++i)
+    v[i] = algorithms::FastTwoSum(
+        dist(gen), dist(gen) * std::numeric_limits<T>::epsilon());
+  return v;
+}
+
+/// \brief Returns samples of a smooth function, as double-word numbers.
+template <typename T>
+soa_vector<T> smoothNumbers(std::size_t n) {
+  soa_vector<T> v(n);
+  for (std::size_t i = 0; i < n; ++i)
+    v[i] = algorithms::TwoProd(T(1) + T(i) / T(n), T(3) + T(i % 7) / T(8));
+  return v;
+}
+
+template <typename T>
+std::vector<std::uint8_t> roundTrip(const soa_vector<T> &values,
+                                    unsigned threads = 0) {
+  const std::vector<std::uint8_t> data =
+      encode(soa_span<const T>(values), threads);
+  soa_vector<T> decoded;
+  EXPECT_FALSE(decode(span<const std::uint8_t>(data), decoded, threads));
+  expectBitwiseEqualArrays<two<T>>(decoded, values);
+  return data;
+}
+
+template <typename T>
+void roundTripTest() {
+  for (std::size_t n : {0, 1, 2, 1000, 200000}) {
+    roundTrip(randomNumbers<T>(n, static_cast<unsigned>(n)));
+    roundTrip(smoothNumbers<T>(n));
+  }
+  // Numbers converted from T
+  soa_vector<T> v = randomNumbers<T>(5000, 3);
+  for (std::size_t i = 0; i < v.size(); ++i) v.l_data()[i] = 0;
+  roundTrip(v);
+}
+
+TEST(CodecTest, RoundTripDouble) { roundTripTest<double>(); }
+
+TEST(CodecTest, RoundTripFloat) { roundTripTest<float>(); }
+
+TEST(CodecTest, SpecialValues) {
+  using L = std::numeric_limits<double>;
+  const double specials[] = {0.0,          -0.0,       L::infinity(),
+                             -L::infinity(), L::quiet_NaN(), L::denorm_min(),
+                             L::min(),     L::max(),   1.0,
+                             -3.5};
+  // Every pair, including unnormalized ones
+  soa_vector<double> v(100);
+  for (std::size_t i = 0; i < 100; ++i) {
+    v.h_data()[i] = specials[i / 10];
+    v.l_data()[i] = specials[i % 10];
+  }
+  roundTrip(v);
+}
+
+TEST(CodecTest, Ratio) {
+  // Numbers converted from T take about half of their size
+  soa_vector<double> v = randomNumbers<double>(100000, 4);
+  for (std::size_t i = 0; i < v.size(); ++i) v.l_data()[i] = 0;
+  EXPECT_LT(roundTrip(v).size(), 0.55 * 16 * v.size());
+  // The exponents of full-precision low words are predicted from the high
+  // words
+  v = randomNumbers<double>(100000, 5);
+  EXPECT_LT(roundTrip(v).size(), 0.95 * 16 * v.size());
+  v = smoothNumbers<double>(100000);
+  EXPECT_LT(roundTrip(v).size(), 0.6 * 16 * v.size());
+}
+
+TEST(CodecTest, Deterministic) {
+  const soa_vector<double> v = randomNumbers<double>(300000, 6);
+  EXPECT_EQ(roundTrip(v, 1), roundTrip(v, 3));
+}
+
+TEST(CodecTest, Errors) {
+  const soa_vector<double> v = smoothNumbers<double>(100000);
+  std::vector<std::uint8_t> data = encode(soa_span<const double>(v));
+  soa_vector<double> decoded(1);
+  const auto check = [&](const std::vector<std::uint8_t> &bad,
+                         std::errc expected) {
+    EXPECT_EQ(decode(span<const std::uint8_t>(bad), decoded), expected);
+    EXPECT_EQ(decoded.size(), 1u);
+  };
+
+  // Another floating point type
+  soa_vector<float> floats;
+  EXPECT_EQ(decode(span<const std::uint8_t>(data), floats),
+            std::errc::invalid_argument);
+  // Truncated streams
+  for (std::size_t n : {std::size_t(0), std::size_t(31), data.size() - 1})
+    check(std::vector<std::uint8_t>(data.begin(), data.begin() + n),
+          std::errc::invalid_argument);
+  // Another version
+  std::vector<std::uint8_t> bad = data;
+  ++bad[7];
+  check(bad, std::errc::not_supported);
+  // Corrupted headers of the planes
+  const std::size_t firstPlane = details::headerSize + 8 * 2;
+  for (std::uint8_t mode : {3, 2}) {
+    bad = data;
+    bad[firstPlane] = mode;
+    check(bad, std::errc::invalid_argument);
+  }
+  // Bad magic
+  bad = data;
+  bad[0] = 'X';
+  check(bad, std::errc::invalid_argument);
+  // Bad lengths: the number of numbers, the block size and a block length
+  const auto setLength = [&](std::size_t offset, std::uint64_t value) {
+    bad = data;
+    for (std::size_t i = 0; i < 8; ++i)
+      bad[offset + i] = static_cast<std::uint8_t>(value >> (8 * i));
+  };
+  for (std::uint64_t n : {std::uint64_t(v.size() + 1),
+                          std::uint64_t(v.size() - 1), std::uint64_t(1) << 40,
+                          std::numeric_limits<std::uint64_t>::max()}) {
+    setLength(16, n);
+    check(bad, std::errc::invalid_argument);
+  }
+  for (std::uint64_t size : {std::uint64_t(0), std::uint64_t(1) << 15,
+                             std::numeric_limits<std::uint64_t>::max()}) {
+    setLength(24, size);
+    check(bad, std::errc::invalid_argument);
+  }
+  setLength(details::headerSize, 0);
+  check(bad, std::errc::invalid_argument);
+  setLength(details::headerSize, std::numeric_limits<std::uint64_t>::max());
+  check(bad, std::errc::invalid_argument);
+  // A forged header alone, which claims many numbers in large blocks
+  bad.assign(data.begin(), data.begin() + details::headerSize);
+  for (std::uint64_t n : {std::uint64_t(1) << 40,
+                          std::numeric_limits<std::uint64_t>::max()})
+    for (std::uint64_t size : {std::uint64_t(1),
+                               std::uint64_t(details::maxBlockSize)}) {
+      for (std::size_t i = 0; i < 8; ++i) {
+        bad[16 + i] = static_cast<std::uint8_t>(n >> (8 * i));
+        bad[24 + i] = static_cast<std::uint8_t>(size >> (8 * i));
+      }
+      check(bad, std::errc::invalid_argument);
+    }
+
+  // Flipped bits are either detected or decode to as many numbers
+  std::mt19937 gen(8);
+  std::uniform_int_distribution<std::size_t> position(0, data.size() - 1);
+  for (int i = 0; i < 50; ++i) {
+    bad = data;
+    bad[position(gen)] ^= static_cast<std::uint8_t>(1u << (i % 8));
+    soa_vector<double> other;
+    if (!decode(span<const std::uint8_t>(bad), other)) {
+      EXPECT_EQ(other.size(), v.size());
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace codec
+}  // namespace twofloat
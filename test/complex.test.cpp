@@ -0,0 +1,181 @@
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/complex.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace doubleword {
+namespace test {
+
+using twofloat::test::expectBitwiseEqual;
+using twofloat::test::forEachInstructionSet;
+using twofloat::test::randomTwo;
+
+template <typename T>
+std::vector<complex<T>> numbers(std::size_t n, unsigned seed) {
+  randomTwo<T> random(seed, T(1e-9));
+  std::vector<complex<T>> v(n);
+  for (complex<T> &z : v) {
+    z.re = random();
+    z.im = random();
+  }
+  return v;
+}
+
+/// \brief The product composed of the double-word operations, which
+/// normalize every intermediate result.
+template <typename T>
+complex<T> composedMul(const complex<T> &x, const complex<T> &y) {
+  return {sub<Mode::Accurate>(mul<Mode::Accurate, true>(x.re, y.re),
+                              mul<Mode::Accurate, true>(x.im, y.im)),
+          add<Mode::Accurate>(mul<Mode::Accurate, true>(x.re, y.im),
+                              mul<Mode::Accurate, true>(x.im, y.re))};
+}
+
+/// \brief Returns `|x - y|` relative to `|y|`, in the maximum norm of the
+/// parts.
+template <typename T>
+double error(const complex<T> &x, const complex<T> &y) {
+  const two<T> dr = sub<Mode::Accurate>(x.re, y.re);
+  const two<T> di = sub<Mode::Accurate>(x.im, y.im);
+  const double e = std::max(std::abs(double(dr.h)), std::abs(double(di.h)));
+  return e / std::max(std::abs(double(y.re.h)), std::abs(double(y.im.h)));
+}
+
+TEST(ComplexTest, Exact) {
+  const complex<double> i(two<double>(0), two<double>(1));
+  expectBitwiseEqual(mul<true>(i, i), complex<double>(two<double>(-1)));
+  expectBitwiseEqual(mul<false>(i, i), complex<double>(two<double>(-1)));
+
+  // (1 + 2i) (3 + 4i) = -5 + 10i, and (-5 + 10i) / (3 + 4i) = 1 + 2i
+  const complex<double> x(two<double>(1), two<double>(2));
+  const complex<double> y(two<double>(3), two<double>(4));
+  const complex<double> p(two<double>(-5), two<double>(10));
+  expectBitwiseEqual(mul<true>(x, y), p);
+  expectBitwiseEqual(div<true>(p, y), x);
+  EXPECT_EQ(norm<true>(y).h, 25);
+  EXPECT_EQ(norm<true>(y).l, 0);
+  // The negated low word is a negative zero
+  expectBitwiseEqual(conj(x),
+                     complex<double>(two<double>(1), two<double>(-2, -0.0)));
+  expectBitwiseEqual(add<Mode::Accurate>(x, y),
+                     complex<double>(two<double>(4), two<double>(6)));
+  expectBitwiseEqual(sub<Mode::Accurate>(x, y),
+                     complex<double>(two<double>(-2), two<double>(-2)));
+}
+
+template <typename T>
+void accuracyTest(double tolerance) {
+  const std::vector<complex<T>> x = numbers<T>(1000, 1),
+                                y = numbers<T>(1000, 2);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    const complex<T> expected = composedMul(x[i], y[i]);
+    EXPECT_LE(error(mul<true>(x[i], y[i]), expected), tolerance);
+    EXPECT_LE(error(mul<false>(x[i], y[i]), expected), tolerance);
+    EXPECT_LE(error(composedMul(div<true>(x[i], y[i]), y[i]), x[i]),
+              4 * tolerance);
+    EXPECT_LE(error(composedMul(div<false>(x[i], y[i]), y[i]), x[i]),
+              4 * tolerance);
+  }
+}
+
+TEST(ComplexTest, AccuracyDouble) { accuracyTest<double>(1e-31); }
+
+TEST(ComplexTest, AccuracyFloat) { accuracyTest<float>(1e-13); }
+
+TEST(ComplexTest, Vector) {
+  // The lanes of a vector give the same results as single numbers
+  using V = simd<double, 4>;
+  const std::vector<complex<double>> x = numbers<double>(4, 3),
+                                     y = numbers<double>(4, 4);
+  complex<V> xv, yv;
+  double lanes[8][4];
+  for (std::size_t k = 0; k < 4; ++k) {
+    lanes[0][k] = x[k].re.h, lanes[1][k] = x[k].re.l;
+    lanes[2][k] = x[k].im.h, lanes[3][k] = x[k].im.l;
+    lanes[4][k] = y[k].re.h, lanes[5][k] = y[k].re.l;
+    lanes[6][k] = y[k].im.h, lanes[7][k] = y[k].im.l;
+  }
+  xv = {two<V>(V::load(lanes[0]), V::load(lanes[1])),
+        two<V>(V::load(lanes[2]), V::load(lanes[3]))};
+  yv = {two<V>(V::load(lanes[4]), V::load(lanes[5])),
+        two<V>(V::load(lanes[6]), V::load(lanes[7]))};
+  const complex<V> p = mul<true>(xv, yv), q = div<true>(xv, yv);
+  for (std::size_t k = 0; k < 4; ++k) {
+    expectBitwiseEqual(complex<double>(two<double>(p.re.h[k], p.re.l[k]),
+                                       two<double>(p.im.h[k], p.im.l[k])),
+                       mul<true>(x[k], y[k]));
+    expectBitwiseEqual(complex<double>(two<double>(q.re.h[k], q.re.l[k]),
+                                       two<double>(q.im.h[k], q.im.l[k])),
+                       div<true>(x[k], y[k]));
+  }
+}
+
+TEST(ComplexTest, Batch) {
+  const std::size_t n = 37;
+  const std::vector<complex<double>> x = numbers<double>(n, 5),
+                                     y = numbers<double>(n, 6);
+  soa_vector<double> xRe(n), xIm(n), yRe(n), yIm(n), zRe(n), zIm(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    xRe[i] = x[i].re, xIm[i] = x[i].im;
+    yRe[i] = y[i].re, yIm[i] = y[i].im;
+  }
+  auto result = [&](std::size_t i) {
+    return complex<double>(zRe[i], zIm[i]);
+  };
+
+  forEachInstructionSet([&]() {
+    batch::mul<true, double>(xRe, xIm, yRe, yIm, zRe, zIm);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(result(i), mul<true>(x[i], y[i]));
+    batch::div<true, double>(xRe, xIm, yRe, yIm, zRe, zIm);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(result(i), div<true>(x[i], y[i]));
+    batch::add<Mode::Accurate, double>(xRe, xIm, yRe, yIm, zRe, zIm);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(result(i), add<Mode::Accurate>(x[i], y[i]));
+    batch::sub<Mode::Accurate, double>(xRe, xIm, yRe, yIm, zRe, zIm);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(result(i), sub<Mode::Accurate>(x[i], y[i]));
+
+    // In place
+    soa_vector<double> aRe = xRe, aIm = xIm;
+    batch::mul<true, double>(aRe, aIm, yRe, yIm, aRe, aIm);
+    for (std::size_t i = 0; i < n; ++i)
+      expectBitwiseEqual(complex<double>(aRe[i], aIm[i]),
+                         mul<true>(x[i], y[i]));
+  });
+}
+
+TEST(ComplexTest, BatchSizes) {
+  const std::size_t n = 5;
+  soa_vector<double> x(n), y(n), z(n), shorter(n - 1);
+  EXPECT_THROW((batch::add<Mode::Accurate, double>(shorter, x, y, y, z, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::sub<Mode::Accurate, double>(x, shorter, y, y, z, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::mul<true, double>(x, x, shorter, y, z, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::div<true, double>(x, x, y, shorter, z, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::mul<true, double>(x, x, y, y, shorter, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::mul<true, double>(x, x, y, y, z, shorter)),
+               std::invalid_argument);
+}
+
+TEST(ComplexTest, Constexpr) {
+  constexpr complex<double> x(two<double>(1), two<double>(2));
+  constexpr complex<double> p = mul<true>(x, x);
+  static_assert(p.re.h == -3 && p.im.h == 4);
+}
+
+}  // namespace test
+}  // namespace doubleword
+}  // namespace twofloat
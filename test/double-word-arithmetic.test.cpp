@@ -1,8 +1,11 @@
+#include <array>
+#include <cmath>
 #include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/details/double-word-tables.hpp>
 #include <libtwofloat/limits.hpp>
 #include <limits>
-#include <random>
 
+#include "exact.hpp"
 #include "gtest/gtest.h"
 
 using namespace twofloat;
@@ -255,6 +258,104 @@ TEST(DoubleWordArithmetic, DivFPTest) { divFPTest<false>(); }
 
 TEST(DoubleWordArithmetic, DivFPFMATest) { divFPTest<true>(); }
 
+/// \brief Checks the error bound of `fma` relative to `|x.h y.h| + |z.h|`,
+/// also when the sum cancels, and that `FastTwoSum` is exact for the
+/// normalization of normalized operands.
+template <Mode mulMode, bool useFMA>
+void fmaTest() {
+  using twofloat::test::exact;
+  using twofloat::test::exactProduct;
+  using twofloat::test::exactValue;
+  using twofloat::test::expectBitwiseEqual;
+  using twofloat::test::randomTwo;
+  using E = expansion<double, 2>;
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+  const auto error = [](const two<double> &x, const two<double> &y,
+                        const two<double> &z, const two<double> &r) {
+    exact e = exactProduct(E(x), E(y));
+    e.add(E(z));
+    return std::abs(exactValue(E(r)).minus(e)) /
+           (std::abs(x.h * y.h) + std::abs(z.h));
+  };
+  randomTwo<double> random(1, u);
+  double maxError = 0, maxErrorFP = 0, maxErrorUnnormalized = 0;
+  for (int i = 0; i < 3000; ++i) {
+    const two<double> x = random(), y = random();
+    two<double> z = random();
+    // The sums cancel partially or completely
+    if (i % 3 == 1)
+      z = sub<Mode::Accurate>(two<double>(random.uniform() * 0x1p-40),
+                              mul<mulMode, useFMA>(x, y));
+    else if (i % 3 == 2)
+      z = sub<Mode::Accurate>(two<double>(0.0), mul<mulMode, useFMA>(x, y));
+
+    const two<double> r = fma<mulMode, Mode::Accurate, useFMA>(x, y, z);
+    EXPECT_EQ(r.h + r.l, r.h);
+    expectBitwiseEqual(fma<mulMode, Mode::Sloppy, useFMA>(x, y, z), r);
+    maxError = std::max(maxError, error(x, y, z, r));
+
+    const two<double> rFP = fma<mulMode, Mode::Accurate, useFMA>(x, y.h, z);
+    expectBitwiseEqual(fma<mulMode, Mode::Sloppy, useFMA>(x, y.h, z), rFP);
+    maxErrorFP = std::max(maxErrorFP, error(x, two<double>(y.h), z, rFP));
+
+    // Low words of up to 4 ulps, like the results of the pair arithmetic
+    const two<double> zu(z.h, random.uniform() * 8 * u * z.h);
+    const two<double> ru = fma<mulMode, Mode::Accurate, useFMA>(x, y, zu);
+    maxErrorUnnormalized = std::max(maxErrorUnnormalized, error(x, y, zu, ru));
+  }
+  EXPECT_LE(maxError, 12 * u * u);
+  EXPECT_LE(maxErrorFP, 12 * u * u);
+  EXPECT_LE(maxErrorUnnormalized, 20 * u * u);
+}
+
+TEST(DoubleWordArithmetic, FmaTest) {
+  fmaTest<Mode::Fast, false>();
+  fmaTest<Mode::Fast, true>();
+  fmaTest<Mode::Accurate, true>();
+}
+
+/// \brief Calculates 1/k! for k = 0, ..., 11.
+template <bool useFMA>
+constexpr std::array<two<double>, 12> invFactorials() {
+  std::array<two<double>, 12> res{};
+  res[0] = two<double>(1.0);
+  for (int k = 1; k < 12; ++k)
+    res[k] = div<useFMA>(res[k - 1], double(k));
+  return res;
+}
+
+// The arithmetic and the error-free transformations work at compile time
+constexpr two<double> third =
+    div<Mode::Fast, false>(two<double>(1.0), two<double>(3.0));
+static_assert(third.h == 1.0 / 3);
+static_assert(algorithms::TwoProd<double, true>(third.h, 3.0).l ==
+              algorithms::TwoProd<double, false>(third.h, 3.0).l);
+static_assert(algorithms::Split(1e300).h + algorithms::Split(1e300).l == 1e300);
+static_assert(mul<Mode::Accurate, true>(third, two<double>(3.0)).eval() == 1.0);
+
+template <bool useFMA>
+void constexprTest() {
+  constexpr std::array<two<double>, 12> table = invFactorials<useFMA>();
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+
+  // The same calculation at runtime gives the same bits
+  volatile double one = 1.0;
+  two<double> f(one);
+  for (int k = 1; k < 12; ++k) {
+    f = div<useFMA>(f, double(k));
+    EXPECT_EQ(f.h, table[k].h);
+    EXPECT_EQ(f.l, table[k].l);
+
+    const auto &expected = details::tables<double>::invFactorial[k];
+    EXPECT_LE(std::abs((table[k].h - expected[0]) + (table[k].l - expected[1])),
+              4 * k * u * u * expected[0]);
+  }
+}
+
+TEST(DoubleWordArithmetic, ConstexprTest) { constexprTest<false>(); }
+
+TEST(DoubleWordArithmetic, ConstexprFMATest) { constexprTest<true>(); }
+
 }  // namespace test
 }  // namespace doubleword
 }  // namespace twofloat
\ No newline at end of file
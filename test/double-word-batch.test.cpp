@@ -0,0 +1,153 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/dispatch.hpp>
+#include <libtwofloat/arithmetics/double-word-batch.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace doubleword {
+namespace test {
+
+using twofloat::test::expectBitwiseEqual;
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::forEachInstructionSet;
+
+/// \brief Creates `n` random normalized double-word numbers. Some of them are
+/// large enough to require scaling in algorithms::Split.
+template <typename T>
+soa_vector<T> randomNumbers(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> mantissa(-1, 1);
+  std::uniform_int_distribution<int> exponent(-20, 20);
+
+  soa_vector<T> v;
+  for (std::size_t i = 0; i < n; ++i) {
+    T h = std::ldexp(mantissa(gen), exponent(gen));
+    if (i % 17 == 0)
+      h = std::numeric_limits<T>::max() * mantissa(gen) / 4;
+    T l = h * mantissa(gen) * std::numeric_limits<T>::epsilon();
+    v.push_back(algorithms::FastTwoSum(h, l));
+  }
+  return v;
+}
+
+/// \brief Expects that the batched operation `batchOp` produces bitwise
+/// identical results to the scalar operation `scalarOp`.
+template <typename T, typename BatchOp, typename ScalarOp>
+void expectBitwiseIdentical(BatchOp batchOp, ScalarOp scalarOp) {
+  // Use a size that is not a multiple of the vector width to test the tail
+  const std::size_t n = 1003;
+  soa_vector<T> x = randomNumbers<T>(n, 1);
+  soa_vector<T> y = randomNumbers<T>(n, 2);
+  soa_vector<T> z;
+
+  batchOp(x, y, z);
+  ASSERT_EQ(z.size(), n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    SCOPED_TRACE(i);
+    expectBitwiseEqual(two<T>(z[i]), scalarOp(two<T>(x[i]), two<T>(y[i])));
+  }
+}
+
+template <typename T>
+void batchTest() {
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::add<Mode::Sloppy>(x, y, z); },
+      [](auto x, auto y) { return add<Mode::Sloppy>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::add<Mode::Accurate>(x, y, z); },
+      [](auto x, auto y) { return add<Mode::Accurate>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::sub<Mode::Sloppy>(x, y, z); },
+      [](auto x, auto y) { return sub<Mode::Sloppy>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::sub<Mode::Accurate>(x, y, z); },
+      [](auto x, auto y) { return sub<Mode::Accurate>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) {
+        batch::mul<Mode::Fast, false>(x, y, z);
+      },
+      [](auto x, auto y) { return mul<Mode::Fast, false>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::mul<Mode::Fast, true>(x, y, z); },
+      [](auto x, auto y) { return mul<Mode::Fast, true>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) {
+        batch::mul<Mode::Accurate, true>(x, y, z);
+      },
+      [](auto x, auto y) { return mul<Mode::Accurate, true>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) {
+        batch::div<Mode::Fast, false>(x, y, z);
+      },
+      [](auto x, auto y) { return div<Mode::Fast, false>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) { batch::div<Mode::Fast, true>(x, y, z); },
+      [](auto x, auto y) { return div<Mode::Fast, true>(x, y); });
+  expectBitwiseIdentical<T>(
+      [](auto &x, auto &y, auto &z) {
+        batch::div<Mode::Accurate, true>(x, y, z);
+      },
+      [](auto x, auto y) { return div<Mode::Accurate, true>(x, y); });
+}
+
+TEST(DoubleWordBatch, FloatTest) { forEachInstructionSet(batchTest<float>); }
+
+TEST(DoubleWordBatch, DoubleTest) { forEachInstructionSet(batchTest<double>); }
+
+TEST(DoubleWordBatch, RuntimeFMATest) {
+  // The batched operations without useFMA must select the same algorithm as
+  // the scalar wrappers in dispatch.hpp
+  expectBitwiseIdentical<double>(
+      [](auto &x, auto &y, auto &z) { batch::mul<Mode::Accurate>(x, y, z); },
+      [](auto x, auto y) { return mul<Mode::Accurate>(x, y); });
+  expectBitwiseIdentical<double>(
+      [](auto &x, auto &y, auto &z) { batch::div<Mode::Accurate>(x, y, z); },
+      [](auto x, auto y) { return div<Mode::Accurate>(x, y); });
+
+  // The scalar wrappers must use the FMA algorithm if FMA is available
+  two<double> x(1.0 + std::numeric_limits<double>::epsilon(), 1e-20);
+  two<double> y(3.0, -1e-19);
+  two<double> expected = cpu::hasFMA() ? mul<Mode::Accurate, true>(x, y)
+                                       : mul<Mode::Fast, false>(x, y);
+  expectBitwiseEqual(mul<Mode::Accurate>(x, y), expected);
+}
+
+TEST(DoubleWordBatch, InPlaceTest) {
+  // The output may alias an input
+  soa_vector<double> x = randomNumbers<double>(100, 3);
+  soa_vector<double> y = randomNumbers<double>(100, 4);
+  soa_vector<double> expected;
+  batch::mul<Mode::Accurate, true>(x, y, expected);
+
+  batch::mul<Mode::Accurate, true, double>(x, y, x);
+  expectBitwiseEqualArrays<two<double>>(x, expected);
+}
+
+TEST(DoubleWordBatch, SizesTest) {
+  const soa_vector<double> x(5), shorter(4), longer(6);
+  soa_vector<double> z;
+  EXPECT_THROW(batch::add<Mode::Accurate>(x, shorter, z),
+               std::invalid_argument);
+  EXPECT_THROW(batch::sub<Mode::Accurate>(x, longer, z),
+               std::invalid_argument);
+  EXPECT_THROW((batch::mul<Mode::Accurate, true>(x, shorter, z)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::div<Mode::Fast, false>(x, shorter, z)),
+               std::invalid_argument);
+  EXPECT_THROW(batch::mul<Mode::Accurate>(shorter, x, z),
+               std::invalid_argument);
+  EXPECT_THROW(batch::div<Mode::Accurate>(x, shorter, z),
+               std::invalid_argument);
+  EXPECT_EQ(z.size(), 0u);
+}
+
+}  // namespace test
+}  // namespace doubleword
+}  // namespace twofloat
@@ -0,0 +1,202 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/dispatch.hpp>
+#include <libtwofloat/arithmetics/double-word-batch.hpp>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <random>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace doubleword {
+namespace test {
+
+using twofloat::test::expectBitwiseEqual;
+
+/// \brief Expects that `x` approximates the double-word number `expected`
+/// with a relative error of at most `ulps` u².
+template <typename T>
+void expectNear(const two<T> &x, const two<T> &expected, T ulps) {
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  two<T> diff = sub<Mode::Accurate>(x, expected);
+  EXPECT_LE(std::abs(diff.h), ulps * u * u * std::abs(expected.h))
+      << x.h << " + " << x.l << " != " << expected.h << " + " << expected.l;
+}
+
+template <bool useFMA>
+void sqrtTest() {
+  two<double> sqrt2 = sqrt<useFMA>(two<double>(2.0));
+  expectNear(sqrt2, {0x1.6a09e667f3bcdp+0, -0x1.bdd3413b26456p-54}, 4.0);
+
+  // The square of the square root is the argument
+  two<double> x(3.0, 0x1p-60);
+  two<double> s = sqrt<useFMA>(x);
+  expectNear(mul<Mode::Fast, useFMA>(s, s), x, 8.0);
+
+  two<float> sqrt2f = sqrt<useFMA>(two<float>(2.0f));
+  EXPECT_NEAR(sqrt2f.eval<double>(), std::sqrt(2.0), 1e-14);
+
+  EXPECT_EQ(sqrt<useFMA>(two<double>(0.0)).eval(), 0.0);
+  EXPECT_EQ(sqrt<useFMA>(two<double>(INFINITY)).h, INFINITY);
+  EXPECT_EQ(sqrt<useFMA>(two<double>(INFINITY)).l, 0.0);
+  EXPECT_TRUE(std::isnan(sqrt<useFMA>(two<double>(-1.0)).h));
+}
+
+template <bool useFMA>
+void expTest() {
+  expectNear(exp<useFMA>(two<double>(1.0)),
+             {0x1.5bf0a8b145769p+1, 0x1.4d57ee2b1013ap-53}, 4.0);
+  expectNear(exp<useFMA>(two<double>(-10.0)),
+             {0x1.7cd79b5647c9bp-15, -0x1.8e936e2abd9dep-69}, 16.0);
+
+  // The reduction is exact, so multiples of log(2) give powers of two
+  two<double> ln2(0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56);
+  for (int k : {-1000, -3, 0, 7, 1020}) {
+    two<double> x = mul<Mode::Accurate, useFMA>(ln2, double(k));
+    expectNear(exp<useFMA>(x), two<double>(std::ldexp(1.0, k)),
+               16.0 * (std::abs(k) + 1));
+  }
+
+  two<float> ef = exp<useFMA>(two<float>(1.0f));
+  EXPECT_NEAR(ef.eval<double>(), 0x1.5bf0a8b145769p+1, 1e-13);
+
+  EXPECT_EQ(exp<useFMA>(two<double>(0.0)).eval(), 1.0);
+  EXPECT_EQ(exp<useFMA>(two<double>(1000.0)).h, INFINITY);
+  EXPECT_EQ(exp<useFMA>(two<double>(INFINITY)).h, INFINITY);
+  EXPECT_EQ(exp<useFMA>(two<double>(-1000.0)).eval(), 0.0);
+  EXPECT_EQ(exp<useFMA>(two<double>(-INFINITY)).eval(), 0.0);
+  EXPECT_TRUE(std::isnan(exp<useFMA>(two<double>(NAN)).h));
+  EXPECT_EQ(exp<useFMA>(two<float>(100.0f)).h, INFINITY);
+}
+
+template <bool useFMA>
+void logTest() {
+  expectNear(log<useFMA>(two<double>(2.0)),
+             {0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56}, 4.0);
+  expectNear(log<useFMA>(two<double>(10.0)),
+             {0x1.26bb1bbb55516p+1, -0x1.f48ad494ea3e9p-53}, 4.0);
+
+  // log and exp are inverse to each other, as long as the low word of the
+  // exponential is not subnormal
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-600, 700);
+  for (int i = 0; i < 1000; ++i) {
+    two<double> x(dist(gen));
+    two<double> y = log<useFMA>(exp<useFMA>(x));
+    expectNear(y, x, 16.0);
+  }
+
+  two<float> lf = log<useFMA>(two<float>(10.0f));
+  EXPECT_NEAR(lf.eval<double>(), 0x1.26bb1bbb55516p+1, 1e-13);
+
+  EXPECT_EQ(log<useFMA>(two<double>(1.0)).eval(), 0.0);
+  EXPECT_EQ(log<useFMA>(two<double>(0.0)).h, -INFINITY);
+  EXPECT_EQ(log<useFMA>(two<double>(INFINITY)).h, INFINITY);
+  EXPECT_TRUE(std::isnan(log<useFMA>(two<double>(-1.0)).h));
+  EXPECT_TRUE(std::isnan(log<useFMA>(two<double>(NAN)).h));
+  // Subnormal numbers
+  expectNear(log<useFMA>(two<double>(0x1p-1070)),
+             mul<Mode::Accurate, useFMA>(
+                 two<double>(0x1.62e42fefa39efp-1, 0x1.abc9e3b39803fp-56),
+                 -1070.0),
+             4.0);
+}
+
+TEST(DoubleWordFunctions, SqrtTest) { sqrtTest<false>(); }
+TEST(DoubleWordFunctions, ExpTest) { expTest<false>(); }
+TEST(DoubleWordFunctions, LogTest) { logTest<false>(); }
+
+TEST(DoubleWordFunctions, FMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  sqrtTest<true>();
+  expTest<true>();
+  logTest<true>();
+}
+
+/// \brief Creates double-word numbers in a range where exp neither overflows
+/// nor underflows, including special values.
+template <typename T>
+soa_vector<T> arguments(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> dist(-80, 80);
+  std::uniform_real_distribution<T> low(-1, 1);
+
+  soa_vector<T> v;
+  for (std::size_t i = 0; i < n; ++i) {
+    T h = dist(gen);
+    v.push_back(algorithms::FastTwoSum(
+        h, h * low(gen) * std::numeric_limits<T>::epsilon()));
+  }
+  for (T special : {T(0), T(-1), T(INFINITY), T(-INFINITY), T(NAN)})
+    v.push_back(two<T>(special));
+  return v;
+}
+
+/// \brief Expects that the vector and batched versions of the function give
+/// bitwise identical results to the scalar version.
+template <typename T, typename Scalar, typename Batch>
+void vectorTest(Scalar scalar, Batch batchOp) {
+  soa_vector<T> x = arguments<T>(1000, 1);
+  soa_vector<T> y;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    two<T> xi = x[i];
+    y.push_back(xi.h < 0 ? two<T>(-xi.h, -xi.l) : xi);
+  }
+
+  // Negative and positive arguments for exp, positive ones for sqrt and log
+  for (const soa_vector<T> *args : {&x, &y}) {
+    soa_vector<T> z;
+    batchOp(*args, z);
+    ASSERT_EQ(z.size(), args->size());
+
+    using V = simd<T, 4>;
+    for (std::size_t i = 0; i + V::size() <= z.size(); i += V::size()) {
+      two<V> v(V::load(args->h_data() + i), V::load(args->l_data() + i));
+      two<V> r = scalar(v);
+      for (std::size_t k = 0; k < V::size(); ++k) {
+        two<T> expected = scalar(two<T>((*args)[i + k]));
+        expectBitwiseEqual(two<T>(z[i + k]), expected, true);
+        expectBitwiseEqual(two<T>(r.h.v[k], r.l.v[k]), expected, true);
+      }
+    }
+  }
+}
+
+template <typename T, bool useFMA>
+void batchTest() {
+  vectorTest<T>([](const auto &x) { return sqrt<useFMA>(x); },
+                [](auto &x, auto &z) { batch::sqrt<useFMA>(x, z); });
+  vectorTest<T>([](const auto &x) { return exp<useFMA>(x); },
+                [](auto &x, auto &z) { batch::exp<useFMA>(x, z); });
+  vectorTest<T>([](const auto &x) { return log<useFMA>(x); },
+                [](auto &x, auto &z) { batch::log<useFMA>(x, z); });
+}
+
+TEST(DoubleWordFunctions, BatchTest) {
+  batchTest<float, false>();
+  batchTest<double, false>();
+  if (cpu::hasFMA()) {
+    batchTest<float, true>();
+    batchTest<double, true>();
+  }
+}
+
+TEST(DoubleWordFunctions, RuntimeFMATest) {
+  two<double> x(2.5, 1e-20);
+  if (cpu::hasFMA()) {
+    expectBitwiseEqual(exp(x), exp<true>(x), true);
+    expectBitwiseEqual(log(x), log<true>(x), true);
+    expectBitwiseEqual(sqrt(x), sqrt<true>(x), true);
+  } else {
+    expectBitwiseEqual(exp(x), exp<false>(x), true);
+    expectBitwiseEqual(log(x), log<false>(x), true);
+    expectBitwiseEqual(sqrt(x), sqrt<false>(x), true);
+  }
+}
+
+}  // namespace test
+}  // namespace doubleword
+}  // namespace twofloat
@@ -0,0 +1,233 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/dispatch.hpp>
+#include <libtwofloat/arithmetics/double-word-batch.hpp>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <random>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace doubleword {
+namespace test {
+
+using twofloat::test::expectBitwiseEqual;
+
+/// \brief Expects that `x` approximates `expected` with an error of at most
+/// `ulps` u² relative to `scale`.
+template <typename T>
+void expectWithin(const two<T> &x, const two<T> &expected, T ulps, T scale) {
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  two<T> diff = sub<Mode::Accurate>(x, expected);
+  EXPECT_LE(std::abs(diff.h), ulps * u * u * scale)
+      << x.h << " + " << x.l << " != " << expected.h << " + " << expected.l;
+}
+
+template <typename T>
+void expectRelative(const two<T> &x, const two<T> &expected, T ulps) {
+  expectWithin(x, expected, ulps, std::abs(expected.h));
+}
+
+/// \brief The references were computed with exact rational arithmetic.
+template <bool useFMA>
+void sinCosTest() {
+  struct {
+    double x;
+    two<double> sin, cos, tan;
+  } references[] = {
+      {1.0,
+       {0x1.aed548f090ceep-1, 0x1.06374f484e288p-59},
+       {0x1.14a280fb5068cp-1, -0x1.b71edcc9344bcp-55},
+       {0x1.8eb245cbee3a6p+0, -0x1.1d4ce0afb373bp-54}},
+      {-7.5e5,
+       {-0x1.edb309999f8a2p-1, -0x1.bce77d6cbd16ep-55},
+       {0x1.0f546016d4acdp-2, -0x1.a1b25d6d7b8e2p-56},
+       {-0x1.d1ce6ac609436p+1, -0x1.e63b2d8f7603cp-54}},
+      // Payne-Hanek reduction
+      {1e22,
+       {-0x1.b453ab76bf397p-1, -0x1.f453790772648p-58},
+       {0x1.0be2cef01c8f4p-1, -0x1.b2d1bc8018c4fp-55},
+       {-0x1.a0f79c1b6b257p+0, -0x1.d27810f5737ddp-54}},
+      {1e300,
+       {-0x1.a2c16b010e385p-1, -0x1.b900a1f54ecd2p-55},
+       {-0x1.2699022adc4c1p-1, 0x1.edd5594b5c574p-56},
+       {0x1.6be411f37ac77p+0, -0x1.5a67ce3109efbp-54}},
+  };
+  for (const auto &ref : references) {
+    two<double> x(ref.x);
+    two<double> s, c;
+    sincos<useFMA>(x, s, c);
+    expectRelative(s, ref.sin, 8.0);
+    expectRelative(c, ref.cos, 8.0);
+    expectRelative(sin<useFMA>(x), ref.sin, 8.0);
+    expectRelative(cos<useFMA>(x), ref.cos, 8.0);
+    expectRelative(tan<useFMA>(x), ref.tan, 16.0);
+  }
+
+  // Close to multiples of π/2, the error is bounded relative to the argument
+  two<double> halfPi(0x1.921fb54442d18p+0, 0x1.1a62633145c07p-54);
+  for (int k : {1, 2, 3, -4, 1000}) {
+    two<double> x = mul<Mode::Accurate, useFMA>(halfPi, double(k));
+    two<double> expected(k % 2 ? 0.0 : (k % 4 == 0 ? 1.0 : -1.0));
+    two<double> other(k % 2 ? (k % 4 == 1 ? 1.0 : -1.0) : 0.0);
+    expectWithin(sin<useFMA>(x), other, 8.0, double(std::abs(k)));
+    expectWithin(cos<useFMA>(x), expected, 8.0, double(std::abs(k)));
+  }
+
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-100, 100);
+  for (int i = 0; i < 1000; ++i) {
+    two<double> x(dist(gen));
+    two<double> s, c;
+    sincos<useFMA>(x, s, c);
+    two<double> one = add<Mode::Accurate>(mul<Mode::Fast, useFMA>(s, s),
+                                          mul<Mode::Fast, useFMA>(c, c));
+    expectRelative(one, two<double>(1.0), 16.0);
+
+    // sin is odd and cos is even
+    two<double> minusX(-x.h, -x.l);
+    EXPECT_EQ(sin<useFMA>(minusX).h, -s.h);
+    EXPECT_EQ(sin<useFMA>(minusX).l, -s.l);
+    EXPECT_EQ(cos<useFMA>(minusX).h, c.h);
+    EXPECT_EQ(cos<useFMA>(minusX).l, c.l);
+  }
+
+  for (float x : {1.0f, 1e10f}) {
+    two<float> s, c;
+    sincos<useFMA>(two<float>(x), s, c);
+    EXPECT_NEAR(s.eval<double>(), sin<useFMA>(two<double>(x)).h, 1e-13);
+    EXPECT_NEAR(c.eval<double>(), cos<useFMA>(two<double>(x)).h, 1e-13);
+  }
+
+  EXPECT_EQ(sin<useFMA>(two<double>(0.0)).eval(), 0.0);
+  EXPECT_EQ(cos<useFMA>(two<double>(0.0)).eval(), 1.0);
+  EXPECT_TRUE(std::isnan(sin<useFMA>(two<double>(INFINITY)).h));
+  EXPECT_TRUE(std::isnan(cos<useFMA>(two<double>(-INFINITY)).h));
+  EXPECT_TRUE(std::isnan(tan<useFMA>(two<double>(NAN)).h));
+  EXPECT_TRUE(std::isnan(sin<useFMA>(two<float>(INFINITY)).h));
+}
+
+template <bool useFMA>
+void atan2Test() {
+  two<double> quarterPi(0x1.921fb54442d18p-1, 0x1.1a62633145c07p-55);
+  two<double> halfPi(0x1.921fb54442d18p+0, 0x1.1a62633145c07p-54);
+  two<double> threeQuarterPi(0x1.2d97c7f3321d2p+1, 0x1.a79394c9e8a0ap-54);
+  two<double> pi(0x1.921fb54442d18p+1, 0x1.1a62633145c07p-53);
+  two<double> one(1.0), zero(0.0);
+  two<double> minusOne(-1.0);
+
+  expectRelative(atan2<useFMA>(one, one), quarterPi, 4.0);
+  expectRelative(atan2<useFMA>(one, minusOne), threeQuarterPi, 4.0);
+  expectRelative(atan2<useFMA>(minusOne, zero),
+                 two<double>(-halfPi.h, -halfPi.l), 4.0);
+  expectRelative(atan2<useFMA>(zero, minusOne), pi, 4.0);
+  expectRelative(atan2<useFMA>(two<double>(-0.0), minusOne),
+                 two<double>(-pi.h, -pi.l), 4.0);
+
+  // tan(atan2(y, x)) = y/x
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  for (int i = 0; i < 1000; ++i) {
+    two<double> y(dist(gen)), x(dist(gen));
+    two<double> a = atan2<useFMA>(y, x);
+    two<double> t = tan<useFMA>(a);
+    two<double> q = div<Mode::Fast, useFMA>(y, x);
+    // The condition number of tan at a is |a| (1 + tan²(a)) / |tan(a)|
+    double cond = std::abs(a.h) * (1 + q.h * q.h) / std::abs(q.h);
+    expectRelative(t, q, 16.0 * (1 + cond));
+  }
+
+  EXPECT_EQ(atan2<useFMA>(zero, one).eval(), 0.0);
+  EXPECT_TRUE(std::signbit(atan2<useFMA>(two<double>(-0.0), one).h));
+  EXPECT_EQ(atan2<useFMA>(one, two<double>(INFINITY)).eval(), 0.0);
+  EXPECT_TRUE(std::isnan(atan2<useFMA>(two<double>(NAN), one).h));
+
+  two<float> af = atan2<useFMA>(two<float>(1.0f), two<float>(1.0f));
+  EXPECT_NEAR(af.eval<double>(), quarterPi.h, 1e-13);
+}
+
+TEST(DoubleWordTrigonometry, SinCosTest) { sinCosTest<false>(); }
+TEST(DoubleWordTrigonometry, Atan2Test) { atan2Test<false>(); }
+
+TEST(DoubleWordTrigonometry, FMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  sinCosTest<true>();
+  atan2Test<true>();
+}
+
+/// \brief Expects that the vector and batched versions of the function give
+/// bitwise identical results to the scalar version, for vectors that mix
+/// arguments of the Cody-Waite and Payne-Hanek reductions.
+template <typename T, typename Scalar, typename Batch>
+void vectorTest(Scalar scalar, Batch batchOp) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<T> dist(-100, 100);
+  std::uniform_real_distribution<T> exponent(0, 30);
+  std::uniform_real_distribution<T> low(-1, 1);
+
+  soa_vector<T> x;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    T h = dist(gen);
+    if (i % 7 == 0) h *= std::pow(T(10), exponent(gen));
+    x.push_back(algorithms::FastTwoSum(
+        h, h * low(gen) * std::numeric_limits<T>::epsilon()));
+  }
+  for (T special : {T(0), T(-1), T(INFINITY), T(-INFINITY), T(NAN)})
+    x.push_back(two<T>(special));
+
+  soa_vector<T> z;
+  batchOp(x, z);
+  ASSERT_EQ(z.size(), x.size());
+
+  using V = simd<T, 4>;
+  for (std::size_t i = 0; i + V::size() <= z.size(); i += V::size()) {
+    two<V> v(V::load(x.h_data() + i), V::load(x.l_data() + i));
+    two<V> r = scalar(v);
+    for (std::size_t k = 0; k < V::size(); ++k) {
+      two<T> expected = scalar(two<T>(x[i + k]));
+      expectBitwiseEqual(two<T>(z[i + k]), expected, true);
+      expectBitwiseEqual(two<T>(r.h.v[k], r.l.v[k]), expected, true);
+    }
+  }
+}
+
+template <typename T, bool useFMA>
+void batchTest() {
+  vectorTest<T>([](const auto &x) { return sin<useFMA>(x); },
+                [](auto &x, auto &z) { batch::sin<useFMA>(x, z); });
+  vectorTest<T>([](const auto &x) { return cos<useFMA>(x); },
+                [](auto &x, auto &z) { batch::cos<useFMA>(x, z); });
+  vectorTest<T>([](const auto &x) { return tan<useFMA>(x); },
+                [](auto &x, auto &z) { batch::tan<useFMA>(x, z); });
+}
+
+TEST(DoubleWordTrigonometry, BatchTest) {
+  batchTest<float, false>();
+  batchTest<double, false>();
+  if (cpu::hasFMA()) {
+    batchTest<float, true>();
+    batchTest<double, true>();
+  }
+}
+
+TEST(DoubleWordTrigonometry, RuntimeFMATest) {
+  two<double> x(2.5, 1e-20), y(-1.5, 1e-21);
+  if (cpu::hasFMA()) {
+    expectBitwiseEqual(sin(x), sin<true>(x), true);
+    expectBitwiseEqual(cos(x), cos<true>(x), true);
+    expectBitwiseEqual(tan(x), tan<true>(x), true);
+    expectBitwiseEqual(atan2(y, x), atan2<true>(y, x), true);
+  } else {
+    expectBitwiseEqual(sin(x), sin<false>(x), true);
+    expectBitwiseEqual(cos(x), cos<false>(x), true);
+    expectBitwiseEqual(tan(x), tan<false>(x), true);
+    expectBitwiseEqual(atan2(y, x), atan2<false>(y, x), true);
+  }
+}
+
+}  // namespace test
+}  // namespace doubleword
+}  // namespace twofloat
@@ -0,0 +1,294 @@
+#pragma once
+
+/// \file exact.hpp
+/// \brief Exact reference values for the tests of the quad-word and
+/// multi-word arithmetic, and helpers shared by all the tests.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/arithmetics/multi-word-arithmetic.hpp>
+#include <libtwofloat/complex.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/limits.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <libtwofloat/twofloat.hpp>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace test {
+
+/// \brief A signed fixed point number with 1024 bits, 800 of them after the
+/// binary point, which holds sums of floating point numbers exactly.
+class exact {
+ public:
+  /// \brief Adds the floating point number `x` exactly.
+  template <typename T>
+  void add(T x) {
+    if (x == 0) return;
+    int e;
+    const double m = std::ldexp(std::frexp(double(x), &e), 53);
+    const int position = e - 53 + fraction;
+    ASSERT_GE(position, 0);
+    ASSERT_LT(position, int(64 * (limbs - 2)));
+    const std::uint64_t mag = static_cast<std::uint64_t>(std::abs(m));
+    const std::size_t k = static_cast<std::size_t>(position / 64);
+    const int shift = position % 64;
+    std::uint64_t v[2] = {mag << shift, shift ? mag >> (64 - shift) : 0};
+    if (m < 0) {
+      // Subtracts with borrow
+      std::uint64_t borrow = 0;
+      for (std::size_t i = k; i < limbs; ++i) {
+        const std::uint64_t s = i - k < 2 ? v[i - k] : 0;
+        const std::uint64_t d = limb_[i] - s - borrow;
+        borrow = (limb_[i] < s) || (limb_[i] - s < borrow);
+        limb_[i] = d;
+      }
+    } else {
+      std::uint64_t carry = 0;
+      for (std::size_t i = k; i < limbs; ++i) {
+        const std::uint64_t s = i - k < 2 ? v[i - k] : 0;
+        const std::uint64_t d = limb_[i] + s + carry;
+        carry = (d < limb_[i]) || (carry && d == limb_[i]);
+        limb_[i] = d;
+      }
+    }
+  }
+
+  template <typename T, std::size_t N>
+  void add(const expansion<T, N> &x) {
+    for (std::size_t i = 0; i < N; ++i) add(x[i]);
+  }
+
+  /// \brief Subtracts `y` and returns the difference as a `double`.
+  double minus(const exact &y) const {
+    exact d = y;
+    d.negate();
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < limbs; ++i) {
+      const std::uint64_t s = d.limb_[i] + limb_[i] + carry;
+      carry = (s < limb_[i]) || (carry && s == limb_[i]);
+      d.limb_[i] = s;
+    }
+    return d.value();
+  }
+
+  double value() const {
+    exact a = *this;
+    const bool negative = a.limb_[limbs - 1] >> 63;
+    if (negative) a.negate();
+    double v = 0;
+    for (std::size_t i = 0; i < limbs; ++i)
+      v += std::ldexp(double(a.limb_[i]), int(64 * i) - fraction);
+    return negative ? -v : v;
+  }
+
+ private:
+  static constexpr std::size_t limbs = 16;
+  static constexpr int fraction = 800;
+
+  void negate() {
+    std::uint64_t carry = 1;
+    for (std::uint64_t &l : limb_) {
+      l = ~l + carry;
+      carry = carry && l == 0;
+    }
+  }
+
+  std::uint64_t limb_[limbs] = {};
+};
+
+template <typename T, std::size_t N>
+exact exactValue(const expansion<T, N> &x) {
+  exact e;
+  e.add(x);
+  return e;
+}
+
+/// \brief Returns the exact product, the sum of the exact products of the
+/// components.
+template <typename T, std::size_t N>
+exact exactProduct(const expansion<T, N> &x, const expansion<T, N> &y) {
+  exact e;
+  for (std::size_t i = 0; i < N; ++i)
+    for (std::size_t j = 0; j < N; ++j) {
+      const two<T> p = algorithms::TwoProd<T, true>(x[i], y[j]);
+      e.add(p.h);
+      e.add(p.l);
+    }
+  return e;
+}
+
+/// \brief Returns `|x - y| / |y|`.
+inline double error(const exact &x, const exact &y) {
+  return std::abs(x.minus(y) / y.value());
+}
+
+/// \brief Returns `n` random normalized expansions with `N` components, with
+/// a leading component in `[-2^20, 2^20]`, or in `[2^-21, 2^20]` if
+/// `positive` is set.
+template <typename T, std::size_t N>
+std::vector<expansion<T, N>> numbers(std::size_t n, unsigned seed,
+                                     bool positive = false) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<T> dist(positive ? 0.5 : -1, 1);
+  std::uniform_int_distribution<int> exponent(-20, 20);
+  constexpr T u = std::numeric_limits<T>::epsilon() / 2;
+  std::vector<expansion<T, N>> v(n);
+  for (expansion<T, N> &x : v) {
+    T c[N];
+    T scale = std::ldexp(T(1), exponent(gen));
+    for (std::size_t i = 0; i < N; ++i, scale *= u) c[i] = dist(gen) * scale;
+    x = multiword::details::renormalize<N, true>(c);
+  }
+  return v;
+}
+
+/// \brief Generates random double-word numbers `FastTwoSum(a, b * scale)`
+/// with `a` and `b` uniformly distributed in `[low, high)`.
+template <typename T>
+class randomTwo {
+ public:
+  randomTwo(unsigned seed, T scale, T low = -1, T high = 1)
+      : gen_(seed), dist_(low, high), scale_(scale) {}
+
+  two<T> operator()() {
+    const T h = dist_(gen_);
+    return algorithms::FastTwoSum(h, dist_(gen_) * scale_);
+  }
+
+  /// \brief Returns `n` random double-word numbers.
+  std::vector<two<T>> operator()(std::size_t n) {
+    std::vector<two<T>> v(n);
+    for (two<T> &x : v) x = (*this)();
+    return v;
+  }
+
+  /// \brief Returns a random number in `[low, high)`.
+  T uniform() { return dist_(gen_); }
+
+  /// \brief The random engine, for other distributions.
+  std::mt19937 &engine() { return gen_; }
+
+ private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<T> dist_;
+  T scale_;
+};
+
+template <typename T, std::size_t N>
+void expectNormalized(const expansion<T, N> &x) {
+  for (std::size_t i = 0; i + 1 < N; ++i) {
+    if (x[i + 1] != 0) {
+      EXPECT_LE(std::abs(x[i + 1]),
+                std::abs(x[i]) * std::numeric_limits<T>::epsilon());
+    }
+  }
+}
+
+/// \brief Returns the unit roundoff of `expansion<T, N>`.
+template <typename T, std::size_t N>
+double unit() {
+  return double(std::numeric_limits<expansion<T, N>>::epsilon()) /
+         std::ldexp(1.0, int(N));
+}
+
+/// \brief Checks that `add`, `mul` and `div` of the numbers `x` and `y`
+/// return normalized expansions with relative errors of at most the
+/// tolerances times the unit roundoff.
+template <typename T, std::size_t N, typename Add, typename Mul, typename Div>
+void accuracyTest(const std::vector<expansion<T, N>> &x,
+                  const std::vector<expansion<T, N>> &y, Add add, Mul mul,
+                  Div div, double addTolerance, double mulTolerance,
+                  double divTolerance) {
+  double addError = 0, mulError = 0, divError = 0;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    exact sum = exactValue(x[i]);
+    sum.add(y[i]);
+    const expansion<T, N> s = add(x[i], y[i]);
+    expectNormalized(s);
+    addError = std::max(addError, error(exactValue(s), sum));
+
+    const expansion<T, N> p = mul(x[i], y[i]);
+    expectNormalized(p);
+    mulError =
+        std::max(mulError, error(exactValue(p), exactProduct(x[i], y[i])));
+
+    // The error of the quotient is the error of y q relative to x
+    const expansion<T, N> q = div(x[i], y[i]);
+    expectNormalized(q);
+    divError =
+        std::max(divError, error(exactProduct(y[i], q), exactValue(x[i])));
+  }
+  EXPECT_LE(addError, (addTolerance * unit<T, N>())) << "N = " << N;
+  EXPECT_LE(mulError, (mulTolerance * unit<T, N>())) << "N = " << N;
+  EXPECT_LE(divError, (divTolerance * unit<T, N>())) << "N = " << N;
+}
+
+/// \brief Returns whether `x` and `y` have the same bits.
+template <typename T>
+bool sameBits(T x, T y) {
+  return std::memcmp(&x, &y, sizeof(T)) == 0;
+}
+
+/// \brief Expects that `x` and `y` have the same bits. If `anyNaN` is set,
+/// any two NaNs are equal, since the sign of a NaN may differ between scalar
+/// and vector instructions.
+template <typename T>
+void expectBitwiseEqual(const two<T> &x, const two<T> &y,
+                        bool anyNaN = false) {
+  for (auto [a, b] : {std::pair(x.h, y.h), std::pair(x.l, y.l)}) {
+    if (anyNaN && std::isnan(a) && std::isnan(b)) continue;
+    EXPECT_TRUE(sameBits(a, b)) << std::hexfloat << a << " != " << b;
+  }
+}
+
+template <typename T>
+void expectBitwiseEqual(const complex<T> &x, const complex<T> &y) {
+  expectBitwiseEqual(x.re, y.re);
+  expectBitwiseEqual(x.im, y.im);
+}
+
+template <typename T, std::size_t N>
+void expectBitwiseEqual(const expansion<T, N> &x, const expansion<T, N> &y) {
+  for (std::size_t k = 0; k < N; ++k)
+    EXPECT_TRUE(sameBits(x[k], y[k]))
+        << std::hexfloat << x[k] << " != " << y[k];
+}
+
+/// \brief Expects that the arrays `x` and `y` of numbers of type `E` have the
+/// same sizes and bits.
+template <typename E, typename X, typename Y>
+void expectBitwiseEqualArrays(const X &x, const Y &y) {
+  ASSERT_EQ(x.size(), y.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    const E a = x[i], b = y[i];
+    if (std::memcmp(&a, &b, sizeof(E)) == 0) continue;
+    SCOPED_TRACE(i);
+    expectBitwiseEqual(a, b);
+  }
+}
+
+/// \brief Calls `f()` with every instruction set, and restores the default
+/// selection afterwards.
+template <typename F>
+void forEachInstructionSet(F f) {
+  for (cpu::InstructionSet isa :
+       {cpu::InstructionSet::Scalar, cpu::InstructionSet::AVX2,
+        cpu::InstructionSet::AVX512}) {
+    cpu::setMaxInstructionSet(isa);
+    f();
+  }
+  cpu::setMaxInstructionSet(cpu::InstructionSet::AVX512);
+}
+
+}  // namespace test
+}  // namespace twofloat
@@ -0,0 +1,127 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/expression.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace expr {
+namespace test {
+
+using doubleword::Mode;
+using twofloat::test::expectBitwiseEqual;
+using twofloat::test::randomTwo;
+
+template <typename T>
+std::vector<two<T>> operands(unsigned seed, T low) {
+  return randomTwo<T>(seed, T(0x1p-30), low, 2)(1000);
+}
+
+template <bool useFMA, Mode mulMode>
+void fusionTest() {
+  using P = policy::doubleword<useFMA, mulMode>;
+  constexpr auto fma = [](const auto &x, const auto &y, const auto &z) {
+    return doubleword::fma<mulMode, Mode::Accurate, useFMA>(x, y, z);
+  };
+  auto xs = operands<double>(1, -2), ys = operands<double>(2, -2),
+       zs = operands<double>(3, -2);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    const two<double> &x = xs[i], &y = ys[i], &z = zs[i];
+    two<double> mz(-z.h, -z.l), mx(-x.h, -x.l);
+    auto a = lazy<P>(x);
+
+    expectBitwiseEqual(two<double>(a * y + z), fma(x, y, z));
+    expectBitwiseEqual(two<double>(z + a * y), fma(x, y, z));
+    expectBitwiseEqual(two<double>(a * y - z), fma(x, y, mz));
+    expectBitwiseEqual(two<double>(z - a * y), fma(mx, y, z));
+    expectBitwiseEqual((a * y.h + z).eval(), fma(x, y.h, z));
+    expectBitwiseEqual((z - y.h * a).eval(), fma(x, -y.h, z));
+
+    // A sum of products is a chain of fused operations
+    expectBitwiseEqual((x + a * y + a * z).eval(), fma(x, z, fma(x, y, x)));
+
+    // Other operations are calculated with the policy
+    expectBitwiseEqual((a + y).eval(), P::add(x, y));
+    expectBitwiseEqual((y.h - a).eval(), P::add(mx, y.h));
+    expectBitwiseEqual((a * y).eval(), P::mul(x, y));
+    expectBitwiseEqual((a / y).eval(), P::div(x, y));
+    expectBitwiseEqual((a / y.h).eval(), P::div(x, y.h));
+  }
+}
+
+template <bool useFMA>
+void accuracyTest() {
+  using P = policy::doubleword<useFMA>;
+  const double u = std::numeric_limits<float>::epsilon() / 2;
+  auto xs = operands<float>(1, -2), ys = operands<float>(2, -2),
+       zs = operands<float>(3, -2);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    two<float> r = lazy<P>(xs[i]) * ys[i] + zs[i];
+    two<double> x(xs[i].h, xs[i].l), y(ys[i].h, ys[i].l), z(zs[i].h, zs[i].l);
+    two<double> xy = doubleword::mul<Mode::Fast, false>(x, y);
+    two<double> expected = doubleword::add<Mode::Accurate>(xy, z);
+    two<double> diff = doubleword::sub<Mode::Accurate>(
+        two<double>(r.h, r.l), expected);
+    // The error is bounded relative to the magnitude of the operands, like
+    // the error of the separate operations
+    EXPECT_LE(std::abs(diff.h), 4 * u * u * (std::abs(xy.h) + std::abs(z.h)));
+  }
+}
+
+template <bool useFMA>
+void pairTest() {
+  using P = policy::pair<useFMA>;
+  auto xs = operands<double>(1, -2), ys = operands<double>(2, -2),
+       zs = operands<double>(3, -2);
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    const two<double> &x = xs[i], &y = ys[i], &z = zs[i];
+    // Only the result of the expression is normalized
+    two<double> r = lazy<P>(x) * y + lazy<P>(z) * x - y;
+    two<double> expected = pair::sub(
+        pair::add(pair::mul<useFMA>(x, y), pair::mul<useFMA>(z, x)), y);
+    expectBitwiseEqual(r, algorithms::FastTwoSum(expected.h, expected.l));
+  }
+}
+
+TEST(Expression, FusionTest) { fusionTest<false, Mode::Fast>(); }
+
+TEST(Expression, AccuracyTest) { accuracyTest<false>(); }
+
+TEST(Expression, PairTest) { pairTest<false>(); }
+
+TEST(Expression, SimdTest) {
+  using V = simd<double, 4>;
+  using P = policy::doubleword<false>;
+  auto xs = operands<double>(1, -2), ys = operands<double>(2, -2);
+  two<V> x, y;
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    x.h.v[k] = xs[k].h;
+    x.l.v[k] = xs[k].l;
+    y.h.v[k] = ys[k].h;
+    y.l.v[k] = ys[k].l;
+  }
+  two<V> r = lazy<P>(x) * y + lazy<P>(x) * y.h;
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    two<double> rk = lazy<P>(xs[k]) * ys[k] + lazy<P>(xs[k]) * ys[k].h;
+    EXPECT_EQ(r.h.v[k], rk.h);
+    EXPECT_EQ(r.l.v[k], rk.l);
+  }
+}
+
+TEST(Expression, FMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  fusionTest<true, Mode::Fast>();
+  fusionTest<true, Mode::Accurate>();
+  accuracyTest<true>();
+  pairTest<true>();
+}
+
+}  // namespace test
+}  // namespace expr
+}  // namespace twofloat
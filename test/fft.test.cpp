@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/arithmetics/double-word-trigonometry.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/details/double-word-trig-tables.hpp>
+#include <libtwofloat/fft.hpp>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace fft {
+namespace test {
+
+using P = policy::doubleword<true>;
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::forEachInstructionSet;
+using twofloat::test::randomTwo;
+
+/// \brief A random complex vector with low words.
+template <typename T>
+void vector(std::size_t n, unsigned seed, soa_vector<T> &re,
+            soa_vector<T> &im) {
+  randomTwo<T> random(seed, T(1e-9));
+  re.resize(n);
+  im.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    re[i] = random();
+    im[i] = random();
+  }
+}
+
+/// \brief The discrete Fourier transform by its definition, with twiddle
+/// factors calculated by `doubleword::sincos` for every index.
+template <typename T>
+void dft(const soa_vector<T> &re, const soa_vector<T> &im,
+         std::vector<two<T>> &outRe, std::vector<two<T>> &outIm) {
+  using C = doubleword::details::trigTables<T>;
+  const two<T> halfPi(C::halfPi[0], C::halfPi[1]);
+  const std::size_t n = re.size();
+  outRe.assign(n, two<T>());
+  outIm.assign(n, two<T>());
+  for (std::size_t k = 0; k < n; ++k)
+    for (std::size_t j = 0; j < n; ++j) {
+      const two<T> x = doubleword::mul<doubleword::Mode::Accurate, true>(
+          halfPi, static_cast<T>(4 * (j * k % n)) / static_cast<T>(n));
+      two<T> s, c;
+      doubleword::sincos<true>(x, s, c);
+      const two<T> a = re[j], b = im[j];
+      // (a + i b) (c - i s)
+      outRe[k] = P::add(outRe[k], P::add(P::mul(a, c), P::mul(b, s)));
+      outIm[k] = P::add(outIm[k], P::sub(P::mul(b, c), P::mul(a, s)));
+    }
+}
+
+/// \brief Returns the largest error relative to the largest element.
+template <typename T>
+double error(const soa_vector<T> &re, const soa_vector<T> &im,
+             const std::vector<two<T>> &expectedRe,
+             const std::vector<two<T>> &expectedIm) {
+  double err = 0, norm = 0;
+  for (std::size_t i = 0; i < re.size(); ++i) {
+    for (auto [x, e] : {std::make_pair(two<T>(re[i]), expectedRe[i]),
+                        std::make_pair(two<T>(im[i]), expectedIm[i])}) {
+      const two<T> d = P::sub(x, e);
+      err = std::max(err, std::abs(static_cast<double>(d.h)));
+      norm = std::max(norm, std::abs(static_cast<double>(e.h)));
+    }
+  }
+  return err / norm;
+}
+
+template <typename T>
+void accuracyTest(double tolerance) {
+  for (std::size_t n : {1, 2, 4, 8, 16, 32, 64, 128, 512}) {
+    soa_vector<T> re, im;
+    vector(n, static_cast<unsigned>(n), re, im);
+    std::vector<two<T>> expectedRe, expectedIm;
+    dft(re, im, expectedRe, expectedIm);
+
+    forward<P>(soa_span<T>(re), soa_span<T>(im));
+    EXPECT_LE(error(re, im, expectedRe, expectedIm), tolerance) << n;
+  }
+}
+
+TEST(ForwardTest, Double) { accuracyTest<double>(1e-30); }
+
+TEST(ForwardTest, Float) { accuracyTest<float>(1e-12); }
+
+TEST(ForwardTest, Impulse) {
+  // The transform of the impulse at n/4 is (-i)^k, which needs the exact
+  // symmetries of the twiddle factors
+  const std::size_t n = 64;
+  soa_vector<double> re(n), im(n);
+  re[n / 4] = two<double>(1);
+  forward<P>(soa_span<double>(re), soa_span<double>(im));
+  for (std::size_t k = 0; k < n; ++k) {
+    // exp(-2 π i k / 4) = (-i)^k
+    const double c[4] = {1, 0, -1, 0}, s[4] = {0, -1, 0, 1};
+    EXPECT_EQ(two<double>(re[k]).h, c[k % 4]) << k;
+    EXPECT_EQ(two<double>(re[k]).l, 0) << k;
+    EXPECT_EQ(two<double>(im[k]).h, s[k % 4]) << k;
+    EXPECT_EQ(two<double>(im[k]).l, 0) << k;
+  }
+}
+
+template <typename T>
+void roundTripTest(double tolerance) {
+  for (std::size_t n : {1 << 12, 1 << 13}) {
+    soa_vector<T> re, im;
+    vector(n, 7, re, im);
+    std::vector<two<T>> expectedRe(n), expectedIm(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      expectedRe[i] = re[i];
+      expectedIm[i] = im[i];
+    }
+
+    forward<P>(soa_span<T>(re), soa_span<T>(im));
+    inverse<P>(soa_span<T>(re), soa_span<T>(im));
+    EXPECT_LE(error(re, im, expectedRe, expectedIm), tolerance) << n;
+  }
+}
+
+TEST(RoundTripTest, Double) { roundTripTest<double>(1e-30); }
+
+TEST(RoundTripTest, Float) { roundTripTest<float>(1e-12); }
+
+TEST(RoundTripTest, Pair) {
+  const std::size_t n = 1 << 10;
+  soa_vector<double> re, im;
+  vector(n, 3, re, im);
+  std::vector<two<double>> expectedRe(n), expectedIm(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    expectedRe[i] = re[i];
+    expectedIm[i] = im[i];
+  }
+
+  using Pair = policy::pair<true>;
+  forward<Pair>(soa_span<double>(re), soa_span<double>(im));
+  inverse<Pair>(soa_span<double>(re), soa_span<double>(im));
+  EXPECT_LE(error(re, im, expectedRe, expectedIm), 1e-29);
+}
+
+TEST(DeterminismTest, ThreadsAndInstructionSets) {
+  // Sizes with and without a radix-2 stage, and with stages whose lanes
+  // hold the twiddle indices
+  for (std::size_t n : {1 << 11, 1 << 16}) {
+    soa_vector<double> re0, im0;
+    vector(n, 11, re0, im0);
+    soa_vector<double> re1 = re0, im1 = im0;
+    forward<P>(soa_span<double>(re0), soa_span<double>(im0), 1);
+
+    forEachInstructionSet([&]() {
+      soa_vector<double> re = re1, im = im1;
+      forward<P>(soa_span<double>(re), soa_span<double>(im), 4);
+      expectBitwiseEqualArrays<two<double>>(re, re0);
+      expectBitwiseEqualArrays<two<double>>(im, im0);
+    });
+  }
+}
+
+TEST(PlanTest, Cached) {
+  EXPECT_EQ(plan<double>::get(256), plan<double>::get(256));
+  EXPECT_NE(plan<double>::get(256), plan<double>::get(512));
+  EXPECT_EQ(plan<float>::get(256)->size(), 256u);
+}
+
+TEST(PlanTest, InvalidSizes) {
+  for (std::size_t n : {0, 3, 6, 12, 100, 1000})
+    EXPECT_THROW(plan<double>{n}, std::invalid_argument) << n;
+  EXPECT_THROW(plan<float>::get(0), std::invalid_argument);
+  soa_vector<double> re(24), im(24);
+  EXPECT_THROW(forward<P>(soa_span<double>(re), soa_span<double>(im)),
+               std::invalid_argument);
+
+  // Spans of other sizes than the plan
+  soa_vector<double> a(16), b(8), c(32);
+  const auto span = [](soa_vector<double> &v) { return soa_span<double>(v); };
+  EXPECT_THROW(forward<P>(span(a), span(b)), std::invalid_argument);
+  EXPECT_THROW(inverse<P>(span(a), span(b)), std::invalid_argument);
+  EXPECT_THROW(forward<P>(span(a), span(c)), std::invalid_argument);
+  const plan<double> p(16);
+  EXPECT_THROW(p.forward<P>(span(c), span(c)), std::invalid_argument);
+  EXPECT_THROW(p.inverse<P>(span(a), span(b)), std::invalid_argument);
+  EXPECT_NO_THROW(p.inverse<P>(span(a), span(a)));
+
+  // The transform of size 1 is the identity
+  soa_vector<double> x(1, two<double>(2.0, 1e-20)), y(1, two<double>(3.0));
+  plan<double>(1).forward<P>(soa_span<double>(x), soa_span<double>(y));
+  EXPECT_EQ(two<double>(x[0]).h, 2.0);
+  EXPECT_EQ(two<double>(x[0]).l, 1e-20);
+  EXPECT_EQ(two<double>(y[0]).h, 3.0);
+}
+
+}  // namespace test
+}  // namespace fft
+}  // namespace twofloat
@@ -0,0 +1,173 @@
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <libtwofloat/algorithms.hpp>
+#include <libtwofloat/io.hpp>
+#include <libtwofloat/soa-vector.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace io {
+namespace test {
+
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::randomTwo;
+
+template <typename T>
+soa_vector<T> numbers(std::size_t n, unsigned seed) {
+  randomTwo<T> random(seed, T(1e-9));
+  soa_vector<T> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = random();
+  return v;
+}
+
+/// \brief A file in the temporary directory that is removed at the end of
+/// the test.
+class temporaryFile {
+ public:
+  explicit temporaryFile(const std::string &name)
+      : path_((std::filesystem::temp_directory_path() /
+               ("twofloat-io-" + name))
+                  .string()) {}
+  ~temporaryFile() { std::remove(path_.c_str()); }
+  const std::string &path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+template <typename T>
+void roundTripTest(Layout layout, bool direct) {
+  const temporaryFile tmp("round-trip");
+  for (std::size_t n : {0, 1, 1000, 5000}) {
+    const soa_vector<T> values = numbers<T>(n, static_cast<unsigned>(n));
+    // Chunks of different sizes than the buffers of 4096 bytes
+    writer<T> w;
+    ASSERT_FALSE(w.open(tmp.path(), n, layout, direct, 4096));
+    for (std::size_t i = 0; i < n; i += 777) {
+      const std::size_t m = std::min<std::size_t>(777, n - i);
+      ASSERT_FALSE(w.write(soa_span<const T>(values.h_data() + i,
+                                             values.l_data() + i, m)));
+    }
+    EXPECT_EQ(w.written(), n);
+    ASSERT_FALSE(w.close());
+
+    mapped_file<T> file;
+    ASSERT_FALSE(file.open(tmp.path()));
+    EXPECT_EQ(file.layout(), layout);
+    expectBitwiseEqualArrays<two<T>>(file, values);
+    if (layout == Layout::SoA) {
+      // The planes are views of the mapping
+      const soa_span<const T> planes = file.planes();
+      ASSERT_EQ(planes.size(), n);
+      EXPECT_EQ(file.numbers().size(), 0u);
+      for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(planes.h_data()[i], values.h_data()[i]);
+        EXPECT_EQ(planes.l_data()[i], values.l_data()[i]);
+      }
+    } else {
+      const span<const two<T>> numbers = file.numbers();
+      ASSERT_EQ(numbers.size(), n);
+      EXPECT_EQ(file.planes().size(), 0u);
+      for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(numbers[i].h, values.h_data()[i]);
+        EXPECT_EQ(numbers[i].l, values.l_data()[i]);
+      }
+    }
+
+    soa_vector<T> loaded;
+    ASSERT_FALSE(load(tmp.path(), loaded));
+    ASSERT_EQ(loaded.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_EQ(loaded.h_data()[i], values.h_data()[i]);
+      EXPECT_EQ(loaded.l_data()[i], values.l_data()[i]);
+    }
+  }
+}
+
+TEST(IoTest, RoundTripSoA) {
+  roundTripTest<double>(Layout::SoA, false);
+  roundTripTest<float>(Layout::SoA, false);
+}
+
+TEST(IoTest, RoundTripAoS) {
+  roundTripTest<double>(Layout::AoS, false);
+  roundTripTest<float>(Layout::AoS, false);
+}
+
+TEST(IoTest, RoundTripDirect) {
+  // Falls back to buffered I/O if the file system does not support O_DIRECT
+  roundTripTest<double>(Layout::SoA, true);
+  roundTripTest<double>(Layout::AoS, true);
+}
+
+TEST(IoTest, SaveArrayOfNumbers) {
+  const temporaryFile tmp("save");
+  const soa_vector<double> values = numbers<double>(100, 1);
+  ASSERT_FALSE(save(tmp.path(), soa_span<const double>(values), Layout::AoS));
+  mapped_file<double> file;
+  ASSERT_FALSE(file.open(tmp.path()));
+  expectBitwiseEqualArrays<two<double>>(file, values);
+
+  std::vector<two<double>> aos(values.size());
+  for (std::size_t i = 0; i < aos.size(); ++i) aos[i] = values[i];
+  writer<double> w;
+  ASSERT_FALSE(w.open(tmp.path(), aos.size()));
+  ASSERT_FALSE(w.write(span<const two<double>>(aos)));
+  ASSERT_FALSE(w.close());
+  mapped_file<double> other;
+  ASSERT_FALSE(other.open(tmp.path()));
+  expectBitwiseEqualArrays<two<double>>(other, values);
+  // The mapping is moved with its owner
+  file = std::move(other);
+  EXPECT_FALSE(other.is_open());
+  expectBitwiseEqualArrays<two<double>>(file, values);
+}
+
+TEST(IoTest, Errors) {
+  const temporaryFile tmp("errors");
+  const soa_vector<double> values = numbers<double>(10, 2);
+  const soa_span<const double> all(values);
+
+  mapped_file<double> file;
+  EXPECT_EQ(file.open(tmp.path() + "-missing"),
+            std::errc::no_such_file_or_directory);
+
+  // Too many numbers
+  writer<double> w;
+  ASSERT_FALSE(w.open(tmp.path(), 5));
+  EXPECT_EQ(w.write(all), std::errc::invalid_argument);
+  EXPECT_EQ(w.written(), 0u);
+  // Too few numbers leave the file without a header
+  ASSERT_FALSE(w.write(soa_span<const double>(values.h_data(),
+                                              values.l_data(), 3)));
+  EXPECT_EQ(w.close(), std::errc::invalid_argument);
+  EXPECT_EQ(file.open(tmp.path()), std::errc::invalid_argument);
+
+  // Another floating point type
+  ASSERT_FALSE(save(tmp.path(), all));
+  mapped_file<float> floats;
+  EXPECT_EQ(floats.open(tmp.path()), std::errc::invalid_argument);
+
+  // A truncated file
+  std::filesystem::resize_file(tmp.path(), 4096 + 8);
+  EXPECT_EQ(file.open(tmp.path()), std::errc::invalid_argument);
+  EXPECT_FALSE(file.is_open());
+
+  // Not a file of this library
+  std::ofstream(tmp.path()) << std::string(8192, 'x');
+  EXPECT_EQ(file.open(tmp.path()), std::errc::invalid_argument);
+  soa_vector<double> loaded(1);
+  EXPECT_EQ(load(tmp.path(), loaded), std::errc::invalid_argument);
+  EXPECT_EQ(loaded.size(), 1u);
+}
+
+}  // namespace test
+}  // namespace io
+}  // namespace twofloat
@@ -0,0 +1,155 @@
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/blas.hpp>
+#include <libtwofloat/ir.hpp>
+#include <libtwofloat/policy.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace ir {
+namespace test {
+
+using doubleword::Mode;
+using P = policy::doubleword<false>;
+using twofloat::test::randomTwo;
+
+/// \brief A random matrix with a dominant diagonal, which is well-conditioned
+/// but requires pivoting.
+std::vector<two<double>> matrix(std::size_t N, unsigned seed) {
+  std::vector<two<double>> A = randomTwo<double>(seed, 0x1p-60)(N * N);
+  for (std::size_t i = 0; i < N; ++i) A[i * N + (i * 7) % N].h += 2.0 * N;
+  return A;
+}
+
+/// \brief A random double-word vector.
+std::vector<two<double>> vector(std::size_t N, unsigned seed) {
+  return randomTwo<double>(seed, 0x1p-60)(N);
+}
+
+/// \brief Returns the maximum relative error of x in the maximum norm.
+double error(const std::vector<two<double>> &x,
+             const std::vector<two<double>> &expected) {
+  double err = 0, norm = 0;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    two<double> d = doubleword::sub<Mode::Accurate>(x[i], expected[i]);
+    err = std::max(err, std::abs(d.h));
+    norm = std::max(norm, std::abs(expected[i].h));
+  }
+  return err / norm;
+}
+
+TEST(IR, FactorizationTest) {
+  // The blocks of the factorization do not divide N
+  const std::size_t N = 150;
+  std::vector<two<double>> A = matrix(N, 1);
+  lu<double> f1(N, A.data(), N, 1), f3(N, A.data(), N, 3);
+  EXPECT_FALSE(f1.singular());
+
+  std::vector<double> x(N), y(N);
+  for (std::size_t i = 0; i < N; ++i) x[i] = y[i] = double(i);
+  f1.solve(x.data());
+  f3.solve(y.data());
+  for (std::size_t i = 0; i < N; ++i) EXPECT_EQ(x[i], y[i]);
+
+  // The residual of the solution in double precision
+  for (std::size_t i = 0; i < N; ++i) {
+    double r = double(i);
+    for (std::size_t j = 0; j < N; ++j) r -= A[i * N + j].h * x[j];
+    EXPECT_LE(std::abs(r), 1e-10);
+  }
+
+  const two<double> S[] = {two<double>(1.0), two<double>(2.0),
+                           two<double>(2.0), two<double>(4.0)};
+  EXPECT_TRUE(lu<double>(2, S, 2).singular());
+
+  // The refinement does not start for singular matrices
+  std::vector<two<double>> b(2, two<double>(1.0)), xs(2);
+  EXPECT_FALSE(solve<P>(S, 2, b, xs).converged);
+}
+
+TEST(IR, RefinementTest) {
+  const std::size_t N = 150;
+  std::vector<two<double>> A = matrix(N, 2);
+  solver<double, P> s(N, A.data(), N);
+
+  // The factorization is reused for several right-hand sides
+  for (unsigned seed : {3u, 4u, 5u}) {
+    std::vector<two<double>> expected = vector(N, seed);
+    std::vector<two<double>> b(N), x(N);
+    blas::gemv<P>(A.data(), N, expected, b);
+
+    result res = s.solve(b, x);
+    EXPECT_TRUE(res.converged);
+    EXPECT_LE(res.iterations, 4u);
+    EXPECT_LE(res.correction, 1e-30);
+    EXPECT_LE(error(x, expected), 1e-29);
+  }
+}
+
+TEST(IR, IllConditionedTest) {
+  // The Hilbert matrix of order 8 has the condition number 1.5e10
+  const std::size_t N = 8;
+  std::vector<two<double>> A(N * N);
+  for (std::size_t i = 0; i < N; ++i)
+    for (std::size_t j = 0; j < N; ++j)
+      A[i * N + j] = doubleword::div<Mode::Fast, false>(
+          two<double>(1.0), two<double>(double(i + j + 1)));
+  std::vector<two<double>> expected(N, two<double>(1.0)), b(N), x(N);
+  blas::gemv<P>(A.data(), N, expected, b);
+
+  // The refinement stagnates at the accuracy that the residuals allow
+  result res = solve<P>(A.data(), N, b, x);
+  EXPECT_TRUE(res.converged);
+  EXPECT_GT(res.iterations, 1u);
+  EXPECT_LE(res.correction, 1e-20);
+  EXPECT_LE(error(x, expected), 1e-20);
+}
+
+TEST(IR, FloatTest) {
+  const std::size_t N = 70;
+  randomTwo<float> random(6, 0x1p-30f);
+  std::vector<two<float>> A(N * N), b(N), x(N);
+  for (two<float> &a : A) a = two<float>(random.uniform());
+  for (std::size_t i = 0; i < N; ++i) A[i * N + i].h += float(N);
+  const std::vector<two<float>> expected = random(N);
+  using PF = policy::doubleword<false>;
+  blas::gemv<PF>(A.data(), N, expected, b);
+
+  result res = solve<PF>(A.data(), N, b, x);
+  EXPECT_TRUE(res.converged);
+  for (std::size_t i = 0; i < N; ++i) {
+    two<float> d = doubleword::sub<Mode::Accurate>(x[i], expected[i]);
+    EXPECT_LE(std::abs(d.h), 1e-12f);
+  }
+}
+
+TEST(IR, EdgeCasesTest) {
+  const std::size_t N = 10;
+  std::vector<two<double>> A = matrix(N, 7);
+  EXPECT_THROW(lu<double>(N, A.data(), N - 1), std::invalid_argument);
+  EXPECT_THROW((solver<double, P>(N, A.data(), N - 1)), std::invalid_argument);
+
+  const solver<double, P> s(N, A.data(), N);
+  std::vector<two<double>> b(N), x(N), shorter(N - 1);
+  EXPECT_THROW(s.solve(shorter, x), std::invalid_argument);
+  EXPECT_THROW(s.solve(b, shorter), std::invalid_argument);
+
+  // The residual of the solution of b = 0 is exactly 0
+  result res = s.solve(b, x);
+  EXPECT_TRUE(res.converged);
+  EXPECT_EQ(res.iterations, 1u);
+  EXPECT_EQ(res.correction, 0);
+  for (const two<double> &xi : x) {
+    EXPECT_EQ(xi.h, 0);
+    EXPECT_EQ(xi.l, 0);
+  }
+}
+
+}  // namespace test
+}  // namespace ir
+}  // namespace twofloat
@@ -0,0 +1,141 @@
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/arithmetics/multi-word-arithmetic.hpp>
+#include <libtwofloat/limits.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace multiword {
+namespace test {
+
+using twofloat::test::error;
+using twofloat::test::exact;
+using twofloat::test::exactValue;
+using twofloat::test::numbers;
+using twofloat::test::unit;
+
+template <typename T, std::size_t N, bool useFMA>
+void accuracyTest() {
+  using E = expansion<T, N>;
+  const std::vector<E> x = numbers<T, N>(2000, 1), y = numbers<T, N>(2000, 2);
+  twofloat::test::accuracyTest(
+      x, y, [](const E &a, const E &b) { return add(a, b); },
+      [](const E &a, const E &b) { return mul<useFMA>(a, b); },
+      [](const E &a, const E &b) { return div<useFMA>(a, b); }, 2, 2, 4);
+
+  // Operations with floating point numbers, the leading components of y
+  std::vector<E> lead(y.size());
+  for (std::size_t i = 0; i < y.size(); ++i) lead[i] = E(y[i][0]);
+  twofloat::test::accuracyTest(
+      x, lead, [](const E &a, const E &b) { return add(a, b[0]); },
+      [](const E &a, const E &b) { return mul<useFMA>(a, b[0]); },
+      [](const E &a, const E &b) { return div<useFMA>(a, b); }, 2, 2, 4);
+}
+
+TEST(MultiWordTest, AccuracyDouble) {
+  accuracyTest<double, 2, true>();
+  accuracyTest<double, 3, true>();
+  accuracyTest<double, 4, true>();
+  accuracyTest<double, 5, false>();
+  accuracyTest<double, 6, true>();
+}
+
+TEST(MultiWordTest, AccuracyFloat) {
+  accuracyTest<float, 2, true>();
+  accuracyTest<float, 3, false>();
+  accuracyTest<float, 4, true>();
+}
+
+TEST(MultiWordTest, Cancellation) {
+  // The leading components of x and y cancel, and the sum of the trailing
+  // components is small
+  const std::vector<expansion<double, 3>> x = numbers<double, 3>(1000, 3);
+  for (const expansion<double, 3> &xi : x) {
+    const expansion<double, 3> y = add(details::negate(xi), xi[0] * 0x1p-130);
+    exact e = exactValue(xi);
+    e.add(y);
+    EXPECT_LE(error(exactValue(add(xi, y)), e), (4 * unit<double, 3>()));
+  }
+}
+
+TEST(MultiWordTest, Exact) {
+  using E = expansion<double, 3>;
+  const E one(1.0), three(3.0);
+  const E third = div<true>(one, three);
+  EXPECT_EQ(third[0], 1.0 / 3);
+  const E p = mul<true>(third, three);
+  EXPECT_EQ(p[0], 1);
+  EXPECT_LE(std::abs(p[1]), 1e-47);
+
+  EXPECT_EQ(E::size(), 3u);
+  EXPECT_EQ(std::numeric_limits<E>::digits, 159);
+  EXPECT_EQ(std::numeric_limits<E>::digits10, 47);
+
+  // (2^60 - 1)^2 = 2^120 - 2^61 + 1 is representable
+  const E a(0x1p60, -1.0, 0.0);
+  const E a2 = mul<false>(a, a);
+  EXPECT_EQ(a2[0], 0x1p120);
+  EXPECT_EQ(a2[1], -0x1p61);
+  EXPECT_EQ(a2[2], 1);
+
+  // Sums with zero components
+  const E s = add(a, E(1.0));
+  EXPECT_EQ(s[0], 0x1p60);
+  EXPECT_EQ(s[1], 0);
+  EXPECT_EQ(add(E(1.0), 0x1p-200)[1], 0x1p-200);
+  EXPECT_EQ(sub(E(1.0), 1.0)[0], 0);
+
+  // Conversions between the precisions
+  const expansion<double, 2> t(third);
+  EXPECT_EQ(t[0], third[0]);
+  EXPECT_EQ(t[1], third[1]);
+  const E u(t);
+  EXPECT_EQ(u[1], third[1]);
+  EXPECT_EQ(u[2], 0);
+  EXPECT_EQ(E(two<double>(1.0, 0x1p-60))[1], 0x1p-60);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const E i = add(E(inf), one);
+  EXPECT_EQ(i[0], inf);
+  EXPECT_EQ(i[1], 0);
+}
+
+template <typename T, std::size_t N, std::size_t W>
+void vectorTest() {
+  using V = simd<T, W>;
+  const std::vector<expansion<T, N>> x = numbers<T, N>(W, 4),
+                                     y = numbers<T, N>(W, 5);
+  expansion<V, N> xv, yv;
+  for (std::size_t k = 0; k < N; ++k)
+    for (std::size_t lane = 0; lane < W; ++lane) {
+      xv[k].v[lane] = x[lane][k];
+      yv[k].v[lane] = y[lane][k];
+    }
+  const expansion<V, N> s = add(xv, yv), p = mul<true>(xv, yv),
+                        q = div<false>(xv, yv);
+  for (std::size_t lane = 0; lane < W; ++lane) {
+    const expansion<T, N> se = add(x[lane], y[lane]),
+                          pe = mul<true>(x[lane], y[lane]),
+                          qe = div<false>(x[lane], y[lane]);
+    for (std::size_t k = 0; k < N; ++k) {
+      EXPECT_EQ(s[k][lane], se[k]);
+      EXPECT_EQ(p[k][lane], pe[k]);
+      EXPECT_EQ(q[k][lane], qe[k]);
+    }
+  }
+}
+
+TEST(MultiWordTest, Vector) {
+  vectorTest<double, 2, 4>();
+  vectorTest<double, 3, 4>();
+  vectorTest<float, 4, 8>();
+}
+
+}  // namespace test
+}  // namespace multiword
+}  // namespace twofloat
@@ -0,0 +1,174 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/number.hpp>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace test {
+
+using doubleword::Mode;
+
+static_assert(sizeof(number<double, policy::doubleword<false>>) ==
+              sizeof(two<double>));
+static_assert(
+    std::is_trivially_copyable_v<number<float, policy::pair<false>>>);
+
+/// \brief Generic code that does not know about double-word numbers.
+template <typename S>
+S evaluate(const std::vector<S> &coeffs, const S &x) {
+  S res = 0;
+  for (auto c = coeffs.rbegin(); c != coeffs.rend(); ++c) res = res * x + *c;
+  return res;
+}
+
+template <typename Policy>
+void operatorTest() {
+  using N = number<double, Policy>;
+  randomTwo<double> random(1, 0x1p-30, -2, 2);
+  for (int i = 0; i < 1000; ++i) {
+    two<double> a = random();
+    two<double> b = random();
+    double c = random.uniform();
+    N x(a), y(b);
+
+    // The operators call the policy
+    expectBitwiseEqual((x + y).value, Policy::add(a, b));
+    expectBitwiseEqual((x - y).value, Policy::sub(a, b));
+    expectBitwiseEqual((x * y).value, Policy::mul(a, b));
+    expectBitwiseEqual((x / y).value, Policy::div(a, b));
+    expectBitwiseEqual((x + c).value, Policy::add(a, c));
+    expectBitwiseEqual((c + x).value, Policy::add(a, c));
+    expectBitwiseEqual((x - c).value, Policy::sub(a, c));
+    expectBitwiseEqual((c - x).value, Policy::add(two<double>(-a.h, -a.l), c));
+    expectBitwiseEqual((x * c).value, Policy::mul(a, c));
+    expectBitwiseEqual((c * x).value, Policy::mul(a, c));
+    expectBitwiseEqual((x / c).value, Policy::div(a, c));
+    expectBitwiseEqual((c / x).value, Policy::div(two<double>(c), a));
+
+    N z = x;
+    z += y;
+    z *= c;
+    z -= x;
+    z /= y;
+    two<double> expected =
+        Policy::div(Policy::sub(Policy::mul(Policy::add(a, b), c), a), b);
+    expectBitwiseEqual(z.value, expected);
+
+    // Comparisons use the normalized numbers
+    EXPECT_EQ(x < y, a.h < b.h || (a.h == b.h && a.l < b.l));
+    EXPECT_TRUE(x + y == y + x);
+    EXPECT_FALSE(x + y != y + x);
+    EXPECT_TRUE(x <= x && x >= x);
+    EXPECT_EQ(abs(x) >= N(0), true);
+    EXPECT_EQ(abs(x).value.h, std::abs(a.h));
+  }
+}
+
+TEST(Number, ConstructorTest) {
+  using N = number<float, policy::doubleword<false>>;
+  N x = 1;
+  EXPECT_EQ(x.value.h, 1.0f);
+  EXPECT_EQ(x.value.l, 0.0f);
+
+  // A double is split into two floats
+  N y = 1.0 + 0x1p-40;
+  EXPECT_EQ(y.value.h, 1.0f);
+  EXPECT_EQ(y.value.l, 0x1p-40f);
+  EXPECT_EQ(static_cast<float>(y), 1.0f);
+  EXPECT_TRUE(x < y);
+}
+
+TEST(Number, IntegerLimitsTest) {
+  using F = number<float, policy::doubleword<false>>;
+  using D = number<double, policy::doubleword<false>>;
+  // The high words round up to 2^31, 2^63 and 2^64
+  expectBitwiseEqual(F(std::numeric_limits<int>::max()).value,
+                     two<float>(0x1p31f, -1.0f));
+  expectBitwiseEqual(F(std::numeric_limits<int>::min()).value,
+                     two<float>(-0x1p31f, 0.0f));
+  expectBitwiseEqual(D(std::numeric_limits<long long>::max()).value,
+                     two<double>(0x1p63, -1.0));
+  expectBitwiseEqual(D(std::numeric_limits<long long>::min()).value,
+                     two<double>(-0x1p63, 0.0));
+  expectBitwiseEqual(D(std::numeric_limits<unsigned long long>::max()).value,
+                     two<double>(0x1p64, -1.0));
+  expectBitwiseEqual(F(std::numeric_limits<unsigned long long>::max()).value,
+                     two<float>(0x1p64f, -1.0f));
+  expectBitwiseEqual(D(-123456789012345678LL).value,
+                     two<double>(-123456789012345680.0, 2.0));
+  expectBitwiseEqual(F(short(-7)).value, two<float>(-7.0f, 0.0f));
+  expectBitwiseEqual(F(true).value, two<float>(1.0f, 0.0f));
+}
+
+template <typename Policy>
+void nanTest() {
+  using N = number<double, Policy>;
+  const double inf = std::numeric_limits<double>::infinity();
+  const N nan(std::numeric_limits<double>::quiet_NaN()), one(1.0),
+      lowNaN(two<double>(1.0, std::numeric_limits<double>::quiet_NaN()));
+  for (const N &x : {nan, lowNaN}) {
+    for (const N &y : {one, nan, lowNaN}) {
+      EXPECT_FALSE(x == y);
+      EXPECT_TRUE(x != y);
+      EXPECT_FALSE(x < y);
+      EXPECT_FALSE(x <= y);
+      EXPECT_FALSE(x > y);
+      EXPECT_FALSE(x >= y);
+      EXPECT_FALSE(y < x);
+      EXPECT_FALSE(y <= x);
+      EXPECT_FALSE(y > x);
+      EXPECT_FALSE(y >= x);
+    }
+  }
+
+  // Infinities compare by their high words, since `FastTwoSum` makes their
+  // low words NaN
+  const N big(inf), normalized(algorithms::FastTwoSum(inf, 0.0));
+  EXPECT_TRUE(std::isnan(normalized.value.l));
+  EXPECT_TRUE(normalized == big);
+  EXPECT_TRUE(normalized >= big);
+  EXPECT_FALSE(normalized > big);
+  EXPECT_TRUE(one < normalized);
+  EXPECT_TRUE(-normalized < one);
+  EXPECT_TRUE(N(0.0) == N(-0.0));
+}
+
+TEST(Number, NaNTest) {
+  nanTest<policy::doubleword<false>>();
+  nanTest<policy::pair<false>>();
+}
+
+TEST(Number, OperatorTest) {
+  operatorTest<policy::doubleword<false>>();
+  operatorTest<policy::pair<false>>();
+}
+
+TEST(Number, GenericTest) {
+  // 1 + x + x²/2 + x³/6 with generic code and with direct calls
+  using P = policy::doubleword<false>;
+  using N = number<double, P>;
+  std::vector<N> coeffs = {N(1), N(1), N(1) / N(2), N(1) / N(6)};
+  N res = evaluate(coeffs, N(0.125));
+
+  two<double> expected;
+  for (auto c = coeffs.rbegin(); c != coeffs.rend(); ++c)
+    expected = P::add(P::mul(expected, two<double>(0.125)), c->value);
+  expectBitwiseEqual(res.value, expected);
+  EXPECT_NEAR(static_cast<double>(res), std::exp(0.125), 1e-4);
+}
+
+TEST(Number, FMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  operatorTest<policy::doubleword<true, Mode::Accurate>>();
+  operatorTest<policy::pair<true>>();
+}
+
+}  // namespace test
+}  // namespace twofloat
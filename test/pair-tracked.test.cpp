@@ -0,0 +1,77 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-tracked.hpp>
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace pair {
+namespace test {
+
+TEST(PairTracked, CountTest) {
+  using P = tracked<double, 4>;
+  P a(1.0), b(two<double>(2.0, 0x1p-60));
+  EXPECT_EQ(a.operations, 0u);
+
+  P c = add(a, b);
+  EXPECT_EQ(c.operations, 1u);
+  P d = mul<false>(c, c);
+  EXPECT_EQ(d.operations, 3u);
+  P e = sub(d, 0.5);
+  EXPECT_EQ(e.operations, 4u);
+
+  // The next operation would exceed the budget, so the operands are
+  // normalized first
+  P f = add(e, a);
+  EXPECT_EQ(f.operations, 1u);
+  P g = div<false>(e, d);
+  EXPECT_EQ(g.operations, 1u);
+  EXPECT_EQ(mul<false>(e, 2.0).operations, 1u);
+
+  two<double> expected = algorithms::FastTwoSum(e.value.h, e.value.l);
+  EXPECT_EQ(f.value.h, expected.h + 1.0);
+  EXPECT_EQ(e.normalized().h, expected.h);
+  EXPECT_EQ(e.normalized().l, expected.l);
+}
+
+TEST(PairTracked, BudgetTest) {
+  // A long product stays within the budget and is as accurate as the
+  // double-word product
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(0.5, 2);
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+
+  tracked<double, 16> p(1.0);
+  two<double> q(1.0);
+  std::size_t maxOperations = 0;
+  for (int i = 0; i < 1000; ++i) {
+    double x = dist(gen);
+    p = mul<false>(p, x);
+    q = doubleword::mul<doubleword::Mode::Accurate, false>(q, x);
+    if (p.operations > maxOperations) maxOperations = p.operations;
+  }
+  EXPECT_EQ(maxOperations, 16u);
+
+  two<double> diff = doubleword::sub<doubleword::Mode::Accurate>(
+      p.normalized(), q);
+  EXPECT_LE(std::abs(diff.h), 1000 * 4 * u * u * std::abs(q.h));
+  EXPECT_EQ(p.normalized().h, q.h);
+}
+
+TEST(PairTracked, DefaultBudgetTest) {
+  EXPECT_EQ((tracked<double>().operations), 0u);
+  static_assert(faithfulOperations<double> == std::size_t(1) << 23);
+  static_assert(faithfulOperations<float> == std::size_t(1) << 9);
+
+  // With float, the default budget is reached in a long sum
+  tracked<float> s;
+  for (int i = 0; i < 2000; ++i) s = add(s, 0.1f);
+  EXPECT_LE(s.operations, faithfulOperations<float>);
+  EXPECT_NEAR(s.normalized().eval<double>(), 2000 * double(0.1f), 1e-9);
+}
+
+}  // namespace test
+}  // namespace pair
+}  // namespace twofloat
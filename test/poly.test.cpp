@@ -0,0 +1,114 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-functions.hpp>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/poly.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace poly {
+namespace test {
+
+const two<double> integers[] = {two<double>(1.0), two<double>(2.0),
+                                two<double>(3.0), two<double>(4.0),
+                                two<double>(5.0)};
+const two<double> constant[] = {two<double>(0.5, 0x1p-60)};
+
+/// \brief The Taylor coefficients of exp up to degree 11.
+template <typename T>
+constexpr const auto &expCoeffs = doubleword::details::tables<T>::invFactorial;
+
+static_assert(std::is_same_v<details::resolve<policy::faithful<false>, double,
+                                              11>::type,
+                             policy::pair<false>>);
+static_assert(std::is_same_v<details::resolve<policy::faithful<true>, float,
+                                              1000>::type,
+                             policy::doubleword<true>>);
+
+template <typename Policy>
+void exactTest() {
+  // 1 + 2/2 + 3/4 + 4/8 + 5/16 is exact
+  for (two<double> p : {horner<integers, Policy>(two<double>(0.5)),
+                        estrin<integers, Policy>(two<double>(0.5))}) {
+    EXPECT_EQ(p.h, 3.5625);
+    EXPECT_EQ(p.l, 0.0);
+  }
+  two<double> c = horner<constant, Policy>(two<double>(3.0));
+  EXPECT_EQ(c.h, 0.5);
+  EXPECT_EQ(c.l, 0x1p-60);
+  two<double> e = estrin<constant, Policy>(two<double>(3.0));
+  EXPECT_EQ(e.l, 0x1p-60);
+}
+
+template <bool useFMA>
+void accuracyTest() {
+  using DW = policy::doubleword<useFMA>;
+  const double u = std::numeric_limits<double>::epsilon() / 2;
+
+  // The truncation error of the Taylor polynomial is below u² for |x| <= 1/64
+  // and each of the 22 operations adds an error of a few u²
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-1.0 / 64, 1.0 / 64);
+  for (int i = 0; i < 1000; ++i) {
+    two<double> x(dist(gen));
+    two<double> expected = doubleword::exp<useFMA>(x);
+    for (two<double> p : {horner<expCoeffs<double>, DW>(x),
+                          estrin<expCoeffs<double>, DW>(x)}) {
+      two<double> diff =
+          doubleword::sub<doubleword::Mode::Accurate>(p, expected);
+      EXPECT_LE(std::abs(diff.h), 64 * u * u);
+    }
+
+    // The pair arithmetic is faithful in working precision
+    for (two<double> p :
+         {horner<expCoeffs<double>, policy::pair<useFMA>>(x),
+          estrin<expCoeffs<double>, policy::faithful<useFMA>>(x)}) {
+      EXPECT_LE(std::abs(p.h - expected.h), 2 * u * expected.h);
+      EXPECT_EQ(p.h, p.h + p.l);
+    }
+  }
+}
+
+TEST(Poly, ExactTest) {
+  exactTest<policy::doubleword<false>>();
+  exactTest<policy::pair<false>>();
+  exactTest<policy::faithful<false>>();
+}
+
+TEST(Poly, AccuracyTest) { accuracyTest<false>(); }
+
+TEST(Poly, FMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  exactTest<policy::doubleword<true, doubleword::Mode::Accurate>>();
+  exactTest<policy::pair<true>>();
+  accuracyTest<true>();
+}
+
+TEST(Poly, SimdTest) {
+  using V = simd<float, 8>;
+  using P = policy::doubleword<false>;
+  two<V> x;
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    x.h.v[k] = float(k) / 512;
+    x.l.v[k] = float(k) * 0x1p-40f;
+  }
+  two<V> h = horner<expCoeffs<float>, P>(x);
+  two<V> e = estrin<expCoeffs<float>, P>(x);
+  for (std::size_t k = 0; k < V::size(); ++k) {
+    two<float> xk(x.h.v[k], x.l.v[k]);
+    two<float> hk = horner<expCoeffs<float>, P>(xk);
+    two<float> ek = estrin<expCoeffs<float>, P>(xk);
+    EXPECT_EQ(h.h.v[k], hk.h);
+    EXPECT_EQ(h.l.v[k], hk.l);
+    EXPECT_EQ(e.h.v[k], ek.h);
+    EXPECT_EQ(e.l.v[k], ek.l);
+  }
+}
+
+}  // namespace test
+}  // namespace poly
+}  // namespace twofloat
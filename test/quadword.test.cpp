@@ -0,0 +1,167 @@
+#include <cmath>
+#include <cstddef>
+#include <libtwofloat/arithmetics/quad-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/quad-word-batch.hpp>
+#include <libtwofloat/limits.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace quadword {
+namespace test {
+
+using twofloat::test::error;
+using twofloat::test::exact;
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::exactValue;
+
+template <typename T>
+std::vector<four<T>> numbers(std::size_t n, unsigned seed, bool positive) {
+  return twofloat::test::numbers<T, 4>(n, seed, positive);
+}
+
+template <typename T>
+double unit() {
+  return twofloat::test::unit<T, 4>();
+}
+
+template <Mode mode, bool useFMA, typename T>
+void accuracyTest(double addTolerance, double mulTolerance,
+                  double divTolerance) {
+  twofloat::test::accuracyTest(
+      numbers<T>(2000, 1, mode == Mode::Sloppy),
+      numbers<T>(2000, 2, mode == Mode::Sloppy),
+      [](const four<T> &x, const four<T> &y) { return add<mode>(x, y); },
+      [](const four<T> &x, const four<T> &y) {
+        return mul<mode, useFMA>(x, y);
+      },
+      [](const four<T> &x, const four<T> &y) {
+        return div<mode, useFMA>(x, y);
+      },
+      addTolerance, mulTolerance, divTolerance);
+}
+
+TEST(QuadWordTest, AccuracyDouble) {
+  accuracyTest<Mode::Sloppy, true, double>(4, 8, 8);
+  accuracyTest<Mode::Accurate, true, double>(4, 8, 8);
+  accuracyTest<Mode::Accurate, false, double>(4, 8, 8);
+}
+
+TEST(QuadWordTest, AccuracyFloat) {
+  accuracyTest<Mode::Sloppy, true, float>(4, 8, 8);
+  accuracyTest<Mode::Accurate, true, float>(4, 8, 8);
+}
+
+TEST(QuadWordTest, Cancellation) {
+  // The leading components of x and y cancel, and the sum of the trailing
+  // components is small
+  const std::vector<four<double>> x = numbers<double>(1000, 3, false);
+  for (const four<double> &xi : x) {
+    const four<double> y = add(details::negate(xi), xi[0] * 0x1p-180);
+    exact e = exactValue(xi);
+    e.add(y);
+    EXPECT_LE(error(exactValue(add<Mode::Accurate>(xi, y)), e),
+              4 * unit<double>());
+  }
+}
+
+TEST(QuadWordTest, Exact) {
+  const four<double> one(1.0), three(3.0);
+  const four<double> third = div<Mode::Accurate, true>(one, three);
+  EXPECT_EQ(third[0], 1.0 / 3);
+  const four<double> p = mul<Mode::Accurate, true>(third, three);
+  EXPECT_EQ(p[0], 1);
+  EXPECT_LE(std::abs(p[1]), 1e-63);
+
+  EXPECT_EQ(std::numeric_limits<four<double>>::digits10, 63);
+
+  // (2^100 - 1)^2 = 2^200 - 2^101 + 1 is representable
+  const four<double> a(0x1p100, -1, 0, 0);
+  const four<double> a2 = mul<Mode::Accurate, false>(a, a);
+  EXPECT_EQ(a2[0], 0x1p200);
+  EXPECT_EQ(a2[1], -0x1p101);
+  EXPECT_EQ(a2[2], 1);
+  EXPECT_EQ(a2[3], 0);
+
+  // Sums with zero components
+  const four<double> s = add<Mode::Accurate>(a, four<double>(1.0));
+  EXPECT_EQ(s[0], 0x1p100);
+  EXPECT_EQ(s[1], 0);
+  EXPECT_EQ(add<Mode::Sloppy>(a, four<double>(1.0))[0], 0x1p100);
+  EXPECT_EQ(add(four<double>(1.0), 0x1p-200)[1], 0x1p-200);
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const four<double> i = add<Mode::Accurate>(four<double>(inf), one);
+  EXPECT_EQ(i[0], inf);
+  EXPECT_EQ(i[1], 0);
+}
+
+template <typename T>
+void batchTest() {
+  const std::size_t n = 37;
+  const std::vector<four<T>> x = numbers<T>(n, 4, false),
+                             y = numbers<T>(n, 5, false);
+  const span<const four<T>> xs(x), ys(y);
+  std::vector<four<T>> z(n), expected(n);
+  const span<four<T>> zs(z);
+
+  batch::add<Mode::Accurate>(xs, ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = add<Mode::Accurate>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+
+  batch::sub<Mode::Sloppy>(xs, ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = sub<Mode::Sloppy>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+
+  batch::mul<Mode::Accurate, true>(xs, ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = mul<Mode::Accurate, true>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+
+  batch::mul<Mode::Sloppy, false>(xs, ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = mul<Mode::Sloppy, false>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+
+  batch::div<Mode::Accurate, true>(xs, ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = div<Mode::Accurate, true>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+
+  // In place
+  z = x;
+  batch::add<Mode::Sloppy>(span<const four<T>>(z), ys, zs);
+  for (std::size_t i = 0; i < n; ++i)
+    expected[i] = add<Mode::Sloppy>(x[i], y[i]);
+  expectBitwiseEqualArrays<four<T>>(z, expected);
+}
+
+TEST(QuadWordTest, Batch) {
+  batchTest<double>();
+  batchTest<float>();
+}
+
+TEST(QuadWordTest, BatchSizes) {
+  const std::vector<four<double>> x(5), shorter(4);
+  std::vector<four<double>> z(5);
+  const span<const four<double>> xs(x), ss(shorter);
+  const span<four<double>> zs(z);
+  EXPECT_THROW(batch::add<Mode::Accurate>(ss, xs, zs), std::invalid_argument);
+  EXPECT_THROW(batch::sub<Mode::Sloppy>(xs, ss, zs), std::invalid_argument);
+  EXPECT_THROW((batch::mul<Mode::Accurate, true>(ss, xs, zs)),
+               std::invalid_argument);
+  EXPECT_THROW((batch::div<Mode::Accurate, true>(xs, ss, zs)),
+               std::invalid_argument);
+  // Longer inputs are allowed, only `z.size()` elements are processed.
+  batch::add<Mode::Accurate>(xs, xs, span<four<double>>(z.data(), 4));
+}
+
+}  // namespace test
+}  // namespace quadword
+}  // namespace twofloat
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cmath>
+#include <libtwofloat/reduce.hpp>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace reduce {
+namespace test {
+
+using twofloat::test::expectBitwiseEqual;
+
+/// \brief Creates `n` random numbers whose exact sum is `n / 2`: pairs of
+/// large numbers that cancel, and ones.
+std::vector<double> cancellingNumbers(std::size_t n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1e10, 1e10);
+
+  std::vector<double> x;
+  for (std::size_t i = 0; i < n / 4; ++i) {
+    double a = dist(gen);
+    x.push_back(a);
+    x.push_back(-a);
+    x.push_back(1);
+    x.push_back(1);
+  }
+  std::shuffle(x.begin(), x.end(), gen);
+  return x;
+}
+
+TEST(Reduce, SumTest) {
+  std::vector<double> x = cancellingNumbers(100000, 1);
+  two<double> result = sum(span<const double>(x));
+
+  // Plain summation loses the ones against the large numbers
+  EXPECT_NEAR(result.eval(), x.size() / 2, 1e-6);
+}
+
+TEST(Reduce, SumFloatTest) {
+  std::vector<float> x(1001, 1.0f);
+  x[0] = 1e8f;
+  two<float> result = sum(span<const float>(x));
+  EXPECT_EQ(result.eval<double>(), 1e8 + 1000);
+}
+
+TEST(Reduce, ThreadCountTest) {
+  // The result must not depend on the number of threads
+  std::vector<double> x = cancellingNumbers(3 * blockSize + 123, 2);
+  two<double> expected = sum(span<const double>(x), 1);
+  for (unsigned threads : {2u, 3u, 8u, 0u})
+    expectBitwiseEqual(sum(span<const double>(x), threads), expected);
+}
+
+TEST(Reduce, SumDoubleWordTest) {
+  std::vector<double> hs = cancellingNumbers(2 * blockSize + 45, 3);
+  std::vector<two<double>> x;
+  soa_vector<double> y;
+  for (double h : hs) {
+    x.push_back(two<double>(h, h * 1e-20));
+    y.push_back(x.back());
+  }
+
+  // Array of structures and structure of arrays give the same result
+  two<double> result = sum(span<const two<double>>(x), 1);
+  expectBitwiseEqual(sum(span<const two<double>>(x), 4), result);
+  expectBitwiseEqual(sum(soa_span<const double>(y), 4), result);
+  EXPECT_NEAR(result.eval(), hs.size() / 2, 1e-6);
+}
+
+/// \brief Creates two arrays of size `2 * n + ones` whose exact dot product is
+/// `ones`, while the products are large and cancel.
+void cancellingProducts(std::size_t n, std::size_t ones, unsigned seed,
+                        std::vector<double> &x, std::vector<double> &y) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1e10, 1e10);
+
+  std::vector<std::pair<double, double>> pairs;
+  for (std::size_t i = 0; i < n; ++i) {
+    double a = dist(gen), b = dist(gen);
+    pairs.push_back({a, b});
+    pairs.push_back({a, -b});
+  }
+  for (std::size_t i = 0; i < ones; ++i) pairs.push_back({1, 1});
+  std::shuffle(pairs.begin(), pairs.end(), gen);
+
+  x.clear();
+  y.clear();
+  for (auto [a, b] : pairs) {
+    x.push_back(a);
+    y.push_back(b);
+  }
+}
+
+template <bool useFMA>
+void dotTest() {
+  std::vector<double> x, y;
+  cancellingProducts(50000, 1001, 5, x, y);
+  two<double> result =
+      dot<useFMA>(span<const double>(x), span<const double>(y));
+  EXPECT_NEAR(result.eval(), 1001, 1e-6);
+
+  // Tail that is not a multiple of the vector width. The rounding errors of
+  // the products must not be lost.
+  std::vector<float> a = {4097, 1, -4097, 3, 5};
+  std::vector<float> b = {4097, 1, 4097, 1, 1};
+  two<float> r = dot<useFMA>(span<const float>(a), span<const float>(b));
+  EXPECT_EQ(r.eval<double>(), 9);
+}
+
+TEST(Reduce, DotTest) { dotTest<false>(); }
+
+TEST(Reduce, DotFMATest) {
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  dotTest<true>();
+}
+
+TEST(Reduce, DotThreadCountTest) {
+  std::vector<double> x, y;
+  cancellingProducts(2 * blockSize, 77, 6, x, y);
+  two<double> expected = dot(span<const double>(x), span<const double>(y), 1);
+  for (unsigned threads : {2u, 5u})
+    expectBitwiseEqual(
+        dot(span<const double>(x), span<const double>(y), threads), expected);
+}
+
+TEST(Reduce, Nrm2Test) {
+  // The squares of these numbers overflow or underflow
+  for (int e : {600, 0, -600, -1060}) {
+    std::vector<double> x(37, 0.0);
+    x[3] = std::ldexp(3.0, e);
+    x[35] = std::ldexp(-4.0, e);
+    two<double> result = nrm2<false>(span<const double>(x));
+    EXPECT_EQ(result.h, std::ldexp(5.0, e)) << e;
+    EXPECT_EQ(result.l, 0.0) << e;
+  }
+
+  // The double-word result is accurate beyond double precision:
+  // |(1, 1e-9)| = 1 + 5e-19 - 1.25e-37 + ...
+  std::vector<double> x = {1, 1e-9};
+  two<double> result = nrm2(span<const double>(x));
+  EXPECT_EQ(result.h, 1.0);
+  EXPECT_NEAR(result.l, 5e-19, 1e-33);
+
+  EXPECT_EQ(nrm2(span<const double>()).eval(), 0.0);
+}
+
+TEST(Reduce, SpecialValuesTest) {
+  // NaNs propagate, also next to infinities and in the vector loop
+  const double nan = std::numeric_limits<double>::quiet_NaN(),
+               inf = std::numeric_limits<double>::infinity();
+  for (std::size_t n : {2, 3, 100}) {
+    for (std::size_t k : {std::size_t(0), n - 1}) {
+      std::vector<double> x(n, 2.0);
+      x[k] = nan;
+      EXPECT_TRUE(std::isnan(nrm2(span<const double>(x)).h)) << n << " " << k;
+      x[n - 1 - k] = inf;
+      EXPECT_TRUE(std::isnan(nrm2(span<const double>(x)).h)) << n << " " << k;
+      x[k] = 0.0;
+      EXPECT_EQ(nrm2(span<const double>(x)).h, inf) << n << " " << k;
+    }
+  }
+  std::vector<double> zeros(10, 0.0);
+  zeros[7] = nan;
+  EXPECT_TRUE(std::isnan(nrm2<false>(span<const double>(zeros)).h));
+
+  // The arrays of a dot product have the same size
+  std::vector<double> x(10, 1.0), y(11, 1.0);
+  EXPECT_THROW(dot(span<const double>(x), span<const double>(y)),
+               std::invalid_argument);
+  EXPECT_THROW(dot<false>(span<const double>(y), span<const double>(x)),
+               std::invalid_argument);
+}
+
+TEST(Reduce, EmptyTest) {
+  two<double> result = sum(span<const double>());
+  EXPECT_EQ(result.h, 0.0);
+  EXPECT_EQ(result.l, 0.0);
+}
+
+}  // namespace test
+}  // namespace reduce
+}  // namespace twofloat
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <libtwofloat/arithmetics/double-word-arithmetic.hpp>
+#include <libtwofloat/arithmetics/pair-arithmetic.hpp>
+#include <libtwofloat/simd.hpp>
+#include <limits>
+#include <random>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace test {
+
+/// \brief Creates a vector of random normalized double-word numbers. Some of
+/// them are large enough to require scaling in algorithms::Split.
+template <typename V>
+two<V> randomVector(std::mt19937 &gen) {
+  using T = scalar_type_t<V>;
+  std::uniform_real_distribution<T> mantissa(-1, 1);
+  std::uniform_int_distribution<int> exponent(-20, 20);
+
+  two<V> v;
+  for (std::size_t i = 0; i < V::size(); ++i) {
+    T h = std::ldexp(mantissa(gen), exponent(gen));
+    if (i == 1) h = std::numeric_limits<T>::max() * mantissa(gen) / 4;
+    T l = h * mantissa(gen) * std::numeric_limits<T>::epsilon();
+    two<T> x = algorithms::FastTwoSum(h, l);
+    v.h.v[i] = x.h;
+    v.l.v[i] = x.l;
+  }
+  return v;
+}
+
+template <typename V>
+two<scalar_type_t<V>> lane(const two<V> &x, std::size_t i) {
+  return {x.h[i], x.l[i]};
+}
+
+/// \brief Expects that the operation `op` applied to vectors produces bitwise
+/// identical results to the operation applied to each lane.
+template <typename V, typename Op>
+void expectLanewise(Op op) {
+  std::mt19937 gen(1);
+  for (int k = 0; k < 100; ++k) {
+    two<V> x = randomVector<V>(gen);
+    two<V> y = randomVector<V>(gen);
+    two<V> z = op(x, y);
+    for (std::size_t i = 0; i < V::size(); ++i) {
+      SCOPED_TRACE(i);
+      expectBitwiseEqual(lane(z, i), op(lane(x, i), lane(y, i)));
+    }
+  }
+}
+
+template <typename V>
+void simdTest() {
+  using doubleword::Mode;
+
+  // Error-free transformations
+  expectLanewise<V>([](auto x, auto y) {
+    return algorithms::TwoSum(x.h, y.h);
+  });
+  expectLanewise<V>([](auto x, auto y) {
+    return algorithms::TwoDiff(x.h, y.h);
+  });
+  expectLanewise<V>([](auto x, auto y) {
+    return algorithms::TwoProd(x.h, y.h);
+  });
+  expectLanewise<V>([](auto x, auto y) {
+    return algorithms::Fast2Prod(x.h, y.h);
+  });
+
+  // Double-word arithmetic
+  expectLanewise<V>(
+      [](auto x, auto y) { return doubleword::add<Mode::Accurate>(x, y); });
+  expectLanewise<V>(
+      [](auto x, auto y) { return doubleword::sub<Mode::Sloppy>(x, y); });
+  expectLanewise<V>(
+      [](auto x, auto y) { return doubleword::mul<Mode::Fast, false>(x, y); });
+  expectLanewise<V>([](auto x, auto y) {
+    return doubleword::mul<Mode::Accurate, true>(x, y);
+  });
+  expectLanewise<V>([](auto x, auto y) {
+    return doubleword::mul<Mode::Accurate, false>(x, y.h);
+  });
+  expectLanewise<V>(
+      [](auto x, auto y) { return doubleword::div<Mode::Fast, false>(x, y); });
+  expectLanewise<V>([](auto x, auto y) {
+    return doubleword::div<Mode::Accurate, true>(x, y);
+  });
+  expectLanewise<V>(
+      [](auto x, auto y) { return doubleword::sub(x.h, y); });
+
+  // Pair arithmetic
+  expectLanewise<V>([](auto x, auto y) { return pair::add(x, y); });
+  expectLanewise<V>([](auto x, auto y) { return pair::sub(x.h, y); });
+  expectLanewise<V>([](auto x, auto y) { return pair::mul<false>(x, y); });
+  expectLanewise<V>([](auto x, auto y) { return pair::mul<true>(x.h, y); });
+  expectLanewise<V>([](auto x, auto y) { return pair::div(x, y); });
+}
+
+TEST(Simd, FloatTest) { simdTest<simd<float, 8>>(); }
+
+TEST(Simd, DoubleTest) {
+  simdTest<simd<double, 2>>();
+  simdTest<simd<double, 4>>();
+}
+
+TEST(Simd, BroadcastTest) {
+  // Scalars and scalar-only constructors of two<T> broadcast to all lanes
+  two<simd<double, 4>> x(1.5);
+  two<simd<double, 4>> y = doubleword::add(x, simd<double, 4>(2));
+  for (std::size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(y.h[i], 3.5);
+    EXPECT_EQ(y.l[i], 0.0);
+  }
+}
+
+template <typename T, std::size_t N>
+void interleavedTest() {
+  T in[2 * N], out[2 * N];
+  for (std::size_t i = 0; i < 2 * N; ++i) in[i] = T(i);
+  simd<T, N> x, y;
+  load_interleaved(in, x, y);
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(x[i], T(2 * i));
+    EXPECT_EQ(y[i], T(2 * i + 1));
+  }
+  store_interleaved(out, x, y);
+  for (std::size_t i = 0; i < 2 * N; ++i) EXPECT_EQ(out[i], in[i]);
+}
+
+TEST(Simd, InterleavedTest) {
+  interleavedTest<double, 1>();
+  interleavedTest<double, 2>();
+  interleavedTest<double, 8>();
+  interleavedTest<float, 4>();
+  interleavedTest<float, 16>();
+}
+
+}  // namespace test
+}  // namespace twofloat
@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <new>
+#include <libtwofloat/soa-vector.hpp>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace test {
+
+TEST(SoaVector, AlignmentTest) {
+  // Both arrays must be aligned to allow aligned vector loads
+  soa_vector<double> v(17);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.h_data()) % soa_alignment, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.l_data()) % soa_alignment, 0u);
+
+  // Growing the container must preserve the alignment
+  for (int i = 0; i < 100; ++i) v.push_back(two<double>(i));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.h_data()) % soa_alignment, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.l_data()) % soa_alignment, 0u);
+}
+
+TEST(SoaVector, ElementAccessTest) {
+  soa_vector<float> v = {{1.0f, 1e-9f}, {2.0f, 2e-9f}};
+  ASSERT_EQ(v.size(), 2u);
+
+  // Reading through the proxy yields the stored double-word number
+  two<float> x = v[1];
+  EXPECT_EQ(x.h, 2.0f);
+  EXPECT_EQ(x.l, 2e-9f);
+
+  // Writing through the proxy updates the separate arrays
+  v[0] = two<float>(3.0f, 3e-9f);
+  v[1].l = 4e-9f;
+  EXPECT_EQ(v.h_data()[0], 3.0f);
+  EXPECT_EQ(v.l_data()[0], 3e-9f);
+  EXPECT_EQ(v.l_data()[1], 4e-9f);
+
+  // Assigning one proxy to another copies the value
+  v[1] = v[0];
+  EXPECT_EQ(v.h_data()[1], 3.0f);
+  EXPECT_EQ(v.l_data()[1], 3e-9f);
+}
+
+TEST(SoaVector, ConversionTest) {
+  std::vector<two<double>> aos = {{1.0, 1e-20}, {2.0, 2e-20}, {3.0, 3e-20}};
+
+  soa_vector<double> v(aos);
+  soa_vector<double> copy = v;
+  soa_span<const double> view = copy;
+
+  std::vector<two<double>> roundtrip(aos.size());
+  copy.copy_to(roundtrip);
+  for (std::size_t i = 0; i < aos.size(); ++i) {
+    EXPECT_EQ(roundtrip[i].h, aos[i].h);
+    EXPECT_EQ(roundtrip[i].l, aos[i].l);
+    EXPECT_EQ(view[i].eval(), aos[i].eval());
+  }
+}
+
+TEST(SoaVector, AllocationSizeTest) {
+  const std::size_t n = soa_vector<double>::max_size();
+  EXPECT_THROW(soa_vector<double>(n + 1), std::bad_array_new_length);
+  EXPECT_THROW(soa_vector<double>(SIZE_MAX), std::bad_array_new_length);
+  soa_vector<double> v;
+  EXPECT_THROW(v.reserve(SIZE_MAX), std::bad_array_new_length);
+  EXPECT_TRUE(v.empty());
+}
+
+}  // namespace test
+}  // namespace twofloat
@@ -0,0 +1,142 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <libtwofloat/cpu.hpp>
+#include <libtwofloat/policy.hpp>
+#include <libtwofloat/sparse.hpp>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "gtest/gtest.h"
+
+namespace twofloat {
+namespace sparse {
+namespace test {
+
+using twofloat::test::expectBitwiseEqualArrays;
+using twofloat::test::forEachInstructionSet;
+using twofloat::test::randomTwo;
+
+/// \brief A random matrix with rows of very different lengths, including
+/// empty rows, and without nonzeros in column 0.
+template <typename E>
+csr<E> matrix(std::size_t rows, std::size_t cols, unsigned seed) {
+  using T = typename csr<E>::value_type;
+  randomTwo<T> random(seed, T(1e-9));
+  std::uniform_int_distribution<std::uint32_t> col(1, cols - 1);
+  csr<E> A;
+  A.rows = rows;
+  A.cols = cols;
+  A.rowPtr.push_back(0);
+  for (std::size_t i = 0; i < rows; ++i) {
+    const std::size_t length = i % 7 == 3 ? 0 : (i * i) % 37;
+    for (std::size_t k = 0; k < length; ++k) {
+      A.colIdx.push_back(col(random.engine()));
+      if constexpr (std::is_same_v<E, T>)
+        A.values.push_back(random.uniform());
+      else
+        A.values.push_back(random());
+    }
+    A.rowPtr.push_back(A.values.size());
+  }
+  return A;
+}
+
+template <typename P, typename E>
+void spmvTest() {
+  using T = typename csr<E>::value_type;
+  const std::size_t rows = 501, cols = 300;
+  const csr<E> A = matrix<E>(rows, cols, 1);
+  std::vector<two<T>> x = randomTwo<T>(2, T(1e-9))(cols);
+  // Column 0 is only referenced by the padding
+  x[0] = two<T>(std::numeric_limits<T>::infinity());
+
+  std::vector<two<T>> expected(rows);
+  for (std::size_t i = 0; i < rows; ++i) {
+    two<T> acc;
+    for (std::size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; ++k) {
+      if constexpr (std::is_same_v<E, T>)
+        acc = P::fma(x[A.colIdx[k]], A.values[k], acc);
+      else
+        acc = P::fma(A.values[k], x[A.colIdx[k]], acc);
+    }
+    expected[i] = P::normalize(acc);
+  }
+
+  const sell<E> sorted(A, 64), unsorted(A);
+  const sell<E, 4> narrow(A, 32);
+  forEachInstructionSet([&]() {
+    for (unsigned threads : {1u, 3u}) {
+      std::vector<two<T>> y1(rows), y2(rows), y3(rows), y4(rows);
+      spmv<P>(A, x, y1, threads);
+      spmv<P>(sorted, x, y2, threads);
+      spmv<P>(unsorted, x, y3, threads);
+      spmv<P>(narrow, x, y4, threads);
+      for (const std::vector<two<T>> &y : {y1, y2, y3, y4})
+        expectBitwiseEqualArrays<two<T>>(y, expected);
+    }
+  });
+}
+
+TEST(Sparse, SpmvTest) {
+  spmvTest<policy::doubleword<false>, two<double>>();
+  spmvTest<policy::doubleword<false>, two<float>>();
+  spmvTest<policy::pair<false>, two<double>>();
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  spmvTest<policy::doubleword<true>, two<double>>();
+}
+
+TEST(Sparse, MixedTest) {
+  // A floating point matrix with a double-word vector
+  spmvTest<policy::doubleword<false>, double>();
+  spmvTest<policy::doubleword<false>, float>();
+  if (!cpu::hasFMA()) GTEST_SKIP() << "The CPU does not support FMA";
+  spmvTest<policy::doubleword<true>, double>();
+}
+
+TEST(Sparse, SellTest) {
+  // The padding of the chunks shrinks with sorting
+  const csr<double> A = matrix<double>(1000, 100, 3);
+  const sell<double> unsorted(A), sorted(A, 1000);
+  EXPECT_EQ(unsorted.chunks(), 125u);
+  EXPECT_LT(sorted.chunkPtr.back(), unsorted.chunkPtr.back());
+  EXPECT_GE(sorted.chunkPtr.back(), A.nonzeros());
+  EXPECT_TRUE(sorted.l.empty());
+  for (std::size_t r = 0; r + 1 < 1000; ++r)
+    EXPECT_GE(sorted.rowLength[r], sorted.rowLength[r + 1]);
+}
+
+TEST(Sparse, EmptyTest) {
+  // Default-constructed matrices and their conversions have no rows
+  using P = policy::doubleword<false>;
+  const csr<two<double>> A;
+  const sell<two<double>> B, converted(A, 8);
+  EXPECT_EQ(A.nonzeros(), 0u);
+  EXPECT_EQ(B.chunks(), 0u);
+  EXPECT_EQ(converted.chunks(), 0u);
+  std::vector<two<double>> x, y;
+  spmv<P>(A, x, y, 3);
+  spmv<P>(B, x, y, 3);
+  spmv<P>(converted, x, y);
+}
+
+TEST(Sparse, SizeErrorsTest) {
+  using P = policy::doubleword<false>;
+  const csr<two<double>> A = matrix<two<double>>(20, 10, 3);
+  const sell<two<double>, 4> B(A, 8);
+  std::vector<two<double>> x(10), y(20), shortX(9), shortY(19);
+  for (unsigned threads : {1u, 3u}) {
+    EXPECT_THROW(spmv<P>(A, shortX, y, threads), std::invalid_argument);
+    EXPECT_THROW(spmv<P>(A, x, shortY, threads), std::invalid_argument);
+    EXPECT_THROW(spmv<P>(B, shortX, y, threads), std::invalid_argument);
+    EXPECT_THROW(spmv<P>(B, x, shortY, threads), std::invalid_argument);
+  }
+  EXPECT_NO_THROW(spmv<P>(B, x, y));
+}
+
+}  // namespace test
+}  // namespace sparse
+}  // namespace twofloat